@@ -0,0 +1,449 @@
+// AudioEngine.cpp
+#include "AudioEngine.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+int64_t SteadyNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t ReadLe16(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8);
+}
+
+uint32_t ReadLe32(const unsigned char* p) {
+    return ReadLe16(p) | (ReadLe16(p + 2) << 16);
+}
+
+// Satu sampel WAV ke float -1..1
+float ReadSample(const unsigned char* p, int bits, bool isFloat) {
+    if (isFloat) {
+        uint32_t raw = ReadLe32(p);
+        float value;
+        std::memcpy(&value, &raw, sizeof(value));
+        return value;
+    }
+    switch (bits) {
+        case 8:
+            return (static_cast<int>(p[0]) - 128) / 128.0f;
+        case 16:
+            return static_cast<int16_t>(ReadLe16(p)) / 32768.0f;
+        case 24: {
+            int32_t value = static_cast<int32_t>((p[0] << 8) | (p[1] << 16) | (static_cast<uint32_t>(p[2]) << 24));
+            return (value >> 8) / 8388608.0f;
+        }
+        default:
+            return static_cast<int32_t>(ReadLe32(p)) / 2147483648.0f;
+    }
+}
+
+int16_t ToSample(float value) {
+    float scaled = value * 32767.0f;
+    if (scaled > 32767.0f) {
+        return 32767;
+    }
+    if (scaled < -32768.0f) {
+        return -32768;
+    }
+    return static_cast<int16_t>(scaled);
+}
+
+}
+
+const char* AudioCueFile(AudioCue cue) {
+    switch (cue) {
+        case CUE_ALARM:         return "alarm.wav";
+        case CUE_SESSION_START: return "cue_start.wav";
+        case CUE_ONE_MINUTE:    return "cue_minute.wav";
+        case CUE_BREAK_OVER:    return "cue_break_over.wav";
+        case CUE_TICK:          return "cue_tick.wav";
+        default:                return "";
+    }
+}
+
+bool DecodeWav(const char* data, size_t size, int targetRate, PcmClip& clip, std::string& error) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0) {
+        error = "bukan file WAV";
+        return false;
+    }
+
+    const unsigned char* format = nullptr;
+    const unsigned char* samples = nullptr;
+    size_t formatSize = 0;
+    size_t samplesSize = 0;
+    size_t position = 12;
+    while (position + 8 <= size) {
+        size_t chunkSize = ReadLe32(bytes + position + 4);
+        const unsigned char* body = bytes + position + 8;
+        size_t available = size - position - 8;
+        if (chunkSize > available) {
+            chunkSize = available;   // file terpotong: pakai yang ada
+        }
+        if (std::memcmp(bytes + position, "fmt ", 4) == 0) {
+            format = body;
+            formatSize = chunkSize;
+        } else if (std::memcmp(bytes + position, "data", 4) == 0) {
+            samples = body;
+            samplesSize = chunkSize;
+        }
+        position += 8 + chunkSize + (chunkSize & 1);
+    }
+    if (!format || formatSize < 16 || !samples) {
+        error = "chunk fmt/data tidak ditemukan";
+        return false;
+    }
+
+    uint32_t formatTag = ReadLe16(format);
+    int channels = static_cast<int>(ReadLe16(format + 2));
+    int sampleRate = static_cast<int>(ReadLe32(format + 4));
+    int blockAlign = static_cast<int>(ReadLe16(format + 12));
+    int bits = static_cast<int>(ReadLe16(format + 14));
+    if (formatTag == 0xFFFE && formatSize >= 26) {
+        formatTag = ReadLe16(format + 24);   // WAVE_FORMAT_EXTENSIBLE: subformat
+    }
+    bool isFloat = (formatTag == 3);
+    if ((formatTag != 1 && !isFloat) || (isFloat && bits != 32) ||
+        (bits != 8 && bits != 16 && bits != 24 && bits != 32)) {
+        error = "format WAV tidak didukung";
+        return false;
+    }
+    if (channels < 1 || sampleRate <= 0 || blockAlign < channels * bits / 8) {
+        error = "header WAV tidak valid";
+        return false;
+    }
+
+    size_t frames = samplesSize / static_cast<size_t>(blockAlign);
+    int bytesPerSample = bits / 8;
+    std::vector<float> source(frames * 2);
+    for (size_t f = 0; f < frames; ++f) {
+        const unsigned char* frame = samples + f * static_cast<size_t>(blockAlign);
+        float left = ReadSample(frame, bits, isFloat);
+        float right = channels > 1 ? ReadSample(frame + bytesPerSample, bits, isFloat) : left;
+        source[f * 2] = left;
+        source[f * 2 + 1] = right;
+    }
+
+    // Resample linear ke laju mesin; isyarat pendek tidak butuh filter
+    // yang lebih mahal
+    size_t outputFrames = (sampleRate == targetRate) ? frames :
+        static_cast<size_t>(static_cast<double>(frames) * targetRate / sampleRate);
+    clip.samples.resize(outputFrames * 2);
+    double step = static_cast<double>(sampleRate) / targetRate;
+    for (size_t f = 0; f < outputFrames; ++f) {
+        double sourcePosition = f * step;
+        size_t index = static_cast<size_t>(sourcePosition);
+        float fraction = static_cast<float>(sourcePosition - index);
+        size_t next = (index + 1 < frames) ? index + 1 : index;
+        for (int c = 0; c < 2; ++c) {
+            float a = source[index * 2 + c];
+            float b = source[next * 2 + c];
+            clip.samples[f * 2 + c] = ToSample(a + (b - a) * fraction);
+        }
+    }
+    return true;
+}
+
+AudioEngine::AudioEngine()
+    : startedCount(0), running(false), stopping(false), idle(false),
+      triggerLatency(20.0), triggers(0), dropped(0), periods(0), mixNs(0) {
+    for (int i = 0; i < CUE_COUNT; ++i) {
+        loaded[i] = false;
+    }
+    std::memset(voices, 0, sizeof(voices));
+}
+
+AudioEngine::~AudioEngine() {
+    Stop();
+}
+
+bool AudioEngine::LoadCue(AudioCue cue, const std::string& path, std::string& error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "tidak dapat membuka " + path;
+        return false;
+    }
+    std::vector<char> data;
+    char chunk[16384];
+    size_t count;
+    while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + count);
+    }
+    std::fclose(file);
+    return LoadCueFromMemory(cue, data.data(), data.size(), error);
+}
+
+bool AudioEngine::LoadCueFromMemory(AudioCue cue, const char* data, size_t size, std::string& error) {
+    if (IsRunning() || cue < 0 || cue >= CUE_COUNT) {
+        error = "isyarat tidak dapat dimuat sekarang";
+        return false;
+    }
+    PcmClip clip;
+    if (!DecodeWav(data, size, SAMPLE_RATE, clip, error)) {
+        return false;
+    }
+    clips[cue].samples.swap(clip.samples);
+    loaded[cue] = clips[cue].Frames() > 0;
+    return loaded[cue];
+}
+
+int AudioEngine::LoadCues() {
+    int count = 0;
+    for (int i = 0; i < CUE_COUNT; ++i) {
+        std::string error;
+        if (LoadCue(static_cast<AudioCue>(i), AudioCueFile(static_cast<AudioCue>(i)), error)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool AudioEngine::HasCue(AudioCue cue) const {
+    return cue >= 0 && cue < CUE_COUNT && loaded[cue];
+}
+
+bool AudioEngine::Start(std::unique_ptr<AudioSink> newSink) {
+    if (IsRunning() || !newSink) {
+        return false;
+    }
+    if (!newSink->Open(SAMPLE_RATE, CHANNELS)) {
+        return false;
+    }
+    sink = std::move(newSink);
+    stopping.store(false);
+    idle.store(false);
+    worker = std::thread(&AudioEngine::Run, this);
+    running.store(true, std::memory_order_release);
+    return true;
+}
+
+void AudioEngine::Stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        stopping.store(true);
+    }
+    idleWakeup.notify_one();
+    worker.join();
+    sink->Close();
+}
+
+const char* AudioEngine::SinkName() const {
+    return sink ? sink->Name() : "none";
+}
+
+bool AudioEngine::Play(AudioCue cue, float gain) {
+    return Send(COMMAND_PLAY, cue, gain);
+}
+
+bool AudioEngine::StartLoop(AudioCue cue, float gain) {
+    return Send(COMMAND_LOOP, cue, gain);
+}
+
+bool AudioEngine::StopLoop(AudioCue cue) {
+    return Send(COMMAND_STOP, cue, 0.0f);
+}
+
+bool AudioEngine::StopAll() {
+    return Send(COMMAND_STOP_ALL, CUE_ALARM, 0.0f);
+}
+
+bool AudioEngine::Send(uint8_t type, AudioCue cue, float gain) {
+    if (!IsRunning()) {
+        return false;
+    }
+    if ((type == COMMAND_PLAY || type == COMMAND_LOOP) && !HasCue(cue)) {
+        return false;
+    }
+    Command command;
+    command.type = type;
+    command.cue = static_cast<uint8_t>(cue);
+    command.gain = gain;
+    command.triggerNs = SteadyNowNs();
+    if (!commands.Push(command)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Pasangan fence dengan Run(): thread audio yang akan tidur pasti
+    // melihat perintah ini, atau kita pasti melihat ia sedang tidur
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idleWakeup.notify_one();
+    }
+    return true;
+}
+
+void AudioEngine::Run() {
+    while (!stopping.load()) {
+        Command command;
+        while (commands.Pop(command)) {
+            ApplyCommand(command);
+        }
+
+        if (!HasActiveVoice()) {
+            sink->Idle();
+            idle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(idleMutex);
+                idleWakeup.wait(lock, [this]() { return stopping.load() || !commands.Empty(); });
+            }
+            idle.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        int64_t mixStartNs = SteadyNowNs();
+        MixPeriod();
+        int64_t writeNs = SteadyNowNs();
+        mixNs.fetch_add(writeNs - mixStartNs, std::memory_order_relaxed);
+
+        RecordTriggerLatency(writeNs, sink->QueuedFrames());
+        sink->Write(outputBuffer, PERIOD_FRAMES);
+        periods.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioEngine::ApplyCommand(const Command& command) {
+    switch (command.type) {
+        case COMMAND_PLAY:
+        case COMMAND_LOOP: {
+            // Detak berulang yang sudah jalan tidak digandakan
+            if (command.type == COMMAND_LOOP) {
+                for (int i = 0; i < MAX_VOICES; ++i) {
+                    if (voices[i].active && voices[i].loop && voices[i].cue == command.cue) {
+                        voices[i].gain = command.gain;
+                        return;
+                    }
+                }
+            }
+            for (int i = 0; i < MAX_VOICES; ++i) {
+                if (!voices[i].active) {
+                    Voice& voice = voices[i];
+                    voice.clip = &clips[command.cue];
+                    voice.position = 0;
+                    voice.gain = command.gain;
+                    voice.active = true;
+                    voice.loop = (command.type == COMMAND_LOOP);
+                    voice.started = false;
+                    voice.cue = command.cue;
+                    voice.triggerNs = command.triggerNs;
+                    triggers.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        case COMMAND_STOP:
+            for (int i = 0; i < MAX_VOICES; ++i) {
+                if (voices[i].active && voices[i].loop && voices[i].cue == command.cue) {
+                    voices[i].active = false;
+                }
+            }
+            break;
+        case COMMAND_STOP_ALL:
+            for (int i = 0; i < MAX_VOICES; ++i) {
+                voices[i].active = false;
+            }
+            break;
+    }
+}
+
+bool AudioEngine::HasActiveVoice() const {
+    for (int i = 0; i < MAX_VOICES; ++i) {
+        if (voices[i].active) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioEngine::MixPeriod() {
+    const int samplesPerPeriod = PERIOD_FRAMES * CHANNELS;
+    std::memset(mixBuffer, 0, sizeof(mixBuffer));
+    startedCount = 0;
+
+    for (int v = 0; v < MAX_VOICES; ++v) {
+        Voice& voice = voices[v];
+        if (!voice.active) {
+            continue;
+        }
+        if (!voice.started) {
+            voice.started = true;
+            startedTriggerNs[startedCount++] = voice.triggerNs;
+        }
+
+        const int16_t* source = voice.clip->samples.data();
+        size_t clipFrames = voice.clip->Frames();
+        float gain = voice.gain / 32768.0f;
+        int written = 0;
+        while (written < PERIOD_FRAMES) {
+            size_t count = clipFrames - voice.position;
+            if (count > static_cast<size_t>(PERIOD_FRAMES - written)) {
+                count = static_cast<size_t>(PERIOD_FRAMES - written);
+            }
+            const int16_t* in = source + voice.position * CHANNELS;
+            float* out = mixBuffer + written * CHANNELS;
+            for (size_t i = 0; i < count * CHANNELS; ++i) {
+                out[i] += in[i] * gain;
+            }
+            written += static_cast<int>(count);
+            voice.position += count;
+            if (voice.position >= clipFrames) {
+                if (!voice.loop) {
+                    voice.active = false;
+                    break;
+                }
+                voice.position = 0;
+            }
+        }
+    }
+
+    for (int i = 0; i < samplesPerPeriod; ++i) {
+        outputBuffer[i] = ToSample(mixBuffer[i]);
+    }
+}
+
+// Sampel pertama terdengar setelah isi buffer perangkat habis diputar
+void AudioEngine::RecordTriggerLatency(int64_t writeNs, int queuedFrames) {
+    if (startedCount == 0) {
+        return;
+    }
+    double queuedMs = queuedFrames * 1000.0 / SAMPLE_RATE;
+    std::lock_guard<std::mutex> lock(statsMutex);
+    for (int i = 0; i < startedCount; ++i) {
+        triggerLatency.Record((writeNs - startedTriggerNs[i]) / 1e6 + queuedMs);
+    }
+}
+
+AudioStats AudioEngine::GetStats() const {
+    AudioStats stats;
+    stats.triggers = triggers.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    stats.periods = periods.load(std::memory_order_relaxed);
+    stats.audioSeconds = static_cast<double>(stats.periods) * PERIOD_FRAMES / SAMPLE_RATE;
+    if (stats.audioSeconds > 0.0) {
+        stats.mixMsPerSecond = mixNs.load(std::memory_order_relaxed) / 1e6 / stats.audioSeconds;
+    }
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.triggerLatency = triggerLatency;
+    return stats;
+}
+
+std::string AudioEngine::Report() const {
+    AudioStats stats = GetStats();
+    char buffer[192];
+    std::snprintf(buffer, sizeof(buffer),
+                  "sink=%s triggers=%lld dropped=%lld audio_s=%.1f mix_ms_per_s=%.3f latency ",
+                  SinkName(), stats.triggers, stats.dropped, stats.audioSeconds, stats.mixMsPerSecond);
+    return buffer + stats.triggerLatency.Report();
+}
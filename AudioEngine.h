@@ -0,0 +1,149 @@
+// AudioEngine.h
+#ifndef AUDIO_ENGINE_H
+#define AUDIO_ENGINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioSink.h"
+#include "LatencyRecorder.h"
+#include "SpscRing.h"
+
+// Isyarat suara aplikasi. File yang tidak ada membuat isyarat itu diam.
+enum AudioCue {
+    CUE_ALARM,           // sesi fokus selesai
+    CUE_SESSION_START,   // sesi fokus/istirahat dimulai
+    CUE_ONE_MINUTE,      // satu menit tersisa
+    CUE_BREAK_OVER,      // istirahat selesai (jika tidak ada, pakai alarm)
+    CUE_TICK,            // detak; diputar berulang selama sesi berjalan
+    CUE_COUNT
+};
+
+// Nama file WAV untuk setiap isyarat, relatif terhadap direktori kerja
+const char* AudioCueFile(AudioCue cue);
+
+// PCM 16-bit stereo interleaved pada AudioEngine::SAMPLE_RATE
+struct PcmClip {
+    std::vector<int16_t> samples;
+
+    size_t Frames() const { return samples.size() / 2; }
+};
+
+// Mendekode WAV (PCM 8/16/24/32-bit atau float 32-bit, mono/stereo) dan
+// mengubahnya ke stereo 16-bit pada targetRate
+bool DecodeWav(const char* data, size_t size, int targetRate, PcmClip& clip, std::string& error);
+
+struct AudioStats {
+    long long triggers;        // perintah Play/StartLoop yang diterima thread audio
+    long long dropped;         // perintah yang hilang karena antrian atau voice penuh
+    long long periods;         // periode yang dicampur dan ditulis
+    double audioSeconds;       // durasi audio yang sudah ditulis
+    double mixMsPerSecond;     // waktu CPU pencampuran per detik audio
+    LatencyRecorder triggerLatency;   // pemicu -> sampel pertama terdengar (ms)
+
+    AudioStats()
+        : triggers(0), dropped(0), periods(0), audioSeconds(0.0), mixMsPerSecond(0.0) {}
+};
+
+// Mesin audio dengan cache PCM yang didekode sekali saat startup. Thread
+// audio mencampur semua suara aktif (boleh tumpang tindih) per periode
+// pendek dan menulisnya ke AudioSink. Perintah dikirim lewat antrian
+// lock-free, sehingga pemanggil (thread GUI) tidak pernah menunggu audio.
+// Saat tidak ada suara, thread audio tidur sampai ada perintah.
+class AudioEngine {
+public:
+    static const int SAMPLE_RATE = 48000;
+    static const int CHANNELS = 2;
+    static const int PERIOD_FRAMES = 256;   // 5,3 ms
+    static const int MAX_VOICES = 16;
+
+    AudioEngine();
+    ~AudioEngine();
+
+    // Hanya sebelum Start(); boleh dari thread mana pun
+    bool LoadCue(AudioCue cue, const std::string& path, std::string& error);
+    bool LoadCueFromMemory(AudioCue cue, const char* data, size_t size, std::string& error);
+    // Memuat semua isyarat dari AudioCueFile(); jumlah isyarat yang termuat
+    int LoadCues();
+    bool HasCue(AudioCue cue) const;
+
+    // Membuka sink dan menjalankan thread audio
+    bool Start(std::unique_ptr<AudioSink> newSink);
+    void Stop();
+    bool IsRunning() const { return running.load(std::memory_order_acquire); }
+    const char* SinkName() const;
+
+    // Dari satu thread produsen saja (thread GUI atau loop utama).
+    // Tidak menunggu; false jika mesin tidak jalan atau antrian penuh.
+    bool Play(AudioCue cue, float gain = 1.0f);
+    bool StartLoop(AudioCue cue, float gain = 1.0f);
+    bool StopLoop(AudioCue cue);
+    bool StopAll();
+
+    AudioStats GetStats() const;
+    std::string Report() const;
+
+private:
+    enum CommandType { COMMAND_PLAY, COMMAND_LOOP, COMMAND_STOP, COMMAND_STOP_ALL };
+
+    struct Command {
+        uint8_t type;
+        uint8_t cue;
+        float gain;
+        int64_t triggerNs;
+    };
+
+    struct Voice {
+        const PcmClip* clip;
+        size_t position;       // frame berikutnya
+        float gain;
+        bool active;
+        bool loop;
+        bool started;          // sampel pertama sudah ditulis
+        uint8_t cue;
+        int64_t triggerNs;
+    };
+
+    PcmClip clips[CUE_COUNT];
+    bool loaded[CUE_COUNT];
+
+    SpscRing<Command, 256> commands;
+    Voice voices[MAX_VOICES];
+    float mixBuffer[PERIOD_FRAMES * CHANNELS];
+    int16_t outputBuffer[PERIOD_FRAMES * CHANNELS];
+    // Waktu pemicu suara yang sampel pertamanya ada di periode ini
+    int64_t startedTriggerNs[MAX_VOICES];
+    int startedCount;
+
+    std::unique_ptr<AudioSink> sink;
+    std::thread worker;
+    std::atomic<bool> running;
+    std::atomic<bool> stopping;
+
+    // Tidur saat diam: produsen hanya mengambil mutex jika thread audio tidur
+    std::mutex idleMutex;
+    std::condition_variable idleWakeup;
+    std::atomic<bool> idle;
+
+    // Statistik; latensi ditulis thread audio sekali per pemicu
+    mutable std::mutex statsMutex;
+    LatencyRecorder triggerLatency;
+    std::atomic<long long> triggers;
+    std::atomic<long long> dropped;
+    std::atomic<long long> periods;
+    std::atomic<long long> mixNs;
+
+    bool Send(uint8_t type, AudioCue cue, float gain);
+    void Run();
+    void ApplyCommand(const Command& command);
+    bool HasActiveVoice() const;
+    void MixPeriod();
+    void RecordTriggerLatency(int64_t writeNs, int queuedFrames);
+};
+
+#endif // AUDIO_ENGINE_H
@@ -0,0 +1,250 @@
+// AudioSink.cpp
+#include "AudioSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifdef POMODORO_HAVE_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+namespace {
+
+int64_t SteadyNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void PutLe16(unsigned char* p, uint32_t value) {
+    p[0] = static_cast<unsigned char>(value);
+    p[1] = static_cast<unsigned char>(value >> 8);
+}
+
+void PutLe32(unsigned char* p, uint32_t value) {
+    PutLe16(p, value & 0xFFFF);
+    PutLe16(p + 2, value >> 16);
+}
+
+}
+
+NullAudioSink::NullAudioSink(bool realtime)
+    : realtime(realtime), sampleRate(48000), streamStartNs(-1),
+      streamFrames(0), framesWritten(0) {
+}
+
+bool NullAudioSink::Open(int rate, int /*channels*/) {
+    sampleRate = rate;
+    streamStartNs = -1;
+    streamFrames = 0;
+    return true;
+}
+
+// Jadwal periode dihitung dari awal stream, bukan dari Write sebelumnya,
+// sehingga keterlambatan bangun tidak terakumulasi
+bool NullAudioSink::Write(const int16_t* /*samples*/, size_t frames) {
+    framesWritten += static_cast<long long>(frames);
+    if (!realtime) {
+        return true;
+    }
+    if (streamStartNs < 0) {
+        streamStartNs = SteadyNowNs();
+    }
+    streamFrames += static_cast<long long>(frames);
+    // Seperti perangkat dengan buffer satu periode: Write kembali saat
+    // periode sebelumnya selesai diputar
+    int64_t playedUntilNs = streamStartNs +
+        (streamFrames - static_cast<long long>(frames)) * 1000000000LL / sampleRate;
+    int64_t waitNs = playedUntilNs - SteadyNowNs();
+    if (waitNs > 0) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(waitNs));
+    }
+    return true;
+}
+
+void NullAudioSink::Idle() {
+    streamStartNs = -1;
+    streamFrames = 0;
+}
+
+WavFileAudioSink::WavFileAudioSink(const std::string& path, bool realtime)
+    : path(path), file(nullptr), sampleRate(48000), channels(2), dataBytes(0), pacer(realtime) {
+}
+
+WavFileAudioSink::~WavFileAudioSink() {
+    Close();
+}
+
+bool WavFileAudioSink::Open(int rate, int channelCount) {
+    Close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    sampleRate = rate;
+    channels = channelCount;
+    dataBytes = 0;
+    pacer.Open(rate, channelCount);
+
+    // Ukuran diisi ulang saat Idle() dan Close()
+    WriteHeader();
+    return true;
+}
+
+bool WavFileAudioSink::Write(const int16_t* samples, size_t frames) {
+    if (!file) {
+        return false;
+    }
+    size_t count = frames * static_cast<size_t>(channels);
+    unsigned char buffer[4096];
+    size_t done = 0;
+    while (done < count) {
+        size_t chunk = std::min(count - done, sizeof(buffer) / 2);
+        for (size_t i = 0; i < chunk; ++i) {
+            PutLe16(buffer + i * 2, static_cast<uint16_t>(samples[done + i]));
+        }
+        if (std::fwrite(buffer, 2, chunk, file) != chunk) {
+            return false;
+        }
+        done += chunk;
+    }
+    dataBytes += static_cast<long long>(count) * 2;
+    return pacer.Write(samples, frames);
+}
+
+void WavFileAudioSink::Idle() {
+    if (file) {
+        WriteHeader();
+        std::fflush(file);
+    }
+    pacer.Idle();
+}
+
+void WavFileAudioSink::Close() {
+    if (!file) {
+        return;
+    }
+    WriteHeader();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void WavFileAudioSink::WriteHeader() {
+    unsigned char header[44];
+    uint32_t byteRate = static_cast<uint32_t>(sampleRate * channels * 2);
+    std::memcpy(header, "RIFF", 4);
+    PutLe32(header + 4, static_cast<uint32_t>(36 + dataBytes));
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    PutLe32(header + 16, 16);
+    PutLe16(header + 20, 1);                       // PCM
+    PutLe16(header + 22, static_cast<uint32_t>(channels));
+    PutLe32(header + 24, static_cast<uint32_t>(sampleRate));
+    PutLe32(header + 28, byteRate);
+    PutLe16(header + 32, static_cast<uint32_t>(channels * 2));
+    PutLe16(header + 34, 16);
+    std::memcpy(header + 36, "data", 4);
+    PutLe32(header + 40, static_cast<uint32_t>(dataBytes));
+
+    long position = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    std::fwrite(header, 1, sizeof(header), file);
+    if (position > 0) {
+        std::fseek(file, position, SEEK_SET);
+    }
+}
+
+#ifdef POMODORO_HAVE_ALSA
+
+namespace {
+
+// Perangkat "default" ALSA dengan buffer kecil (~20 ms) agar isyarat
+// terdengar segera setelah dipicu
+class AlsaAudioSink : public AudioSink {
+public:
+    AlsaAudioSink() : pcm(nullptr), channels(2), prepared(false) {}
+    ~AlsaAudioSink() { Close(); }
+
+    bool Open(int sampleRate, int channelCount) override {
+        channels = channelCount;
+        if (snd_pcm_open(&pcm, "default", SND_PCM_STREAM_PLAYBACK, 0) < 0) {
+            pcm = nullptr;
+            return false;
+        }
+        if (snd_pcm_set_params(pcm, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED,
+                               static_cast<unsigned int>(channels),
+                               static_cast<unsigned int>(sampleRate), 1, 20000) < 0) {
+            Close();
+            return false;
+        }
+        prepared = true;
+        return true;
+    }
+
+    bool Write(const int16_t* samples, size_t frames) override {
+        if (!pcm) {
+            return false;
+        }
+        if (!prepared) {
+            snd_pcm_prepare(pcm);
+            prepared = true;
+        }
+        while (frames > 0) {
+            snd_pcm_sframes_t written = snd_pcm_writei(pcm, samples, frames);
+            if (written < 0) {
+                // Underrun atau suspend: pulihkan lalu coba lagi
+                if (snd_pcm_recover(pcm, static_cast<int>(written), 1) < 0) {
+                    return false;
+                }
+                continue;
+            }
+            frames -= static_cast<size_t>(written);
+            samples += written * channels;
+        }
+        return true;
+    }
+
+    int QueuedFrames() const override {
+        snd_pcm_sframes_t delay = 0;
+        if (!pcm || snd_pcm_delay(pcm, &delay) < 0) {
+            return 0;
+        }
+        return static_cast<int>(delay);
+    }
+
+    // Biarkan sisa buffer selesai diputar lalu hentikan perangkat
+    void Idle() override {
+        if (pcm && prepared) {
+            snd_pcm_drain(pcm);
+            prepared = false;
+        }
+    }
+
+    void Close() override {
+        if (pcm) {
+            snd_pcm_close(pcm);
+            pcm = nullptr;
+        }
+    }
+
+    const char* Name() const override { return "alsa"; }
+
+private:
+    snd_pcm_t* pcm;
+    int channels;
+    bool prepared;
+};
+
+}
+
+std::unique_ptr<AudioSink> CreateDeviceAudioSink() {
+    return std::unique_ptr<AudioSink>(new AlsaAudioSink());
+}
+
+#else
+
+std::unique_ptr<AudioSink> CreateDeviceAudioSink() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,77 @@
+// AudioSink.h
+#ifndef AUDIO_SINK_H
+#define AUDIO_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+// Tujuan keluaran AudioEngine: PCM 16-bit interleaved. Semua metode
+// dipanggil dari thread audio saja.
+class AudioSink {
+public:
+    virtual ~AudioSink() {}
+
+    virtual bool Open(int sampleRate, int channels) = 0;
+    // Boleh menunggu sampai perangkat siap menerima periode berikutnya
+    virtual bool Write(const int16_t* samples, size_t frames) = 0;
+    // Frame yang sudah ditulis tetapi belum terdengar
+    virtual int QueuedFrames() const { return 0; }
+    // Tidak ada suara yang aktif; perangkat boleh dihentikan sampai Write berikutnya
+    virtual void Idle() {}
+    virtual void Close() {}
+    virtual const char* Name() const = 0;
+};
+
+// Membuang sampel. Dengan realtime=true Write() menunggu sampai waktu
+// periode itu tiba, sehingga thread audio berjalan dengan kecepatan
+// perangkat sungguhan (untuk headless dan benchmark latensi).
+class NullAudioSink : public AudioSink {
+public:
+    explicit NullAudioSink(bool realtime = true);
+
+    bool Open(int sampleRate, int channels) override;
+    bool Write(const int16_t* samples, size_t frames) override;
+    void Idle() override;
+    const char* Name() const override { return "null"; }
+
+    long long GetFramesWritten() const { return framesWritten; }
+
+private:
+    bool realtime;
+    int sampleRate;
+    int64_t streamStartNs;    // -1 = belum ada periode yang ditulis
+    long long streamFrames;
+    long long framesWritten;
+};
+
+// Menulis campuran ke file WAV (untuk menguji isyarat tanpa perangkat audio)
+class WavFileAudioSink : public AudioSink {
+public:
+    explicit WavFileAudioSink(const std::string& path, bool realtime = true);
+    ~WavFileAudioSink();
+
+    bool Open(int sampleRate, int channels) override;
+    bool Write(const int16_t* samples, size_t frames) override;
+    void Idle() override;
+    void Close() override;
+    const char* Name() const override { return "wav"; }
+
+private:
+    std::string path;
+    FILE* file;
+    int sampleRate;
+    int channels;
+    long long dataBytes;
+    NullAudioSink pacer;
+
+    void WriteHeader();
+};
+
+// Perangkat audio bawaan sistem (ALSA jika dibangun dengan
+// POMODORO_HAVE_ALSA), atau nullptr jika tidak tersedia
+std::unique_ptr<AudioSink> CreateDeviceAudioSink();
+
+#endif // AUDIO_SINK_H
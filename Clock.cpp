@@ -0,0 +1,31 @@
+// Clock.cpp
+#include "Clock.h"
+
+#include <chrono>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <time.h>
+#endif
+
+int64_t MonotonicNowMs() {
+#if defined(_WIN32)
+    // GetTickCount64 tetap berjalan selama sleep/hibernate
+    return static_cast<int64_t>(GetTickCount64());
+#elif defined(__linux__)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_BOOTTIME, &ts) != 0) {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+    }
+    return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+#else
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+int64_t WallClockNowMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
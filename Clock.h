@@ -0,0 +1,47 @@
+// Clock.h
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <cstdint>
+
+// Waktu monoton dalam milidetik. Di Linux memakai CLOCK_BOOTTIME sehingga
+// waktu selama suspend ikut terhitung; tidak terpengaruh perubahan jam sistem.
+int64_t MonotonicNowMs();
+
+// Jam dinding dalam milidetik sejak epoch, untuk mencatat kapan sesi terjadi
+int64_t WallClockNowMs();
+
+// Sumber waktu yang bisa diganti, agar logika sesi bisa dijalankan tanpa
+// event loop dan tanpa menunggu detik sungguhan
+class Clock {
+public:
+    virtual ~Clock() {}
+    virtual int64_t NowMs() const = 0;
+    virtual int64_t WallNowMs() const = 0;
+};
+
+// Jam sistem (monoton)
+class SystemClock : public Clock {
+public:
+    int64_t NowMs() const override { return MonotonicNowMs(); }
+    int64_t WallNowMs() const override { return WallClockNowMs(); }
+};
+
+// Jam virtual untuk simulasi dan benchmark; hanya maju jika digerakkan.
+// Jam dinding virtual = wallBaseMs + waktu monoton virtual.
+class VirtualClock : public Clock {
+public:
+    explicit VirtualClock(int64_t startMs = 0, int64_t wallBaseMs = 0)
+        : nowMs(startMs), wallBaseMs(wallBaseMs) {}
+
+    int64_t NowMs() const override { return nowMs; }
+    int64_t WallNowMs() const override { return wallBaseMs + nowMs; }
+    void Set(int64_t ms) { nowMs = ms; }
+    void Advance(int64_t ms) { nowMs += ms; }
+
+private:
+    int64_t nowMs;
+    int64_t wallBaseMs;
+};
+
+#endif // CLOCK_H
@@ -0,0 +1,761 @@
+// ControlServer.cpp
+#include "ControlServer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Baris perintah yang lebih panjang dari ini dianggap klien rusak
+const size_t MAX_LINE_LENGTH = 1024;
+const int MAX_EVENTS = 64;
+const size_t MAX_TIMER_NAME = 32;
+
+// Field status tanpa kurung kurawal, dipakai baris status dan "list"
+void FormatStatusFields(const ControlStatus& status, char* buffer, size_t size) {
+    std::snprintf(buffer, size,
+                  "\"state\":\"%s\",\"transition\":%s,\"remaining_ms\":%lld,"
+                  "\"transition_ms\":%lld,\"at_ms\":%lld,\"completed\":%d,"
+                  "\"focus_min\":%d,\"break_min\":%d",
+                  ControlStateName(status.state), status.inTransition ? "true" : "false",
+                  static_cast<long long>(status.remainingMs),
+                  static_cast<long long>(status.transitionMs),
+                  static_cast<long long>(status.atMs),
+                  status.completedSessions, status.focusMinutes, status.breakMinutes);
+}
+
+// Durasi "add" dalam menit; kosong berarti tetap default
+bool ParseTimerMinutes(const std::string& text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || parsed < 1 || parsed > 24 * 60) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+}
+
+std::string DefaultControlSocketPath() {
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    if (runtimeDir && runtimeDir[0] != '\0') {
+        return std::string(runtimeDir) + "/pomodoro.sock";
+    }
+#ifdef __linux__
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "/tmp/pomodoro-%u.sock",
+                  static_cast<unsigned>(getuid()));
+    return buffer;
+#else
+    return "pomodoro.sock";
+#endif
+}
+
+const char* ControlStateName(TimerState state) {
+    switch (state) {
+        case READY:
+            return "ready";
+        case RUNNING_FOCUS:
+            return "focus";
+        case RUNNING_BREAK:
+            return "break";
+        case PAUSED_FOCUS:
+            return "paused_focus";
+        case PAUSED_BREAK:
+            return "paused_break";
+    }
+    return "unknown";
+}
+
+const char* ControlCommandName(ControlCommand command) {
+    switch (command) {
+        case CONTROL_START:
+            return "start";
+        case CONTROL_PAUSE:
+            return "pause";
+        case CONTROL_RESET:
+            return "reset";
+        case CONTROL_TRACE:
+            return "trace";
+        case CONTROL_ADD:
+            return "add";
+    }
+    return "unknown";
+}
+
+bool IsValidTimerName(const std::string& name) {
+    if (name.empty() || name.size() > MAX_TIMER_NAME) {
+        return false;
+    }
+    for (unsigned char c : name) {
+        bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                       (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+        if (!allowed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ControlStatus CaptureControlStatus(const TimerCore& core) {
+    ControlStatus status;
+    int64_t now = core.GetClock().NowMs();
+    status.state = core.GetState();
+    status.inTransition = core.InTransition();
+    status.remainingMs = core.RemainingMs();
+    status.transitionMs = core.InTransition() ? core.NextDeadlineMs() - now : 0;
+    status.atMs = now;
+    status.completedSessions = core.GetCompletedSessions();
+    status.focusMinutes = core.GetFocusDuration();
+    status.breakMinutes = core.GetBreakDuration();
+    return status;
+}
+
+bool ApplyTimerCommand(TimerRegistry& registry, const ControlTimerCommand& command) {
+    if (command.command == CONTROL_ADD) {
+        TimerRegistry::Handle handle = registry.Add(command.name);
+        if (handle == TimerRegistry::INVALID_HANDLE) {
+            return false;
+        }
+        registry.Core(handle).SetDurations(command.focusMinutes, command.breakMinutes);
+        return true;
+    }
+    TimerRegistry::Handle handle = registry.Find(command.name);
+    if (!registry.IsValid(handle)) {
+        return false;
+    }
+    switch (command.command) {
+        case CONTROL_START:
+            registry.Start(handle);
+            break;
+        case CONTROL_PAUSE:
+            registry.Pause(handle);
+            break;
+        case CONTROL_RESET:
+            registry.Reset(handle);
+            break;
+        case CONTROL_TRACE:
+        case CONTROL_ADD:
+            return false;
+    }
+    return true;
+}
+
+bool SendControlCommand(const std::string& path, ControlCommand command, int timeoutMs) {
+#ifdef __linux__
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    std::string line = std::string(ControlCommandName(command)) + "\n";
+    bool ok = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+              send(fd, line.data(), line.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(line.size());
+
+    // Balasan "ok" berarti perintah sudah diteruskan ke thread pemilik
+    char reply[256];
+    size_t received = 0;
+    while (ok && received < sizeof(reply)) {
+        pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, timeoutMs) <= 0) {
+            ok = false;
+            break;
+        }
+        ssize_t count = read(fd, reply + received, sizeof(reply) - received);
+        if (count <= 0) {
+            ok = false;
+            break;
+        }
+        received += static_cast<size_t>(count);
+        if (std::memchr(reply, '\n', received)) {
+            break;
+        }
+    }
+    close(fd);
+    return ok && received > 0 && std::strstr(std::string(reply, received).c_str(), "\"ok\"") != nullptr;
+#else
+    return false;
+#endif
+}
+
+std::string FormatControlStatus(const ControlStatus& status, const char* event,
+                                unsigned long long seq, const char* timer) {
+    char fields[256];
+    FormatStatusFields(status, fields, sizeof(fields));
+    char buffer[384];
+    if (timer) {
+        std::snprintf(buffer, sizeof(buffer), "{\"event\":\"%s\",\"seq\":%llu,\"timer\":\"%s\",%s}\n",
+                      event, seq, timer, fields);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "{\"event\":\"%s\",\"seq\":%llu,%s}\n",
+                      event, seq, fields);
+    }
+    return buffer;
+}
+
+ControlServer::ControlServer()
+    : listener(nullptr), running(false), listenFd(-1), epollFd(-1), wakeFd(-1),
+      stopping(false), clientCount(0), subscriberCount(0),
+      publishedSeq(0), broadcastSeq(0) {
+}
+
+ControlServer::~ControlServer() {
+    Stop();
+}
+
+void ControlServer::SetListener(ControlServerListener* newListener) {
+    listener = newListener;
+}
+
+void ControlServer::Publish(const ControlStatus& status) {
+    std::lock_guard<std::mutex> lock(mutex);
+    latest = status;
+    publishedSeq++;
+#ifdef __linux__
+    // Masih di bawah mutex: Stop() menutup wakeFd di bawah mutex yang sama,
+    // jadi fd yang ditulis tidak mungkin sudah ditutup atau dipakai ulang
+    if (running) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written;
+    }
+#endif
+}
+
+void ControlServer::PublishTimers(const TimerRegistry& registry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::map<std::string, ControlStatus>::iterator it = timers.begin(); it != timers.end(); ++it) {
+        // Timer yang baru dibuat klien mungkin belum sampai ke registry
+        TimerRegistry::Handle handle = registry.Find(it->first);
+        if (registry.IsValid(handle)) {
+            it->second = CaptureControlStatus(registry.Core(handle));
+        }
+    }
+}
+
+ControlStatus ControlServer::Snapshot(unsigned long long& seq) {
+    std::lock_guard<std::mutex> lock(mutex);
+    seq = publishedSeq;
+    return latest;
+}
+
+#ifdef __linux__
+
+bool ControlServer::Start(const std::string& socketPath) {
+    if (running) {
+        return true;
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    // Socket lama yang masih dilayani berarti instance lain sedang berjalan;
+    // yang tidak dilayani adalah sisa crash dan boleh dihapus
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe >= 0) {
+        bool alive = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        close(probe);
+        if (alive) {
+            return false;
+        }
+    }
+    unlink(socketPath.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    bool ok = listenFd >= 0 && epollFd >= 0 && wakeFd >= 0 &&
+              bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    if (ok) {
+        chmod(socketPath.c_str(), S_IRUSR | S_IWUSR);
+        ok = listen(listenFd, SOMAXCONN) == 0;
+    }
+    if (ok) {
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        ok = epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+        event.data.fd = wakeFd;
+        ok = ok && epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0;
+    }
+
+    if (!ok) {
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(socketPath.c_str());
+        }
+        if (epollFd >= 0) {
+            close(epollFd);
+        }
+        if (wakeFd >= 0) {
+            close(wakeFd);
+        }
+        listenFd = epollFd = wakeFd = -1;
+        return false;
+    }
+
+    path = socketPath;
+    stopping = false;
+    running = true;
+    worker = std::thread(&ControlServer::Run, this);
+    return true;
+}
+
+void ControlServer::Stop() {
+    if (!running) {
+        return;
+    }
+    stopping = true;
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+    worker.join();
+
+    for (std::unordered_map<int, Client>::iterator it = clients.begin(); it != clients.end(); ++it) {
+        close(it->first);
+    }
+    clients.clear();
+    clientCount = 0;
+    subscriberCount = 0;
+
+    close(listenFd);
+    close(epollFd);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+        close(wakeFd);
+        listenFd = epollFd = wakeFd = -1;
+    }
+    unlink(path.c_str());
+}
+
+void ControlServer::Run() {
+    epoll_event events[MAX_EVENTS];
+
+    while (!stopping) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                AcceptClients();
+            } else if (fd == wakeFd) {
+                uint64_t value;
+                while (read(wakeFd, &value, sizeof(value)) > 0) {
+                }
+                if (!stopping) {
+                    Broadcast();
+                }
+            } else {
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                    ReadClient(fd);
+                }
+                if ((events[i].events & EPOLLOUT) && clients.count(fd) > 0) {
+                    WriteClient(fd);
+                }
+            }
+        }
+    }
+}
+
+void ControlServer::AcceptClients() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // EAGAIN: antrian accept sudah kosong. EMFILE dan sejenisnya:
+            // coba lagi pada event berikutnya
+            return;
+        }
+
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+
+        Client& client = clients[fd];
+        client.outputOffset = 0;
+        client.subscribed = false;
+        client.wantWrite = false;
+        clientCount = clients.size();
+    }
+}
+
+void ControlServer::ReadClient(int fd) {
+    std::unordered_map<int, Client>::iterator it = clients.find(fd);
+    if (it == clients.end()) {
+        return;
+    }
+    Client& client = it->second;
+
+    char buffer[4096];
+    bool closed = false;
+    while (true) {
+        ssize_t received = read(fd, buffer, sizeof(buffer));
+        if (received > 0) {
+            client.input.append(buffer, static_cast<size_t>(received));
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        // EOF atau error; perintah yang sudah terbaca tetap dijalankan
+        closed = true;
+        break;
+    }
+
+    size_t start = 0;
+    size_t newline;
+    while ((newline = client.input.find('\n', start)) != std::string::npos) {
+        std::string line = client.input.substr(start, newline - start);
+        start = newline + 1;
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        HandleLine(fd, client, line);
+        if (clients.count(fd) == 0) {
+            return;
+        }
+    }
+    client.input.erase(0, start);
+
+    if (closed || client.input.size() > MAX_LINE_LENGTH) {
+        CloseClient(fd);
+    }
+}
+
+void ControlServer::HandleLine(int fd, Client& client, const std::string& fullLine) {
+    if (fullLine.empty()) {
+        return;
+    }
+
+    // "perintah [argumen]"; perintah untuk timer bernama dilayani terpisah
+    std::string verb = fullLine;
+    std::string argument;
+    size_t space = fullLine.find(' ');
+    if (space != std::string::npos) {
+        verb = fullLine.substr(0, space);
+        argument = fullLine.substr(space + 1);
+    }
+    bool timerVerb = verb == "start" || verb == "pause" || verb == "reset" || verb == "status";
+    if (verb == "add" || verb == "list" || (timerVerb && argument != DEFAULT_TIMER_NAME &&
+                                            space != std::string::npos)) {
+        HandleTimerLine(fd, client, verb, argument);
+        return;
+    }
+    // "start default" sama dengan "start"
+    const std::string& line = timerVerb ? verb : fullLine;
+
+    if (line == "start" || line == "pause" || line == "reset" || line == "trace") {
+        ControlCommand command = line == "start" ? CONTROL_START :
+                                 line == "pause" ? CONTROL_PAUSE :
+                                 line == "reset" ? CONTROL_RESET : CONTROL_TRACE;
+        if (listener) {
+            listener->OnControlCommand(command);
+        }
+        Queue(fd, client, "{\"event\":\"ok\",\"command\":\"" + line + "\"}\n");
+    } else if (line == "status") {
+        unsigned long long seq;
+        ControlStatus status = Snapshot(seq);
+        Queue(fd, client, FormatControlStatus(status, "status", seq));
+    } else if (line == "subscribe") {
+        if (!client.subscribed) {
+            client.subscribed = true;
+            subscriberCount++;
+        }
+        unsigned long long seq;
+        ControlStatus status = Snapshot(seq);
+        if (Queue(fd, client, "{\"event\":\"ok\",\"command\":\"subscribe\"}\n")) {
+            Queue(fd, client, FormatControlStatus(status, "update", seq));
+        }
+    } else if (line == "unsubscribe") {
+        if (client.subscribed) {
+            client.subscribed = false;
+            subscriberCount--;
+        }
+        Queue(fd, client, "{\"event\":\"ok\",\"command\":\"unsubscribe\"}\n");
+    } else {
+        Queue(fd, client, "{\"event\":\"error\",\"message\":\"unknown command\"}\n");
+    }
+}
+
+// "add NAMA [fokus [istirahat]]", "list", dan start/pause/reset/status NAMA.
+// Nama dicatat di sini saat "add", jadi perintah berikutnya untuk nama itu
+// langsung diterima walaupun pemilik belum sempat membuat timernya.
+void ControlServer::HandleTimerLine(int fd, Client& client, const std::string& verb,
+                                    const std::string& argument) {
+    if (verb == "list") {
+        if (!argument.empty()) {
+            Queue(fd, client, "{\"event\":\"error\",\"message\":\"unknown command\"}\n");
+            return;
+        }
+        Queue(fd, client, FormatTimerList());
+        return;
+    }
+
+    std::string name = argument;
+    std::string durations;
+    size_t space = argument.find(' ');
+    if (space != std::string::npos) {
+        name = argument.substr(0, space);
+        durations = argument.substr(space + 1);
+    }
+    if (!IsValidTimerName(name)) {
+        Queue(fd, client, "{\"event\":\"error\",\"message\":\"invalid timer name\"}\n");
+        return;
+    }
+
+    ControlTimerCommand command;
+    command.name = name;
+    const char* error = nullptr;
+    std::string reply;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<std::string, ControlStatus>::iterator it = timers.find(name);
+        if (verb == "add") {
+            command.command = CONTROL_ADD;
+            command.focusMinutes = latest.focusMinutes;
+            command.breakMinutes = latest.breakMinutes;
+            std::string breakText;
+            size_t split = durations.find(' ');
+            if (split != std::string::npos) {
+                breakText = durations.substr(split + 1);
+                durations.erase(split);
+            }
+            if ((!durations.empty() && !ParseTimerMinutes(durations, command.focusMinutes)) ||
+                (!breakText.empty() && !ParseTimerMinutes(breakText, command.breakMinutes))) {
+                error = "invalid duration";
+            } else if (it != timers.end() || name == DEFAULT_TIMER_NAME) {
+                error = "timer exists";
+            } else if (timers.size() >= MAX_NAMED_TIMERS) {
+                error = "too many timers";
+            } else {
+                // Sampai pemilik menerbitkan snapshot-nya: timer siap fokus
+                ControlStatus& status = timers[name];
+                status.remainingMs = command.focusMinutes * 60 * 1000LL;
+                status.atMs = MonotonicNowMs();
+                status.focusMinutes = command.focusMinutes;
+                status.breakMinutes = command.breakMinutes;
+            }
+        } else if (!durations.empty()) {
+            error = "unknown command";
+        } else if (it == timers.end()) {
+            error = "unknown timer";
+        } else if (verb == "status") {
+            reply = FormatControlStatus(it->second, "status", publishedSeq, name.c_str());
+        } else {
+            command.command = verb == "start" ? CONTROL_START :
+                              verb == "pause" ? CONTROL_PAUSE : CONTROL_RESET;
+        }
+    }
+
+    if (error) {
+        Queue(fd, client, std::string("{\"event\":\"error\",\"message\":\"") + error + "\"}\n");
+        return;
+    }
+    if (!reply.empty()) {
+        Queue(fd, client, reply);
+        return;
+    }
+    if (listener) {
+        listener->OnTimerCommand(command);
+    }
+    Queue(fd, client, "{\"event\":\"ok\",\"command\":\"" + verb + "\",\"timer\":\"" + name +
+                      "\"}\n");
+}
+
+// {"event":"list","timers":[{"timer":"default",...},...]}, timer utama dulu
+std::string ControlServer::FormatTimerList() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string line = "{\"event\":\"list\",\"seq\":" + std::to_string(publishedSeq) +
+                       ",\"timers\":[";
+    char fields[256];
+    FormatStatusFields(latest, fields, sizeof(fields));
+    line += std::string("{\"timer\":\"") + DEFAULT_TIMER_NAME + "\"," + fields + "}";
+    for (std::map<std::string, ControlStatus>::const_iterator it = timers.begin();
+         it != timers.end(); ++it) {
+        FormatStatusFields(it->second, fields, sizeof(fields));
+        line += ",{\"timer\":\"" + it->first + "\"," + fields + "}";
+    }
+    line += "]}\n";
+    return line;
+}
+
+void ControlServer::Broadcast() {
+    unsigned long long seq;
+    ControlStatus status = Snapshot(seq);
+    if (seq == broadcastSeq) {
+        return;
+    }
+    broadcastSeq = seq;
+
+    // Diformat sekali untuk semua pelanggan
+    std::string line = FormatControlStatus(status, "update", seq);
+
+    std::vector<int> subscribers;
+    subscribers.reserve(subscriberCount.load());
+    for (std::unordered_map<int, Client>::iterator it = clients.begin(); it != clients.end(); ++it) {
+        if (it->second.subscribed) {
+            subscribers.push_back(it->first);
+        }
+    }
+    for (size_t i = 0; i < subscribers.size(); ++i) {
+        std::unordered_map<int, Client>::iterator it = clients.find(subscribers[i]);
+        if (it != clients.end()) {
+            Queue(it->first, it->second, line);
+        }
+    }
+}
+
+bool ControlServer::Queue(int fd, Client& client, const std::string& text) {
+    if (client.output.size() - client.outputOffset + text.size() > MAX_CLIENT_BUFFER) {
+        CloseClient(fd);
+        return false;
+    }
+    client.output.append(text);
+    if (!client.wantWrite) {
+        WriteClient(fd);
+    }
+    return clients.count(fd) > 0;
+}
+
+void ControlServer::WriteClient(int fd) {
+    std::unordered_map<int, Client>::iterator it = clients.find(fd);
+    if (it == clients.end()) {
+        return;
+    }
+    Client& client = it->second;
+
+    while (client.outputOffset < client.output.size()) {
+        ssize_t sent = send(fd, client.output.data() + client.outputOffset,
+                            client.output.size() - client.outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            client.outputOffset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        CloseClient(fd);
+        return;
+    }
+
+    bool pending = client.outputOffset < client.output.size();
+    if (!pending) {
+        client.output.clear();
+        client.outputOffset = 0;
+    }
+
+    // Minta EPOLLOUT hanya selama masih ada sisa yang belum terkirim
+    if (pending != client.wantWrite) {
+        client.wantWrite = pending;
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP | (pending ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    }
+}
+
+void ControlServer::CloseClient(int fd) {
+    std::unordered_map<int, Client>::iterator it = clients.find(fd);
+    if (it == clients.end()) {
+        return;
+    }
+    if (it->second.subscribed) {
+        subscriberCount--;
+    }
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    clients.erase(it);
+    clientCount = clients.size();
+}
+
+#else
+
+bool ControlServer::Start(const std::string& socketPath) {
+    return false;
+}
+
+void ControlServer::Stop() {
+}
+
+void ControlServer::Run() {
+}
+
+void ControlServer::AcceptClients() {
+}
+
+void ControlServer::ReadClient(int fd) {
+}
+
+void ControlServer::WriteClient(int fd) {
+}
+
+void ControlServer::HandleLine(int fd, Client& client, const std::string& line) {
+}
+
+void ControlServer::HandleTimerLine(int fd, Client& client, const std::string& verb,
+                                    const std::string& argument) {
+}
+
+std::string ControlServer::FormatTimerList() {
+    return std::string();
+}
+
+void ControlServer::Broadcast() {
+}
+
+bool ControlServer::Queue(int fd, Client& client, const std::string& text) {
+    return false;
+}
+
+void ControlServer::CloseClient(int fd) {
+}
+
+#endif
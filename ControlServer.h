@@ -0,0 +1,181 @@
+// ControlServer.h
+#ifndef CONTROL_SERVER_H
+#define CONTROL_SERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "TimerCore.h"
+#include "TimerRegistry.h"
+
+// Perintah dari klien kontrol (setara tombol Start/Pause/Reset)
+enum ControlCommand {
+    CONTROL_START,
+    CONTROL_PAUSE,
+    CONTROL_RESET,
+    CONTROL_TRACE,    // tulis file trace sekarang
+    CONTROL_ADD       // buat timer bernama; hanya lewat ControlTimerCommand
+};
+
+// Batas timer bernama yang bisa dibuat klien, selain timer utama
+const size_t MAX_NAMED_TIMERS = 64;
+
+// Perintah untuk satu timer bernama di TimerRegistry pemilik
+struct ControlTimerCommand {
+    ControlCommand command;     // CONTROL_ADD, CONTROL_START, CONTROL_PAUSE atau CONTROL_RESET
+    std::string name;
+    int focusMinutes;           // hanya untuk CONTROL_ADD
+    int breakMinutes;
+
+    ControlTimerCommand() : command(CONTROL_START), focusMinutes(25), breakMinutes(5) {}
+};
+
+// Snapshot state timer yang dikirim ke klien
+struct ControlStatus {
+    TimerState state;
+    bool inTransition;
+    int64_t remainingMs;
+    int64_t transitionMs;       // sisa masa transisi
+    int64_t atMs;               // MonotonicNowMs() saat snapshot dibuat
+    int completedSessions;
+    int focusMinutes;
+    int breakMinutes;
+
+    ControlStatus()
+        : state(READY), inTransition(false), remainingMs(0), transitionMs(0),
+          atMs(0), completedSessions(0), focusMinutes(25), breakMinutes(5) {}
+};
+
+// $XDG_RUNTIME_DIR/pomodoro.sock, atau /tmp/pomodoro-<uid>.sock
+std::string DefaultControlSocketPath();
+
+// Nama state untuk protokol ("ready", "focus", "paused_focus", ...)
+const char* ControlStateName(TimerState state);
+
+// Nama perintah di protokol ("start", "pause", "reset", "trace", "add")
+const char* ControlCommandName(ControlCommand command);
+
+// 1..32 karakter huruf, angka, '-', '_' atau '.'
+bool IsValidTimerName(const std::string& name);
+
+// Snapshot satu TimerCore, dengan waktu dari Clock-nya
+ControlStatus CaptureControlStatus(const TimerCore& core);
+
+// Menjalankan perintah timer bernama pada registry pemilik; dipanggil di
+// thread yang memiliki registry. false jika nama tidak dikenal (CONTROL_ADD:
+// sudah ada).
+bool ApplyTimerCommand(TimerRegistry& registry, const ControlTimerCommand& command);
+
+// Mengirim satu perintah ke instance yang memegang endpoint di path dan
+// menunggu balasannya (paling lama timeoutMs). Dipakai instance yang hanya
+// menampilkan state bersama untuk meneruskan tombol ke pemilik.
+bool SendControlCommand(const std::string& path, ControlCommand command, int timeoutMs = 1000);
+
+// Satu baris JSON (diakhiri '\n') untuk event status/update; timer diisi
+// untuk status timer bernama
+std::string FormatControlStatus(const ControlStatus& status, const char* event,
+                                unsigned long long seq, const char* timer = nullptr);
+
+// Dipanggil dari thread I/O, bukan thread GUI; penerima harus meneruskan
+// perintah ke thread-nya sendiri (misalnya lewat CallAfter)
+class ControlServerListener {
+public:
+    virtual ~ControlServerListener() {}
+    virtual void OnControlCommand(ControlCommand command) = 0;
+    // Perintah untuk timer bernama selain timer utama; nama sudah diperiksa
+    // server. Penerima menjalankannya dengan ApplyTimerCommand() lalu
+    // memanggil PublishTimers().
+    virtual void OnTimerCommand(const ControlTimerCommand& /*command*/) {}
+};
+
+// Endpoint kontrol lokal di Unix domain socket. Protokolnya berbasis baris:
+// klien mengirim "start", "pause", "reset", "trace", "status", "subscribe"
+// atau "unsubscribe"; server membalas satu baris JSON per perintah, dan
+// pelanggan menerima baris "update" setiap kali status dipublikasikan.
+//
+// Timer bernama di TimerRegistry pemilik: "add NAMA [fokus [istirahat]]"
+// membuatnya (durasi dalam menit, default sama dengan timer utama),
+// "start|pause|reset|status NAMA" menuju timer itu ("default" adalah timer
+// utama), dan "list" membalas state semua timer dalam satu baris. Timer
+// bernama hanya hidup selama proses pemilik berjalan dan tidak dicatat ke
+// jurnal; pelanggan hanya menerima update timer utama.
+//
+// Semua klien dilayani satu thread epoll. Thread GUI hanya memanggil
+// Publish() sekali per perubahan; format dan fan-out ke ratusan pelanggan
+// dikerjakan di thread I/O. Hanya tersedia di Linux; di platform lain
+// Start() mengembalikan false.
+class ControlServer {
+public:
+    // Klien yang tidak membaca dan antriannya melewati batas ini diputus
+    static const size_t MAX_CLIENT_BUFFER = 256 * 1024;
+
+    ControlServer();
+    ~ControlServer();
+
+    void SetListener(ControlServerListener* listener);
+
+    bool Start(const std::string& path);
+    void Stop();
+    bool IsRunning() const { return running; }
+    const std::string& GetPath() const { return path; }
+
+    // Aman dari thread mana pun; update beruntun sebelum thread I/O sempat
+    // berjalan digabung menjadi satu
+    void Publish(const ControlStatus& status);
+    // Snapshot setiap timer bernama yang dibuat lewat "add"; dipanggil di
+    // thread pemilik registry setelah perintah atau deadline timer itu
+    void PublishTimers(const TimerRegistry& registry);
+
+    size_t GetClientCount() const { return clientCount.load(); }
+    size_t GetSubscriberCount() const { return subscriberCount.load(); }
+
+private:
+    struct Client {
+        std::string input;
+        std::string output;
+        size_t outputOffset;
+        bool subscribed;
+        bool wantWrite;
+    };
+
+    ControlServerListener* listener;
+    std::string path;
+    std::atomic<bool> running;    // dibaca IsRunning()/Publish() dari thread lain
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    std::thread worker;
+    std::atomic<bool> stopping;
+    std::atomic<size_t> clientCount;
+    std::atomic<size_t> subscriberCount;
+
+    // Dibagi dengan thread pemanggil Publish()
+    std::mutex mutex;
+    ControlStatus latest;
+    unsigned long long publishedSeq;
+    std::map<std::string, ControlStatus> timers;   // timer bernama, urut nama
+
+    // Hanya disentuh thread I/O
+    std::unordered_map<int, Client> clients;
+    unsigned long long broadcastSeq;
+
+    void Run();
+    void AcceptClients();
+    void ReadClient(int fd);
+    void WriteClient(int fd);
+    void HandleLine(int fd, Client& client, const std::string& line);
+    void HandleTimerLine(int fd, Client& client, const std::string& verb,
+                         const std::string& argument);
+    std::string FormatTimerList();
+    void Broadcast();
+    bool Queue(int fd, Client& client, const std::string& text);
+    void CloseClient(int fd);
+    ControlStatus Snapshot(unsigned long long& seq);
+};
+
+#endif // CONTROL_SERVER_H
@@ -0,0 +1,69 @@
+// CountdownEngine.cpp
+#include "CountdownEngine.h"
+
+CountdownEngine::CountdownEngine()
+    : durationMs(0), deadlineMs(0), pausedRemainingMs(0),
+      running(false), paused(false) {
+}
+
+void CountdownEngine::Start(int64_t duration, int64_t nowMs) {
+    durationMs = duration;
+    deadlineMs = nowMs + duration;
+    pausedRemainingMs = 0;
+    running = true;
+    paused = false;
+}
+
+void CountdownEngine::Pause(int64_t nowMs) {
+    if (!running) {
+        return;
+    }
+    pausedRemainingMs = RemainingMs(nowMs);
+    running = false;
+    paused = true;
+}
+
+void CountdownEngine::Resume(int64_t nowMs) {
+    if (!paused) {
+        return;
+    }
+    deadlineMs = nowMs + pausedRemainingMs;
+    running = true;
+    paused = false;
+}
+
+void CountdownEngine::Reset() {
+    durationMs = 0;
+    deadlineMs = 0;
+    pausedRemainingMs = 0;
+    running = false;
+    paused = false;
+}
+
+bool CountdownEngine::IsExpired(int64_t nowMs) const {
+    return running && nowMs >= deadlineMs;
+}
+
+int64_t CountdownEngine::RemainingMs(int64_t nowMs) const {
+    if (paused) {
+        return pausedRemainingMs;
+    }
+    if (!running) {
+        return durationMs;
+    }
+    int64_t remaining = deadlineMs - nowMs;
+    return remaining > 0 ? remaining : 0;
+}
+
+int CountdownEngine::RemainingSeconds(int64_t nowMs) const {
+    return static_cast<int>((RemainingMs(nowMs) + 999) / 1000);
+}
+
+int64_t CountdownEngine::MsUntilNextSecond(int64_t nowMs) const {
+    int64_t remaining = RemainingMs(nowMs);
+    if (remaining <= 0) {
+        return 0;
+    }
+    int64_t delay = remaining % 1000;
+    return delay == 0 ? 1000 : delay;
+}
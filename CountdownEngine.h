@@ -0,0 +1,43 @@
+// CountdownEngine.h
+#ifndef COUNTDOWN_ENGINE_H
+#define COUNTDOWN_ENGINE_H
+
+#include <cstdint>
+
+// Mesin hitung mundur berbasis deadline absolut.
+// Sisa waktu selalu dihitung ulang dari deadline pada setiap wakeup, sehingga
+// tick yang terlambat, tick yang tergabung, atau suspend/resume tidak
+// menambah panjang sesi.
+class CountdownEngine {
+public:
+    CountdownEngine();
+
+    void Start(int64_t durationMs, int64_t nowMs);
+    void Pause(int64_t nowMs);
+    void Resume(int64_t nowMs);
+    void Reset();
+
+    bool IsRunning() const { return running; }
+    bool IsPaused() const { return paused; }
+    bool IsExpired(int64_t nowMs) const;
+
+    int64_t DurationMs() const { return durationMs; }
+    int64_t DeadlineMs() const { return deadlineMs; }
+    int64_t RemainingMs(int64_t nowMs) const;
+
+    // Detik yang ditampilkan (dibulatkan ke atas, jadi "25:00" tampil penuh
+    // selama detik pertama)
+    int RemainingSeconds(int64_t nowMs) const;
+
+    // Jeda sampai angka detik yang tampil berubah berikutnya
+    int64_t MsUntilNextSecond(int64_t nowMs) const;
+
+private:
+    int64_t durationMs;
+    int64_t deadlineMs;         // valid saat running
+    int64_t pausedRemainingMs;  // valid saat paused
+    bool running;
+    bool paused;
+};
+
+#endif // COUNTDOWN_ENGINE_H
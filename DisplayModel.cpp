@@ -0,0 +1,103 @@
+// DisplayModel.cpp
+#include "DisplayModel.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// "00".."99", dihitung sekali saat pertama dipakai
+struct TwoDigitTable {
+    char digits[100][2];
+
+    TwoDigitTable() {
+        for (int i = 0; i < 100; ++i) {
+            digits[i][0] = static_cast<char>('0' + i / 10);
+            digits[i][1] = static_cast<char>('0' + i % 10);
+        }
+    }
+};
+
+const TwoDigitTable& TwoDigits() {
+    static const TwoDigitTable table;
+    return table;
+}
+
+}
+
+void FormatTime(int seconds, char* out, size_t size) {
+    if (seconds < 0) {
+        seconds = 0;
+    }
+    int mins = seconds / 60;
+    int secs = seconds % 60;
+    // Jalur tick: menit dua digit disalin dari tabel tanpa snprintf
+    if (mins < 100 && size >= 6) {
+        const TwoDigitTable& table = TwoDigits();
+        std::memcpy(out, table.digits[mins], 2);
+        out[2] = ':';
+        std::memcpy(out + 3, table.digits[secs], 2);
+        out[5] = '\0';
+        return;
+    }
+    std::snprintf(out, size, "%02d:%02d", mins, secs);
+}
+
+const char* StateLabel(TimerState state) {
+    switch (state) {
+        case READY:
+            return "SIAP";
+        case RUNNING_FOCUS:
+            return "FOKUS";
+        case RUNNING_BREAK:
+            return "ISTIRAHAT";
+        case PAUSED_FOCUS:
+            return "JEDA (FOKUS)";
+        case PAUSED_BREAK:
+            return "JEDA (ISTIRAHAT)";
+    }
+    return "";
+}
+
+DisplayState BuildDisplayState(const TimerCore& core) {
+    DisplayState display;
+    FormatTime(core.RemainingSeconds(), display.timeText, sizeof(display.timeText));
+    display.state = core.GetState();
+    display.stateText = StateLabel(display.state);
+    display.progress = core.ProgressPercent();
+    return display;
+}
+
+DisplayState BuildDisplayState(const SharedTimerState& shared, int64_t nowMs) {
+    DisplayState display;
+    FormatTime(shared.RemainingSeconds(nowMs), display.timeText, sizeof(display.timeText));
+    display.state = shared.state;
+    display.stateText = StateLabel(display.state);
+    display.progress = shared.ProgressPercent(nowMs);
+    return display;
+}
+
+unsigned DiffDisplayState(const DisplayState& oldState, const DisplayState& newState) {
+    unsigned changed = 0;
+    if (std::strcmp(oldState.timeText, newState.timeText) != 0) {
+        changed |= FIELD_TIME;
+    }
+    // Label state selalu pointer ke string statis yang sama
+    if (oldState.stateText != newState.stateText) {
+        changed |= FIELD_STATE;
+    }
+    if (oldState.progress != newState.progress) {
+        changed |= FIELD_PROGRESS;
+    }
+    return changed;
+}
+
+std::string UiCounters::Report() const {
+    double perUpdate = updates > 0 ? 1.0 / updates : 0.0;
+    char buffer[192];
+    std::snprintf(buffer, sizeof(buffer),
+                  "%lld update; per update: label %.2f, value %.2f, layout %.2f, paint %.2f, freeze %.2f",
+                  updates, labelSets * perUpdate, valueSets * perUpdate,
+                  layouts * perUpdate, paints * perUpdate, freezes * perUpdate);
+    return buffer;
+}
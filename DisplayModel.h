@@ -0,0 +1,53 @@
+// DisplayModel.h
+#ifndef DISPLAY_MODEL_H
+#define DISPLAY_MODEL_H
+
+#include <string>
+#include "SharedTimerState.h"
+#include "TimerCore.h"
+
+// Bagian tampilan yang bisa berubah per tick
+enum DisplayField {
+    FIELD_TIME = 1 << 0,      // angka MM:SS
+    FIELD_STATE = 1 << 1,     // label state dan status bar
+    FIELD_PROGRESS = 1 << 2   // progress bar
+};
+const unsigned FIELD_ALL = FIELD_TIME | FIELD_STATE | FIELD_PROGRESS;
+
+// Snapshot tampilan timer, dibangun dari TimerCore tanpa alokasi
+struct DisplayState {
+    char timeText[8];        // "MM:SS"
+    TimerState state;
+    const char* stateText;   // label statis, lihat StateLabel()
+    int progress;            // 0..100
+};
+
+// Format "MM:SS" ke buffer (minimal 8 byte); tanpa alokasi, dan di bawah
+// 100 menit tanpa snprintf
+void FormatTime(int seconds, char* out, size_t size);
+
+// Label state yang ditampilkan
+const char* StateLabel(TimerState state);
+
+DisplayState BuildDisplayState(const TimerCore& core);
+// Dari state instance pemilik, untuk instance yang hanya menampilkan
+DisplayState BuildDisplayState(const SharedTimerState& shared, int64_t nowMs);
+
+// Bit DisplayField yang berbeda antara dua snapshot
+unsigned DiffDisplayState(const DisplayState& oldState, const DisplayState& newState);
+
+// Instrumentasi: berapa widget yang disentuh, di-resize dan di-repaint
+struct UiCounters {
+    long long updates;       // panggilan UpdateTimerDisplay
+    long long labelSets;     // SetLabel/SetStatusText
+    long long valueSets;     // SetValue progress bar
+    long long layouts;       // event size pada widget tampilan
+    long long paints;        // event paint pada widget tampilan
+    long long freezes;       // batch Freeze/Thaw
+
+    UiCounters() : updates(0), labelSets(0), valueSets(0), layouts(0), paints(0), freezes(0) {}
+
+    std::string Report() const;
+};
+
+#endif // DISPLAY_MODEL_H
@@ -0,0 +1,13 @@
+// HeadlessMain.cpp
+// Titik masuk pomodoro-cli: mode headless tanpa link ke wxWidgets, sehingga
+// loader tidak perlu memuat GTK sama sekali.
+#include "HeadlessRunner.h"
+#include "StartupProfiler.h"
+#include "Tracer.h"
+
+int main(int argc, char** argv) {
+    GetStartupProfiler().Mark("main");
+    GetStartupProfiler().SetEnabled(HasStartupTimingsFlag(argc, argv));
+    ConfigureTracer(argc, argv);
+    return RunHeadless(argc, argv);
+}
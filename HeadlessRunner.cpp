@@ -0,0 +1,739 @@
+// HeadlessRunner.cpp
+#include "HeadlessRunner.h"
+#include "StartupProfiler.h"
+#include "Tracer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char* const USAGE =
+    "Penggunaan: pomodoro --headless [opsi]\n"
+    "  --log                 satu baris log per event (default jika bukan terminal)\n"
+    "  --no-start            tunggu perintah start dari endpoint kontrol\n"
+    "  --sessions N          berhenti setelah N sesi fokus selesai\n"
+    "  --focus M             durasi fokus (menit) untuk run ini saja\n"
+    "  --break M             durasi istirahat (menit) untuk run ini saja\n"
+    "  --task JUDUL          tautkan sesi fokus run ini ke task JUDUL (dibuat jika\n"
+    "                        belum ada)\n"
+    "  --no-control          tanpa endpoint kontrol Unix socket\n"
+    "  --ticking             suara detak selama sesi\n"
+    "  --audio-out FILE      tulis isyarat suara ke FILE (WAV), bukan perangkat audio\n"
+    "  --exit-after-startup  keluar setelah inisialisasi\n"
+    "  --startup-timings     cetak waktu fase startup ke stderr\n"
+    "  --trace[=FILE]        histogram handler dan trace Chrome (pomodoro_trace.json)\n"
+    "  --export FILE         ekspor riwayat sesi ke FILE (daftar task ke FILE.tasks)\n"
+    "                        lalu keluar\n"
+    "  --import FILE         tambahkan riwayat sesi dari FILE lalu keluar; task dari\n"
+    "                        FILE.tasks digabung menurut judul, tanpa file itu sesi\n"
+    "                        masuk tanpa task\n"
+    "  --format F            format ekspor: csv, jsonl atau bin (default dari ekstensi\n"
+    "                        FILE); impor mengenali format dari isi file\n"
+    "Jika instance lain sedang berjalan, perintah start diteruskan ke sana;\n"
+    "ekspor, impor dan --no-start ditolak.\n";
+
+const int PROGRESS_WIDTH = 20;
+
+bool ParseMinutes(const char* text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < 1 || parsed > 24 * 60) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// Jumlah sesi: bilangan bulat positif, batas atasnya sekadar menolak
+// angka yang jelas salah ketik
+bool ParseSessionCount(const char* text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < 1 || parsed > 10000) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// File daftar task yang menyertai file ekspor
+std::string TaskSidecarPath(const std::string& exportPath) {
+    return exportPath + ".tasks";
+}
+
+// --export/--import: memproses jurnal secara streaming lalu keluar. taskId
+// hanya bermakna bersama daftar task asalnya, jadi daftar itu ikut
+// diekspor dan digabung saat impor.
+int RunTransfer(const HeadlessOptions& options) {
+    SessionJournal journal;
+    if (!journal.Open(JOURNAL_FILE)) {
+        std::fprintf(stderr, "Tidak dapat membuka %s\n", JOURNAL_FILE);
+        return 1;
+    }
+
+    TransferStats stats;
+    std::string error;
+    if (!options.exportPath.empty()) {
+        ExportFormat format = options.exportFormatSet ? options.exportFormat :
+                              ExportFormatForPath(options.exportPath);
+        if (!ExportJournal(journal, options.exportPath, format, INT64_MIN, INT64_MAX, stats, error)) {
+            std::fprintf(stderr, "Ekspor gagal: %s\n", error.c_str());
+            return 1;
+        }
+        TaskStore tasks;
+        std::string sidecar = TaskSidecarPath(options.exportPath);
+        if (!tasks.Load(TASKS_FILE)) {
+            // Tanpa daftar task: sidecar lama dari ekspor sebelumnya dibuang
+            std::remove(sidecar.c_str());
+        } else if (!tasks.WriteSnapshot(sidecar)) {
+            std::fprintf(stderr, "Ekspor gagal: tidak dapat menulis %s\n", sidecar.c_str());
+            return 1;
+        }
+        std::printf("Ekspor %s (%s): %s\n", options.exportPath.c_str(),
+                    ExportFormatName(format), stats.Report().c_str());
+    } else {
+        // File yang rusak atau terpotong ditolak sebelum daftar task atau
+        // jurnal disentuh
+        if (!CheckImportFile(options.importPath, error)) {
+            std::fprintf(stderr, "Impor gagal: %s\n", error.c_str());
+            return 1;
+        }
+        // Task asal digabung dulu di memori saja, agar taskId di file bisa
+        // dipetakan ke id lokal. Daftar di disk baru ditambah jika ada
+        // record yang masuk ke jurnal; gabungan yang sama pada daftar yang
+        // sama menghasilkan id yang sama.
+        std::vector<uint32_t> taskMap;
+        TaskStore source;
+        bool hasSidecar = source.Load(TaskSidecarPath(options.importPath));
+        if (hasSidecar) {
+            TaskStore staged;
+            staged.Load(TASKS_FILE);
+            staged.MergeFrom(source, taskMap);
+        }
+        bool imported = ImportJournal(journal, options.importPath, stats, error, &taskMap);
+        size_t sourceTasks = 0;
+        if (hasSidecar && stats.records > 0) {
+            TaskStore tasks;
+            std::vector<uint32_t> committedMap;
+            if (!tasks.Open(TASKS_FILE)) {
+                std::fprintf(stderr, "Tidak dapat membuka %s\n", TASKS_FILE);
+                return 1;
+            }
+            size_t before = tasks.Size();
+            tasks.MergeFrom(source, committedMap);
+            sourceTasks = tasks.Size() - before;
+            if (committedMap != taskMap) {
+                std::fprintf(stderr, "Peringatan: %s berubah selama impor; tautan task "
+                                     "sesi impor mungkin salah\n", TASKS_FILE);
+            }
+        }
+        if (!imported) {
+            std::fprintf(stderr, "Impor gagal: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("Impor %s: %s, %zu task baru\n", options.importPath.c_str(),
+                    stats.Report().c_str(), sourceTasks);
+    }
+    return 0;
+}
+
+// Instance lain (jendela atau headless) memegang file sesi; bekerja di
+// sampingnya berarti menjadi penulis kedua. Yang bisa dilakukan hanya
+// meneruskan start lewat endpoint kontrolnya.
+int ForwardToOwner(const HeadlessOptions& options) {
+    bool transfer = !options.exportPath.empty() || !options.importPath.empty();
+    if (!transfer && options.autoStart && !options.exitAfterStartup) {
+        if (SendControlCommand(DefaultControlSocketPath(), CONTROL_START)) {
+            std::printf("Instance lain sedang berjalan; start diteruskan ke sana "
+                        "(opsi run ini tidak dipakai)\n");
+            return 0;
+        }
+        std::fprintf(stderr, "Instance lain sedang berjalan dan endpoint kontrolnya tidak "
+                             "menjawab: %s\n", DefaultControlSocketPath().c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "Instance lain sedang berjalan; tutup dulu sebelum %s\n",
+                 transfer ? "ekspor atau impor" : "menjalankan mode headless");
+    return 1;
+}
+
+#ifdef _WIN32
+HeadlessRunner* activeRunner = nullptr;
+
+BOOL WINAPI ConsoleHandler(DWORD type) {
+    if (activeRunner) {
+        activeRunner->RequestStop();
+        return TRUE;
+    }
+    return FALSE;
+}
+#endif
+
+}
+
+bool IsHeadlessRequested(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseHeadlessOptions(int argc, char** argv, HeadlessOptions& options, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless") {
+            continue;
+        } else if (arg == "--log") {
+            options.logLines = true;
+        } else if (arg == "--no-start") {
+            options.autoStart = false;
+        } else if (arg == "--no-control") {
+            options.controlEnabled = false;
+        } else if (arg == "--exit-after-startup") {
+            options.exitAfterStartup = true;
+        } else if (arg == "--startup-timings" || arg == "--trace" ||
+                   arg.compare(0, 8, "--trace=") == 0) {
+            continue;
+        } else if (arg == "--ticking") {
+            options.ticking = true;
+        } else if (arg == "--audio-out" && hasValue) {
+            options.audioOut = argv[++i];
+        } else if (arg == "--export" && hasValue) {
+            options.exportPath = argv[++i];
+        } else if (arg == "--import" && hasValue) {
+            options.importPath = argv[++i];
+        } else if (arg == "--format" && hasValue) {
+            if (!ParseExportFormat(argv[++i], options.exportFormat)) {
+                error = "format ekspor tidak dikenal";
+                return false;
+            }
+            options.exportFormatSet = true;
+        } else if (arg == "--sessions" && hasValue) {
+            if (!ParseSessionCount(argv[++i], options.maxFocusSessions)) {
+                error = "jumlah sesi tidak valid";
+                return false;
+            }
+        } else if (arg == "--focus" && hasValue) {
+            if (!ParseMinutes(argv[++i], options.focusMinutes)) {
+                error = "durasi fokus tidak valid";
+                return false;
+            }
+        } else if (arg == "--break" && hasValue) {
+            if (!ParseMinutes(argv[++i], options.breakMinutes)) {
+                error = "durasi istirahat tidak valid";
+                return false;
+            }
+        } else if (arg == "--task" && hasValue) {
+            options.task = argv[++i];
+            if (options.task.find_first_not_of(" \t") == std::string::npos) {
+                error = "judul task kosong";
+                return false;
+            }
+        } else {
+            error = "opsi tidak dikenal: " + arg;
+            return false;
+        }
+    }
+    if (!options.exportPath.empty() && !options.importPath.empty()) {
+        error = "--export dan --import tidak bisa dipakai bersamaan";
+        return false;
+    }
+    return true;
+}
+
+int RunHeadless(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            std::fputs(USAGE, stdout);
+            return 0;
+        }
+    }
+
+    HeadlessOptions options;
+    std::string error;
+    if (!ParseHeadlessOptions(argc, argv, options, error)) {
+        std::fprintf(stderr, "%s\n%s", error.c_str(), USAGE);
+        return 2;
+    }
+
+    // Dipegang sampai runner selesai menutup file sesi, seperti jendela
+    // pemilik; instance yang dibuka kemudian menjadi cermin
+    SharedStatePublisher owner;
+    if (!AcquireSharedOwnership(owner, DefaultSharedStateName())) {
+        return ForwardToOwner(options);
+    }
+    if (!options.exportPath.empty() || !options.importPath.empty()) {
+        return RunTransfer(options);
+    }
+
+#ifndef _WIN32
+    // Sinyal diblok sebelum thread mana pun dibuat, lalu diterima satu thread
+    // khusus dengan sigwait; tidak ada kode yang berjalan di handler sinyal
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+#endif
+
+    HeadlessRunner runner(options, owner);
+
+#ifndef _WIN32
+    std::atomic<bool> finished(false);
+    std::thread signalThread([&]() {
+        int received = 0;
+        while (sigwait(&signals, &received) == 0 && !finished) {
+            runner.RequestStop();
+        }
+    });
+    int result = runner.Run();
+    finished = true;
+    pthread_kill(signalThread.native_handle(), SIGTERM);
+    signalThread.join();
+#else
+    activeRunner = &runner;
+    SetConsoleCtrlHandler(ConsoleHandler, TRUE);
+    int result = runner.Run();
+    SetConsoleCtrlHandler(ConsoleHandler, FALSE);
+    activeRunner = nullptr;
+#endif
+    return result;
+}
+
+HeadlessRunner::HeadlessRunner(const HeadlessOptions& runOptions, SharedStatePublisher& owner)
+    : options(runOptions), sharedPublisher(owner), registry(systemClock),
+      mainTimer(registry.Add(DEFAULT_TIMER_NAME)), core(registry.Core(mainTimer)), wakeupScheduler(systemClock),
+      settingsWriter(SETTINGS_FILE), cues(audio, core), stopRequested(false), displayValid(false),
+      lineOpen(false), focusCompletedThisRun(0), sessionRestored(false) {
+
+    // Tampilan satu baris hanya masuk akal di terminal
+    if (!isatty(fileno(stdout))) {
+        options.logLines = true;
+    }
+
+    StartupProfiler& profiler = GetStartupProfiler();
+    LoadSettingsFile(SETTINGS_FILE, settings);
+    core.SetDurations(options.focusMinutes > 0 ? options.focusMinutes : settings.focusDuration,
+                      options.breakMinutes > 0 ? options.breakMinutes : settings.breakDuration);
+    core.SetCompletedSessions(settings.completedSessions);
+
+    if (!journal.Open(JOURNAL_FILE)) {
+        LogLine(std::string("Tidak dapat membuka ") + JOURNAL_FILE);
+    }
+    stats.Rebuild(journal.Records(), journal.Size());
+
+    // Task dari --task hanya untuk run ini, seperti --focus; pengaturan
+    // tetap menyimpan task yang dipilih di jendela
+    if (!tasks.Open(TASKS_FILE)) {
+        LogLine(std::string("Tidak dapat membuka ") + TASKS_FILE);
+    }
+    tasks.RebuildRollups(journal.Records(), journal.Size());
+    uint32_t taskId = options.task.empty()
+        ? static_cast<uint32_t>(settings.activeTask)
+        : tasks.FindOrAdd(options.task, systemClock.WallNowMs());
+    const Task* task = tasks.Find(taskId);
+    core.SetTaskId(task ? task->id : 0);
+    if (task) {
+        LogLine("Task: " + task->title + " (" + TaskStore::FormatRollup(*task) + ")");
+    }
+    if (!checkpointLog.Open(CHECKPOINT_FILE)) {
+        LogLine(std::string("Tidak dapat membuka ") + CHECKPOINT_FILE);
+    }
+    profiler.Mark("settings");
+
+    // Isyarat suara; tanpa perangkat audio alarm kembali ke bel terminal
+    if (settings.soundEnabled && !options.exitAfterStartup) {
+        std::unique_ptr<AudioSink> sink;
+        if (!options.audioOut.empty()) {
+            sink.reset(new WavFileAudioSink(options.audioOut));
+        } else {
+            sink = CreateDeviceAudioSink();
+        }
+        if (sink && audio.LoadCues() > 0 && !audio.Start(std::move(sink))) {
+            LogLine("Audio tidak aktif");
+        }
+    }
+    cues.SetEnabled(settings.soundEnabled, options.ticking || settings.tickingSound);
+    profiler.Mark("audio");
+
+    // Mode log tidak menampilkan hitungan per detik, cukup bangun di deadline
+    wakeupScheduler.SetVisible(!options.logLines);
+    core.SetListener(this);
+
+    // Lanjutkan sesi yang masih berjalan saat proses terakhir mati
+    CheckpointRecord checkpoint;
+    if (!options.exitAfterStartup && checkpointLog.GetRecovered(checkpoint) &&
+        IsSessionInFlight(checkpoint)) {
+        sessionRestored = core.RestoreCheckpoint(checkpoint);
+        registry.Sync(mainTimer);
+        if (sessionRestored) {
+            LogLine("Sesi sebelumnya dilanjutkan");
+        } else {
+            SaveSettings();
+        }
+    }
+
+    // Sesi yang dipulihkan tidak memicu hook; hanya perubahan berikutnya
+    if (!options.exitAfterStartup) {
+        std::string error;
+        if (!hooks.LoadFile(HOOKS_FILE, error)) {
+            LogLine("Hook tidak dimuat: " + error);
+        }
+        hooks.Start();
+    }
+
+    PublishStatus();
+    if (options.controlEnabled && !options.exitAfterStartup) {
+        controlServer.SetListener(this);
+        if (!controlServer.Start(DefaultControlSocketPath())) {
+            LogLine("Endpoint kontrol tidak aktif: " + DefaultControlSocketPath());
+        }
+    }
+    profiler.Mark("construct");
+}
+
+HeadlessRunner::~HeadlessRunner() {
+    hooks.Stop();
+    audio.Stop();
+    controlServer.Stop();
+    core.SetListener(nullptr);
+}
+
+int HeadlessRunner::Run() {
+    StartupProfiler& profiler = GetStartupProfiler();
+    if (!options.exitAfterStartup) {
+        if (options.autoStart && !sessionRestored) {
+            registry.Start(mainTimer);
+        } else {
+            Render();
+        }
+    }
+    profiler.Mark("first_display");
+    if (profiler.IsEnabled()) {
+        std::fputs(profiler.Report().c_str(), stderr);
+    }
+    if (options.exitAfterStartup) {
+        return 0;
+    }
+
+    Tracer& tracer = GetTracer();
+    while (true) {
+        {
+            ScopedTrace trace(TRACE_ON_TIMER);
+            ApplyCommands();
+            // Timer bernama yang deadline-nya lewat ikut diproses; statusnya
+            // diterbitkan agar "status NAMA" tidak basi
+            if (registry.Advance() > 0 && registry.Size() > 1) {
+                controlServer.PublishTimers(registry);
+            }
+            registry.Poll(mainTimer);
+            cues.Poll();
+        }
+
+        // Satu wakeup untuk tampilan, timer bernama lain dan isyarat suara
+        int64_t delay = wakeupScheduler.NextDelayMs(core);
+        int64_t now = systemClock.NowMs();
+        const int64_t deadlines[] = { registry.NextDeadlineMs(), cues.NextCueMs() };
+        for (int64_t deadline : deadlines) {
+            if (deadline < 0) {
+                continue;
+            }
+            int64_t deadlineDelay = deadline > now ? deadline - now : 0;
+            if (delay < 0 || deadlineDelay < delay) {
+                delay = deadlineDelay;
+            }
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopRequested) {
+            break;
+        }
+        if (!commands.empty() || !timerCommands.empty()) {
+            continue;
+        }
+        if (delay < 0) {
+            wakeup.wait(lock);
+        } else if (delay > 0) {
+            int64_t dueNs = tracer.IsEnabled() ? tracer.NowNs() + delay * 1000000 : -1;
+            if (wakeup.wait_for(lock, std::chrono::milliseconds(delay)) == std::cv_status::timeout &&
+                dueNs >= 0) {
+                tracer.RecordTickLateness(tracer.NowNs() - dueNs);
+            }
+        }
+        lock.unlock();
+        wakeupScheduler.RecordWakeup();
+    }
+
+    if (lineOpen) {
+        std::fputc('\n', stdout);
+        lineOpen = false;
+    }
+    controlServer.Stop();
+    if (audio.IsRunning()) {
+        LogLine("Audio: " + audio.Report());
+    }
+    audio.Stop();
+    if (hooks.IsRunning()) {
+        // Hook yang masih berjalan diberi kesempatan selesai sebelum dihentikan
+        hooks.WaitIdle(SessionHooks::KILL_GRACE_MS);
+        std::fputs(hooks.Report().c_str(), stderr);
+    }
+    hooks.Stop();
+    SaveSettings();
+    settingsWriter.Flush();
+    checkpointLog.Flush();
+    journal.Sync();
+    DumpTrace();
+
+    StatsSummary summary = stats.Summarize(systemClock.WallNowMs());
+    LogLine(SessionStats::FormatSummary(summary, core.GetCompletedSessions()));
+    return 0;
+}
+
+void HeadlessRunner::RequestStop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wakeup.notify_one();
+}
+
+void HeadlessRunner::OnControlCommand(ControlCommand command) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.push_back(command);
+    }
+    wakeup.notify_one();
+}
+
+void HeadlessRunner::OnTimerCommand(const ControlTimerCommand& command) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        timerCommands.push_back(command);
+    }
+    wakeup.notify_one();
+}
+
+void HeadlessRunner::ApplyCommands() {
+    std::deque<ControlCommand> pending;
+    std::deque<ControlTimerCommand> pendingTimers;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(commands);
+        pendingTimers.swap(timerCommands);
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        switch (pending[i]) {
+            case CONTROL_START:
+                registry.Start(mainTimer);
+                break;
+            case CONTROL_PAUSE:
+                registry.Pause(mainTimer);
+                break;
+            case CONTROL_RESET:
+                registry.Reset(mainTimer);
+                break;
+            case CONTROL_TRACE:
+                DumpTrace();
+                break;
+            case CONTROL_ADD:
+                // Hanya datang lewat OnTimerCommand
+                break;
+        }
+    }
+    for (size_t i = 0; i < pendingTimers.size(); ++i) {
+        const ControlTimerCommand& command = pendingTimers[i];
+        if (ApplyTimerCommand(registry, command) && command.command == CONTROL_ADD) {
+            LogLine("Timer " + command.name + " dibuat");
+        }
+    }
+    if (!pendingTimers.empty()) {
+        controlServer.PublishTimers(registry);
+    }
+}
+
+// TimerCore: state berubah
+void HeadlessRunner::OnStateChanged(TimerState state) {
+    cues.OnStateChanged(state);
+    hooks.OnStateChanged(core);
+    if (options.logLines) {
+        char timeText[8];
+        FormatTime(core.RemainingSeconds(), timeText, sizeof(timeText));
+        LogLine(std::string(StateLabel(state)) + " " + timeText);
+    }
+    Render();
+    PublishStatus();
+}
+
+// TimerCore: angka detik berubah
+void HeadlessRunner::OnTick(int /*remainingSeconds*/) {
+    Render();
+    PublishStatus();
+}
+
+// TimerCore: sesi selesai
+void HeadlessRunner::OnSessionCompleted(bool wasFocusSession) {
+    hooks.OnSessionCompleted(core, wasFocusSession);
+    if (wasFocusSession) {
+        SaveSettings();
+    }
+    bool played = cues.OnSessionCompleted(wasFocusSession);
+    if (settings.soundEnabled && !played && !options.logLines) {
+        std::fputc('\a', stdout);
+    }
+
+    LogLine(wasFocusSession ?
+            "Sesi fokus selesai! Istirahat dimulai dalam 5 detik." :
+            "Waktu istirahat selesai! Fokus dimulai dalam 5 detik.");
+
+    if (wasFocusSession && options.maxFocusSessions > 0 &&
+        ++focusCompletedThisRun >= options.maxFocusSessions) {
+        RequestStop();
+    }
+    PublishStatus();
+}
+
+// TimerCore: countdown masa transisi
+void HeadlessRunner::OnTransitionTick(int secondsLeft) {
+    if (!options.logLines) {
+        std::printf("\r%s %d detik\033[K",
+                    core.WasFocusCompleted() ? "Istirahat dimulai dalam" : "Fokus dimulai dalam",
+                    secondsLeft);
+        std::fflush(stdout);
+        lineOpen = true;
+        displayValid = false;
+    }
+    PublishStatus();
+}
+
+// TimerCore: catatan sesi untuk jurnal
+void HeadlessRunner::OnSessionRecord(const SessionRecord& record) {
+    journal.Append(record);
+    stats.Add(record);
+    tasks.AddSession(record);
+
+    if (record.type == SESSION_FOCUS && (record.flags & RECORD_COMPLETED)) {
+        StatsSummary summary = stats.Summarize(systemClock.WallNowMs());
+        LogLine(SessionStats::FormatSummary(summary, core.GetCompletedSessions()));
+        const Task* task = tasks.Find(record.taskId);
+        if (task) {
+            LogLine("Task: " + task->title + " (" + TaskStore::FormatRollup(*task) + ")");
+        }
+    }
+}
+
+// TimerCore: transisi sesi untuk log checkpoint
+void HeadlessRunner::OnCheckpoint(const CheckpointRecord& record) {
+    checkpointLog.Append(record);
+}
+
+// Tampilan terminal satu baris, ditimpa dengan '\r'; hanya ditulis ulang
+// jika ada bagian yang berubah
+void HeadlessRunner::Render() {
+    ScopedTrace trace(TRACE_UPDATE_DISPLAY);
+    if (options.logLines || core.InTransition()) {
+        return;
+    }
+
+    DisplayState display = BuildDisplayState(core);
+    if (displayValid && DiffDisplayState(lastDisplay, display) == 0) {
+        return;
+    }
+    lastDisplay = display;
+    displayValid = true;
+
+    char bar[PROGRESS_WIDTH * 3 + 1];
+    int filled = display.progress * PROGRESS_WIDTH / 100;
+    size_t pos = 0;
+    for (int i = 0; i < PROGRESS_WIDTH; ++i) {
+        // "█" untuk bagian yang sudah lewat, "░" untuk sisanya
+        const char* cell = i < filled ? "\xE2\x96\x88" : "\xE2\x96\x91";
+        std::memcpy(bar + pos, cell, 3);
+        pos += 3;
+    }
+    bar[pos] = '\0';
+
+    std::printf("\r%-16s %s %s %3d%%  sesi: %d\033[K",
+                display.stateText, display.timeText, bar, display.progress,
+                core.GetCompletedSessions());
+    std::fflush(stdout);
+    lineOpen = true;
+}
+
+// Satu baris log dengan stempel waktu lokal; teks multi-baris dipecah
+void HeadlessRunner::LogLine(const std::string& text) {
+    if (lineOpen) {
+        std::fputc('\n', stdout);
+        lineOpen = false;
+        displayValid = false;
+    }
+
+    char stamp[32];
+    std::time_t now = std::time(nullptr);
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::printf("%s %.*s\n", stamp, static_cast<int>(end - start), text.c_str() + start);
+        start = end + 1;
+    }
+    std::fflush(stdout);
+}
+
+void HeadlessRunner::PublishStatus() {
+    sharedPublisher.Publish(CaptureSharedState(core));
+    if (!options.controlEnabled) {
+        return;
+    }
+    controlServer.Publish(CaptureControlStatus(core));
+}
+
+// Durasi dari --focus/--break tidak disimpan; hanya jumlah sesi yang berubah
+void HeadlessRunner::SaveSettings() {
+    ScopedTrace trace(TRACE_SAVE_SETTINGS);
+    settings.completedSessions = core.GetCompletedSessions();
+    settingsWriter.Schedule(settings);
+}
+
+// Histogram handler ke stderr dan event terbaru ke file trace Chrome; hanya
+// jika dijalankan dengan --trace
+void HeadlessRunner::DumpTrace() {
+    Tracer& tracer = GetTracer();
+    if (!tracer.IsEnabled()) {
+        return;
+    }
+    std::fputs(tracer.Report().c_str(), stderr);
+    if (!tracer.WriteChromeTrace(tracer.GetOutputPath())) {
+        LogLine("Tidak dapat menulis " + tracer.GetOutputPath());
+    }
+}
@@ -0,0 +1,127 @@
+// HeadlessRunner.h
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include "Clock.h"
+#include "TimerCore.h"
+#include "WakeupScheduler.h"
+#include "DisplayModel.h"
+#include "SettingsStore.h"
+#include "SessionJournal.h"
+#include "SessionExport.h"
+#include "SessionCheckpoint.h"
+#include "SessionStats.h"
+#include "SharedTimerState.h"
+#include "TaskStore.h"
+#include "TimerRegistry.h"
+#include "ControlServer.h"
+#include "AudioEngine.h"
+#include "SessionCues.h"
+#include "SessionHooks.h"
+
+// Opsi baris perintah mode headless
+struct HeadlessOptions {
+    bool autoStart;           // langsung mulai fokus (--no-start untuk menunggu perintah)
+    bool logLines;            // satu baris log per event, bukan tampilan terminal
+    int maxFocusSessions;     // berhenti setelah N sesi fokus selesai (0 = terus)
+    int focusMinutes;         // 0 = dari pengaturan
+    int breakMinutes;         // 0 = dari pengaturan
+    bool controlEnabled;      // endpoint kontrol Unix socket
+    bool exitAfterStartup;    // keluar setelah inisialisasi (untuk ukur startup)
+    bool ticking;             // detak selama sesi, selain dari pengaturan
+    std::string task;         // judul task untuk run ini (dicari atau dibuat); kosong = dari pengaturan
+    std::string audioOut;     // tulis isyarat ke file WAV, bukan perangkat audio
+    std::string exportPath;   // ekspor jurnal lalu keluar, tanpa menjalankan timer
+    std::string importPath;   // impor ke jurnal lalu keluar
+    bool exportFormatSet;     // --format; jika tidak, format dari ekstensi
+    ExportFormat exportFormat;
+
+    HeadlessOptions()
+        : autoStart(true), logLines(false), maxFocusSessions(0), focusMinutes(0),
+          breakMinutes(0), controlEnabled(true), exitAfterStartup(false), ticking(false),
+          exportFormatSet(false), exportFormat(EXPORT_CSV) {}
+};
+
+// true jika argumen berisi --headless
+bool IsHeadlessRequested(int argc, char** argv);
+
+// false dan pesan error jika ada opsi yang tidak dikenal
+bool ParseHeadlessOptions(int argc, char** argv, HeadlessOptions& options, std::string& error);
+
+// Titik masuk mode headless: tidak menyentuh wx/GTK sama sekali
+int RunHeadless(int argc, char** argv);
+
+// Siklus fokus/istirahat yang sama dengan PomodoroFrame, termasuk
+// pengaturan, jurnal, statistik dan endpoint kontrol, dengan tampilan
+// satu baris di terminal atau baris log untuk skrip dan service. Seperti
+// jendela, timer yang ditampilkan adalah timer utama TimerRegistry; timer
+// bernama lain dibuat dan dijalankan lewat endpoint kontrol. Hanya
+// dibuat oleh pemilik state bersama (AcquireSharedOwnership); state
+// diterbitkan lewat owner agar jendela yang dibuka kemudian mengikutinya.
+class HeadlessRunner : public TimerCoreListener, public ControlServerListener {
+public:
+    HeadlessRunner(const HeadlessOptions& options, SharedStatePublisher& owner);
+    ~HeadlessRunner();
+
+    int Run();
+
+    // Aman dari thread mana pun (handler sinyal, thread I/O)
+    void RequestStop();
+
+    // ControlServerListener (dipanggil dari thread I/O)
+    void OnControlCommand(ControlCommand command) override;
+    void OnTimerCommand(const ControlTimerCommand& command) override;
+
+private:
+    HeadlessOptions options;
+    SharedStatePublisher& sharedPublisher;
+    SystemClock systemClock;
+    TimerRegistry registry;
+    TimerRegistry::Handle mainTimer;
+    TimerCore& core;              // timer utama di registry
+    WakeupScheduler wakeupScheduler;
+    SessionJournal journal;
+    SessionStats stats;
+    TaskStore tasks;
+    CheckpointLog checkpointLog;
+    Settings settings;
+    SettingsWriter settingsWriter;
+    ControlServer controlServer;
+    AudioEngine audio;
+    SessionCues cues;
+    SessionHooks hooks;
+
+    // Perintah dari thread lain, diproses di loop utama
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<ControlCommand> commands;
+    std::deque<ControlTimerCommand> timerCommands;
+    bool stopRequested;
+
+    DisplayState lastDisplay;
+    bool displayValid;
+    bool lineOpen;            // baris terminal sedang ditimpa dengan '\r'
+    int focusCompletedThisRun;
+    bool sessionRestored;     // sesi dari checkpoint dilanjutkan, jangan auto-start
+
+    // TimerCoreListener
+    void OnStateChanged(TimerState state) override;
+    void OnTick(int remainingSeconds) override;
+    void OnSessionCompleted(bool wasFocusSession) override;
+    void OnTransitionTick(int secondsLeft) override;
+    void OnSessionRecord(const SessionRecord& record) override;
+    void OnCheckpoint(const CheckpointRecord& record) override;
+
+    void ApplyCommands();
+    void Render();
+    void LogLine(const std::string& text);
+    void PublishStatus();
+    void SaveSettings();
+    void DumpTrace();
+};
+
+#endif // HEADLESS_RUNNER_H
@@ -0,0 +1,251 @@
+// IdleMonitor.cpp
+#include "IdleMonitor.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef POMODORO_HAVE_XSYNC
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <X11/Xlib.h>
+#include <X11/extensions/sync.h>
+
+namespace {
+
+int64_t ValueToInt64(const XSyncValue& value) {
+    return (static_cast<int64_t>(XSyncValueHigh32(value)) << 32) |
+           static_cast<int64_t>(XSyncValueLow32(value));
+}
+
+XSyncValue Int64ToValue(int64_t value) {
+    XSyncValue result;
+    XSyncIntsToValue(&result, static_cast<unsigned int>(value & 0xFFFFFFFF),
+                     static_cast<int>(value >> 32));
+    return result;
+}
+
+// Alarm tanpa delta: setelah terpicu harus dipasang ulang
+XSyncAlarmAttributes AlarmAttributes(XSyncCounter counter, XSyncTestType test, int64_t value) {
+    XSyncAlarmAttributes attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.trigger.counter = counter;
+    attributes.trigger.value_type = XSyncAbsolute;
+    attributes.trigger.test_type = test;
+    attributes.trigger.wait_value = Int64ToValue(value);
+    XSyncIntToValue(&attributes.delta, 0);
+    attributes.events = True;
+    return attributes;
+}
+
+const unsigned long ALARM_FLAGS = XSyncCACounter | XSyncCAValueType | XSyncCATestType |
+                                  XSyncCAValue | XSyncCADelta | XSyncCAEvents;
+
+}
+
+#endif
+
+IdleMonitor::IdleMonitor()
+    : listener(nullptr), thresholdMs(0), running(false), display(nullptr),
+      idleCounter(0), idleAlarm(0), activeAlarm(0), syncEventBase(0), wakeFd(-1),
+      wakeups(0), events(0) {
+}
+
+IdleMonitor::~IdleMonitor() {
+    Stop();
+}
+
+#ifdef POMODORO_HAVE_XSYNC
+
+bool IdleMonitor::Start(int64_t threshold, IdleListener* idleListener) {
+    Stop();
+    if (threshold < 1 || !idleListener || !std::getenv("DISPLAY")) {
+        return false;
+    }
+
+    Display* x = XOpenDisplay(nullptr);
+    if (!x) {
+        return false;
+    }
+    display = x;
+
+    int errorBase = 0;
+    int major = 0;
+    int minor = 0;
+    if (!XSyncQueryExtension(x, &syncEventBase, &errorBase) || !XSyncInitialize(x, &major, &minor)) {
+        Close();
+        return false;
+    }
+
+    int counterCount = 0;
+    XSyncSystemCounter* counters = XSyncListSystemCounters(x, &counterCount);
+    for (int i = 0; counters && i < counterCount; ++i) {
+        if (std::strcmp(counters[i].name, "IDLETIME") == 0) {
+            idleCounter = counters[i].counter;
+        }
+    }
+    if (counters) {
+        XSyncFreeSystemCounterList(counters);
+    }
+    if (idleCounter == 0) {
+        Close();
+        return false;
+    }
+
+    // Naik melewati ambang = mulai diam; turun di bawahnya = ada input.
+    // Keduanya hanya terpicu pada transisi, jadi boleh terpasang bersamaan.
+    XSyncAlarmAttributes idle = AlarmAttributes(idleCounter, XSyncPositiveTransition, threshold);
+    XSyncAlarmAttributes active = AlarmAttributes(idleCounter, XSyncNegativeTransition, threshold - 1);
+    idleAlarm = XSyncCreateAlarm(x, ALARM_FLAGS, &idle);
+    activeAlarm = XSyncCreateAlarm(x, ALARM_FLAGS, &active);
+
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        Close();
+        return false;
+    }
+
+    thresholdMs = threshold;
+    listener = idleListener;
+    wakeups = 0;
+    events = 0;
+
+    // Sudah diam lebih lama dari ambang saat dimulai: tidak akan ada
+    // transisi naik, jadi laporkan sekarang
+    XSyncValue current;
+    if (XSyncQueryCounter(x, idleCounter, &current) && ValueToInt64(current) >= threshold) {
+        listener->OnUserIdle(ValueToInt64(current));
+    }
+    XFlush(x);
+
+    running = true;
+    worker = std::thread(&IdleMonitor::Run, this);
+    return true;
+}
+
+void IdleMonitor::Stop() {
+    if (running) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written;
+        worker.join();
+        running = false;
+    }
+    Close();
+}
+
+void IdleMonitor::Run() {
+    Display* x = static_cast<Display*>(display);
+    pollfd fds[2];
+    fds[0].fd = ConnectionNumber(x);
+    fds[0].events = POLLIN;
+    fds[1].fd = wakeFd;
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        // XPending membaca semua yang sudah ada di socket sebelum tidur lagi
+        while (XPending(x) > 0) {
+            XEvent event;
+            XNextEvent(x, &event);
+            if (event.type != syncEventBase + XSyncAlarmNotify) {
+                continue;
+            }
+            XSyncAlarmNotifyEvent* alarm = reinterpret_cast<XSyncAlarmNotifyEvent*>(&event);
+            events.fetch_add(1, std::memory_order_relaxed);
+            if (alarm->alarm == idleAlarm) {
+                XSyncAlarmAttributes idle = AlarmAttributes(idleCounter, XSyncPositiveTransition,
+                                                            thresholdMs);
+                XSyncChangeAlarm(x, idleAlarm, ALARM_FLAGS, &idle);
+                listener->OnUserIdle(ValueToInt64(alarm->counter_value));
+            } else if (alarm->alarm == activeAlarm) {
+                XSyncAlarmAttributes active = AlarmAttributes(idleCounter, XSyncNegativeTransition,
+                                                              thresholdMs - 1);
+                XSyncChangeAlarm(x, activeAlarm, ALARM_FLAGS, &active);
+                listener->OnUserActive();
+            }
+        }
+        XFlush(x);
+
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) < 0) {
+            continue;
+        }
+        wakeups.fetch_add(1, std::memory_order_relaxed);
+        if (fds[1].revents & POLLIN) {
+            return;
+        }
+        if (fds[0].revents & (POLLERR | POLLHUP)) {
+            return;
+        }
+    }
+}
+
+void IdleMonitor::Close() {
+    Display* x = static_cast<Display*>(display);
+    if (x) {
+        if (idleAlarm) {
+            XSyncDestroyAlarm(x, idleAlarm);
+        }
+        if (activeAlarm) {
+            XSyncDestroyAlarm(x, activeAlarm);
+        }
+        XCloseDisplay(x);
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+    }
+    display = nullptr;
+    idleCounter = idleAlarm = activeAlarm = 0;
+    wakeFd = -1;
+}
+
+#else
+
+bool IdleMonitor::Start(int64_t threshold, IdleListener* idleListener) {
+    return false;
+}
+
+void IdleMonitor::Stop() {
+}
+
+void IdleMonitor::Run() {
+}
+
+void IdleMonitor::Close() {
+}
+
+#endif
+
+IdleAutoPause::IdleAutoPause(TimerRegistry& registry, TimerRegistry::Handle handle)
+    : registry(registry), handle(handle), pausedByIdle(false),
+      pauseCount(0), resumeCount(0), returnedMs(0) {
+}
+
+bool IdleAutoPause::OnUserIdle(int64_t idleMs) {
+    TimerCore& core = registry.Core(handle);
+    // Istirahat tidak dijeda: diam saat istirahat memang diharapkan
+    if (core.GetState() != RUNNING_FOCUS || core.InTransition()) {
+        return false;
+    }
+    int64_t before = core.RemainingMs();
+    core.PauseSince(core.GetClock().NowMs() - idleMs);
+    registry.Sync(handle);
+    returnedMs += core.RemainingMs() - before;
+    pausedByIdle = true;
+    pauseCount++;
+    return true;
+}
+
+bool IdleAutoPause::OnUserActive() {
+    if (!pausedByIdle) {
+        return false;
+    }
+    pausedByIdle = false;
+    if (registry.Core(handle).GetState() != PAUSED_FOCUS) {
+        return false;
+    }
+    registry.Start(handle);
+    resumeCount++;
+    return true;
+}
@@ -0,0 +1,94 @@
+// IdleMonitor.h
+#ifndef IDLE_MONITOR_H
+#define IDLE_MONITOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "TimerRegistry.h"
+
+// Lama tanpa input sebelum sesi fokus dijeda otomatis (default pengaturan)
+const int DEFAULT_IDLE_PAUSE_MINUTES = 5;
+
+class IdleListener {
+public:
+    virtual ~IdleListener() {}
+
+    // Tidak ada input selama idleMs (>= ambang); dari thread monitor
+    virtual void OnUserIdle(int64_t idleMs) = 0;
+    // Ada input lagi setelah OnUserIdle; dari thread monitor
+    virtual void OnUserActive() = 0;
+};
+
+// Deteksi pengguna diam dari alarm counter IDLETIME ekstensi X SYNC. Server
+// X sendiri yang membandingkan counter dengan ambang dan mengirim event
+// saat melewatinya (naik: diam, turun: ada input), sehingga thread monitor
+// tidur di poll() tanpa batas waktu dan tidak pernah bangun selama keadaan
+// tidak berubah. Koneksi X terpisah dari milik GTK.
+//
+// Hanya jika dibangun dengan POMODORO_HAVE_XSYNC dan ada display X11
+// (termasuk Xvfb dan XWayland); selain itu Start() mengembalikan false.
+class IdleMonitor {
+public:
+    IdleMonitor();
+    ~IdleMonitor();
+
+    bool Start(int64_t thresholdMs, IdleListener* listener);
+    void Stop();
+    bool IsRunning() const { return running; }
+    int64_t GetThresholdMs() const { return thresholdMs; }
+
+    // Berapa kali thread monitor bangun, dan berapa event yang diteruskan
+    long long GetWakeupCount() const { return wakeups.load(std::memory_order_relaxed); }
+    long long GetEventCount() const { return events.load(std::memory_order_relaxed); }
+
+private:
+    IdleListener* listener;
+    int64_t thresholdMs;
+    bool running;
+    void* display;              // Display*
+    unsigned long idleCounter;  // XSyncCounter IDLETIME
+    unsigned long idleAlarm;    // naik melewati ambang
+    unsigned long activeAlarm;  // turun di bawah ambang
+    int syncEventBase;
+    int wakeFd;
+    std::thread worker;
+    std::atomic<long long> wakeups;
+    std::atomic<long long> events;
+
+    void Run();
+    void Close();
+};
+
+// Menjeda sesi fokus yang berjalan saat pengguna diam dan melanjutkannya
+// saat pengguna kembali. Jeda berlaku mundur sejak input terakhir, jadi
+// waktu diam tidak ikut terhitung sebagai fokus. Hanya sesi yang dijeda di
+// sini yang dilanjutkan otomatis; perintah manual membatalkannya.
+// Dipanggil dari thread pemilik TimerRegistry.
+class IdleAutoPause {
+public:
+    IdleAutoPause(TimerRegistry& registry, TimerRegistry::Handle handle);
+
+    // true jika sesi fokus dijeda
+    bool OnUserIdle(int64_t idleMs);
+    // true jika sesi dilanjutkan
+    bool OnUserActive();
+    // Start/Pause/Reset dari pengguna: jangan lanjutkan otomatis
+    void Forget() { pausedByIdle = false; }
+
+    bool IsPausedByIdle() const { return pausedByIdle; }
+    long long GetPauseCount() const { return pauseCount; }
+    long long GetResumeCount() const { return resumeCount; }
+    // Total waktu diam yang dikembalikan ke sisa sesi
+    int64_t GetReturnedMs() const { return returnedMs; }
+
+private:
+    TimerRegistry& registry;
+    TimerRegistry::Handle handle;
+    bool pausedByIdle;
+    long long pauseCount;
+    long long resumeCount;
+    int64_t returnedMs;
+};
+
+#endif // IDLE_MONITOR_H
@@ -0,0 +1,48 @@
+// LatencyRecorder.cpp
+#include "LatencyRecorder.h"
+
+#include <algorithm>
+#include <cstdio>
+
+LatencyRecorder::LatencyRecorder(double budgetMs)
+    : count(0), overBudget(0), budgetMs(budgetMs), lastMs(0.0), maxMs(0.0) {
+}
+
+void LatencyRecorder::Record(double ms) {
+    samples[count % CAPACITY] = ms;
+    count++;
+    lastMs = ms;
+    if (ms > maxMs) {
+        maxMs = ms;
+    }
+    if (budgetMs > 0.0 && ms > budgetMs) {
+        overBudget++;
+    }
+}
+
+void LatencyRecorder::Clear() {
+    count = 0;
+    overBudget = 0;
+    lastMs = 0.0;
+    maxMs = 0.0;
+}
+
+double LatencyRecorder::Percentile(double p) const {
+    int size = static_cast<int>(count < CAPACITY ? count : CAPACITY);
+    if (size == 0) {
+        return 0.0;
+    }
+    double sorted[CAPACITY];
+    std::copy(samples, samples + size, sorted);
+    int index = static_cast<int>(p * (size - 1) + 0.5);
+    std::nth_element(sorted, sorted + index, sorted + size);
+    return sorted[index];
+}
+
+std::string LatencyRecorder::Report() const {
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer),
+                  "n=%lld p50=%.3fms p99=%.3fms max=%.3fms over_budget=%lld (anggaran %gms)",
+                  count, Percentile(0.50), Percentile(0.99), maxMs, overBudget, budgetMs);
+    return buffer;
+}
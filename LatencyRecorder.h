@@ -0,0 +1,40 @@
+// LatencyRecorder.h
+#ifndef LATENCY_RECORDER_H
+#define LATENCY_RECORDER_H
+
+#include <string>
+
+// Sampel latensi terakhir dalam ring buffer, dengan persentil dan hitungan
+// sampel yang melewati anggaran. Tanpa alokasi saat Record().
+class LatencyRecorder {
+public:
+    static const int CAPACITY = 256;
+
+    explicit LatencyRecorder(double budgetMs = 0.0);
+
+    void Record(double ms);
+    void Clear();
+
+    long long Count() const { return count; }
+    long long OverBudgetCount() const { return overBudget; }
+    double BudgetMs() const { return budgetMs; }
+    double LastMs() const { return lastMs; }
+    double MaxMs() const { return maxMs; }
+
+    // Persentil (0..1) dari sampel yang masih ada di ring buffer
+    double Percentile(double p) const;
+
+    // "n=.. p50=..ms p99=..ms max=..ms over_budget=.. (anggaran ..ms)"; anggaran
+    // dicetak apa adanya (%g) karena bisa di bawah 1 ms
+    std::string Report() const;
+
+private:
+    double samples[CAPACITY];
+    long long count;
+    long long overBudget;
+    double budgetMs;
+    double lastMs;
+    double maxMs;
+};
+
+#endif // LATENCY_RECORDER_H
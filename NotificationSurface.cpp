@@ -0,0 +1,130 @@
+// NotificationSurface.cpp
+#include "NotificationSurface.h"
+
+NotificationSurface::NotificationSurface(const Clock& clock)
+    : clock(clock), parent(nullptr), dialog(nullptr), panel(nullptr),
+      messageText(nullptr), countdownText(nullptr), shown(false), centred(false),
+      paintPendingDeadlineMs(-1),
+      showLatency(NOTIFICATION_BUDGET_MS), paintLatency(NOTIFICATION_BUDGET_MS) {
+}
+
+void NotificationSurface::Create(wxWindow* newParent) {
+    if (dialog) {
+        return;
+    }
+    parent = newParent;
+    
+    dialog = new wxDialog(parent, wxID_ANY, wxEmptyString,
+                          wxDefaultPosition, wxSize(320, 180),
+                          wxDEFAULT_DIALOG_STYLE | wxSTAY_ON_TOP);
+    
+    panel = new wxPanel(dialog);
+    wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+    
+    // Pesan teks
+    messageText = new wxStaticText(panel, wxID_ANY, wxEmptyString,
+                                   wxDefaultPosition, wxDefaultSize,
+                                   wxALIGN_CENTRE_HORIZONTAL);
+    messageText->SetForegroundColour(wxColour(255, 255, 255));
+    
+    // Countdown text
+    countdownText = new wxStaticText(panel, wxID_ANY, wxEmptyString,
+                                     wxDefaultPosition, wxDefaultSize,
+                                     wxALIGN_CENTRE_HORIZONTAL);
+    countdownText->SetForegroundColour(wxColour(255, 255, 255));
+    
+    sizer->Add(messageText, 0, wxALIGN_CENTER | wxALL | wxEXPAND, 15);
+    sizer->Add(countdownText, 0, wxALIGN_CENTER | wxALL, 10);
+    panel->SetSizer(sizer);
+    
+    wxBoxSizer* dialogSizer = new wxBoxSizer(wxVERTICAL);
+    dialogSizer->Add(panel, 1, wxEXPAND);
+    dialog->SetSizer(dialogSizer);
+    
+    panel->Bind(wxEVT_PAINT, &NotificationSurface::OnPanelPaint, this);
+    dialog->Bind(wxEVT_CLOSE_WINDOW, &NotificationSurface::OnDialogClose, this);
+}
+
+void NotificationSurface::Show(const wxString& title, const wxString& message,
+                               const wxString& countdown, const wxColour& background,
+                               int64_t deadlineMs) {
+    if (!dialog) {
+        // Belum dibuat saat startup (misalnya sesi selesai sebelum paint pertama)
+        return;
+    }
+    
+    bool relayout = false;
+    if (title != currentTitle) {
+        currentTitle = title;
+        dialog->SetTitle(title);
+    }
+    if (message != currentMessage) {
+        currentMessage = message;
+        messageText->SetLabel(message);
+        relayout = true;
+    }
+    if (countdown != currentCountdown) {
+        currentCountdown = countdown;
+        countdownText->SetLabel(countdown);
+        relayout = true;
+    }
+    if (background != currentBackground) {
+        currentBackground = background;
+        panel->SetBackgroundColour(background);
+        panel->Refresh();
+    }
+    if (relayout) {
+        panel->Layout();
+    }
+    
+    if (!centred) {
+        dialog->Centre();
+        centred = true;
+    }
+    if (!shown) {
+        dialog->Show();
+        shown = true;
+    }
+    dialog->Raise();
+    
+    if (deadlineMs >= 0) {
+        showLatency.Record(static_cast<double>(clock.NowMs() - deadlineMs));
+        paintPendingDeadlineMs = deadlineMs;
+        panel->Refresh();
+    }
+}
+
+void NotificationSurface::SetCountdown(const wxString& countdown) {
+    if (!dialog || countdown == currentCountdown) {
+        return;
+    }
+    currentCountdown = countdown;
+    countdownText->SetLabel(countdown);
+}
+
+void NotificationSurface::Hide() {
+    if (!dialog || !shown) {
+        return;
+    }
+    dialog->Hide();
+    shown = false;
+    paintPendingDeadlineMs = -1;
+}
+
+void NotificationSurface::OnPanelPaint(wxPaintEvent& event) {
+    if (paintPendingDeadlineMs >= 0) {
+        paintLatency.Record(static_cast<double>(clock.NowMs() - paintPendingDeadlineMs));
+        paintPendingDeadlineMs = -1;
+    }
+    event.Skip();
+}
+
+// Tombol tutup hanya menyembunyikan; jendela dipakai lagi sesi berikutnya
+void NotificationSurface::OnDialogClose(wxCloseEvent& event) {
+    if (event.CanVeto()) {
+        event.Veto();
+        Hide();
+        return;
+    }
+    event.Skip();
+}
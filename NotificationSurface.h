@@ -0,0 +1,62 @@
+// NotificationSurface.h
+#ifndef NOTIFICATION_SURFACE_H
+#define NOTIFICATION_SURFACE_H
+
+#include <wx/wx.h>
+#include "Clock.h"
+#include "LatencyRecorder.h"
+
+// Anggaran latensi dari deadline sesi sampai notifikasi terlihat
+const double NOTIFICATION_BUDGET_MS = 100.0;
+
+// Dialog notifikasi yang dibuat sekali lalu dipakai ulang setiap sesi.
+// Show() hanya mengganti teks dan warna yang berubah, lalu menampilkan
+// jendela yang sudah ada; Hide() menyembunyikannya tanpa menghancurkan.
+// Latensi deadline -> Show() dan deadline -> paint pertama dicatat.
+class NotificationSurface {
+public:
+    explicit NotificationSurface(const Clock& clock);
+
+    // Membuat jendela (idempoten); bisa dipanggil lebih awal agar
+    // notifikasi pertama tidak ikut membayar biaya pembuatan
+    void Create(wxWindow* parent);
+    bool IsCreated() const { return dialog != nullptr; }
+
+    // deadlineMs: deadline terjadwal sesi (jam monoton), atau -1
+    void Show(const wxString& title, const wxString& message,
+              const wxString& countdown, const wxColour& background,
+              int64_t deadlineMs);
+    void SetCountdown(const wxString& countdown);
+    void Hide();
+    bool IsShown() const { return shown; }
+
+    const LatencyRecorder& ShowLatency() const { return showLatency; }
+    const LatencyRecorder& PaintLatency() const { return paintLatency; }
+
+private:
+    const Clock& clock;
+    wxWindow* parent;
+    wxDialog* dialog;        // dimiliki parent, dihancurkan bersama parent
+    wxPanel* panel;
+    wxStaticText* messageText;
+    wxStaticText* countdownText;
+    bool shown;
+    bool centred;
+
+    // Isi terakhir, agar widget hanya disentuh jika berubah
+    wxString currentTitle;
+    wxString currentMessage;
+    wxString currentCountdown;
+    wxColour currentBackground;
+
+    // Deadline yang menunggu paint pertama, atau -1
+    int64_t paintPendingDeadlineMs;
+
+    LatencyRecorder showLatency;
+    LatencyRecorder paintLatency;
+
+    void OnPanelPaint(wxPaintEvent& event);
+    void OnDialogClose(wxCloseEvent& event);
+};
+
+#endif // NOTIFICATION_SURFACE_H
@@ -1,5 +1,13 @@
 // PomodoroTimer.cpp
 #include "PomodoroTimer.h"
+#include "Tracer.h"
+
+#include <cstdio>
+
+#if defined(POMODORO_HAVE_GDK_X11) && defined(__WXGTK3__)
+#include <gtk/gtk.h>
+#include <gdk/gdkx.h>
+#endif
 
 // Implementasi event table
 BEGIN_EVENT_TABLE(PomodoroFrame, wxFrame)
@@ -7,82 +15,131 @@ BEGIN_EVENT_TABLE(PomodoroFrame, wxFrame)
     EVT_BUTTON(ID_PAUSE_BUTTON, PomodoroFrame::OnPauseTimer)
     EVT_BUTTON(ID_RESET_BUTTON, PomodoroFrame::OnResetTimer)
     EVT_TIMER(ID_TIMER, PomodoroFrame::OnTimer)
-    EVT_TIMER(ID_NOTIFICATION_TIMER, PomodoroFrame::OnNotificationTimer)
     EVT_SLIDER(ID_FOCUS_SLIDER, PomodoroFrame::OnFocusSliderChange)
     EVT_SLIDER(ID_BREAK_SLIDER, PomodoroFrame::OnBreakSliderChange)
     EVT_TOGGLEBUTTON(ID_THEME_TOGGLE, PomodoroFrame::OnThemeToggle)
     EVT_TOGGLEBUTTON(ID_SOUND_TOGGLE, PomodoroFrame::OnSoundToggle)
+    EVT_TOGGLEBUTTON(ID_TICKING_TOGGLE, PomodoroFrame::OnTickingToggle)
+    EVT_TOGGLEBUTTON(ID_IDLE_TOGGLE, PomodoroFrame::OnIdlePauseToggle)
+    EVT_TOGGLEBUTTON(ID_TRAY_TOGGLE, PomodoroFrame::OnTrayToggle)
+    EVT_TEXT(ID_TASK_SEARCH, PomodoroFrame::OnTaskSearch)
+    EVT_TEXT_ENTER(ID_TASK_SEARCH, PomodoroFrame::OnTaskEnter)
+    EVT_LISTBOX(ID_TASK_RESULTS, PomodoroFrame::OnTaskSelected)
+    EVT_BUTTON(ID_TASK_DONE, PomodoroFrame::OnTaskDone)
     EVT_CLOSE(PomodoroFrame::OnClose)
+    EVT_ICONIZE(PomodoroFrame::OnIconize)
+    EVT_SHOW(PomodoroFrame::OnShow)
+    EVT_ACTIVATE(PomodoroFrame::OnActivate)
 END_EVENT_TABLE()
 
-// Implementasi kelas aplikasi
-wxIMPLEMENT_APP(PomodoroApp);
+// Implementasi kelas aplikasi; main() ada di main.cpp agar mode headless
+// bisa berjalan tanpa menginisialisasi wx
+wxIMPLEMENT_APP_NO_MAIN(PomodoroApp);
 
 bool PomodoroApp::OnInit() {
+    GetStartupProfiler().Mark("toolkit_init");
     PomodoroFrame* frame = new PomodoroFrame("Pomodoro Timer");
     frame->Show(true);
+    GetStartupProfiler().Mark("shown");
+    
+    // Untuk mengukur waktu startup: tutup begitu startup bertahap selesai
+    for (int i = 1; i < argc; ++i) {
+        if (wxString(argv[i]) == "--exit-after-startup") {
+            frame->SetExitAfterStartup(true);
+        }
+    }
     return true;
 }
 
 // Implementasi konstruktor PomodoroFrame
-PomodoroFrame::PomodoroFrame(const wxString& title)
-    : wxFrame(NULL, wxID_ANY, title, wxDefaultPosition, wxSize(450, 350)) {
-    
-    // Inisialisasi data
-    timerState = READY;
-    remainingSeconds = 0;
+PomodoroFrame::PomodoroFrame(const wxString& title, Clock* customClock)
+    : wxFrame(NULL, wxID_ANY, title, wxDefaultPosition, wxSize(450, 350)),
+      clock(customClock ? *customClock : systemClock),
+      registry(clock),
+      mainTimer(registry.Add(DEFAULT_TIMER_NAME)),
+      core(registry.Core(mainTimer)),
+      wakeupScheduler(clock),
+      offWorkspace(false),
+      notification(clock),
+      settingsWriter(SETTINGS_FILE),
+      idlePause(registry, mainTimer),
+      cues(audio, core) {
     
     // Nilai default untuk pengaturan
     focusDuration = 25;
     breakDuration = 5;
     darkMode = false;
     soundEnabled = true;
-    completedSessions = 0;
-    notificationDialog = nullptr;
+    tickingSound = false;
+    idlePauseEnabled = true;
+    idlePauseMinutes = DEFAULT_IDLE_PAUSE_MINUTES;
+    trayMode = false;
+    trayIcon = nullptr;
+    displayValid = false;
+    appliedTheme = -1;
+    alarmSound = nullptr;
+    deferredStarted = false;
+    pendingStartupTasks = 0;
+    exitAfterStartup = false;
+    tickDueNs = -1;
+    mirrorMode = false;
+    BuildLabelTables();
+    
+    StartupProfiler& profiler = GetStartupProfiler();
     
     // Mencoba memuat pengaturan dari file
     LoadSettings();
+    core.SetDurations(focusDuration, breakDuration);
+    cues.SetEnabled(soundEnabled, tickingSound);
+    
+    // Instance pertama menjadi pemilik state; instance berikutnya hanya
+    // menampilkan state pemilik
+    mirrorMode = !BecomeOwner();
+    if (!mirrorMode) {
+        OpenSessionFiles();
+    }
+    profiler.Mark("settings");
     
     // Inisialisasi timer
     timer = new wxTimer(this, ID_TIMER);
-    notificationTimer = new wxTimer(this, ID_NOTIFICATION_TIMER);
-    
-    // Inisialisasi suara alarm
-    alarmSound = new wxSound("alarm.wav");
     
     // Membuat GUI
     CreateControls();
     
-    // Set icon and pos
+    // Set pos; ikon dan suara alarm dimuat setelah paint pertama
     Centre();
     statusBar = CreateStatusBar();
     statusBar->SetStatusText("Status: Siap");
-
-    wxIcon appIcon;
-    if (wxFileExists("resources/pomodoro.ico")) {
-        appIcon.LoadFile("resources/pomodoro.ico", wxBITMAP_TYPE_ICO);
-        if (appIcon.IsOk()) {
-            SetIcon(appIcon);
-        }
-    }
     
     // Terapkan tema
     ApplyTheme();
+    profiler.Mark("controls");
     
     // Set initial timer display
-    remainingSeconds = focusDuration * 60;
+    core.SetListener(this);
     UpdateTimerDisplay();
+    if (mirrorMode) {
+        EnterMirrorMode();
+    } else {
+        StartOwnerServices();
+    }
+    profiler.Mark("construct");
 }
 
 // Destruktor
 PomodoroFrame::~PomodoroFrame() {
+    sharedWatcher.Stop();
+    idleMonitor.Stop();
+    hooks.Stop();
+    if (assetLoader.joinable()) {
+        assetLoader.join();
+    }
+    audio.Stop();
+    controlServer.Stop();
+    core.SetListener(nullptr);
+    delete trayIcon;
     delete timer;
-    delete notificationTimer;
     delete alarmSound;
-    
-    if (notificationDialog) {
-        notificationDialog->Destroy();
-    }
 }
 
 // Metode untuk membuat kontrol GUI - disederhanakan
@@ -96,14 +153,8 @@ void PomodoroFrame::CreateControls() {
     wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
     
     // ----- AREA TIMER -----
-    // Timer display
-    timerDisplay = new wxStaticText(mainPanel, wxID_ANY, "25:00", 
-                                  wxDefaultPosition, wxDefaultSize,
-                                  wxALIGN_CENTRE_HORIZONTAL);
-    wxFont timerFont = timerDisplay->GetFont();
-    timerFont.SetPointSize(42);
-    timerFont.SetWeight(wxFONTWEIGHT_BOLD);
-    timerDisplay->SetFont(timerFont);
+    // Timer display dan progress bar, digambar sendiri dari cache glyph
+    timerDisplay = new TimerDisplayCtrl(mainPanel, wxID_ANY, 42);
     
     // State display
     stateDisplay = new wxStaticText(mainPanel, wxID_ANY, "SIAP", 
@@ -113,13 +164,14 @@ void PomodoroFrame::CreateControls() {
     stateFont.SetPointSize(12);
     stateDisplay->SetFont(stateFont);
     
-    // Progress bar
-    progressBar = new wxGauge(mainPanel, wxID_ANY, 100, 
-                            wxDefaultPosition, wxSize(300, 15));
+    // Instrumentasi paint/size pada widget yang diperbarui per tick
+    timerDisplay->Bind(wxEVT_PAINT, &PomodoroFrame::OnDisplayPaint, this);
+    stateDisplay->Bind(wxEVT_PAINT, &PomodoroFrame::OnDisplayPaint, this);
+    timerDisplay->Bind(wxEVT_SIZE, &PomodoroFrame::OnDisplaySize, this);
+    stateDisplay->Bind(wxEVT_SIZE, &PomodoroFrame::OnDisplaySize, this);
     
     mainSizer->Add(timerDisplay, 0, wxALIGN_CENTER | wxALL, 5);
     mainSizer->Add(stateDisplay, 0, wxALIGN_CENTER | wxALL, 3);
-    mainSizer->Add(progressBar, 0, wxALIGN_CENTER | wxALL, 8);
     
     // ----- AREA TOMBOL -----
     wxBoxSizer* buttonSizer = new wxBoxSizer(wxHORIZONTAL);
@@ -139,6 +191,32 @@ void PomodoroFrame::CreateControls() {
     
     mainSizer->Add(buttonSizer, 0, wxALIGN_CENTER | wxALL, 10);
     
+    // ----- AREA TASK -----
+    wxStaticBox* taskBox = new wxStaticBox(mainPanel, wxID_ANY, "Task");
+    wxStaticBoxSizer* taskSizer = new wxStaticBoxSizer(taskBox, wxVERTICAL);
+    
+    // Hasil dicari ulang setiap ketikan; Enter memilih judul yang sama
+    // persis atau membuat task baru
+    wxBoxSizer* taskSearchSizer = new wxBoxSizer(wxHORIZONTAL);
+    taskSearch = new wxTextCtrl(mainPanel, ID_TASK_SEARCH, wxEmptyString,
+                                wxDefaultPosition, wxDefaultSize, wxTE_PROCESS_ENTER);
+    taskSearch->SetHint("Cari atau buat task (Enter)");
+    taskDoneButton = new wxButton(mainPanel, ID_TASK_DONE, "Selesai");
+    taskDoneButton->SetToolTip("Tandai task aktif selesai");
+    taskDoneButton->Disable();
+    
+    taskSearchSizer->Add(taskSearch, 1, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    taskSearchSizer->Add(taskDoneButton, 0, wxALIGN_CENTER_VERTICAL);
+    
+    taskResults = new wxListBox(mainPanel, ID_TASK_RESULTS, wxDefaultPosition, wxSize(-1, 90));
+    taskText = new wxStaticText(mainPanel, wxID_ANY, "Tanpa task");
+    
+    taskSizer->Add(taskSearchSizer, 0, wxEXPAND | wxALL, 5);
+    taskSizer->Add(taskResults, 0, wxEXPAND | wxLEFT | wxRIGHT, 5);
+    taskSizer->Add(taskText, 0, wxALL, 5);
+    
+    mainSizer->Add(taskSizer, 0, wxEXPAND | wxLEFT | wxRIGHT, 10);
+    
     // ----- AREA PENGATURAN -----
     wxStaticBox* settingsBox = new wxStaticBox(mainPanel, wxID_ANY, "Pengaturan");
     wxStaticBoxSizer* settingsSizer = new wxStaticBoxSizer(settingsBox, wxVERTICAL);
@@ -190,10 +268,51 @@ void PomodoroFrame::CreateControls() {
     soundToggle->SetValue(soundEnabled);
     soundToggle->SetBackgroundColour(wxColour(160, 160, 150));
     
+    // Detak selama sesi
+    wxStaticText* tickingLabel = new wxStaticText(mainPanel, wxID_ANY, "Detak:");
+    wxToggleButton* tickingToggle = new wxToggleButton(mainPanel, ID_TICKING_TOGGLE, 
+                                    tickingSound ? "ON" : "OFF",
+                                    wxDefaultPosition, wxSize(70, -1));
+    tickingToggle->SetValue(tickingSound);
+    tickingToggle->SetBackgroundColour(wxColour(160, 160, 150));
+    tickingToggle->SetToolTip("Suara detak selama sesi (cue_tick.wav)");
+    
+    // Jeda fokus otomatis saat tidak ada input
+    wxStaticText* idleLabel = new wxStaticText(mainPanel, wxID_ANY, "Jeda otomatis:");
+    wxToggleButton* idleToggle = new wxToggleButton(mainPanel, ID_IDLE_TOGGLE, 
+                                    idlePauseEnabled ? "ON" : "OFF",
+                                    wxDefaultPosition, wxSize(70, -1));
+    idleToggle->SetValue(idlePauseEnabled);
+    idleToggle->SetBackgroundColour(wxColour(160, 160, 150));
+    idleToggle->SetToolTip(wxString::Format(
+        "Jeda sesi fokus setelah %d menit tanpa aktivitas, lanjut saat Anda kembali",
+        idlePauseMinutes));
+    
     toggleSizer->Add(themeLabel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
     toggleSizer->Add(themeToggle, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 15);
     toggleSizer->Add(soundLabel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
-    toggleSizer->Add(soundToggle, 0, wxALIGN_CENTER_VERTICAL);
+    toggleSizer->Add(soundToggle, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 15);
+    toggleSizer->Add(tickingLabel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    toggleSizer->Add(tickingToggle, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 15);
+    toggleSizer->Add(idleLabel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    toggleSizer->Add(idleToggle, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 15);
+    
+    // Ikon countdown di tray
+    wxStaticText* trayLabel = new wxStaticText(mainPanel, wxID_ANY, "Tray:");
+    trayToggle = new wxToggleButton(mainPanel, ID_TRAY_TOGGLE, 
+                                    trayMode ? "ON" : "OFF",
+                                    wxDefaultPosition, wxSize(70, -1));
+    trayToggle->SetValue(trayMode);
+    trayToggle->SetBackgroundColour(wxColour(160, 160, 150));
+    if (wxTaskBarIcon::IsAvailable()) {
+        trayToggle->SetToolTip("Sisa menit di ikon tray; minimize menyembunyikan jendela ke tray");
+    } else {
+        trayToggle->SetToolTip("Tray sistem tidak tersedia");
+        trayToggle->Disable();
+    }
+    
+    toggleSizer->Add(trayLabel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    toggleSizer->Add(trayToggle, 0, wxALIGN_CENTER_VERTICAL);
     
     settingsSizer->Add(toggleSizer, 0, wxALIGN_CENTER | wxALL, 5);
     
@@ -202,68 +321,211 @@ void PomodoroFrame::CreateControls() {
     // ----- STATISTIK -----
     wxBoxSizer* statsSizer = new wxBoxSizer(wxHORIZONTAL);
     
+    StatsSummary summary = stats.Summarize(clock.WallNowMs());
     wxStaticText* statsLabel = new wxStaticText(mainPanel, wxID_ANY, "Statistik:");
     statsText = new wxStaticText(mainPanel, wxID_ANY, 
-                               wxString::Format("Sesi selesai: %d", completedSessions));
+                               wxString::FromUTF8(SessionStats::FormatSummary(
+                                   summary, core.GetCompletedSessions()).c_str()));
     
     statsSizer->Add(statsLabel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 10);
     statsSizer->Add(statsText, 0, wxALIGN_CENTER_VERTICAL);
     
     mainSizer->Add(statsSizer, 0, wxALIGN_CENTER | wxALL, 10);
     
+    // Distribusi menit fokus per jam
+    hourText = new wxStaticText(mainPanel, wxID_ANY, 
+                              wxString::FromUTF8(SessionStats::FormatHourHistogram(summary).c_str()));
+    hourText->SetToolTip("Menit fokus menurut jam mulai (00-23)");
+    
+    mainSizer->Add(hourText, 0, wxALIGN_CENTER | wxLEFT | wxRIGHT | wxBOTTOM, 10);
+    
     mainPanel->SetSizer(mainSizer);
     mainSizer->Fit(this);
 }
 
-// Format waktu display
-wxString PomodoroFrame::FormatTimeDisplay(int seconds) {
-    int mins = seconds / 60;
-    int secs = seconds % 60;
-    return wxString::Format("%02d:%02d", mins, secs);
+// Teks tetap untuk jalur tick. wxString di tabel hanya dirujuk atau
+// disalin ke string yang kapasitasnya sudah cukup, sehingga tick tidak
+// mengalokasi memori
+void PomodoroFrame::BuildLabelTables() {
+    for (int state = 0; state < TIMER_STATE_COUNT; ++state) {
+        const char* label = StateLabel(static_cast<TimerState>(state));
+        stateLabels[state] = label;
+        statusLabels[state] = wxString::Format("Status: %s", label);
+    }
+    for (int seconds = 0; seconds <= TRANSITION_SECONDS; ++seconds) {
+        countdownLabels[0][seconds] = wxString::Format("Waktu istirahat berjalan: %d detik", seconds);
+        countdownLabels[1][seconds] = wxString::Format("Fokus dimulai dalam: %d detik", seconds);
+    }
 }
 
 // Update timer display
+// Hanya widget yang nilainya berubah yang disentuh; jika lebih dari satu,
+// perubahan digabung dalam satu Freeze/Thaw. Yang dibekukan frame, bukan
+// mainPanel, karena status bar anak frame dan ikut berubah bersama state.
 void PomodoroFrame::UpdateTimerDisplay() {
-    timerDisplay->SetLabel(FormatTimeDisplay(remainingSeconds));
+    ScopedTrace trace(TRACE_UPDATE_DISPLAY);
+    UpdateTrayIcon();
+    DisplayState display;
+    double progress;
+    if (mirrorMode) {
+        int64_t now = clock.NowMs();
+        display = BuildDisplayState(mirror, now);
+        progress = mirror.ProgressFraction(now);
+    } else {
+        display = BuildDisplayState(core);
+        progress = core.ProgressFraction();
+    }
+    unsigned changed = displayValid ? DiffDisplayState(lastDisplay, display) : FIELD_ALL;
+    uiCounters.updates++;
+    
+    // Progress tidak dibulatkan ke persen: ujung bar bergeser per
+    // seperempat piksel, dan hanya kolom itu yang digambar ulang
+    if (timerDisplay->SetProgress(progress)) {
+        uiCounters.valueSets++;
+    }
+    changed &= ~FIELD_PROGRESS;
+    if (changed == 0) {
+        lastDisplay = display;
+        return;
+    }
+    
+    // Perubahan state sendiri sudah menyentuh dua widget
+    bool batch = (changed & (changed - 1)) != 0 || (changed & FIELD_STATE) != 0;
+    if (batch) {
+        Freeze();
+        uiCounters.freezes++;
+    }
     
-    // Update state text dan progress bar
-    wxString stateText;
-    int progress = 0;
+    if (changed & FIELD_TIME) {
+        timerDisplay->SetTime(display.timeText);
+        uiCounters.labelSets++;
+    }
+    if (changed & FIELD_STATE) {
+        stateDisplay->SetLabel(stateLabels[display.state]);
+        statusBar->SetStatusText(statusLabels[display.state]);
+        uiCounters.labelSets += 2;
+    }
+    if (batch) {
+        Thaw();
+    }
     
-    switch (timerState) {
+    lastDisplay = display;
+    displayValid = true;
+}
+
+// Aktif/nonaktif tombol sesuai state
+void PomodoroFrame::UpdateButtons() {
+    switch (DisplayedState()) {
         case READY:
-            stateText = "SIAP";
-            progress = 0;
+            startButton->Enable();
+            pauseButton->Disable();
+            resetButton->Disable();
             break;
         case RUNNING_FOCUS:
-            stateText = "FOKUS";
-            progress = 100 - (remainingSeconds * 100 / (focusDuration * 60));
-            break;
         case RUNNING_BREAK:
-            stateText = "ISTIRAHAT";
-            progress = 100 - (remainingSeconds * 100 / (breakDuration * 60));
+            startButton->Disable();
+            pauseButton->Enable();
+            resetButton->Enable();
             break;
         case PAUSED_FOCUS:
-            stateText = "JEDA (FOKUS)";
-            break;
         case PAUSED_BREAK:
-            stateText = "JEDA (ISTIRAHAT)";
+            startButton->Enable();
+            pauseButton->Disable();
+            resetButton->Enable();
             break;
     }
-    
-    stateDisplay->SetLabel(stateText);
-    progressBar->SetValue(progress);
-    statusBar->SetStatusText(wxString::Format("Status: %s", stateText));
+}
+
+// Update statistik dari bucket yang sudah teragregasi (tanpa scan riwayat)
+void PomodoroFrame::UpdateStatsText() {
+    StatsSummary summary = stats.Summarize(clock.WallNowMs());
+    statsText->SetLabel(wxString::FromUTF8(
+        SessionStats::FormatSummary(summary, core.GetCompletedSessions()).c_str()));
+    hourText->SetLabel(wxString::FromUTF8(SessionStats::FormatHourHistogram(summary).c_str()));
+    mainPanel->Layout();
+}
+
+// Buka daftar task dan hitung ulang rollup dari jurnal. Task aktif yang
+// tidak ada lagi di daftar dilepas.
+void PomodoroFrame::LoadTasks() {
+    if (!tasks.Open(TASKS_FILE)) {
+        wxLogWarning("Tidak dapat membuka %s", TASKS_FILE);
+    }
+    tasks.RebuildRollups(journal.Records(), journal.Size());
+    if (!tasks.Find(core.GetTaskId())) {
+        core.SetTaskId(0);
+    }
+    ShowActiveTask();
+    RefreshTaskResults();
+}
+
+// Isi daftar hasil dari query saat ini; query kosong menampilkan task
+// terbaru. Hanya beberapa baris yang dibuat, berapa pun jumlah task.
+void PomodoroFrame::RefreshTaskResults() {
+    const size_t limit = 8;
+    std::string query(taskSearch->GetValue().utf8_str());
+    tasks.Search(query, limit, taskMatches);
+    
+    wxArrayString items;
+    int selection = wxNOT_FOUND;
+    for (size_t i = 0; i < taskMatches.size(); ++i) {
+        const Task* task = tasks.Find(taskMatches[i].id);
+        items.Add(wxString::FromUTF8(task->title.c_str()));
+        if (task->id == core.GetTaskId()) {
+            selection = static_cast<int>(i);
+        }
+    }
+    taskResults->Freeze();
+    taskResults->Set(items);
+    taskResults->SetSelection(selection);
+    taskResults->Thaw();
+}
+
+// Sesi fokus berikutnya (dan yang sedang berjalan, karena task dibaca
+// saat record sesi dibuat) ditautkan ke task ini; 0 = tanpa task
+void PomodoroFrame::SelectTask(uint32_t id) {
+    core.SetTaskId(id);
+    ShowActiveTask();
+    SaveSettings();
+}
+
+// Judul task aktif dan rollup waktu fokusnya
+void PomodoroFrame::ShowActiveTask() {
+    const Task* task = tasks.Find(core.GetTaskId());
+    if (task) {
+        taskText->SetLabel(wxString::FromUTF8(
+            (task->title + " - " + TaskStore::FormatRollup(*task)).c_str()));
+    } else {
+        taskText->SetLabel("Tanpa task");
+    }
+    taskDoneButton->Enable(task != nullptr && !mirrorMode);
+    mainPanel->Layout();
 }
 
 // Apply theme
 void PomodoroFrame::ApplyTheme() {
+    ScopedTrace trace(TRACE_APPLY_THEME);
+    // Lewati jika tema yang sama sudah diterapkan
+    if (appliedTheme == (darkMode ? 1 : 0)) {
+        return;
+    }
+    appliedTheme = darkMode ? 1 : 0;
+    
+    // Semua perubahan warna digabung, lalu satu kali repaint
+    mainPanel->Freeze();
+    uiCounters.freezes++;
+    
     if (darkMode) {
         // Light mode
         mainPanel->SetBackgroundColour(wxColour(250, 250, 250));
-        timerDisplay->SetForegroundColour(wxColour(20, 20, 20));
+        timerDisplay->SetColours(wxColour(20, 20, 20), wxColour(250, 250, 250),
+                                 wxColour(220, 220, 220), wxColour(100, 150, 200));
+        trayStyle = { { 20, 20, 20 }, { 250, 250, 250 }, { 220, 220, 220 },
+                      { 100, 150, 200 }, { 130, 170, 220 } };
         stateDisplay->SetForegroundColour(wxColour(80, 80, 80));
         statsText->SetForegroundColour(wxColour(0, 0, 0));
+        hourText->SetForegroundColour(wxColour(0, 0, 0));
+        taskText->SetForegroundColour(wxColour(0, 0, 0));
         themeToggle->SetLabel("Light");
         startButton->SetBackgroundColour(wxColour(100, 150, 200));  // Biru
         startButton->SetForegroundColour(wxColour(255, 255, 255));
@@ -276,9 +538,14 @@ void PomodoroFrame::ApplyTheme() {
 } else {
         // krem mode
         mainPanel->SetBackgroundColour(wxColour(250, 245, 230)); // Warna krem yang lembut
-        timerDisplay->SetForegroundColour(wxColour(70, 50, 30)); // Warna teks coklat gelap
+        timerDisplay->SetColours(wxColour(70, 50, 30), wxColour(250, 245, 230), // Warna teks coklat gelap
+                                 wxColour(225, 215, 195), wxColour(180, 140, 100));
+        trayStyle = { { 70, 50, 30 }, { 250, 245, 230 }, { 225, 215, 195 },
+                      { 180, 140, 100 }, { 130, 170, 220 } };
         stateDisplay->SetForegroundColour(wxColour(100, 80, 60)); // Warna teks coklat medium
         statsText->SetForegroundColour(wxColour(80, 60, 40)); // Warna teks coklat
+        hourText->SetForegroundColour(wxColour(80, 60, 40));
+        taskText->SetForegroundColour(wxColour(80, 60, 40));
         themeToggle->SetLabel("Krem");
         themeToggle->SetBackgroundColour(wxColour(160, 160, 150));
 
@@ -292,17 +559,15 @@ void PomodoroFrame::ApplyTheme() {
         resetButton->SetForegroundColour(wxColour(255, 255, 255));
     }
     
+    mainPanel->Thaw();
     mainPanel->Refresh();
+    ConfigureTrayIcon();
 }
 
-// Simplifikasi dialog notifikasi
+// Isi dialog notifikasi untuk sesi yang baru selesai; jendelanya sendiri
+// tidak dibuat ulang
 void PomodoroFrame::ShowNotificationDialog(bool isFocusCompleted) {
-    // Tutup dialog lama jika ada
-    if (notificationDialog) {
-        notificationDialog->Destroy();
-        notificationDialog = nullptr;
-    }
-    
+    ScopedTrace trace(TRACE_SHOW_NOTIFICATION);
     wxString title, message;
     wxColour bgColor;
     
@@ -313,9 +578,6 @@ void PomodoroFrame::ShowNotificationDialog(bool isFocusCompleted) {
             "Cobalah untuk minum dan beristirahat selama %d menit.",
             focusDuration, breakDuration);
         bgColor = wxColour(100, 150, 200); // Biru
-        
-        // Mulai countdown untuk notifikasi istirahat - menggunakan durasi istirahat
-        notificationCountdownSeconds = 5; // Gunakan 5 detik saja untuk transisi
     } else {
         title = "Waktu Istirahat Selesai";
         message = wxString::Format(
@@ -323,228 +585,708 @@ void PomodoroFrame::ShowNotificationDialog(bool isFocusCompleted) {
             "Kembali ke sesi fokus selama %d menit.",
             breakDuration, focusDuration);
         bgColor = wxColour(130, 170, 220); // Biru lebih terang
-        
-        // Mulai countdown untuk kembali ke fokus - selalu 5 detik
-        notificationCountdownSeconds = 5;
     }
     
-    // Buat dialog notifikasi sederhana
-    notificationDialog = new wxDialog(this, wxID_ANY, title, 
-                                    wxDefaultPosition, wxSize(320, 180),
-                                    wxDEFAULT_DIALOG_STYLE | wxSTAY_ON_TOP);
-    
-    wxPanel* panel = new wxPanel(notificationDialog);
-    panel->SetBackgroundColour(bgColor);
-    
-    wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
-    
-    // Pesan teks
-    wxStaticText* messageText = new wxStaticText(panel, wxID_ANY, message,
-                                              wxDefaultPosition, wxDefaultSize,
-                                              wxALIGN_CENTRE_HORIZONTAL);
-    messageText->SetForegroundColour(wxColour(255, 255, 255));
-    
     // Countdown text
     wxString countdownLabel = isFocusCompleted ? 
                              "Istirahat dimulai dalam:" : 
                              "Fokus dimulai dalam:";
-    
-    notificationCountdown = new wxStaticText(panel, wxID_ANY, 
-                                          wxString::Format("%s %d detik", 
-                                          countdownLabel, notificationCountdownSeconds),
-                                          wxDefaultPosition, wxDefaultSize,
-                                          wxALIGN_CENTRE_HORIZONTAL);
-    notificationCountdown->SetForegroundColour(wxColour(255, 255, 255));
-    
-    sizer->Add(messageText, 0, wxALIGN_CENTER | wxALL | wxEXPAND, 15);
-    sizer->Add(notificationCountdown, 0, wxALIGN_CENTER | wxALL, 10);
-    
-    panel->SetSizer(sizer);
-    
-    wxBoxSizer* dialogSizer = new wxBoxSizer(wxVERTICAL);
-    dialogSizer->Add(panel, 1, wxEXPAND);
-    notificationDialog->SetSizer(dialogSizer);
-    
-    notificationDialog->Centre();
-    notificationDialog->Show();
-    
-    // Mulai timer notifikasi untuk countdown
-    notificationTimer->Start(1000);
+    wxString countdown = wxString::Format("%s %d detik",
+                                          countdownLabel, core.TransitionSecondsLeft());
+    
+    // Biasanya sudah dibuat saat startup bertahap; Create() tidak berbuat
+    // apa-apa kecuali sesi selesai sebelum itu
+    notification.Create(this);
+    notification.Show(title, message, countdown, bgColor, core.CompletedDeadlineMs());
+    
+    const LatencyRecorder& latency = notification.ShowLatency();
+    if (latency.LastMs() > latency.BudgetMs()) {
+        wxLogVerbose("Notifikasi terlambat %.0f ms dari deadline (anggaran %.0f ms)",
+                     latency.LastMs(), latency.BudgetMs());
+    }
 }
 
-// Fungsi untuk memulai sesi fokus
-void PomodoroFrame::StartFocusSession() {
-    timerState = RUNNING_FOCUS;
-    remainingSeconds = focusDuration * 60;
-    
-    // Update UI
-    startButton->Disable();
-    pauseButton->Enable();
-    resetButton->Enable();
-    
-    // Update tampilan dan mulai timer
-    UpdateTimerDisplay();
-    timer->Start(1000);
+// Sembunyikan dialog notifikasi
+void PomodoroFrame::CloseNotificationDialog() {
+    notification.Hide();
 }
 
-// Fungsi untuk memulai sesi istirahat
-void PomodoroFrame::StartBreakSession() {
-    timerState = RUNNING_BREAK;
-    remainingSeconds = breakDuration * 60;
-    
-    // Update UI
-    startButton->Disable();
-    pauseButton->Enable();
-    resetButton->Enable();
-    
-    // Update tampilan dan mulai timer
-    UpdateTimerDisplay();
-    timer->Start(1000);
+
+// Jadwalkan wakeup berikutnya: batas detik saat countdown terlihat,
+// atau langsung ke deadline saat jendela tersembunyi. Timer bernama lain
+// di registry, isyarat satu menit dan pergantian frame ikon tray ikut
+// dilayani oleh wakeup yang sama.
+void PomodoroFrame::ScheduleNextTick() {
+    if (mirrorMode) {
+        ScheduleMirrorTick();
+        return;
+    }
+    int64_t delay = wakeupScheduler.NextDelayMs(core);
+    int64_t now = clock.NowMs();
+    int64_t trayDelay = TrayDelayMs();
+    const int64_t deadlines[] = { registry.NextDeadlineMs(), cues.NextCueMs(),
+                                  trayDelay >= 0 ? now + trayDelay : -1,
+                                  WorkspaceRecheckMs(now) };
+    for (int64_t deadline : deadlines) {
+        if (deadline < 0) {
+            continue;
+        }
+        int64_t deadlineDelay = deadline > now ? deadline - now : 0;
+        if (delay < 0 || deadlineDelay < delay) {
+            delay = deadlineDelay;
+        }
+    }
+    if (delay < 0) {
+        timer->Stop();
+        tickDueNs = -1;
+        return;
+    }
+    int interval = delay > 0 ? static_cast<int>(delay) : 1;
+    timer->StartOnce(interval);
+    Tracer& tracer = GetTracer();
+    tickDueNs = tracer.IsEnabled() ? tracer.NowNs() + interval * 1000000LL : -1;
 }
 
-// Fungsi untuk menyelesaikan sesi
-void PomodoroFrame::CompleteSession() {
-    bool wasFocusSession = (timerState == RUNNING_FOCUS);
-    
-    if (wasFocusSession) {
-        // Update statistik
-        completedSessions++;
-        statsText->SetLabel(wxString::Format("Sesi selesai: %d", completedSessions));
-        SaveSettings();
+// Countdown dianggap terlihat jika frame tampil, tidak diminimalkan dan
+// ada di workspace yang sedang tampil, atau dialog notifikasi sedang
+// menghitung mundur. Pindah workspace tidak memicu event wx, jadi ini juga
+// dipanggil dari tick, paint dan aktivasi jendela.
+void PomodoroFrame::UpdateVisibility() {
+    bool shown = IsShown() && !IsIconized();
+    offWorkspace = shown && !IsOnCurrentWorkspace();
+    bool visible = (shown && !offWorkspace) || notification.IsShown();
+    if (visible == wakeupScheduler.IsVisible()) {
+        return;
     }
     
-    // Hentikan timer terlebih dahulu
-    timer->Stop();
-    
-    // Mainkan suara alarm jika diaktifkan
-    if (soundEnabled && alarmSound->IsOk()) {
-        alarmSound->Play(wxSOUND_ASYNC);
+    wakeupScheduler.SetVisible(visible);
+    if (visible) {
+        // Susul tampilan yang tertinggal selama tersembunyi
+        registry.Poll(mainTimer);
+        UpdateTimerDisplay();
     }
-    
-    // Tampilkan dialog notifikasi untuk kedua jenis sesi
-    ShowNotificationDialog(wasFocusSession);
-    
-    // Jangan langsung mulai sesi berikutnya - tunggu sampai notifikasi selesai
-    // Peralihan ke sesi berikutnya akan ditangani oleh OnNotificationTimer
-    // saat countdown notifikasi selesai
-    
-    // Jangan mulai istirahat atau fokus di sini, 
-    // biar ditangani oleh OnNotificationTimer saja
+    ScheduleNextTick();
+}
+
+// Jendela top-level untuk WorkspaceProbe; platform tanpa dukungan selalu
+// dianggap ada di workspace yang tampil
+bool PomodoroFrame::IsOnCurrentWorkspace() {
+#if defined(__WXMSW__)
+    return workspace.IsOnCurrentWorkspace(nullptr, reinterpret_cast<uintptr_t>(GetHWND()),
+                                          clock.NowMs());
+#elif defined(POMODORO_HAVE_GDK_X11) && defined(__WXGTK3__)
+    GdkWindow* window = GetHandle() ? gtk_widget_get_window(GetHandle()) : nullptr;
+    if (!window || !GDK_IS_X11_WINDOW(window)) {
+        // Wayland: tidak ada cara melihat workspace jendela
+        return true;
+    }
+    // Jendela bisa hilang di server sebelum wx tahu; BadWindow diabaikan
+    gdk_error_trap_push();
+    bool onCurrent = workspace.IsOnCurrentWorkspace(GDK_WINDOW_XDISPLAY(window),
+                                                    GDK_WINDOW_XID(window), clock.NowMs());
+    gdk_error_trap_pop_ignored();
+    return onCurrent;
+#else
+    return true;
+#endif
+}
+
+// Selama frame di workspace lain, cek ulang sesekali: kembali ke workspace
+// itu tidak selalu memicu paint (cloaking DWM), dan tanpa wakeup ini
+// countdown yang tidak jalan tidak akan pernah dicek lagi
+int64_t PomodoroFrame::WorkspaceRecheckMs(int64_t now) const {
+    return offWorkspace && !wakeupScheduler.IsVisible() ? now + WorkspaceProbe::RECHECK_MS : -1;
 }
 
 // Event handler: Timer start
+// Perintah dari pengguna membatalkan lanjut otomatis dari jeda karena diam
 void PomodoroFrame::OnStartTimer(wxCommandEvent& event) {
-    if (timerState == READY) {
-        StartFocusSession();
-    } else if (timerState == PAUSED_FOCUS || timerState == PAUSED_BREAK) {
-        // Resume timer
-        timerState = (timerState == PAUSED_FOCUS) ? RUNNING_FOCUS : RUNNING_BREAK;
-        startButton->Disable();
-        pauseButton->Enable();
-        timer->Start(1000);
-        UpdateTimerDisplay();
+    if (mirrorMode) {
+        ForwardCommand(CONTROL_START);
+        return;
     }
+    idlePause.Forget();
+    registry.Start(mainTimer);
 }
 
 // Event handler: Timer pause
 void PomodoroFrame::OnPauseTimer(wxCommandEvent& event) {
-    if (timerState == RUNNING_FOCUS || timerState == RUNNING_BREAK) {
-        // Pause timer
-        timerState = (timerState == RUNNING_FOCUS) ? PAUSED_FOCUS : PAUSED_BREAK;
-        timer->Stop();
-        startButton->Enable();
-        pauseButton->Disable();
-        UpdateTimerDisplay();
+    if (mirrorMode) {
+        ForwardCommand(CONTROL_PAUSE);
+        return;
     }
+    idlePause.Forget();
+    registry.Pause(mainTimer);
 }
 
 // Event handler: Timer reset
 void PomodoroFrame::OnResetTimer(wxCommandEvent& event) {
-    // Stop semua timer
-    timer->Stop();
-    if (notificationTimer->IsRunning()) {
-        notificationTimer->Stop();
-    }
-    
-    // Reset ke keadaan awal
-    timerState = READY;
-    remainingSeconds = focusDuration * 60;
-    
-    // Update UI
-    startButton->Enable();
-    pauseButton->Disable();
-    resetButton->Disable();
-    UpdateTimerDisplay();
-    
-    // Tutup dialog notifikasi jika ada
-    if (notificationDialog) {
-        notificationDialog->Destroy();
-        notificationDialog = nullptr;
+    if (mirrorMode) {
+        ForwardCommand(CONTROL_RESET);
+        return;
     }
+    idlePause.Forget();
+    registry.Reset(mainTimer);
 }
 
 // Event handler: Timer tick
-// Event handler: Timer tick
+// Sisa waktu dihitung dari deadline oleh TimerCore, sehingga tick yang
+// terlambat atau tergabung tidak membuat sesi lebih panjang
 void PomodoroFrame::OnTimer(wxTimerEvent& event) {
-    if (remainingSeconds > 0) {
-        remainingSeconds--;
+    Tracer& tracer = GetTracer();
+    if (tickDueNs >= 0 && tracer.IsEnabled()) {
+        tracer.RecordTickLateness(tracer.NowNs() - tickDueNs);
+    }
+    ScopedTrace trace(TRACE_ON_TIMER);
+    wakeupScheduler.RecordWakeup();
+    UpdateVisibility();
+    if (mirrorMode) {
+        // Sisa waktu dihitung dari deadline pemilik; tanpa akses segmen
         UpdateTimerDisplay();
+        if (mirror.inTransition) {
+            int secondsLeft = mirror.TransitionSecondsLeft(clock.NowMs());
+            if (secondsLeft <= TRANSITION_SECONDS) {
+                statusBar->SetStatusText(countdownLabels[mirror.focusCompleted ? 0 : 1][secondsLeft]);
+            }
+        }
+        ScheduleMirrorTick();
+        return;
+    }
+    // Status timer bernama yang deadline-nya lewat diterbitkan ulang
+    if (registry.Advance() > 0 && registry.Size() > 1) {
+        controlServer.PublishTimers(registry);
+    }
+    registry.Poll(mainTimer);
+    cues.Poll();
+    ScheduleNextTick();
+}
+
+// TimerCore: state berubah
+void PomodoroFrame::OnStateChanged(TimerState state) {
+    cues.OnStateChanged(state);
+    hooks.OnStateChanged(core);
+    UpdateButtons();
+    UpdateTimerDisplay();
+    ScheduleNextTick();
+    PublishControlStatus();
+}
+
+// TimerCore: angka detik berubah
+void PomodoroFrame::OnTick(int remainingSeconds) {
+    UpdateTimerDisplay();
+    PublishControlStatus();
+}
+
+// TimerCore: sesi selesai
+void PomodoroFrame::OnSessionCompleted(bool wasFocusSession) {
+    hooks.OnSessionCompleted(core, wasFocusSession);
+    if (wasFocusSession) {
+        // Statistik sudah diperbarui lewat OnSessionRecord
+        SaveSettings();
+    }
+    
+    // Mainkan suara alarm jika diaktifkan; wxSound hanya jika AudioEngine
+    // tidak berjalan
+    bool played = cues.OnSessionCompleted(wasFocusSession);
+    if (soundEnabled && !played) {
+        EnsureAlarmSound();
+        if (alarmSound->IsOk()) {
+            alarmSound->Play(wxSOUND_ASYNC);
+        }
+    }
+    
+    // Tampilkan dialog notifikasi untuk kedua jenis sesi
+    // Peralihan ke sesi berikutnya ditangani TimerCore saat masa transisi habis
+    ShowNotificationDialog(wasFocusSession);
+    UpdateVisibility();
+    PublishControlStatus();
+}
+
+// TimerCore: countdown notifikasi
+void PomodoroFrame::OnTransitionTick(int secondsLeft) {
+    if (notification.IsShown() && secondsLeft >= 0 && secondsLeft <= TRANSITION_SECONDS) {
+        // Label berdasarkan jenis sesi yang baru saja selesai
+        notification.SetCountdown(countdownLabels[core.WasFocusCompleted() ? 0 : 1][secondsLeft]);
+    }
+    PublishControlStatus();
+}
+
+// TimerCore: masa transisi selesai atau dibatalkan
+void PomodoroFrame::OnTransitionFinished() {
+    CloseNotificationDialog();
+    UpdateVisibility();
+}
+
+// TimerCore: catatan sesi untuk jurnal
+void PomodoroFrame::OnSessionRecord(const SessionRecord& record) {
+    journal.Append(record);
+    stats.Add(record);
+    UpdateStatsText();
+    tasks.AddSession(record);
+    if (record.taskId != 0 && record.taskId == core.GetTaskId()) {
+        ShowActiveTask();
+    }
+}
+
+// TimerCore: transisi sesi untuk log checkpoint; fsync dikerjakan worker
+void PomodoroFrame::OnCheckpoint(const CheckpointRecord& record) {
+    checkpointLog.Append(record);
+}
+
+// Lanjutkan sesi yang masih berjalan atau dijeda saat aplikasi terakhir
+// mati. Sesi yang habis selama itu tercatat selesai di jurnal.
+void PomodoroFrame::RestoreSession() {
+    CheckpointRecord checkpoint;
+    if (!checkpointLog.GetRecovered(checkpoint) || !IsSessionInFlight(checkpoint)) {
+        return;
+    }
+    if (core.RestoreCheckpoint(checkpoint)) {
+        statusBar->SetStatusText(statusLabels[core.GetState()] + " (dilanjutkan)");
     } else {
-        CompleteSession();
+        SaveSettings();
     }
+    registry.Sync(mainTimer);
+    ScheduleNextTick();
 }
 
-// Event handler: Notification timer tick - diperbaiki untuk kedua jenis notifikasi
-// Event handler: Notification timer tick
-// Event handler: Notification timer tick
-void PomodoroFrame::OnNotificationTimer(wxTimerEvent& event) {
-    if (notificationCountdownSeconds > 0) {
-        notificationCountdownSeconds--;
+// Pekerjaan startup yang tidak dibutuhkan untuk menampilkan timer.
+// Statistik, ikon dan dialog notifikasi dikerjakan di thread GUI pada giliran
+// event berikutnya; file suara dibaca di thread terpisah lalu wxSound dibuat
+// dari memori.
+void PomodoroFrame::StartDeferredLoading() {
+    pendingStartupTasks = 5;
+    UpdateIdleMonitor();
+    
+    assetLoader = std::thread([this]() {
+        // Semua isyarat didekode sekali ke cache PCM jika ada perangkat audio
+        bool audioReady = false;
+        std::unique_ptr<AudioSink> sink = CreateDeviceAudioSink();
+        if (sink && audio.LoadCues() > 0) {
+            audioReady = audio.Start(std::move(sink));
+        }
         
-        if (notificationDialog && notificationCountdown) {
-            wxString countdownLabel;
-            
-            // Tentukan label berdasarkan jenis sesi yang baru saja selesai
-            if (timerState == RUNNING_BREAK) {
-                countdownLabel = "Fokus dimulai dalam:";
-            } else if (timerState == RUNNING_FOCUS) {
-                countdownLabel = "Waktu istirahat berjalan:";
+        std::vector<char> data;
+        FILE* file = audioReady ? nullptr : std::fopen("alarm.wav", "rb");
+        if (file) {
+            char chunk[16384];
+            size_t count;
+            while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+                data.insert(data.end(), chunk, chunk + count);
             }
-            
-            notificationCountdown->SetLabel(wxString::Format("%s %d detik", 
-                                                        countdownLabel, 
-                                                        notificationCountdownSeconds));
+            std::fclose(file);
         }
+        CallAfter([this, audioReady, data = std::move(data)]() mutable {
+            // Bisa saja sudah dimuat paksa oleh EnsureAlarmSound
+            if (!audioReady && !alarmSound) {
+                alarmSoundData.swap(data);
+                alarmSound = new wxSound();
+                if (!alarmSoundData.empty()) {
+                    alarmSound->Create(alarmSoundData.size(), alarmSoundData.data());
+                }
+            }
+            // Detak untuk sesi yang sudah berjalan sebelum mesin siap
+            cues.SetEnabled(soundEnabled, tickingSound);
+            ScheduleNextTick();
+            FinishStartupTask("sound_loaded");
+        });
+    });
+    
+    // Jurnal hanya dibuka instance pemilik; di instance cermin kosong
+    stats.Rebuild(journal.Records(), journal.Size());
+    UpdateStatsText();
+    FinishStartupTask("stats_loaded");
+    
+    // Daftar task bisa berisi ribuan judul; indeksnya dibangun pada
+    // giliran event sendiri
+    CallAfter([this]() {
+        if (!mirrorMode) {
+            LoadTasks();
+        }
+        FinishStartupTask("tasks_loaded");
+    });
+    
+    CallAfter([this]() {
+        LoadAppIcon();
+        UpdateTrayMode();
+        FinishStartupTask("icon_loaded");
+    });
+    
+    // Dialog notifikasi dibuat sekarang agar notifikasi pertama tidak
+    // ikut membayar biaya pembuatan jendela
+    CallAfter([this]() {
+        notification.Create(this);
+        FinishStartupTask("notification_ready");
+    });
+}
+
+void PomodoroFrame::FinishStartupTask(const char* phase) {
+    StartupProfiler& profiler = GetStartupProfiler();
+    profiler.Mark(phase);
+    if (--pendingStartupTasks > 0) {
+        return;
+    }
+    
+    profiler.Mark("startup_complete");
+    if (profiler.IsEnabled()) {
+        std::fputs(profiler.Report().c_str(), stderr);
+    }
+    if (exitAfterStartup) {
+        Close(true);
+    }
+}
+
+void PomodoroFrame::LoadAppIcon() {
+    wxIcon appIcon;
+    if (wxFileExists("resources/pomodoro.ico")) {
+        appIcon.LoadFile("resources/pomodoro.ico", wxBITMAP_TYPE_ICO);
+        if (appIcon.IsOk()) {
+            SetIcon(appIcon);
+        }
+    }
+}
+
+// Pasang atau lepas ikon tray sesuai pengaturan
+void PomodoroFrame::UpdateTrayMode() {
+    bool wanted = trayMode && wxTaskBarIcon::IsAvailable();
+    if (wanted == (trayIcon != nullptr)) {
+        return;
+    }
+    if (wanted) {
+        trayIcon = new TrayIcon(this);
+        ConfigureTrayIcon();
     } else {
-        // Waktu habis
-        notificationTimer->Stop();
-        
-        if (notificationDialog) {
-            notificationDialog->Destroy();
-            notificationDialog = nullptr;
+        trayIcon->RemoveIcon();
+        delete trayIcon;
+        trayIcon = nullptr;
+    }
+    ScheduleNextTick();
+}
+
+// Atlas dirender ulang hanya untuk strip yang warna atau durasinya berubah
+void PomodoroFrame::ConfigureTrayIcon() {
+    if (!trayIcon) {
+        return;
+    }
+    trayIcon->Configure(trayStyle, focusDuration, breakDuration);
+    UpdateTrayIcon();
+}
+
+// Dipanggil bersama UpdateTimerDisplay; hanya mengganti ikon jika frame berubah
+void PomodoroFrame::UpdateTrayIcon() {
+    if (!trayIcon) {
+        return;
+    }
+    if (mirrorMode) {
+        trayIcon->Update(mirror.state, mirror.RemainingMs(clock.NowMs()), mirror.durationMs);
+    } else {
+        trayIcon->Update(core.GetState(), core.RemainingMs(), core.SessionDurationMs());
+    }
+}
+
+int64_t PomodoroFrame::TrayDelayMs() const {
+    if (!trayIcon) {
+        return -1;
+    }
+    if (mirrorMode) {
+        return trayIcon->NextChangeDelayMs(mirror.state, mirror.RemainingMs(clock.NowMs()),
+                                           mirror.durationMs);
+    }
+    return trayIcon->NextChangeDelayMs(core.GetState(), core.RemainingMs(),
+                                       core.SessionDurationMs());
+}
+
+// Suara dibutuhkan sebelum pemuatan latar belakang selesai: muat langsung
+void PomodoroFrame::EnsureAlarmSound() {
+    if (!alarmSound) {
+        alarmSound = new wxSound("alarm.wav");
+    }
+}
+
+// Histogram handler ke stderr dan event terbaru ke file trace Chrome; hanya
+// jika dijalankan dengan --trace
+void PomodoroFrame::DumpTrace() {
+    Tracer& tracer = GetTracer();
+    if (!tracer.IsEnabled()) {
+        return;
+    }
+    std::fputs(tracer.Report().c_str(), stderr);
+    if (!tracer.WriteChromeTrace(tracer.GetOutputPath())) {
+        wxLogWarning("Tidak dapat menulis %s", tracer.GetOutputPath().c_str());
+    }
+}
+
+// ControlServer: perintah dari klien kontrol. Dipanggil di thread I/O, jadi
+// diteruskan ke thread GUI dan dijalankan seperti klik tombol.
+void PomodoroFrame::OnControlCommand(ControlCommand command) {
+    CallAfter([this, command]() { ApplyControlCommand(command); });
+}
+
+void PomodoroFrame::ApplyControlCommand(ControlCommand command) {
+    wxCommandEvent event;
+    switch (command) {
+        case CONTROL_START:
+            OnStartTimer(event);
+            break;
+        case CONTROL_PAUSE:
+            OnPauseTimer(event);
+            break;
+        case CONTROL_RESET:
+            OnResetTimer(event);
+            break;
+        case CONTROL_TRACE:
+            DumpTrace();
+            break;
+        case CONTROL_ADD:
+            // Hanya datang lewat OnTimerCommand
+            break;
+    }
+}
+
+// ControlServer: perintah untuk timer bernama selain timer jendela. Timer
+// itu berbagi wakeup dengan countdown, jadi jadwalnya dihitung ulang.
+void PomodoroFrame::OnTimerCommand(const ControlTimerCommand& command) {
+    CallAfter([this, command]() {
+        ApplyTimerCommand(registry, command);
+        controlServer.PublishTimers(registry);
+        ScheduleNextTick();
+    });
+}
+
+// IdleMonitor: tidak ada input selama idleMs. Sesi fokus dijeda mundur
+// sampai input terakhir, seperti tombol Pause yang ditekan saat itu.
+void PomodoroFrame::OnUserIdle(int64_t idleMs) {
+    CallAfter([this, idleMs]() {
+        if (idlePause.OnUserIdle(idleMs)) {
+            statusBar->SetStatusText(statusLabels[core.GetState()] + " - tidak ada aktivitas");
         }
-        
-        // Tentukan sesi apa yang akan dimulai berdasarkan sesi yang baru saja selesai
-        if (timerState == RUNNING_BREAK) {
-            // Jika istirahat selesai, mulai sesi fokus baru
-            StartFocusSession();
-        } else if (timerState == RUNNING_FOCUS) {
-            // Jika fokus selesai, mulai sesi istirahat
-            StartBreakSession();
+    });
+}
+
+// IdleMonitor: ada input lagi; lanjutkan sesi yang dijeda otomatis
+void PomodoroFrame::OnUserActive() {
+    CallAfter([this]() { idlePause.OnUserActive(); });
+}
+
+// Monitor hanya berjalan saat jeda otomatis aktif; tanpa display X11
+// (atau ekstensi SYNC) fitur ini diam-diam tidak aktif
+void PomodoroFrame::UpdateIdleMonitor() {
+    // Jeda otomatis dijalankan instance pemilik
+    if (!idlePauseEnabled || mirrorMode) {
+        idleMonitor.Stop();
+        idlePause.Forget();
+        return;
+    }
+    if (!idleMonitor.IsRunning() &&
+        !idleMonitor.Start(static_cast<int64_t>(idlePauseMinutes) * 60 * 1000, this)) {
+        wxLogVerbose("Deteksi pengguna diam tidak tersedia");
+    }
+}
+
+// Kirim snapshot state ke endpoint kontrol; format dan fan-out ke
+// pelanggan dikerjakan thread I/O
+void PomodoroFrame::PublishControlStatus() {
+    ControlStatus status;
+    status.state = core.GetState();
+    status.inTransition = core.InTransition();
+    status.remainingMs = core.RemainingMs();
+    status.transitionMs = core.InTransition() ? core.NextDeadlineMs() - clock.NowMs() : 0;
+    status.atMs = clock.NowMs();
+    status.completedSessions = core.GetCompletedSessions();
+    status.focusMinutes = focusDuration;
+    status.breakMinutes = breakDuration;
+    controlServer.Publish(status);
+    sharedPublisher.Publish(CaptureSharedState(core));
+}
+
+// Menjadi pemilik segmen state bersama. false jika instance lain sudah
+// menjadi pemilik; tanpa shared memory instance berjalan sendiri.
+bool PomodoroFrame::BecomeOwner() {
+    return AcquireSharedOwnership(sharedPublisher, DefaultSharedStateName());
+}
+
+// Buka jurnal sesi (riwayat tetap jalan walaupun gagal dibuka) dan log
+// checkpoint. Statistik dihitung ulang setelah paint pertama.
+void PomodoroFrame::OpenSessionFiles() {
+    if (!journal.Open(JOURNAL_FILE)) {
+        wxLogWarning("Tidak dapat membuka %s", JOURNAL_FILE);
+    }
+    if (!checkpointLog.Open(CHECKPOINT_FILE)) {
+        wxLogWarning("Tidak dapat membuka %s", CHECKPOINT_FILE);
+    }
+}
+
+// Lanjutkan sesi dari checkpoint, lalu buka endpoint kontrol (aplikasi
+// tetap jalan walaupun gagal dibuka) dan terbitkan state pertama
+void PomodoroFrame::StartOwnerServices() {
+    RestoreSession();
+    // Sesi yang dipulihkan tidak memicu hook; hanya perubahan berikutnya
+    if (!hooks.IsRunning()) {
+        std::string error;
+        if (!hooks.LoadFile(HOOKS_FILE, error)) {
+            wxLogVerbose("Hook tidak dimuat: %s", error.c_str());
         }
+        hooks.Start();
+    }
+    controlServer.SetListener(this);
+    PublishControlStatus();
+    if (!controlServer.Start(DefaultControlSocketPath())) {
+        wxLogVerbose("Endpoint kontrol tidak aktif: %s", DefaultControlSocketPath().c_str());
     }
 }
 
+// Durasi mengikuti pemilik, jadi slider hanya ditampilkan
+void PomodoroFrame::EnterMirrorMode() {
+    focusSlider->Disable();
+    breakSlider->Disable();
+    taskSearch->Disable();
+    taskResults->Disable();
+    taskDoneButton->Disable();
+    taskText->SetLabel("Task mengikuti instance utama");
+    statusBar->SetStatusText("Status: mengikuti instance utama");
+    if (!sharedWatcher.Start(DefaultSharedStateName(), this)) {
+        wxLogVerbose("State bersama tidak dapat dibaca");
+    }
+}
+
+// Pemilik keluar: instance ini mengambil alih. Sesi yang sedang berjalan
+// dilanjutkan dari log checkpoint yang ditinggalkan pemilik lama.
+void PomodoroFrame::PromoteToOwner() {
+    sharedWatcher.Stop();
+    if (!BecomeOwner()) {
+        // Instance cermin lain lebih dulu mengambil alih
+        sharedWatcher.Start(DefaultSharedStateName(), this);
+        return;
+    }
+    mirrorMode = false;
+    LoadSettings();
+    core.SetDurations(focusDuration, breakDuration);
+    cues.SetEnabled(soundEnabled, tickingSound);
+    ShowDurations();
+    ConfigureTrayIcon();
+    focusSlider->Enable();
+    breakSlider->Enable();
+    OpenSessionFiles();
+    stats.Rebuild(journal.Records(), journal.Size());
+    UpdateStatsText();
+    taskSearch->Enable();
+    taskResults->Enable();
+    
+    displayValid = false;
+    UpdateButtons();
+    UpdateTimerDisplay();
+    StartOwnerServices();
+    // Setelah checkpoint: sesi yang dilanjutkan membawa task-nya sendiri
+    LoadTasks();
+    UpdateIdleMonitor();
+    ScheduleNextTick();
+}
+
+// Snapshot baru dari pemilik; dipanggil di thread GUI
+void PomodoroFrame::ApplyMirrorState(const SharedTimerState& state) {
+    bool durationsChanged = state.focusMinutes != focusDuration ||
+                            state.breakMinutes != breakDuration;
+    bool sessionsChanged = state.completedSessions != core.GetCompletedSessions();
+    mirror = state;
+    if (durationsChanged) {
+        focusDuration = state.focusMinutes;
+        breakDuration = state.breakMinutes;
+        ShowDurations();
+        ConfigureTrayIcon();
+    }
+    if (sessionsChanged) {
+        core.SetCompletedSessions(state.completedSessions);
+        UpdateStatsText();
+    }
+    UpdateButtons();
+    UpdateTimerDisplay();
+    ScheduleMirrorTick();
+}
+
+// Wakeup berikutnya hanya untuk batas detik countdown pemilik saat
+// terlihat, dan untuk frame ikon tray; perubahan state datang lewat
+// SharedStateWatcher
+void PomodoroFrame::ScheduleMirrorTick() {
+    int64_t now = clock.NowMs();
+    int64_t next = wakeupScheduler.IsVisible() ? mirror.NextWakeupMs(now) : -1;
+    int64_t trayDelay = TrayDelayMs();
+    if (trayDelay >= 0 && (next < 0 || now + trayDelay < next)) {
+        next = now + trayDelay;
+    }
+    int64_t recheck = WorkspaceRecheckMs(now);
+    if (recheck >= 0 && (next < 0 || recheck < next)) {
+        next = recheck;
+    }
+    if (next < 0) {
+        timer->Stop();
+        tickDueNs = -1;
+        return;
+    }
+    int interval = next > now ? static_cast<int>(next - now) : 1;
+    timer->StartOnce(interval);
+    Tracer& tracer = GetTracer();
+    tickDueNs = tracer.IsEnabled() ? tracer.NowNs() + interval * 1000000LL : -1;
+}
+
+// Tombol di instance cermin dijalankan oleh pemilik; hasilnya kembali
+// lewat state bersama
+void PomodoroFrame::ForwardCommand(ControlCommand command) {
+    if (!SendControlCommand(DefaultControlSocketPath(), command)) {
+        statusBar->SetStatusText("Status: instance utama tidak merespons");
+    }
+}
+
+void PomodoroFrame::ShowDurations() {
+    focusSlider->SetValue(focusDuration);
+    breakSlider->SetValue(breakDuration);
+    focusValueText->SetLabel(wxString::Format("%d menit", focusDuration));
+    breakValueText->SetLabel(wxString::Format("%d menit", breakDuration));
+}
+
+TimerState PomodoroFrame::DisplayedState() const {
+    return mirrorMode ? mirror.state : core.GetState();
+}
+
+// SharedStateWatcher: snapshot baru dari pemilik
+void PomodoroFrame::OnSharedStateChanged(const SharedTimerState& state) {
+    CallAfter([this, state]() { ApplyMirrorState(state); });
+}
+
+// SharedStateWatcher: pemilik keluar atau mati
+void PomodoroFrame::OnSharedOwnerGone() {
+    CallAfter([this]() { PromoteToOwner(); });
+}
+
+// Menu tray: sama seperti tombol, termasuk diteruskan ke pemilik di
+// instance cermin
+void PomodoroFrame::OnTrayCommand(ControlCommand command) {
+    ApplyControlCommand(command);
+}
+
+// Klik ikon tray: kembalikan jendela dari tray
+void PomodoroFrame::OnTrayActivate() {
+    Show(true);
+    if (IsIconized()) {
+        Iconize(false);
+    }
+    Raise();
+}
+
+void PomodoroFrame::OnTrayQuit() {
+    Close(true);
+}
+
 // Event handler: Fokus slider
 void PomodoroFrame::OnFocusSliderChange(wxCommandEvent& event) {
     focusDuration = focusSlider->GetValue();
     focusValueText->SetLabel(wxString::Format("%d menit", focusDuration));
+    core.SetDurations(focusDuration, breakDuration);
+    ConfigureTrayIcon();
     
-    if (timerState == READY) {
-        remainingSeconds = focusDuration * 60;
+    if (core.GetState() == READY) {
         UpdateTimerDisplay();
     }
     
+    PublishControlStatus();
     SaveSettings();
 }
 
@@ -552,6 +1294,9 @@ void PomodoroFrame::OnFocusSliderChange(wxCommandEvent& event) {
 void PomodoroFrame::OnBreakSliderChange(wxCommandEvent& event) {
     breakDuration = breakSlider->GetValue();
     breakValueText->SetLabel(wxString::Format("%d menit", breakDuration));
+    core.SetDurations(focusDuration, breakDuration);
+    ConfigureTrayIcon();
+    PublishControlStatus();
     SaveSettings();
 }
 
@@ -567,33 +1312,186 @@ void PomodoroFrame::OnSoundToggle(wxCommandEvent& event) {
     wxToggleButton* button = (wxToggleButton*)event.GetEventObject();
     soundEnabled = button->GetValue();
     button->SetLabel(soundEnabled ? "On" : "Off");
+    cues.SetEnabled(soundEnabled, tickingSound);
+    SaveSettings();
+}
+
+// Event handler: Ticking toggle
+void PomodoroFrame::OnTickingToggle(wxCommandEvent& event) {
+    wxToggleButton* button = (wxToggleButton*)event.GetEventObject();
+    tickingSound = button->GetValue();
+    button->SetLabel(tickingSound ? "ON" : "OFF");
+    cues.SetEnabled(soundEnabled, tickingSound);
+    SaveSettings();
+}
+
+// Event handler: Jeda otomatis
+void PomodoroFrame::OnIdlePauseToggle(wxCommandEvent& event) {
+    wxToggleButton* button = (wxToggleButton*)event.GetEventObject();
+    idlePauseEnabled = button->GetValue();
+    button->SetLabel(idlePauseEnabled ? "ON" : "OFF");
+    UpdateIdleMonitor();
     SaveSettings();
 }
 
+// Event handler: Mode tray
+void PomodoroFrame::OnTrayToggle(wxCommandEvent& event) {
+    trayMode = trayToggle->GetValue();
+    trayToggle->SetLabel(trayMode ? "ON" : "OFF");
+    UpdateTrayMode();
+    SaveSettings();
+}
+
+// Event handler: Ketikan di kotak pencarian task
+void PomodoroFrame::OnTaskSearch(wxCommandEvent& event) {
+    RefreshTaskResults();
+}
+
+// Event handler: Enter di kotak pencarian task
+void PomodoroFrame::OnTaskEnter(wxCommandEvent& event) {
+    std::string title(taskSearch->GetValue().utf8_str());
+    uint32_t id = tasks.FindOrAdd(title, clock.WallNowMs());
+    if (id == 0) {
+        return;
+    }
+    SelectTask(id);
+    // ChangeValue tidak memicu EVT_TEXT
+    taskSearch->ChangeValue(wxEmptyString);
+    RefreshTaskResults();
+}
+
+// Event handler: Task dipilih dari hasil pencarian
+void PomodoroFrame::OnTaskSelected(wxCommandEvent& event) {
+    int index = event.GetSelection();
+    if (index >= 0 && index < static_cast<int>(taskMatches.size())) {
+        SelectTask(taskMatches[index].id);
+    }
+}
+
+// Event handler: Task aktif selesai; sesi berikutnya tanpa task
+void PomodoroFrame::OnTaskDone(wxCommandEvent& event) {
+    tasks.SetDone(core.GetTaskId(), true);
+    SelectTask(0);
+    RefreshTaskResults();
+}
+
 // Event handler: Close window
 void PomodoroFrame::OnClose(wxCloseEvent& event) {
+    // Pastikan perubahan terakhir sudah di disk sebelum jendela ditutup,
+    // baru lepaskan kepemilikan agar instance cermin bisa mengambil alih
     SaveSettings();
+    settingsWriter.Flush();
+    checkpointLog.Flush();
+    controlServer.Stop();
+    sharedPublisher.Close();
+    sharedWatcher.Stop();
+    wxLogVerbose("Wakeup: %s", wakeupScheduler.Report().c_str());
+    wxLogVerbose("UI: %s", uiCounters.Report().c_str());
+    wxLogVerbose("Render: %s glyph_sets=%lld", timerDisplay->GetCounters().Report().c_str(),
+                 timerDisplay->GetRasterizeCount());
+    wxLogVerbose("Audio: %s", audio.Report().c_str());
+    wxLogVerbose("Hook:\n%s", hooks.Report().c_str());
+    if (trayIcon) {
+        wxLogVerbose("Tray: %s", trayIcon->Report().c_str());
+    }
+    wxLogVerbose("Notifikasi deadline->show: %s", notification.ShowLatency().Report().c_str());
+    wxLogVerbose("Notifikasi deadline->paint: %s", notification.PaintLatency().Report().c_str());
+    DumpTrace();
+    event.Skip();
+}
+
+// Event handler: Minimize/restore window
+// Di mode tray jendela yang diminimalkan disembunyikan; ikon tray yang
+// menampilkan countdown
+void PomodoroFrame::OnIconize(wxIconizeEvent& event) {
+    if (trayIcon && event.IsIconized()) {
+        Hide();
+    }
+    UpdateVisibility();
+    event.Skip();
+}
+
+// Event handler: Show/hide window
+void PomodoroFrame::OnShow(wxShowEvent& event) {
+    workspace.Invalidate();
+    UpdateVisibility();
+    event.Skip();
+}
+
+// Event handler: jendela aktif/tidak aktif. Pindah ke workspace lain dan
+// kembali biasanya ikut mengubah fokus jendela.
+void PomodoroFrame::OnActivate(wxActivateEvent& event) {
+    workspace.Invalidate();
+    UpdateVisibility();
+    event.Skip();
+}
+
+// Instrumentasi: paint pada widget tampilan timer
+void PomodoroFrame::OnDisplayPaint(wxPaintEvent& event) {
+    uiCounters.paints++;
+    if (!deferredStarted) {
+        deferredStarted = true;
+        GetStartupProfiler().Mark("first_paint");
+        // Jalankan setelah paint ini selesai, bukan di dalam handler paint
+        CallAfter([this]() { StartDeferredLoading(); });
+    }
+    if (offWorkspace) {
+        // Paint saat dianggap di workspace lain: kemungkinan sudah kembali.
+        // Dicek setelah paint, karena UpdateVisibility bisa mengubah widget.
+        CallAfter([this]() {
+            workspace.Invalidate();
+            UpdateVisibility();
+        });
+    }
+    event.Skip();
+}
+
+// Instrumentasi: resize/layout pada widget tampilan timer
+void PomodoroFrame::OnDisplaySize(wxSizeEvent& event) {
+    uiCounters.layouts++;
     event.Skip();
 }
 
 // Save settings
+// Penulisan dilakukan worker di latar belakang; perubahan beruntun digabung.
+// Instance cermin tidak menulis: file pengaturan milik instance pemilik.
 void PomodoroFrame::SaveSettings() {
-    std::ofstream file("pomodoro_settings.txt");
-    if (file.is_open()) {
-        file << focusDuration << std::endl
-             << breakDuration << std::endl
-             << darkMode << std::endl
-             << soundEnabled << std::endl
-             << completedSessions << std::endl;
-        file.close();
+    if (mirrorMode) {
+        return;
     }
+    ScopedTrace trace(TRACE_SAVE_SETTINGS);
+    settingsWriter.Schedule(CurrentSettings());
 }
 
 // Load settings
 void PomodoroFrame::LoadSettings() {
-    std::ifstream file("pomodoro_settings.txt");
-    if (file.is_open()) {
-        file >> focusDuration >> breakDuration >> darkMode >> soundEnabled >> completedSessions;
-        file.close();
+    Settings settings;
+    if (LoadSettingsFile(SETTINGS_FILE, settings)) {
+        focusDuration = settings.focusDuration;
+        breakDuration = settings.breakDuration;
+        darkMode = settings.darkMode;
+        soundEnabled = settings.soundEnabled;
+        tickingSound = settings.tickingSound;
+        idlePauseEnabled = settings.idlePause;
+        idlePauseMinutes = settings.idlePauseMinutes;
+        trayMode = settings.trayMode;
+        core.SetCompletedSessions(settings.completedSessions);
+        core.SetTaskId(settings.activeTask);
     }
-}
\ No newline at end of file
+}
+
+// Snapshot pengaturan saat ini
+Settings PomodoroFrame::CurrentSettings() const {
+    Settings settings;
+    settings.focusDuration = focusDuration;
+    settings.breakDuration = breakDuration;
+    settings.darkMode = darkMode;
+    settings.soundEnabled = soundEnabled;
+    settings.tickingSound = tickingSound;
+    settings.idlePause = idlePauseEnabled;
+    settings.idlePauseMinutes = idlePauseMinutes;
+    settings.trayMode = trayMode;
+    settings.completedSessions = core.GetCompletedSessions();
+    settings.activeTask = static_cast<int>(core.GetTaskId());
+    return settings;
+}
@@ -5,18 +5,30 @@
 #include <wx/wx.h>
 #include <wx/timer.h>
 #include <wx/sound.h>
-#include <wx/tglbtn.h> 
-#include <wx/gauge.h>
-#include <fstream>
-
-// Enum untuk state timer
-enum TimerState {
-    READY,
-    RUNNING_FOCUS,
-    RUNNING_BREAK,
-    PAUSED_FOCUS,
-    PAUSED_BREAK
-};
+#include <wx/tglbtn.h>
+#include <thread>
+#include <vector>
+#include "Clock.h"
+#include "TimerCore.h"
+#include "TimerRegistry.h"
+#include "WakeupScheduler.h"
+#include "DisplayModel.h"
+#include "SettingsStore.h"
+#include "SessionJournal.h"
+#include "SessionCheckpoint.h"
+#include "SessionStats.h"
+#include "TaskStore.h"
+#include "ControlServer.h"
+#include "StartupProfiler.h"
+#include "NotificationSurface.h"
+#include "AudioEngine.h"
+#include "SessionCues.h"
+#include "TimerDisplayCtrl.h"
+#include "IdleMonitor.h"
+#include "SharedTimerState.h"
+#include "SessionHooks.h"
+#include "TrayIcon.h"
+#include "WorkspaceProbe.h"
 
 // Kelas utama aplikasi
 class PomodoroApp : public wxApp {
@@ -24,16 +36,28 @@ public:
     virtual bool OnInit();
 };
 
-// Kelas untuk frame utama
-class PomodoroFrame : public wxFrame {
+// Kelas untuk frame utama. Logika sesi ada di TimerCore; frame hanya
+// menampilkan state dan meneruskan perintah tombol.
+class PomodoroFrame : public wxFrame, public TimerCoreListener,
+                      public ControlServerListener, public IdleListener,
+                      public SharedStateListener, public TrayIconListener {
 public:
-    PomodoroFrame(const wxString& title);
+    // clock: nullptr = jam sistem; jam virtual dipakai benchmark UI
+    PomodoroFrame(const wxString& title, Clock* clock = nullptr);
     virtual ~PomodoroFrame();
 
+    // Tutup jendela begitu startup selesai (untuk mengukur startup)
+    void SetExitAfterStartup(bool exit) { exitAfterStartup = exit; }
+
+    // Untuk benchmark: state sesi frame, dan apakah instance ini hanya
+    // cermin dari instance lain yang sudah berjalan
+    const TimerCore& GetCore() const { return core; }
+    bool IsMirror() const { return mirrorMode; }
+
 private:
     // Komponen GUI
     wxPanel* mainPanel;
-    wxStaticText* timerDisplay;
+    TimerDisplayCtrl* timerDisplay;    // angka countdown dan progress bar
     wxStaticText* stateDisplay;
     wxButton* startButton;
     wxButton* pauseButton;
@@ -44,60 +68,206 @@ private:
     wxStaticText* breakValueText;
     wxToggleButton* themeToggle;
     wxStatusBar* statusBar;
-    wxGauge* progressBar;
     wxStaticText* statsText;
-    
-    // Dialog notifikasi
-    wxDialog* notificationDialog;
-    wxStaticText* notificationCountdown;
-    int notificationCountdownSeconds;
-    
+    wxStaticText* hourText;
+    wxTextCtrl* taskSearch;
+    wxListBox* taskResults;
+    wxButton* taskDoneButton;
+    wxStaticText* taskText;
+
+    // Snapshot tampilan terakhir, agar hanya widget yang berubah disentuh
+    DisplayState lastDisplay;
+    bool displayValid;
+    int appliedTheme;    // -1 = belum diterapkan
+    UiCounters uiCounters;
+
+    // Teks yang dipakai jalur tick, dibuat sekali di konstruktor agar tick
+    // tidak membangun wxString: label state, status bar, dan countdown
+    // notifikasi per detik transisi ([0] setelah fokus, [1] setelah istirahat)
+    wxString stateLabels[TIMER_STATE_COUNT];
+    wxString statusLabels[TIMER_STATE_COUNT];
+    wxString countdownLabels[2][TRANSITION_SECONDS + 1];
+
     // Timer dan data
+    SystemClock systemClock;
+    Clock& clock;                      // systemClock, kecuali diganti
+    TimerRegistry registry;
+    TimerRegistry::Handle mainTimer;   // timer yang ditampilkan di jendela
+    TimerCore& core;
+    WakeupScheduler wakeupScheduler;
+    WorkspaceProbe workspace;
+    bool offWorkspace;    // tampil, tetapi di workspace lain
     wxTimer* timer;
-    wxTimer* notificationTimer;
-    TimerState timerState;
-    int remainingSeconds;
-    
+    int64_t tickDueNs;    // jadwal wakeup berikutnya (jam Tracer), untuk jitter
+
+    // Riwayat dan statistik sesi
+    SessionJournal journal;
+    SessionStats stats;
+
+    // Daftar task; sesi fokus ditautkan ke task aktif (TimerCore::GetTaskId).
+    // Hasil pencarian dicari ulang setiap ketikan, tanpa dialog.
+    TaskStore tasks;
+    std::vector<TaskMatch> taskMatches;   // isi taskResults
+
+    // Log transisi sesi, agar sesi yang berjalan selamat dari crash/reboot
+    CheckpointLog checkpointLog;
+
+    // Dialog notifikasi; dibuat sekali setelah paint pertama lalu dipakai ulang
+    NotificationSurface notification;
+
+    // Endpoint kontrol lokal untuk skrip dan status bar
+    ControlServer controlServer;
+
+    // State bersama antar instance. Instance pertama menjadi pemilik dan
+    // menerbitkan state sesinya; instance berikutnya (jendela di monitor
+    // lain) hanya menampilkan state itu dan meneruskan tombol ke pemilik
+    // lewat endpoint kontrol. Instance cermin tidak menulis pengaturan,
+    // jurnal maupun checkpoint, dan mengambil alih jika pemilik keluar.
+    SharedStatePublisher sharedPublisher;
+    SharedStateWatcher sharedWatcher;
+    SharedTimerState mirror;     // snapshot terakhir dari pemilik
+    bool mirrorMode;
+
     // Pengaturan
     int focusDuration;    // dalam menit
     int breakDuration;    // dalam menit
     bool darkMode;
     bool soundEnabled;
-    
-    // Statistik sederhana
-    int completedSessions;
-    
-    // Sound
+    bool tickingSound;
+    bool idlePauseEnabled;
+    int idlePauseMinutes;
+    bool trayMode;
+    SettingsWriter settingsWriter;
+
+    // Jeda fokus otomatis saat pengguna diam; event dari thread monitor
+    // diteruskan ke thread GUI
+    IdleMonitor idleMonitor;
+    IdleAutoPause idlePause;
+
+    // Sound; dimuat di latar belakang setelah paint pertama. Isyarat
+    // diputar AudioEngine jika ada perangkat audio, selain itu alarm
+    // memakai wxSound.
+    AudioEngine audio;
+    SessionCues cues;
     wxSound* alarmSound;
-    
+
+    // Aksi pengguna saat sesi berubah (pomodoro_hooks.txt), dijalankan di
+    // pool worker agar hook yang lambat tidak menunda tick atau alarm
+    SessionHooks hooks;
+
+    // Mode tray: ikon dengan sisa menit dari atlas yang dirender saat tema
+    // atau durasi berubah; minimize menyembunyikan jendela ke tray.
+    // nullptr jika mode tray mati atau tray tidak tersedia.
+    TrayIcon* trayIcon;
+    TrayIconStyle trayStyle;             // warna dari ApplyTheme
+    wxToggleButton* trayToggle;
+
+    std::vector<char> alarmSoundData;
+    std::thread assetLoader;
+
+    // Startup bertahap: pekerjaan yang tidak perlu untuk paint pertama
+    // (statistik, ikon, suara) dijalankan sesudahnya
+    bool deferredStarted;
+    int pendingStartupTasks;
+    bool exitAfterStartup;
+
     // Metode privat
     void CreateControls();
     void UpdateTimerDisplay();
+    void UpdateButtons();
+    void UpdateStatsText();
+    void LoadTasks();
+    void RefreshTaskResults();
+    void SelectTask(uint32_t id);
+    void ShowActiveTask();
     void ApplyTheme();
     void ShowNotificationDialog(bool isFocusCompleted);
-    
+    void CloseNotificationDialog();
+    void ScheduleNextTick();
+    void UpdateVisibility();
+    bool IsOnCurrentWorkspace();
+    void PublishControlStatus();
+    bool BecomeOwner();
+    void OpenSessionFiles();
+    void StartOwnerServices();
+    void EnterMirrorMode();
+    void PromoteToOwner();
+    void ApplyMirrorState(const SharedTimerState& state);
+    void ScheduleMirrorTick();
+    void ForwardCommand(ControlCommand command);
+    void ShowDurations();
+    TimerState DisplayedState() const;
+    int64_t WorkspaceRecheckMs(int64_t now) const;
+    void ApplyControlCommand(ControlCommand command);
+    void StartDeferredLoading();
+    void FinishStartupTask(const char* phase);
+    void LoadAppIcon();
+    void UpdateTrayMode();
+    void ConfigureTrayIcon();
+    void UpdateTrayIcon();
+    int64_t TrayDelayMs() const;
+    void EnsureAlarmSound();
+    void DumpTrace();
+
     // Event handlers
     void OnStartTimer(wxCommandEvent& event);
     void OnPauseTimer(wxCommandEvent& event);
     void OnResetTimer(wxCommandEvent& event);
     void OnTimer(wxTimerEvent& event);
-    void OnNotificationTimer(wxTimerEvent& event);
     void OnFocusSliderChange(wxCommandEvent& event);
     void OnBreakSliderChange(wxCommandEvent& event);
     void OnThemeToggle(wxCommandEvent& event);
     void OnSoundToggle(wxCommandEvent& event);
+    void OnTickingToggle(wxCommandEvent& event);
+    void OnIdlePauseToggle(wxCommandEvent& event);
+    void OnTrayToggle(wxCommandEvent& event);
+    void OnTaskSearch(wxCommandEvent& event);
+    void OnTaskEnter(wxCommandEvent& event);
+    void OnTaskSelected(wxCommandEvent& event);
+    void OnTaskDone(wxCommandEvent& event);
     void OnClose(wxCloseEvent& event);
-    
+    void OnIconize(wxIconizeEvent& event);
+    void OnShow(wxShowEvent& event);
+    void OnActivate(wxActivateEvent& event);
+    void OnDisplayPaint(wxPaintEvent& event);
+    void OnDisplaySize(wxSizeEvent& event);
+
+    // TimerCoreListener
+    void OnStateChanged(TimerState state) override;
+    void OnTick(int remainingSeconds) override;
+    void OnSessionCompleted(bool wasFocusSession) override;
+    void OnTransitionTick(int secondsLeft) override;
+    void OnTransitionFinished() override;
+    void OnSessionRecord(const SessionRecord& record) override;
+    void OnCheckpoint(const CheckpointRecord& record) override;
+
+    // ControlServerListener (dipanggil dari thread I/O)
+    void OnControlCommand(ControlCommand command) override;
+    void OnTimerCommand(const ControlTimerCommand& command) override;
+
+    // IdleListener (dipanggil dari thread IdleMonitor)
+    void OnUserIdle(int64_t idleMs) override;
+    void OnUserActive() override;
+    void UpdateIdleMonitor();
+
+    // SharedStateListener (dipanggil dari thread SharedStateWatcher)
+    void OnSharedStateChanged(const SharedTimerState& state) override;
+    void OnSharedOwnerGone() override;
+
+    // TrayIconListener
+    void OnTrayCommand(ControlCommand command) override;
+    void OnTrayActivate() override;
+    void OnTrayQuit() override;
+
     // File operations
     void SaveSettings();
     void LoadSettings();
-    
+    void RestoreSession();
+    Settings CurrentSettings() const;
+
     // Utility methods
-    void StartFocusSession();
-    void StartBreakSession();
-    void CompleteSession();
-    wxString FormatTimeDisplay(int seconds);
-    
+    void BuildLabelTables();
+
     DECLARE_EVENT_TABLE()
 };
 
@@ -110,8 +280,13 @@ enum {
     ID_BREAK_SLIDER,
     ID_THEME_TOGGLE,
     ID_SOUND_TOGGLE,
-    ID_TIMER,
-    ID_NOTIFICATION_TIMER
+    ID_TICKING_TOGGLE,
+    ID_IDLE_TOGGLE,
+    ID_TRAY_TOGGLE,
+    ID_TASK_SEARCH,
+    ID_TASK_RESULTS,
+    ID_TASK_DONE,
+    ID_TIMER
 };
 
 #endif // POMODORO_TIMER_H
\ No newline at end of file
@@ -0,0 +1,366 @@
+// SessionCheckpoint.cpp
+#include "SessionCheckpoint.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = { 'P', 'M', 'W', 'A', 'L', '1', '\0', '\0' };
+const uint32_t CHECKPOINT_VERSION = 1;
+// Record yang dibaca sekaligus saat pemulihan
+const size_t READ_BLOCK = 1024;
+
+// Header di awal file, 16 byte
+struct LogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+static_assert(sizeof(LogHeader) == 16, "header log checkpoint harus 16 byte");
+
+const size_t CRC_BYTES = offsetof(CheckpointRecord, crc);
+
+struct CrcTable {
+    uint32_t entries[256];
+
+    CrcTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+    }
+};
+
+// CRC-32 (polinomial IEEE, terbalik), tabel dibuat sekali
+uint32_t Crc32(const void* data, size_t size) {
+    static const CrcTable table;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool SyncFile(FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Hasil scan: record valid terakhir dan apakah ada ekor yang harus dibuang
+bool ScanLog(const std::string& path, CheckpointRecord& last, size_t& validRecords, bool& clean) {
+    validRecords = 0;
+    clean = false;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    LogHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+        header.version != CHECKPOINT_VERSION ||
+        header.recordSize != sizeof(CheckpointRecord)) {
+        std::fclose(file);
+        return false;
+    }
+
+    std::vector<CheckpointRecord> block(READ_BLOCK);
+    uint64_t lastSequence = 0;
+    bool torn = false;
+    for (;;) {
+        size_t count = std::fread(block.data(), sizeof(CheckpointRecord), READ_BLOCK, file);
+        for (size_t i = 0; i < count; ++i) {
+            const CheckpointRecord& record = block[i];
+            if (record.crc != Crc32(&record, CRC_BYTES) ||
+                (validRecords > 0 && record.sequence <= lastSequence)) {
+                torn = true;
+                break;
+            }
+            last = record;
+            lastSequence = record.sequence;
+            validRecords++;
+        }
+        if (torn || count < READ_BLOCK) {
+            break;
+        }
+    }
+    // Sisa byte yang tidak genap satu record juga berarti ekor terpotong
+    long expectedBytes = static_cast<long>(sizeof(LogHeader) + validRecords * sizeof(CheckpointRecord));
+    clean = !torn && std::fseek(file, 0, SEEK_END) == 0 && std::ftell(file) == expectedBytes;
+    std::fclose(file);
+    return true;
+}
+
+}
+
+bool ReadCheckpointLog(const std::string& path, CheckpointRecord& last, size_t& validRecords) {
+    bool clean = false;
+    return ScanLog(path, last, validRecords, clean) && validRecords > 0;
+}
+
+CheckpointLog::CheckpointLog(int minSyncIntervalMs, size_t compactAfter)
+    : minSyncIntervalMs(minSyncIntervalMs), compactAfter(compactAfter),
+      lastRecord(), hasRecovered(false), recovered(),
+      nextSequence(1), fileRecords(0), flushRequested(false), writing(false),
+      stopping(false), appendCount(0), syncCount(0), compactionCount(0),
+      file(nullptr),
+#ifdef _WIN32
+      lockHandle(INVALID_HANDLE_VALUE)
+#else
+      lockFd(-1)
+#endif
+{
+}
+
+CheckpointLog::~CheckpointLog() {
+    Close();
+}
+
+bool CheckpointLog::Open(const std::string& logPath) {
+    Close();
+    path = logPath;
+    if (!LockWriter()) {
+        return false;
+    }
+
+    CheckpointRecord last = CheckpointRecord();
+    size_t validRecords = 0;
+    bool clean = false;
+    bool readable = ScanLog(path, last, validRecords, clean);
+
+    hasRecovered = validRecords > 0;
+    recovered = last;
+    lastRecord = last;
+    nextSequence = hasRecovered ? last.sequence + 1 : 1;
+
+    // Log yang utuh cukup dilanjutkan; log baru, rusak atau terpotong ditulis
+    // ulang dulu agar append berikutnya tidak jatuh setelah sampah
+    if (readable && clean && validRecords < compactAfter) {
+        file = std::fopen(path.c_str(), "ab");
+        fileRecords = validRecords;
+    } else if (Compact(hasRecovered ? &last : nullptr)) {
+        fileRecords = hasRecovered ? 1 : 0;
+    }
+    if (!file) {
+        UnlockWriter();
+        return false;
+    }
+
+    stopping = false;
+    worker = std::thread(&CheckpointLog::Run, this);
+    return true;
+}
+
+void CheckpointLog::Close() {
+    if (!worker.joinable()) {
+        UnlockWriter();
+        return;
+    }
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    worker.join();
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    UnlockWriter();
+}
+
+// Kunci penulis tunggal; lepas sendiri jika prosesnya mati
+bool CheckpointLog::LockWriter() {
+    std::string lockPath = path + ".lock";
+#ifdef _WIN32
+    lockHandle = CreateFileA(lockPath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                             OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    return lockHandle != INVALID_HANDLE_VALUE;
+#else
+    lockFd = ::open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lockFd < 0) {
+        return false;
+    }
+    if (flock(lockFd, LOCK_EX | LOCK_NB) != 0) {
+        UnlockWriter();
+        return false;
+    }
+    return true;
+#endif
+}
+
+// File kunci dibiarkan: menghapusnya bisa membuat pembuka berikutnya
+// mengunci inode yang berbeda dari proses yang masih memegangnya
+void CheckpointLog::UnlockWriter() {
+#ifdef _WIN32
+    if (lockHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(lockHandle);
+        lockHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (lockFd >= 0) {
+        ::close(lockFd);
+        lockFd = -1;
+    }
+#endif
+}
+
+bool CheckpointLog::IsOpen() const {
+    return file != nullptr;
+}
+
+bool CheckpointLog::GetRecovered(CheckpointRecord& record) const {
+    if (hasRecovered) {
+        record = recovered;
+    }
+    return hasRecovered;
+}
+
+void CheckpointLog::Append(const CheckpointRecord& record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        CheckpointRecord entry = record;
+        entry.sequence = nextSequence++;
+        entry.padding = 0;
+        entry.crc = Crc32(&entry, CRC_BYTES);
+        pending.push_back(entry);
+        lastRecord = entry;
+        appendCount++;
+    }
+    wakeup.notify_one();
+}
+
+void CheckpointLog::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (worker.joinable() && (!pending.empty() || writing)) {
+        if (!pending.empty()) {
+            flushRequested = true;
+            wakeup.notify_one();
+        }
+        written.wait(lock);
+    }
+}
+
+long long CheckpointLog::GetAppendCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return appendCount;
+}
+
+long long CheckpointLog::GetSyncCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncCount;
+}
+
+long long CheckpointLog::GetCompactionCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return compactionCount;
+}
+
+void CheckpointLog::Run() {
+    typedef std::chrono::steady_clock SteadyClock;
+    SteadyClock::time_point lastSync;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wakeup.wait(lock, [this] { return !pending.empty() || stopping; });
+        if (pending.empty() && stopping) {
+            return;
+        }
+
+        // Batas laju fsync: transisi yang datang sebelum giliran berikutnya
+        // ikut di commit yang sama
+        SteadyClock::time_point due = lastSync + std::chrono::milliseconds(minSyncIntervalMs);
+        while (!flushRequested && !stopping && SteadyClock::now() < due) {
+            wakeup.wait_until(lock, due);
+        }
+
+        batch.swap(pending);
+        CheckpointRecord last = lastRecord;
+        flushRequested = false;
+        writing = true;
+
+        // Tulis tanpa memegang lock agar Append() tidak pernah menunggu disk
+        lock.unlock();
+        bool compacted = fileRecords + batch.size() >= compactAfter && Compact(&last);
+        if (!compacted && file) {
+            std::fwrite(batch.data(), sizeof(CheckpointRecord), batch.size(), file);
+            SyncFile(file);
+        }
+        lastSync = SteadyClock::now();
+        lock.lock();
+
+        fileRecords = compacted ? 1 : fileRecords + batch.size();
+        batch.clear();
+        writing = false;
+        syncCount++;
+        if (compacted) {
+            compactionCount++;
+        }
+        written.notify_all();
+    }
+}
+
+// Menulis header dan record terakhir ke file sementara lalu rename atomik,
+// seperti WriteSettingsFile; crash di tengah jalan meninggalkan log lama utuh
+bool CheckpointLog::Compact(const CheckpointRecord* last) {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    std::string tempPath = path + ".tmp";
+    FILE* temp = std::fopen(tempPath.c_str(), "wb");
+    bool ok = temp != nullptr;
+    if (ok) {
+        LogHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        header.version = CHECKPOINT_VERSION;
+        header.recordSize = sizeof(CheckpointRecord);
+        ok = std::fwrite(&header, sizeof(header), 1, temp) == 1;
+        if (ok && last) {
+            ok = std::fwrite(last, sizeof(CheckpointRecord), 1, temp) == 1;
+        }
+        ok = SyncFile(temp) && ok;
+        ok = (std::fclose(temp) == 0) && ok;
+    }
+
+    if (ok) {
+#ifdef _WIN32
+        ok = MoveFileExA(tempPath.c_str(), path.c_str(),
+                         MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        ok = std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    }
+    if (!ok) {
+        std::remove(tempPath.c_str());
+    }
+
+    // Lanjutkan append ke file yang ada, hasil rename atau yang lama
+    file = std::fopen(path.c_str(), "ab");
+    return ok && file != nullptr;
+}
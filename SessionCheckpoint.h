@@ -0,0 +1,122 @@
+// SessionCheckpoint.h
+#ifndef SESSION_CHECKPOINT_H
+#define SESSION_CHECKPOINT_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Nama file log checkpoint default
+const char* const CHECKPOINT_FILE = "pomodoro_checkpoint.wal";
+
+enum CheckpointEvent {
+    CHECKPOINT_START = 1,
+    CHECKPOINT_PAUSE = 2,
+    CHECKPOINT_RESUME = 3,
+    CHECKPOINT_COMPLETE = 4,
+    CHECKPOINT_RESET = 5
+};
+
+// Satu transisi state sesi, ukuran tetap. Waktu memakai jam dinding karena
+// jam monoton tidak bertahan melewati reboot.
+struct CheckpointRecord {
+    uint64_t sequence;            // diisi CheckpointLog, naik terus
+    int64_t wallMs;               // kapan transisi terjadi
+    int64_t sessionStartWallMs;
+    int64_t durationMs;
+    int64_t remainingMs;          // sisa waktu pada wallMs
+    int64_t pausedMs;             // total jeda sebelum wallMs
+    uint16_t pauseCount;
+    uint8_t event;                // CheckpointEvent
+    uint8_t state;                // TimerState
+    uint32_t taskId;              // task sesi fokus, 0 = tanpa task
+    uint32_t crc;                 // CRC-32 dari semua byte sebelum kolom ini
+    uint32_t padding;             // selalu 0
+};
+
+static_assert(sizeof(CheckpointRecord) == 64, "format CheckpointRecord berubah");
+
+// true jika record menggambarkan sesi yang masih berjalan atau dijeda
+inline bool IsSessionInFlight(const CheckpointRecord& record) {
+    return record.event == CHECKPOINT_START || record.event == CHECKPOINT_PAUSE ||
+           record.event == CHECKPOINT_RESUME;
+}
+
+// Membaca log dan mengembalikan record valid terakhir. Pembacaan berhenti
+// di record pertama yang terpotong, CRC-nya salah, atau sequence-nya tidak
+// naik (sisa penulisan yang terputus crash).
+bool ReadCheckpointLog(const std::string& path, CheckpointRecord& last, size_t& validRecords);
+
+// Write-ahead log state sesi. Append() hanya menyalin record ke antrean;
+// worker menulis semua record yang terkumpul dengan satu write + fsync dan
+// paling banyak sekali per minSyncIntervalMs (group commit), sehingga klik
+// Start/Pause beruntun tidak berubah menjadi fsync beruntun. Setelah
+// compactAfter record, log ditulis ulang berisi record terakhir saja.
+class CheckpointLog {
+public:
+    explicit CheckpointLog(int minSyncIntervalMs = 1000, size_t compactAfter = 256);
+    ~CheckpointLog();
+
+    // Memulihkan record terakhir (jika ada) lalu memadatkan log menjadi
+    // record itu saja, sehingga ekor yang rusak tidak pernah ditimpa append.
+    // Gagal selama proses lain membuka log yang sama: urutan sequence dua
+    // penulis akan saling menyela. Kuncinya di file "<path>.lock", karena
+    // pemadatan mengganti file log dengan rename.
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const;
+
+    // Record valid terakhir saat Open(); false jika log kosong atau baru
+    bool GetRecovered(CheckpointRecord& record) const;
+
+    // Murah: hanya menyalin record dan membangunkan worker
+    void Append(const CheckpointRecord& record);
+
+    // Menulis dan fsync record yang tertunda sekarang, lalu menunggu
+    void Flush();
+
+    long long GetAppendCount() const;
+    long long GetSyncCount() const;
+    long long GetCompactionCount() const;
+
+private:
+    int minSyncIntervalMs;
+    size_t compactAfter;
+    std::string path;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable written;
+    std::vector<CheckpointRecord> pending;
+    std::vector<CheckpointRecord> batch;    // hanya dipakai worker
+    CheckpointRecord lastRecord;
+    bool hasRecovered;
+    CheckpointRecord recovered;
+    uint64_t nextSequence;
+    size_t fileRecords;
+    bool flushRequested;
+    bool writing;
+    bool stopping;
+    long long appendCount;
+    long long syncCount;
+    long long compactionCount;
+    FILE* file;
+    std::thread worker;
+#ifdef _WIN32
+    void* lockHandle;
+#else
+    int lockFd;
+#endif
+
+    void Run();
+    bool Compact(const CheckpointRecord* last);
+    bool LockWriter();
+    void UnlockWriter();
+};
+
+#endif // SESSION_CHECKPOINT_H
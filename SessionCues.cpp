@@ -0,0 +1,74 @@
+// SessionCues.cpp
+#include "SessionCues.h"
+
+SessionCues::SessionCues(AudioEngine& engine, const TimerCore& core)
+    : engine(engine), core(core), soundEnabled(true), tickingEnabled(false),
+      minuteCueDue(false), ticking(false), lastState(READY) {
+}
+
+void SessionCues::SetEnabled(bool sound, bool tickingOn) {
+    soundEnabled = sound;
+    tickingEnabled = tickingOn;
+    UpdateTicking();
+}
+
+void SessionCues::OnStateChanged(TimerState state) {
+    bool running = (state == RUNNING_FOCUS || state == RUNNING_BREAK);
+    bool resumed = (lastState == PAUSED_FOCUS && state == RUNNING_FOCUS) ||
+                   (lastState == PAUSED_BREAK && state == RUNNING_BREAK);
+    lastState = state;
+
+    if (running && !resumed) {
+        // Sesi baru (bukan lanjut dari jeda)
+        minuteCueDue = core.RemainingMs() > ONE_MINUTE_CUE_MS;
+        if (soundEnabled) {
+            engine.Play(CUE_SESSION_START);
+        }
+    } else if (state == READY) {
+        minuteCueDue = false;
+    }
+    UpdateTicking();
+}
+
+bool SessionCues::OnSessionCompleted(bool wasFocusSession) {
+    minuteCueDue = false;
+    UpdateTicking();
+    if (!soundEnabled || !engine.IsRunning()) {
+        return false;
+    }
+    AudioCue cue = (!wasFocusSession && engine.HasCue(CUE_BREAK_OVER)) ? CUE_BREAK_OVER : CUE_ALARM;
+    return engine.Play(cue);
+}
+
+void SessionCues::Poll() {
+    if (minuteCueDue && core.IsRunning() && !core.InTransition() &&
+        core.RemainingMs() <= ONE_MINUTE_CUE_MS) {
+        minuteCueDue = false;
+        if (soundEnabled) {
+            engine.Play(CUE_ONE_MINUTE);
+        }
+    }
+}
+
+int64_t SessionCues::NextCueMs() const {
+    // IsRunning() lebih dulu: cache isyarat baru boleh dibaca setelah mesin jalan
+    if (!minuteCueDue || !soundEnabled || !engine.IsRunning() || !engine.HasCue(CUE_ONE_MINUTE) ||
+        !core.IsRunning() || core.InTransition()) {
+        return -1;
+    }
+    return core.NextDeadlineMs() - ONE_MINUTE_CUE_MS;
+}
+
+// Detak hanya terdengar selama sesi berjalan, tidak saat jeda atau transisi
+void SessionCues::UpdateTicking() {
+    bool wanted = soundEnabled && tickingEnabled && core.IsRunning() && !core.InTransition();
+    if (wanted == ticking) {
+        return;
+    }
+    if (wanted) {
+        ticking = engine.StartLoop(CUE_TICK, 0.5f);
+    } else {
+        engine.StopLoop(CUE_TICK);
+        ticking = false;
+    }
+}
@@ -0,0 +1,42 @@
+// SessionCues.h
+#ifndef SESSION_CUES_H
+#define SESSION_CUES_H
+
+#include <cstdint>
+#include "AudioEngine.h"
+#include "TimerCore.h"
+
+// Sisa waktu saat isyarat "satu menit lagi" diputar
+const int64_t ONE_MINUTE_CUE_MS = 60 * 1000;
+
+// Memetakan event TimerCore ke isyarat AudioEngine. Dipakai PomodoroFrame
+// dan HeadlessRunner dari thread yang juga menjalankan TimerCore.
+class SessionCues {
+public:
+    SessionCues(AudioEngine& engine, const TimerCore& core);
+
+    void SetEnabled(bool sound, bool ticking);
+    bool IsTickingEnabled() const { return tickingEnabled; }
+
+    void OnStateChanged(TimerState state);
+    // true jika alarm diputar lewat AudioEngine; false berarti pemanggil
+    // perlu memakai jalur cadangan (wxSound, bel terminal)
+    bool OnSessionCompleted(bool wasFocusSession);
+    // Dipanggil setiap wakeup; memutar isyarat satu menit jika sudah waktunya
+    void Poll();
+    // Waktu absolut isyarat berikutnya yang perlu wakeup, atau -1
+    int64_t NextCueMs() const;
+
+private:
+    AudioEngine& engine;
+    const TimerCore& core;
+    bool soundEnabled;
+    bool tickingEnabled;
+    bool minuteCueDue;     // sesi ini belum memutar isyarat satu menit
+    bool ticking;
+    TimerState lastState;
+
+    void UpdateTicking();
+};
+
+#endif // SESSION_CUES_H
@@ -0,0 +1,887 @@
+// SessionExport.cpp
+#include "SessionExport.h"
+
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Versi 2 menambah varint taskId di akhir record; versi 1 masih dibaca
+const char EXPORT_MAGIC[8] = { 'P', 'M', 'E', 'X', 'P', '2', '\0', '\0' };
+const char EXPORT_MAGIC_V1[8] = { 'P', 'M', 'E', 'X', 'P', '1', '\0', '\0' };
+const int BINARY_FIELDS = 8;
+const int BINARY_FIELDS_V1 = 7;
+
+// Batas satu record: baris teks terpanjang, dan 8 varint 64-bit
+const size_t MAX_TEXT_RECORD = 256;
+const size_t MAX_BINARY_RECORD = BINARY_FIELDS * 10;
+
+const char* const CSV_HEADER =
+    "start_ms,end_ms,type,planned_s,actual_s,paused_s,pauses,completed,reset,task_id\n";
+
+// Nama kolom CSV dan kunci JSON, urutannya sama dengan SessionImporter::Column
+const char* const FIELD_NAMES[] = {
+    "start_ms", "end_ms", "type", "planned_s", "actual_s",
+    "paused_s", "pauses", "completed", "reset", "task_id"
+};
+const int FIELD_COUNT = sizeof(FIELD_NAMES) / sizeof(FIELD_NAMES[0]);
+const unsigned REQUIRED_FIELDS = (1u << 0) | (1u << 1);   // start_ms dan end_ms
+
+// Rentang waktu record impor yang masuk akal: tidak sebelum 2000-01-01 UTC
+// dan tidak lebih dari sehari di depan jam mesin ini. Satu endMs yang jauh
+// di depan membuat statistik mengalokasikan bucket untuk seluruh rentang
+// dan Append() menjepit endMs setiap record sesudahnya.
+const int64_t MIN_RECORD_MS = 946684800000LL;
+const int64_t MAX_FUTURE_MS = 24LL * 3600 * 1000;
+// actualSeconds dibulatkan ke detik terdekat
+const int64_t ACTUAL_ROUNDING_MS = 1000;
+
+size_t AppendInt(char* out, int64_t value) {
+    char digits[20];
+    size_t length = 0;
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    do {
+        digits[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t pos = 0;
+    if (value < 0) {
+        out[pos++] = '-';
+    }
+    while (length > 0) {
+        out[pos++] = digits[--length];
+    }
+    return pos;
+}
+
+size_t AppendText(char* out, const char* text) {
+    size_t length = std::strlen(text);
+    std::memcpy(out, text, length);
+    return length;
+}
+
+size_t AppendVarint(unsigned char* out, uint64_t value) {
+    size_t pos = 0;
+    while (value >= 0x80) {
+        out[pos++] = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    out[pos++] = static_cast<unsigned char>(value);
+    return pos;
+}
+
+uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+bool ReadVarint(const unsigned char*& p, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        unsigned char byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseInt(const char*& p, const char* end, int64_t& value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    const char* digits = p;
+    uint64_t magnitude = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        magnitude = magnitude * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    if (p == digits) {
+        return false;
+    }
+    value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+bool Matches(const char* text, size_t length, const char* word) {
+    return std::strlen(word) == length && std::memcmp(text, word, length) == 0;
+}
+
+int FieldIndex(const char* name, size_t length) {
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        if (Matches(name, length, FIELD_NAMES[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Nilai satu field teks ke record. Angka, "focus"/"break", atau
+// true/false untuk flag.
+bool SetField(SessionRecord& record, int field, const char* text, size_t length) {
+    const char* p = text;
+    const char* end = text + length;
+    int64_t value = 0;
+    if (field == 2 && Matches(text, length, "focus")) {
+        value = SESSION_FOCUS;
+    } else if (field == 2 && Matches(text, length, "break")) {
+        value = SESSION_BREAK;
+    } else if (Matches(text, length, "true")) {
+        value = 1;
+    } else if (Matches(text, length, "false")) {
+        value = 0;
+    } else if (!ParseInt(p, end, value) || p != end) {
+        return false;
+    }
+
+    // Nilai yang tidak muat di field record ditolak, bukan dipotong
+    if (field >= 2 && field <= 6) {
+        int64_t limit = field == 2 ? UINT8_MAX : field == 6 ? UINT16_MAX : INT32_MAX;
+        if (value > limit || value < (field == 2 || field == 6 ? 0 : INT32_MIN)) {
+            return false;
+        }
+    }
+
+    switch (field) {
+        case 0: record.startMs = value; break;
+        case 1: record.endMs = value; break;
+        case 2: record.type = static_cast<uint8_t>(value); break;
+        case 3: record.plannedSeconds = static_cast<int32_t>(value); break;
+        case 4: record.actualSeconds = static_cast<int32_t>(value); break;
+        case 5: record.pausedSeconds = static_cast<int32_t>(value); break;
+        case 6: record.pauseCount = static_cast<uint16_t>(value); break;
+        case 7:
+            record.flags = static_cast<uint8_t>(value ? record.flags | RECORD_COMPLETED :
+                                                        record.flags & ~RECORD_COMPLETED);
+            break;
+        case 8:
+            record.flags = static_cast<uint8_t>(value ? record.flags | RECORD_RESET :
+                                                        record.flags & ~RECORD_RESET);
+            break;
+        case 9:
+            if (value < 0 || value > UINT32_MAX) {
+                return false;
+            }
+            record.taskId = static_cast<uint32_t>(value);
+            break;
+    }
+    return true;
+}
+
+const char* TypeName(uint8_t type) {
+    return type == SESSION_FOCUS ? "focus" : type == SESSION_BREAK ? "break" : nullptr;
+}
+
+size_t FormatCsv(const SessionRecord& record, char* out) {
+    size_t pos = AppendInt(out, record.startMs);
+    out[pos++] = ',';
+    pos += AppendInt(out + pos, record.endMs);
+    out[pos++] = ',';
+    const char* type = TypeName(record.type);
+    pos += type ? AppendText(out + pos, type) : AppendInt(out + pos, record.type);
+    out[pos++] = ',';
+    pos += AppendInt(out + pos, record.plannedSeconds);
+    out[pos++] = ',';
+    pos += AppendInt(out + pos, record.actualSeconds);
+    out[pos++] = ',';
+    pos += AppendInt(out + pos, record.pausedSeconds);
+    out[pos++] = ',';
+    pos += AppendInt(out + pos, record.pauseCount);
+    out[pos++] = ',';
+    out[pos++] = (record.flags & RECORD_COMPLETED) ? '1' : '0';
+    out[pos++] = ',';
+    out[pos++] = (record.flags & RECORD_RESET) ? '1' : '0';
+    out[pos++] = ',';
+    pos += AppendInt(out + pos, record.taskId);
+    out[pos++] = '\n';
+    return pos;
+}
+
+size_t FormatJson(const SessionRecord& record, char* out) {
+    size_t pos = AppendText(out, "{\"start_ms\":");
+    pos += AppendInt(out + pos, record.startMs);
+    pos += AppendText(out + pos, ",\"end_ms\":");
+    pos += AppendInt(out + pos, record.endMs);
+    pos += AppendText(out + pos, ",\"type\":");
+    const char* type = TypeName(record.type);
+    if (type) {
+        out[pos++] = '"';
+        pos += AppendText(out + pos, type);
+        out[pos++] = '"';
+    } else {
+        pos += AppendInt(out + pos, record.type);
+    }
+    pos += AppendText(out + pos, ",\"planned_s\":");
+    pos += AppendInt(out + pos, record.plannedSeconds);
+    pos += AppendText(out + pos, ",\"actual_s\":");
+    pos += AppendInt(out + pos, record.actualSeconds);
+    pos += AppendText(out + pos, ",\"paused_s\":");
+    pos += AppendInt(out + pos, record.pausedSeconds);
+    pos += AppendText(out + pos, ",\"pauses\":");
+    pos += AppendInt(out + pos, record.pauseCount);
+    pos += AppendText(out + pos, (record.flags & RECORD_COMPLETED) ? ",\"completed\":true" :
+                                                                    ",\"completed\":false");
+    pos += AppendText(out + pos, (record.flags & RECORD_RESET) ? ",\"reset\":true" :
+                                                                ",\"reset\":false");
+    pos += AppendText(out + pos, ",\"task_id\":");
+    pos += AppendInt(out + pos, record.taskId);
+    pos += AppendText(out + pos, "}\n");
+    return pos;
+}
+
+// endMs sebagai delta dari record sebelumnya (kecil karena terurut), mulai
+// sebagai jarak ke endMs, sisanya apa adanya; taskId terakhir (satu byte
+// untuk sesi tanpa task)
+size_t FormatBinary(const SessionRecord& record, int64_t previousEndMs, char* out) {
+    unsigned char* p = reinterpret_cast<unsigned char*>(out);
+    size_t pos = AppendVarint(p, ZigZag(record.endMs - previousEndMs));
+    pos += AppendVarint(p + pos, ZigZag(record.endMs - record.startMs));
+    pos += AppendVarint(p + pos, ZigZag(record.plannedSeconds));
+    pos += AppendVarint(p + pos, ZigZag(record.actualSeconds));
+    pos += AppendVarint(p + pos, ZigZag(record.pausedSeconds));
+    pos += AppendVarint(p + pos, record.pauseCount);
+    pos += AppendVarint(p + pos, static_cast<uint64_t>(record.type) | (static_cast<uint64_t>(record.flags) << 8));
+    pos += AppendVarint(p + pos, record.taskId);
+    return pos;
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+}
+
+bool ParseExportFormat(const std::string& name, ExportFormat& format) {
+    if (name == "csv") {
+        format = EXPORT_CSV;
+    } else if (name == "jsonl" || name == "json") {
+        format = EXPORT_JSONL;
+    } else if (name == "bin" || name == "binary") {
+        format = EXPORT_BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ExportFormat ExportFormatForPath(const std::string& path) {
+    size_t dot = path.rfind('.');
+    ExportFormat format = EXPORT_BINARY;
+    if (dot != std::string::npos && path.find('/', dot) == std::string::npos) {
+        ParseExportFormat(path.substr(dot + 1), format);
+    }
+    return format;
+}
+
+const char* ExportFormatName(ExportFormat format) {
+    switch (format) {
+        case EXPORT_CSV:
+            return "csv";
+        case EXPORT_JSONL:
+            return "jsonl";
+        case EXPORT_BINARY:
+            return "bin";
+    }
+    return "";
+}
+
+SessionExporter::SessionExporter()
+    : file(nullptr), format(EXPORT_CSV), used(0), failed(false),
+      previousEndMs(0), recordCount(0), byteCount(0) {
+}
+
+SessionExporter::~SessionExporter() {
+    // Tanpa Close() ekspor dianggap batal
+    Discard();
+}
+
+bool SessionExporter::Open(const std::string& exportPath, ExportFormat exportFormat) {
+    Discard();
+    path = exportPath;
+    tempPath = exportPath + ".tmp";
+    format = exportFormat;
+    used = 0;
+    failed = false;
+    previousEndMs = 0;
+    recordCount = 0;
+    byteCount = 0;
+
+    file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    if (!buffer) {
+        buffer.reset(new char[EXPORT_BUFFER_BYTES]);
+    }
+
+    if (format == EXPORT_CSV) {
+        used = AppendText(buffer.get(), CSV_HEADER);
+    } else if (format == EXPORT_BINARY) {
+        std::memcpy(buffer.get(), EXPORT_MAGIC, sizeof(EXPORT_MAGIC));
+        used = sizeof(EXPORT_MAGIC);
+    }
+    return true;
+}
+
+bool SessionExporter::Write(const SessionRecord& record) {
+    if (!file || failed) {
+        return false;
+    }
+    char* out = Reserve(format == EXPORT_BINARY ? MAX_BINARY_RECORD : MAX_TEXT_RECORD);
+    switch (format) {
+        case EXPORT_CSV:
+            used += FormatCsv(record, out);
+            break;
+        case EXPORT_JSONL:
+            used += FormatJson(record, out);
+            break;
+        case EXPORT_BINARY:
+            used += FormatBinary(record, previousEndMs, out);
+            previousEndMs = record.endMs;
+            break;
+    }
+    recordCount++;
+    return !failed;
+}
+
+bool SessionExporter::Close() {
+    if (!file) {
+        return false;
+    }
+    FlushBuffer();
+    bool ok = !failed && std::fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = (std::fclose(file) == 0) && ok;
+    file = nullptr;
+
+    if (ok) {
+#ifdef _WIN32
+        ok = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        ok = std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    }
+    if (!ok) {
+        std::remove(tempPath.c_str());
+    }
+    return ok;
+}
+
+char* SessionExporter::Reserve(size_t bytes) {
+    if (used + bytes > EXPORT_BUFFER_BYTES) {
+        FlushBuffer();
+    }
+    return buffer.get() + used;
+}
+
+void SessionExporter::FlushBuffer() {
+    if (used == 0) {
+        return;
+    }
+    if (!failed && std::fwrite(buffer.get(), 1, used, file) != used) {
+        failed = true;
+    }
+    byteCount += used;
+    used = 0;
+}
+
+void SessionExporter::Discard() {
+    if (!file) {
+        return;
+    }
+    std::fclose(file);
+    file = nullptr;
+    std::remove(tempPath.c_str());
+}
+
+SessionImporter::SessionImporter()
+    : file(nullptr), format(EXPORT_CSV), binaryFields(BINARY_FIELDS), begin(0), end(0),
+      atEof(false), previousEndMs(0), latestEndMs(0), lineNumber(0), skippedCount(0),
+      byteCount(0) {
+}
+
+SessionImporter::~SessionImporter() {
+    Close();
+}
+
+bool SessionImporter::Open(const std::string& path) {
+    Close();
+    begin = 0;
+    end = 0;
+    atEof = false;
+    previousEndMs = 0;
+    latestEndMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count() +
+                  MAX_FUTURE_MS;
+    lineNumber = 0;
+    skippedCount = 0;
+    byteCount = 0;
+    error.clear();
+    for (int i = 0; i < MAX_CSV_COLUMNS; ++i) {
+        csvColumns[i] = static_cast<signed char>(i < FIELD_COUNT ? i : -1);
+    }
+
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "tidak dapat membuka " + path;
+        return false;
+    }
+    if (!buffer) {
+        buffer.reset(new char[EXPORT_BUFFER_BYTES]);
+    }
+
+    Fill(sizeof(EXPORT_MAGIC));
+    if (end - begin >= sizeof(EXPORT_MAGIC)) {
+        bool current = std::memcmp(buffer.get() + begin, EXPORT_MAGIC, sizeof(EXPORT_MAGIC)) == 0;
+        if (current ||
+            std::memcmp(buffer.get() + begin, EXPORT_MAGIC_V1, sizeof(EXPORT_MAGIC_V1)) == 0) {
+            format = EXPORT_BINARY;
+            binaryFields = current ? BINARY_FIELDS : BINARY_FIELDS_V1;
+            begin += sizeof(EXPORT_MAGIC);
+            return true;
+        }
+    }
+
+    size_t first = begin;
+    while (first < end && (buffer[first] == ' ' || buffer[first] == '\t' ||
+                           buffer[first] == '\r' || buffer[first] == '\n')) {
+        ++first;
+    }
+    if (first < end && buffer[first] == '{') {
+        format = EXPORT_JSONL;
+        return true;
+    }
+
+    // CSV: baris pertama yang diawali huruf adalah header; tanpa header
+    // kolom dianggap berurutan seperti hasil ekspor
+    format = EXPORT_CSV;
+    if (first < end && ((buffer[first] >= 'a' && buffer[first] <= 'z') ||
+                        (buffer[first] >= 'A' && buffer[first] <= 'Z') || buffer[first] == '"')) {
+        const char* line;
+        size_t length;
+        if (NextLine(line, length) && !ParseCsvHeader(line, length)) {
+            error = "header CSV tanpa kolom start_ms dan end_ms";
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void SessionImporter::Close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+size_t SessionImporter::Read(SessionRecord* records, size_t maxRecords) {
+    size_t count = 0;
+    while (file && count < maxRecords && error.empty()) {
+        SessionRecord record = SessionRecord();
+        if (format == EXPORT_BINARY) {
+            bool valid = true;
+            if (!ReadBinary(record, valid)) {
+                break;
+            }
+            if (!valid || !IsPlausible(record)) {
+                skippedCount++;
+                continue;
+            }
+        } else {
+            const char* line;
+            size_t length;
+            if (!NextLine(line, length)) {
+                break;
+            }
+            if (length == 0) {
+                continue;
+            }
+            bool parsed = format == EXPORT_CSV ? ParseCsvLine(line, length, record) :
+                                                 ParseJsonLine(line, length, record);
+            if (!parsed || !IsPlausible(record)) {
+                skippedCount++;
+                continue;
+            }
+        }
+        records[count++] = record;
+    }
+    return count;
+}
+
+bool SessionImporter::Fill(size_t minBytes) {
+    if (end - begin >= minBytes) {
+        return true;
+    }
+    // Geser sisa data ke awal buffer lalu isi bagian yang kosong
+    if (begin > 0) {
+        std::memmove(buffer.get(), buffer.get() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    while (!atEof && end - begin < minBytes && end < EXPORT_BUFFER_BYTES) {
+        size_t n = std::fread(buffer.get() + end, 1, EXPORT_BUFFER_BYTES - end, file);
+        if (n == 0) {
+            if (std::ferror(file)) {
+                error = "gagal membaca file";
+            }
+            atEof = true;
+        }
+        end += n;
+        byteCount += static_cast<long long>(n);
+    }
+    return end - begin >= minBytes;
+}
+
+bool SessionImporter::NextLine(const char*& line, size_t& length) {
+    for (;;) {
+        const char* start = buffer.get() + begin;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', end - begin));
+        if (newline) {
+            line = start;
+            length = static_cast<size_t>(newline - start);
+            begin += length + 1;
+            break;
+        }
+        if (atEof) {
+            if (begin == end) {
+                return false;
+            }
+            // Baris terakhir tanpa '\n'
+            line = start;
+            length = end - begin;
+            begin = end;
+            break;
+        }
+        if (begin == 0 && end == EXPORT_BUFFER_BYTES) {
+            error = "baris terlalu panjang";
+            return false;
+        }
+        Fill(end - begin + 1);
+        if (!error.empty()) {
+            return false;
+        }
+    }
+    lineNumber++;
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+    return true;
+}
+
+bool SessionImporter::IsPlausible(const SessionRecord& record) const {
+    if (record.startMs < MIN_RECORD_MS || record.endMs > latestEndMs ||
+        record.endMs < record.startMs) {
+        return false;
+    }
+    if (record.type != SESSION_FOCUS && record.type != SESSION_BREAK) {
+        return false;
+    }
+    if (record.plannedSeconds < 0 || record.actualSeconds < 0 || record.pausedSeconds < 0) {
+        return false;
+    }
+    return record.actualSeconds * 1000LL <= record.endMs - record.startMs + ACTUAL_ROUNDING_MS;
+}
+
+// valid = false jika record terbaca utuh tetapi nilainya tidak muat di
+// SessionRecord; pembacaan tetap bisa berlanjut ke record berikutnya
+bool SessionImporter::ReadBinary(SessionRecord& record, bool& valid) {
+    Fill(MAX_BINARY_RECORD);
+    if (begin == end) {
+        return false;
+    }
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer.get() + begin);
+    const unsigned char* limit = reinterpret_cast<const unsigned char*>(buffer.get() + end);
+    uint64_t values[BINARY_FIELDS] = {};
+    for (int i = 0; i < binaryFields; ++i) {
+        if (!ReadVarint(p, limit, values[i])) {
+            error = "record biner terpotong atau rusak";
+            return false;
+        }
+    }
+    begin = static_cast<size_t>(reinterpret_cast<const char*>(p) - buffer.get());
+
+    record.endMs = previousEndMs + UnZigZag(values[0]);
+    record.startMs = record.endMs - UnZigZag(values[1]);
+    for (int i = 2; i <= 4; ++i) {
+        int64_t seconds = UnZigZag(values[i]);
+        valid = valid && seconds >= INT32_MIN && seconds <= INT32_MAX;
+    }
+    valid = valid && values[5] <= UINT16_MAX && (values[6] >> 16) == 0;
+    record.plannedSeconds = static_cast<int32_t>(UnZigZag(values[2]));
+    record.actualSeconds = static_cast<int32_t>(UnZigZag(values[3]));
+    record.pausedSeconds = static_cast<int32_t>(UnZigZag(values[4]));
+    record.pauseCount = static_cast<uint16_t>(values[5]);
+    record.type = static_cast<uint8_t>(values[6] & 0xFF);
+    record.flags = static_cast<uint8_t>(values[6] >> 8);
+    if (values[7] > UINT32_MAX) {
+        error = "record biner terpotong atau rusak";
+        return false;
+    }
+    record.taskId = static_cast<uint32_t>(values[7]);
+    previousEndMs = record.endMs;
+    return true;
+}
+
+bool SessionImporter::ParseCsvHeader(const char* line, size_t length) {
+    unsigned seen = 0;
+    const char* p = line;
+    const char* limit = line + length;
+    for (int column = 0; p <= limit; ++column) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', limit - p));
+        const char* fieldEnd = comma ? comma : limit;
+        const char* name = p;
+        size_t nameLength = static_cast<size_t>(fieldEnd - p);
+        if (nameLength >= 2 && name[0] == '"' && name[nameLength - 1] == '"') {
+            name++;
+            nameLength -= 2;
+        }
+        int field = FieldIndex(name, nameLength);
+        if (column < MAX_CSV_COLUMNS) {
+            csvColumns[column] = static_cast<signed char>(field);
+        }
+        if (field >= 0) {
+            seen |= 1u << field;
+        }
+        if (!comma) {
+            for (int rest = column + 1; rest < MAX_CSV_COLUMNS; ++rest) {
+                csvColumns[rest] = -1;
+            }
+            break;
+        }
+        p = comma + 1;
+    }
+    return (seen & REQUIRED_FIELDS) == REQUIRED_FIELDS;
+}
+
+bool SessionImporter::ParseCsvLine(const char* line, size_t length, SessionRecord& record) const {
+    unsigned seen = 0;
+    const char* p = line;
+    const char* limit = line + length;
+    for (int column = 0; column < MAX_CSV_COLUMNS; ++column) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', limit - p));
+        const char* fieldEnd = comma ? comma : limit;
+        int field = csvColumns[column];
+        if (field >= 0) {
+            const char* text = p;
+            size_t textLength = static_cast<size_t>(fieldEnd - p);
+            if (textLength >= 2 && text[0] == '"' && text[textLength - 1] == '"') {
+                text++;
+                textLength -= 2;
+            }
+            if (!SetField(record, field, text, textLength)) {
+                return false;
+            }
+            seen |= 1u << field;
+        }
+        if (!comma) {
+            break;
+        }
+        p = comma + 1;
+    }
+    return (seen & REQUIRED_FIELDS) == REQUIRED_FIELDS;
+}
+
+// Objek datar satu baris; kunci yang tidak dikenal diabaikan
+bool SessionImporter::ParseJsonLine(const char* line, size_t length, SessionRecord& record) {
+    unsigned seen = 0;
+    const char* p = line;
+    const char* limit = line + length;
+    auto skipSpace = [&]() {
+        while (p < limit && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+    };
+
+    skipSpace();
+    if (p >= limit || *p++ != '{') {
+        return false;
+    }
+    for (;;) {
+        skipSpace();
+        if (p < limit && *p == '}') {
+            break;
+        }
+        if (p >= limit || *p++ != '"') {
+            return false;
+        }
+        const char* key = p;
+        while (p < limit && *p != '"') {
+            ++p;
+        }
+        if (p >= limit) {
+            return false;
+        }
+        int field = FieldIndex(key, static_cast<size_t>(p - key));
+        ++p;
+        skipSpace();
+        if (p >= limit || *p++ != ':') {
+            return false;
+        }
+        skipSpace();
+
+        const char* value = p;
+        size_t valueLength;
+        if (p < limit && *p == '"') {
+            value = ++p;
+            while (p < limit && *p != '"') {
+                p += (*p == '\\' && p + 1 < limit) ? 2 : 1;
+            }
+            if (p >= limit) {
+                return false;
+            }
+            valueLength = static_cast<size_t>(p - value);
+            ++p;
+        } else {
+            while (p < limit && *p != ',' && *p != '}' && *p != ' ') {
+                ++p;
+            }
+            valueLength = static_cast<size_t>(p - value);
+        }
+        if (field >= 0) {
+            if (!SetField(record, field, value, valueLength)) {
+                return false;
+            }
+            seen |= 1u << field;
+        }
+
+        skipSpace();
+        if (p < limit && *p == ',') {
+            ++p;
+        } else if (p < limit && *p == '}') {
+            break;
+        } else {
+            return false;
+        }
+    }
+    return (seen & REQUIRED_FIELDS) == REQUIRED_FIELDS;
+}
+
+std::string TransferStats::Report() const {
+    double megabytes = bytes / (1024.0 * 1024.0);
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "%lld record, %.1f MB, %.0f record/s, %.1f MB/s",
+                  records, megabytes, seconds > 0 ? records / seconds : 0.0,
+                  seconds > 0 ? megabytes / seconds : 0.0);
+    std::string text = buffer;
+    if (skipped > 0) {
+        std::snprintf(buffer, sizeof(buffer), ", %lld dilewati", skipped);
+        text += buffer;
+    }
+    return text;
+}
+
+bool ExportJournal(const SessionJournal& journal, const std::string& path, ExportFormat format,
+                   int64_t fromMs, int64_t toMs, TransferStats& stats, std::string& error) {
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    SessionExporter exporter;
+    if (!exporter.Open(path, format)) {
+        error = "tidak dapat menulis " + path;
+        return false;
+    }
+
+    // Record dibaca langsung dari pemetaan jurnal; halaman yang sudah
+    // lewat boleh dibuang OS, sehingga memori tidak ikut besar
+    size_t first = 0;
+    size_t last = 0;
+    journal.FindRange(fromMs, toMs, first, last);
+    for (size_t i = first; i < last; ++i) {
+        if (!exporter.Write(journal.At(i))) {
+            break;
+        }
+    }
+    if (!exporter.Close()) {
+        error = "gagal menulis " + path;
+        return false;
+    }
+
+    stats.records = exporter.GetRecordCount();
+    stats.bytes = exporter.GetByteCount();
+    stats.seconds = SecondsSince(begin);
+    return true;
+}
+
+bool CheckImportFile(const std::string& path, std::string& error) {
+    SessionImporter importer;
+    if (!importer.Open(path)) {
+        error = importer.GetError();
+        return false;
+    }
+    std::vector<SessionRecord> batch(4096);
+    while (importer.Read(batch.data(), batch.size()) > 0) {
+    }
+    if (importer.HasError()) {
+        error = importer.GetError();
+        return false;
+    }
+    return true;
+}
+
+bool ImportJournal(SessionJournal& journal, const std::string& path,
+                   TransferStats& stats, std::string& error,
+                   const std::vector<uint32_t>* taskMap) {
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    SessionImporter importer;
+    if (!importer.Open(path)) {
+        error = importer.GetError();
+        return false;
+    }
+
+    const size_t BATCH = 4096;
+    std::vector<SessionRecord> batch(BATCH);
+    int64_t lastEndMs = journal.Size() > 0 ? journal.At(journal.Size() - 1).endMs :
+                                             std::numeric_limits<int64_t>::min();
+    long long appended = 0;
+    long long older = 0;
+    size_t count;
+    while ((count = importer.Read(batch.data(), BATCH)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            if (batch[i].endMs <= lastEndMs) {
+                older++;
+                continue;
+            }
+            uint32_t taskId = batch[i].taskId;
+            batch[i].taskId = taskMap && taskId < taskMap->size() ? (*taskMap)[taskId] : 0;
+            if (!journal.Append(batch[i])) {
+                journal.Sync();
+                stats.records = appended;
+                error = "tidak dapat menambah record ke jurnal";
+                return false;
+            }
+            lastEndMs = batch[i].endMs;
+            appended++;
+        }
+    }
+    journal.Sync();
+
+    stats.records = appended;
+    stats.skipped = older + importer.GetSkippedCount();
+    stats.bytes = importer.GetByteCount();
+    stats.seconds = SecondsSince(begin);
+    if (importer.HasError()) {
+        error = importer.GetError();
+        return false;
+    }
+    return true;
+}
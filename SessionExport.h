@@ -0,0 +1,151 @@
+// SessionExport.h
+#ifndef SESSION_EXPORT_H
+#define SESSION_EXPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "SessionJournal.h"
+
+// Format file ekspor riwayat sesi
+enum ExportFormat {
+    EXPORT_CSV,       // header + satu baris per sesi, untuk spreadsheet
+    EXPORT_JSONL,     // satu objek JSON per baris
+    EXPORT_BINARY     // varint delta, ~16 byte per sesi, untuk migrasi
+};
+
+// "csv", "jsonl"/"json", "bin"; false jika tidak dikenal
+bool ParseExportFormat(const std::string& name, ExportFormat& format);
+// Dari ekstensi path (.csv, .jsonl/.json, lainnya biner)
+ExportFormat ExportFormatForPath(const std::string& path);
+const char* ExportFormatName(ExportFormat format);
+
+// Ukuran buffer I/O eksportir dan importir; memori keduanya tetap sebesar
+// ini berapa pun jumlah record
+const size_t EXPORT_BUFFER_BYTES = 256 * 1024;
+
+// Menulis record satu per satu ke buffer tetap yang dikirim ke file per
+// EXPORT_BUFFER_BYTES. Ditulis ke file sementara lalu rename saat Close(),
+// sehingga ekspor yang gagal tidak meninggalkan file setengah jadi; tanpa
+// Close() file sementara dibuang.
+class SessionExporter {
+public:
+    SessionExporter();
+    ~SessionExporter();
+
+    bool Open(const std::string& path, ExportFormat format);
+    bool Write(const SessionRecord& record);
+    // false jika ada penulisan yang gagal; file sementara dihapus
+    bool Close();
+
+    long long GetRecordCount() const { return recordCount; }
+    long long GetByteCount() const { return byteCount; }
+
+private:
+    std::string path;
+    std::string tempPath;
+    FILE* file;
+    ExportFormat format;
+    std::unique_ptr<char[]> buffer;
+    size_t used;
+    bool failed;
+    int64_t previousEndMs;    // basis delta format biner
+    long long recordCount;
+    long long byteCount;
+
+    char* Reserve(size_t bytes);
+    void FlushBuffer();
+    void Discard();
+};
+
+// Membaca file ekspor secara streaming; format dikenali dari isinya.
+// Baris teks yang tidak valid dan record yang tidak masuk akal (endMs
+// sebelum startMs, waktu sebelum 2000 atau lebih dari sehari ke depan, tipe
+// tidak dikenal, detik negatif, actual melebihi rentang sesi) dilewati dan
+// dihitung; data biner yang rusak menghentikan pembacaan dengan error.
+class SessionImporter {
+public:
+    SessionImporter();
+    ~SessionImporter();
+
+    bool Open(const std::string& path);
+    void Close();
+
+    // Mengisi paling banyak maxRecords; 0 berarti selesai (atau error)
+    size_t Read(SessionRecord* records, size_t maxRecords);
+
+    ExportFormat GetFormat() const { return format; }
+    bool HasError() const { return !error.empty(); }
+    const std::string& GetError() const { return error; }
+    long long GetSkippedCount() const { return skippedCount; }
+    long long GetByteCount() const { return byteCount; }
+
+private:
+    // Kolom CSV yang dikenali, dipetakan dari header
+    enum Column {
+        COL_START, COL_END, COL_TYPE, COL_PLANNED, COL_ACTUAL,
+        COL_PAUSED, COL_PAUSES, COL_COMPLETED, COL_RESET, COL_TASK, COL_COUNT
+    };
+    static const int MAX_CSV_COLUMNS = 32;
+
+    FILE* file;
+    ExportFormat format;
+    int binaryFields;         // varint per record; versi 1 tanpa taskId
+    std::unique_ptr<char[]> buffer;
+    size_t begin;
+    size_t end;
+    bool atEof;
+    int64_t previousEndMs;
+    int64_t latestEndMs;      // endMs terbesar yang diterima (jam saat Open + sehari)
+    long long lineNumber;
+    long long skippedCount;
+    long long byteCount;
+    std::string error;
+    signed char csvColumns[MAX_CSV_COLUMNS];   // indeks kolom file -> Column, -1 = abaikan
+
+    bool Fill(size_t minBytes);
+    bool NextLine(const char*& line, size_t& length);
+    bool ReadBinary(SessionRecord& record, bool& valid);
+    bool IsPlausible(const SessionRecord& record) const;
+    bool ParseCsvHeader(const char* line, size_t length);
+    bool ParseCsvLine(const char* line, size_t length, SessionRecord& record) const;
+    static bool ParseJsonLine(const char* line, size_t length, SessionRecord& record);
+};
+
+// Hasil ekspor atau impor
+struct TransferStats {
+    long long records;
+    long long skipped;     // baris tidak valid, atau record yang sudah ada di jurnal
+    long long bytes;
+    double seconds;
+
+    TransferStats() : records(0), skipped(0), bytes(0), seconds(0) {}
+
+    // "N record, M MB, x record/s, y MB/s"
+    std::string Report() const;
+};
+
+// Record jurnal dengan fromMs <= endMs < toMs ke file
+bool ExportJournal(const SessionJournal& journal, const std::string& path, ExportFormat format,
+                   int64_t fromMs, int64_t toMs, TransferStats& stats, std::string& error);
+
+// Membaca seluruh file tanpa menyentuh jurnal; false jika file tidak bisa
+// dibuka, terpotong atau rusak. Untuk memeriksa file sebelum mengubah data
+// lain yang bergantung pada impornya.
+bool CheckImportFile(const std::string& path, std::string& error);
+
+// Menambahkan record dari file ke jurnal. Jika gagal di tengah,
+// stats.records tetap berisi jumlah record yang sudah ditambahkan. Jurnal terurut menurut endMs,
+// jadi record yang tidak lebih baru dari record terakhir jurnal (riwayat
+// yang sudah ada, atau file yang sama diimpor dua kali) dilewati.
+// taskId di file adalah id di mesin asal: taskMap[id asal] = id lokal
+// (lihat TaskStore::MergeFrom); id tanpa pemetaan, atau semua jika taskMap
+// nullptr, menjadi 0 agar sesi tidak tertaut ke task lokal yang salah.
+bool ImportJournal(SessionJournal& journal, const std::string& path,
+                   TransferStats& stats, std::string& error,
+                   const std::vector<uint32_t>* taskMap = nullptr);
+
+#endif // SESSION_EXPORT_H
@@ -0,0 +1,488 @@
+// SessionHooks.cpp
+#include "SessionHooks.h"
+#include "ControlServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace {
+
+const char* const EVENT_NAMES[HOOK_EVENT_COUNT] = {
+    "focus_start", "break_start", "pause", "resume", "reset", "focus_complete", "break_complete"
+};
+
+int64_t SteadyNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+HookEventData MakeEvent(SessionHookEvent event, const TimerCore& core) {
+    HookEventData data;
+    data.event = event;
+    data.state = core.GetState();
+    data.remainingMs = core.RemainingMs();
+    data.completedSessions = core.GetCompletedSessions();
+    data.wallMs = core.GetClock().WallNowMs();
+    return data;
+}
+
+bool IsFocusState(TimerState state) {
+    return state == RUNNING_FOCUS || state == PAUSED_FOCUS;
+}
+
+#ifdef __linux__
+// Menunggu proses selesai paling lama timeoutMs; true jika sudah di-reap.
+// pidfd jika kernel mendukung, selain itu polling waitpid.
+bool WaitChild(pid_t pid, int timeoutMs, int& status) {
+    if (timeoutMs < 0) {
+        timeoutMs = 0;
+    }
+#ifdef SYS_pidfd_open
+    int pidfd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd >= 0) {
+        pollfd entry = { pidfd, POLLIN, 0 };
+        int ready;
+        do {
+            ready = poll(&entry, 1, timeoutMs);
+        } while (ready < 0 && errno == EINTR);
+        close(pidfd);
+        return ready > 0 && waitpid(pid, &status, 0) == pid;
+    }
+#endif
+    int64_t deadline = SteadyNowNs() + static_cast<int64_t>(timeoutMs) * 1000000;
+    for (;;) {
+        pid_t done = waitpid(pid, &status, WNOHANG);
+        if (done == pid) {
+            return true;
+        }
+        if (done < 0 && errno != EINTR) {
+            return false;
+        }
+        if (SteadyNowNs() >= deadline) {
+            return false;
+        }
+        usleep(5000);
+    }
+}
+#endif
+
+} // namespace
+
+const char* HookEventName(SessionHookEvent event) {
+    return event >= 0 && event < HOOK_EVENT_COUNT ? EVENT_NAMES[event] : "?";
+}
+
+bool ParseHookEvent(const std::string& name, SessionHookEvent& event) {
+    for (int i = 0; i < HOOK_EVENT_COUNT; ++i) {
+        if (name == EVENT_NAMES[i]) {
+            event = static_cast<SessionHookEvent>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LoadHooksFile(const std::string& path, std::vector<SessionHook>& hooks, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        return true;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string events;
+        int timeoutMs = 0;
+        std::string mode;
+        std::string command;
+        fields >> events >> timeoutMs >> mode;
+        std::getline(fields >> std::ws, command);
+        while (!command.empty() && (command.back() == '\r' || command.back() == ' ')) {
+            command.pop_back();
+        }
+
+        SessionHook hook;
+        hook.timeoutMs = timeoutMs;
+        bool valid = !fields.bad() && timeoutMs > 0 && !command.empty();
+        if (mode == "drop") {
+            hook.backpressure = HOOK_DROP;
+        } else if (mode != "coalesce") {
+            valid = false;
+        }
+        if (events == "*") {
+            hook.eventMask = HOOK_ALL_EVENTS;
+        } else {
+            std::istringstream names(events);
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                SessionHookEvent event;
+                if (!ParseHookEvent(name, event)) {
+                    valid = false;
+                    break;
+                }
+                hook.eventMask |= 1u << event;
+            }
+        }
+        if (!valid || hook.eventMask == 0) {
+            error = path + ":" + std::to_string(lineNumber) + ": baris hook tidak valid";
+            return false;
+        }
+        hook.command = command;
+        hooks.push_back(hook);
+    }
+    return true;
+}
+
+SessionHooks::SessionHooks()
+    : lastState(READY), hasLastState(false), maxQueueDepth(0), runningCount(0), stopping(false) {
+}
+
+SessionHooks::~SessionHooks() {
+    Stop();
+}
+
+void SessionHooks::Add(const SessionHook& hook) {
+    if (workers.empty()) {
+        HookSlot slot;
+        slot.hook = hook;
+        slot.pending = 0;
+        slot.running = false;
+        slot.pid = 0;
+        hooks.push_back(slot);
+    }
+}
+
+bool SessionHooks::LoadFile(const std::string& path, std::string& error) {
+    std::vector<SessionHook> loaded;
+    if (!LoadHooksFile(path, loaded, error)) {
+        return false;
+    }
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        Add(loaded[i]);
+    }
+    return true;
+}
+
+void SessionHooks::Start(int workerCount) {
+    if (!workers.empty() || hooks.empty()) {
+        return;
+    }
+    // Tidak perlu lebih banyak worker daripada hook: satu hook tidak pernah
+    // berjalan dua kali sekaligus
+    int count = std::max(1, std::min(workerCount, static_cast<int>(hooks.size())));
+    queue.reserve(QUEUE_CAPACITY);
+    stopping = false;
+    for (int i = 0; i < count; ++i) {
+        workers.push_back(std::thread(&SessionHooks::Run, this));
+    }
+}
+
+void SessionHooks::Stop() {
+    if (workers.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            HookSlot& slot = hooks[queue[i].hook];
+            slot.pending--;
+            slot.stats.dropped++;
+        }
+        queue.clear();
+#ifdef __linux__
+        for (size_t i = 0; i < hooks.size(); ++i) {
+            if (hooks[i].pid > 0) {
+                kill(-hooks[i].pid, SIGTERM);
+            }
+        }
+#endif
+    }
+    wakeup.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    workers.clear();
+    idle.notify_all();
+}
+
+void SessionHooks::OnStateChanged(const TimerCore& core) {
+    TimerState state = core.GetState();
+    TimerState previous = hasLastState ? lastState : READY;
+    lastState = state;
+    hasLastState = true;
+    if (state == previous) {
+        return;
+    }
+
+    bool wasPaused = previous == PAUSED_FOCUS || previous == PAUSED_BREAK;
+    switch (state) {
+    case READY:
+        Dispatch(MakeEvent(HOOK_RESET, core));
+        break;
+    case PAUSED_FOCUS:
+    case PAUSED_BREAK:
+        Dispatch(MakeEvent(HOOK_PAUSE, core));
+        break;
+    case RUNNING_FOCUS:
+    case RUNNING_BREAK:
+        if (wasPaused && IsFocusState(previous) == IsFocusState(state)) {
+            Dispatch(MakeEvent(HOOK_RESUME, core));
+        } else {
+            Dispatch(MakeEvent(state == RUNNING_FOCUS ? HOOK_FOCUS_START : HOOK_BREAK_START, core));
+        }
+        break;
+    }
+}
+
+void SessionHooks::OnSessionCompleted(const TimerCore& core, bool wasFocus) {
+    Dispatch(MakeEvent(wasFocus ? HOOK_FOCUS_COMPLETE : HOOK_BREAK_COMPLETE, core));
+}
+
+bool SessionHooks::Dispatch(const HookEventData& data) {
+    if (workers.empty()) {
+        return false;
+    }
+    int64_t nowNs = SteadyNowNs();
+    bool accepted = false;
+    bool subscribed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return false;
+        }
+        for (size_t i = 0; i < hooks.size(); ++i) {
+            HookSlot& slot = hooks[i];
+            if (!(slot.hook.eventMask & (1u << data.event))) {
+                continue;
+            }
+            subscribed = true;
+            // Hook yang masih antre: gabungkan ke job yang ada atau buang
+            if (slot.pending > 0) {
+                if (slot.hook.backpressure == HOOK_DROP) {
+                    slot.stats.dropped++;
+                    continue;
+                }
+                for (size_t j = 0; j < queue.size(); ++j) {
+                    if (queue[j].hook == i) {
+                        queue[j].data = data;
+                        break;
+                    }
+                }
+                slot.stats.coalesced++;
+                accepted = true;
+                continue;
+            }
+            // Hook yang sedang berjalan dengan mode drop tidak diantre lagi
+            if ((slot.running && slot.hook.backpressure == HOOK_DROP) || queue.size() >= QUEUE_CAPACITY) {
+                slot.stats.dropped++;
+                continue;
+            }
+            Job job = { i, data, nowNs };
+            queue.push_back(job);
+            slot.pending++;
+            slot.stats.queued++;
+            accepted = true;
+        }
+        maxQueueDepth = std::max(maxQueueDepth, queue.size());
+    }
+    if (accepted) {
+        wakeup.notify_one();
+    }
+    return accepted || !subscribed;
+}
+
+bool SessionHooks::WaitIdle(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return idle.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                         [this] { return (queue.empty() && runningCount == 0) || workers.empty(); });
+}
+
+HookStats SessionHooks::GetStats(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return index < hooks.size() ? hooks[index].stats : HookStats();
+}
+
+size_t SessionHooks::GetQueueDepth() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+size_t SessionHooks::GetMaxQueueDepth() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxQueueDepth;
+}
+
+std::string SessionHooks::Report() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string report;
+    char buffer[256];
+    for (size_t i = 0; i < hooks.size(); ++i) {
+        const HookSlot& slot = hooks[i];
+        std::string events;
+        for (int event = 0; event < HOOK_EVENT_COUNT; ++event) {
+            if (slot.hook.eventMask & (1u << event)) {
+                events += events.empty() ? "" : ",";
+                events += EVENT_NAMES[event];
+            }
+        }
+        std::snprintf(buffer, sizeof(buffer),
+                      "hook %zu [%s] runs=%lld failures=%lld timeouts=%lld dropped=%lld coalesced=%lld\n",
+                      i, events.c_str(), slot.stats.runs, slot.stats.failures, slot.stats.timeouts,
+                      slot.stats.dropped, slot.stats.coalesced);
+        report += buffer;
+        report += "  antre: " + slot.stats.queueWait.Report() + "\n";
+        report += "  jalan: " + slot.stats.runTime.Report() + "\n";
+    }
+    std::snprintf(buffer, sizeof(buffer), "antrean: sekarang=%zu maks=%zu kapasitas=%zu\n",
+                  queue.size(), maxQueueDepth, QUEUE_CAPACITY);
+    report += buffer;
+    return report;
+}
+
+// Job pertama yang hook-nya tidak sedang berjalan; dipanggil dengan lock
+bool SessionHooks::TakeJob(Job& job) {
+    for (size_t i = 0; i < queue.size(); ++i) {
+        if (!hooks[queue[i].hook].running) {
+            job = queue[i];
+            queue.erase(queue.begin() + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void SessionHooks::Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        Job job;
+        wakeup.wait(lock, [&] { return stopping || TakeJob(job); });
+        if (stopping) {
+            return;
+        }
+        HookSlot& slot = hooks[job.hook];
+        slot.pending--;
+        slot.running = true;
+        runningCount++;
+        int64_t startNs = SteadyNowNs();
+        slot.stats.queueWait.Record((startNs - job.queuedNs) / 1e6);
+        SessionHook hook = slot.hook;
+        lock.unlock();
+
+        bool timedOut = false;
+        bool ok;
+        if (hook.handler) {
+            ok = hook.handler(job.data);
+            timedOut = SteadyNowNs() - startNs > static_cast<int64_t>(hook.timeoutMs) * 1000000;
+        } else {
+            ok = RunCommand(job.hook, hook, job.data, timedOut);
+        }
+        double runMs = (SteadyNowNs() - startNs) / 1e6;
+
+        lock.lock();
+        slot.running = false;
+        runningCount--;
+        slot.stats.runs++;
+        slot.stats.failures += ok ? 0 : 1;
+        slot.stats.timeouts += timedOut ? 1 : 0;
+        slot.stats.runTime.Record(runMs);
+        if (queue.empty() && runningCount == 0) {
+            idle.notify_all();
+        }
+    }
+}
+
+bool SessionHooks::RunCommand(size_t index, const SessionHook& hook, const HookEventData& data,
+                              bool& timedOut) {
+#ifdef __linux__
+    // Lingkungan disiapkan sebelum spawn; anak tidak mewarisi apa pun dari
+    // thread ini selain itu
+    std::vector<std::string> variables;
+    variables.push_back(std::string("POMODORO_EVENT=") + HookEventName(data.event));
+    variables.push_back(std::string("POMODORO_STATE=") + ControlStateName(data.state));
+    variables.push_back("POMODORO_REMAINING_MS=" + std::to_string(data.remainingMs));
+    variables.push_back("POMODORO_COMPLETED=" + std::to_string(data.completedSessions));
+    variables.push_back("POMODORO_TIME_MS=" + std::to_string(data.wallMs));
+    std::vector<char*> envp;
+    for (char** entry = environ; entry && *entry; ++entry) {
+        if (std::string(*entry).compare(0, 9, "POMODORO_") != 0) {
+            envp.push_back(*entry);
+        }
+    }
+    for (size_t i = 0; i < variables.size(); ++i) {
+        envp.push_back(&variables[i][0]);
+    }
+    envp.push_back(nullptr);
+
+    // Grup proses sendiri agar timeout juga menghentikan anak-anak skrip
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+    posix_spawnattr_setpgroup(&attributes, 0);
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+
+    std::string command = hook.command;
+    char* argv[] = { const_cast<char*>("sh"), const_cast<char*>("-c"), &command[0], nullptr };
+    pid_t pid = 0;
+    int spawned = posix_spawn(&pid, "/bin/sh", &actions, &attributes, argv, envp.data());
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+    if (spawned != 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        hooks[index].pid = pid;
+        // Stop() bisa saja lewat di antara spawn dan baris di atas
+        if (stopping) {
+            kill(-pid, SIGTERM);
+        }
+    }
+
+    int status = 0;
+    bool exited = WaitChild(pid, hook.timeoutMs, status);
+    if (!exited) {
+        timedOut = true;
+        kill(-pid, SIGTERM);
+        if (!WaitChild(pid, KILL_GRACE_MS, status)) {
+            kill(-pid, SIGKILL);
+            waitpid(pid, &status, 0);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        hooks[index].pid = 0;
+    }
+    return exited && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#else
+    (void)index;
+    (void)hook;
+    (void)data;
+    (void)timedOut;
+    return false;
+#endif
+}
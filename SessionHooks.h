@@ -0,0 +1,166 @@
+// SessionHooks.h
+#ifndef SESSION_HOOKS_H
+#define SESSION_HOOKS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+#include "LatencyRecorder.h"
+#include "TimerCore.h"
+
+// Nama file konfigurasi hook default
+const char* const HOOKS_FILE = "pomodoro_hooks.txt";
+
+enum SessionHookEvent {
+    HOOK_FOCUS_START,
+    HOOK_BREAK_START,
+    HOOK_PAUSE,
+    HOOK_RESUME,
+    HOOK_RESET,
+    HOOK_FOCUS_COMPLETE,
+    HOOK_BREAK_COMPLETE
+};
+
+const int HOOK_EVENT_COUNT = HOOK_BREAK_COMPLETE + 1;
+const unsigned HOOK_ALL_EVENTS = (1u << HOOK_EVENT_COUNT) - 1;
+
+// "focus_start", "break_start", "pause", "resume", "reset",
+// "focus_complete", "break_complete"
+const char* HookEventName(SessionHookEvent event);
+bool ParseHookEvent(const std::string& name, SessionHookEvent& event);
+
+// Yang dilakukan saat event datang sementara hook itu masih antre atau
+// berjalan (hook yang lambat)
+enum HookBackpressure {
+    HOOK_COALESCE,   // event yang antre diganti event terbaru
+    HOOK_DROP        // event baru dibuang
+};
+
+// Data event; untuk perintah diteruskan lewat variabel lingkungan
+// POMODORO_EVENT, POMODORO_STATE, POMODORO_REMAINING_MS,
+// POMODORO_COMPLETED dan POMODORO_TIME_MS
+struct HookEventData {
+    SessionHookEvent event;
+    TimerState state;
+    int64_t remainingMs;
+    int completedSessions;
+    int64_t wallMs;
+};
+
+struct SessionHook {
+    unsigned eventMask;           // bit (1 << SessionHookEvent)
+    std::string command;          // dijalankan lewat /bin/sh -c
+    // Alternatif command untuk hook di dalam proses; false berarti gagal.
+    // Timeout hanya dicatat, handler tidak bisa dihentikan paksa.
+    std::function<bool(const HookEventData&)> handler;
+    int timeoutMs;
+    HookBackpressure backpressure;
+
+    SessionHook()
+        : eventMask(0), timeoutMs(5000), backpressure(HOOK_COALESCE) {}
+};
+
+// Metrik satu hook
+struct HookStats {
+    long long queued;
+    long long runs;
+    long long failures;
+    long long timeouts;
+    long long dropped;
+    long long coalesced;
+    LatencyRecorder queueWait;    // dari Dispatch() sampai mulai berjalan
+    LatencyRecorder runTime;
+
+    HookStats()
+        : queued(0), runs(0), failures(0), timeouts(0), dropped(0), coalesced(0) {}
+};
+
+// Baris "event[,event...]|* timeout_ms coalesce|drop perintah..."; baris
+// kosong dan yang diawali '#' dilewati. false jika file ada tetapi ada
+// baris yang tidak valid (error berisi nomor barisnya); file yang tidak
+// ada berarti tidak ada hook.
+bool LoadHooksFile(const std::string& path, std::vector<SessionHook>& hooks, std::string& error);
+
+// Menjalankan aksi saat sesi berubah (membisukan chat, mode jangan
+// ganggu, mencatat ke time tracker, skrip pengguna) di pool worker
+// berukuran tetap. Thread pemanggil hanya menyalin event ke antrean
+// terbatas, jadi hook yang lambat atau macet tidak pernah menunda tick
+// atau alert. Setiap hook berjalan paling banyak satu instance sekaligus,
+// sehingga hook yang macet hanya menahan satu worker sampai timeout-nya
+// (SIGTERM ke grup prosesnya, lalu SIGKILL); event berikutnya untuk hook
+// itu digabung atau dibuang sesuai backpressure-nya.
+class SessionHooks {
+public:
+    static const int DEFAULT_WORKERS = 2;
+    static const size_t QUEUE_CAPACITY = 64;
+    static const int KILL_GRACE_MS = 500;
+
+    SessionHooks();
+    ~SessionHooks();
+
+    // Sebelum Start()
+    void Add(const SessionHook& hook);
+    bool LoadFile(const std::string& path, std::string& error);
+    size_t GetHookCount() const { return hooks.size(); }
+
+    // Tanpa hook tidak ada thread yang dibuat
+    void Start(int workerCount = DEFAULT_WORKERS);
+    // Membuang antrean, menghentikan perintah yang berjalan, lalu join
+    void Stop();
+    bool IsRunning() const { return !workers.empty(); }
+
+    // Dari thread pemilik TimerCore; menurunkan event dari perubahan state
+    void OnStateChanged(const TimerCore& core);
+    void OnSessionCompleted(const TimerCore& core, bool wasFocus);
+    // Tidak pernah menunggu hook; false jika event dibuang untuk semua hook
+    // yang berlangganan
+    bool Dispatch(const HookEventData& data);
+
+    // Menunggu antrean kosong dan tidak ada hook berjalan (benchmark)
+    bool WaitIdle(int timeoutMs);
+
+    HookStats GetStats(size_t index) const;
+    size_t GetQueueDepth() const;
+    size_t GetMaxQueueDepth() const;
+    // Satu baris per hook: event, hitungan dan latensi
+    std::string Report() const;
+
+private:
+    struct Job {
+        size_t hook;
+        HookEventData data;
+        int64_t queuedNs;
+    };
+
+    struct HookSlot {
+        SessionHook hook;
+        size_t pending;           // job milik hook ini di antrean
+        bool running;
+        pid_t pid;                // proses yang sedang berjalan, 0 jika tidak ada
+        HookStats stats;
+    };
+
+    std::vector<HookSlot> hooks;  // tetap setelah Start()
+    std::vector<std::thread> workers;
+    TimerState lastState;
+    bool hasLastState;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable idle;
+    std::vector<Job> queue;       // kapasitas QUEUE_CAPACITY, dialokasikan saat Start()
+    size_t maxQueueDepth;
+    size_t runningCount;
+    bool stopping;
+
+    void Run();
+    bool TakeJob(Job& job);
+    bool RunCommand(size_t index, const SessionHook& hook, const HookEventData& data, bool& timedOut);
+};
+
+#endif // SESSION_HOOKS_H
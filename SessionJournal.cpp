@@ -0,0 +1,265 @@
+// SessionJournal.cpp
+#include "SessionJournal.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char JOURNAL_MAGIC[8] = { 'P', 'M', 'J', 'R', 'N', 'L', '1', '\0' };
+const uint32_t JOURNAL_VERSION = 1;
+const size_t INITIAL_CAPACITY = 4096;
+
+// Header di awal file, 64 byte
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t count;
+    unsigned char padding[40];
+};
+
+static_assert(sizeof(Header) == 64, "header jurnal harus 64 byte");
+
+Header* HeaderOf(unsigned char* base) {
+    return reinterpret_cast<Header*>(base);
+}
+
+}
+
+SessionJournal::SessionJournal()
+    : base(nullptr), mappedBytes(0), capacity(0),
+#ifdef _WIN32
+      fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#else
+      fd(-1)
+#endif
+{
+}
+
+SessionJournal::~SessionJournal() {
+    Close();
+}
+
+bool SessionJournal::Open(const std::string& journalPath) {
+    Close();
+    path = journalPath;
+
+    size_t fileBytes = 0;
+#ifdef _WIN32
+    // Tanpa FILE_SHARE_WRITE: pembuka kedua dengan akses tulis ditolak
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                             NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size)) {
+        Close();
+        return false;
+    }
+    fileBytes = static_cast<size_t>(size.QuadPart);
+#else
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    // Kunci lepas sendiri saat fd ditutup atau prosesnya mati
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        Close();
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        Close();
+        return false;
+    }
+    fileBytes = static_cast<size_t>(st.st_size);
+#endif
+
+    bool fresh = fileBytes < sizeof(Header);
+    if (fresh) {
+        fileBytes = sizeof(Header) + INITIAL_CAPACITY * sizeof(SessionRecord);
+    }
+    if (!Map(fileBytes)) {
+        Close();
+        return false;
+    }
+
+    Header* header = HeaderOf(base);
+    if (fresh) {
+        std::memset(header, 0, sizeof(Header));
+        std::memcpy(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+        header->version = JOURNAL_VERSION;
+        header->recordSize = sizeof(SessionRecord);
+        header->count = 0;
+    } else if (std::memcmp(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+               header->version != JOURNAL_VERSION ||
+               header->recordSize != sizeof(SessionRecord)) {
+        // Bukan jurnal yang kita kenal; jangan sentuh isinya
+        Close();
+        return false;
+    }
+
+    if (header->count > capacity) {
+        header->count = capacity;
+    }
+    return true;
+}
+
+void SessionJournal::Close() {
+    Unmap();
+#ifdef _WIN32
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+bool SessionJournal::Append(const SessionRecord& record) {
+    if (!IsOpen()) {
+        return false;
+    }
+    Header* header = HeaderOf(base);
+    size_t count = static_cast<size_t>(header->count);
+    if (count >= capacity) {
+        if (!Grow(capacity * 2)) {
+            return false;
+        }
+        header = HeaderOf(base);
+    }
+
+    SessionRecord* records = reinterpret_cast<SessionRecord*>(base + sizeof(Header));
+    records[count] = record;
+    records[count].reserved = 0;
+    // Jaga urutan indeks walaupun jam dinding mundur (NTP, ganti zona)
+    if (count > 0 && records[count].endMs < records[count - 1].endMs) {
+        records[count].endMs = records[count - 1].endMs;
+    }
+
+    // Record ditulis dulu, baru jumlahnya dinaikkan
+    header->count = count + 1;
+    return true;
+}
+
+void SessionJournal::Sync() {
+    if (!IsOpen()) {
+        return;
+    }
+#ifdef _WIN32
+    FlushViewOfFile(base, mappedBytes);
+#else
+    msync(base, mappedBytes, MS_ASYNC);
+#endif
+}
+
+size_t SessionJournal::Size() const {
+    return IsOpen() ? static_cast<size_t>(HeaderOf(base)->count) : 0;
+}
+
+const SessionRecord* SessionJournal::Records() const {
+    return IsOpen() ? reinterpret_cast<const SessionRecord*>(base + sizeof(Header)) : nullptr;
+}
+
+void SessionJournal::FindRange(int64_t fromMs, int64_t toMs, size_t& first, size_t& last) const {
+    first = LowerBound(fromMs);
+    last = LowerBound(toMs);
+    if (last < first) {
+        last = first;
+    }
+}
+
+bool SessionJournal::Map(size_t bytes) {
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(bytes);
+    mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READWRITE,
+                                       size.HighPart, size.LowPart, NULL);
+    if (!mappingHandle) {
+        return false;
+    }
+    void* view = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!view) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+        return false;
+    }
+#else
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        return false;
+    }
+    if (static_cast<size_t>(st.st_size) < bytes && ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        return false;
+    }
+    void* view = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+#endif
+    base = static_cast<unsigned char*>(view);
+    mappedBytes = bytes;
+    capacity = (bytes - sizeof(Header)) / sizeof(SessionRecord);
+    return true;
+}
+
+void SessionJournal::Unmap() {
+    if (!base) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(mappingHandle);
+    mappingHandle = nullptr;
+#else
+    munmap(base, mappedBytes);
+#endif
+    base = nullptr;
+    mappedBytes = 0;
+    capacity = 0;
+}
+
+bool SessionJournal::Grow(size_t minRecords) {
+    if (minRecords < INITIAL_CAPACITY) {
+        minRecords = INITIAL_CAPACITY;
+    }
+    size_t bytes = sizeof(Header) + minRecords * sizeof(SessionRecord);
+    size_t oldBytes = mappedBytes;
+    Unmap();
+    if (!Map(bytes)) {
+        // Kembalikan pemetaan lama agar jurnal tetap bisa dibaca
+        Map(oldBytes);
+        return false;
+    }
+    return true;
+}
+
+size_t SessionJournal::LowerBound(int64_t endMs) const {
+    const SessionRecord* records = Records();
+    size_t low = 0;
+    size_t high = Size();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (records[mid].endMs < endMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
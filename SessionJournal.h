@@ -0,0 +1,84 @@
+// SessionJournal.h
+#ifndef SESSION_JOURNAL_H
+#define SESSION_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Nama file jurnal default
+const char* const JOURNAL_FILE = "pomodoro_journal.bin";
+
+enum SessionType {
+    SESSION_FOCUS = 0,
+    SESSION_BREAK = 1
+};
+
+enum SessionFlags {
+    RECORD_COMPLETED = 1 << 0,   // sesi habis sampai deadline
+    RECORD_RESET = 1 << 1        // sesi dihentikan dengan Reset
+};
+
+// Satu sesi, ukuran tetap. Waktu dalam milidetik epoch (jam dinding).
+struct SessionRecord {
+    int64_t startMs;
+    int64_t endMs;            // kunci indeks waktu, tidak pernah mundur
+    int32_t plannedSeconds;
+    int32_t actualSeconds;    // waktu berjalan, tanpa waktu jeda
+    int32_t pausedSeconds;
+    uint16_t pauseCount;
+    uint8_t type;             // SessionType
+    uint8_t flags;            // SessionFlags
+    uint32_t taskId;          // task sesi fokus (TaskStore), 0 = tanpa task
+    uint32_t reserved;        // selalu 0
+};
+
+static_assert(sizeof(SessionRecord) == 40, "format SessionRecord berubah");
+
+// Jurnal sesi append-only dengan record berukuran tetap di file yang
+// di-memory-map. Record tersusun menurut endMs, sehingga query rentang
+// waktu cukup binary search langsung di file: O(log n) tanpa parsing.
+class SessionJournal {
+public:
+    SessionJournal();
+    ~SessionJournal();
+
+    // Hanya satu penulis per file: count di header dinaikkan dan file
+    // diperbesar tanpa sinkronisasi antarproses, jadi Open() gagal selama
+    // proses lain membuka jurnal yang sama
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return base != nullptr; }
+
+    bool Append(const SessionRecord& record);
+    // Meminta OS menulis halaman yang kotor ke disk
+    void Sync();
+
+    size_t Size() const;
+    // Pointer hanya valid sampai Append() berikutnya (file bisa dipetakan ulang)
+    const SessionRecord* Records() const;
+    const SessionRecord& At(size_t index) const { return Records()[index]; }
+
+    // Indeks [first, last) record dengan fromMs <= endMs < toMs
+    void FindRange(int64_t fromMs, int64_t toMs, size_t& first, size_t& last) const;
+
+private:
+    std::string path;
+    unsigned char* base;
+    size_t mappedBytes;
+    size_t capacity;      // jumlah record yang muat di pemetaan saat ini
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+
+    bool Map(size_t bytes);
+    void Unmap();
+    bool Grow(size_t minRecords);
+    size_t LowerBound(int64_t endMs) const;
+};
+
+#endif // SESSION_JOURNAL_H
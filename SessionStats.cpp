@@ -0,0 +1,309 @@
+// SessionStats.cpp
+#include "SessionStats.h"
+
+#include <cstdio>
+#include <ctime>
+#include <cstring>
+
+namespace {
+
+// Blok record yang diproses sekaligus saat Rebuild(); kolomnya muat di L2
+const size_t REBUILD_BLOCK = 16384;
+
+int64_t FloorDiv(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+// Senin sebagai awal minggu; 1970-01-01 adalah hari Kamis
+int32_t WeekOfDay(int32_t day) {
+    return static_cast<int32_t>(FloorDiv(static_cast<int64_t>(day) + 3, 7));
+}
+
+// Indeks bulan (tahun * 12 + bulan) dari nomor hari sejak epoch
+int32_t MonthOfDay(int32_t day) {
+    int64_t z = static_cast<int64_t>(day) + 719468;
+    int64_t era = FloorDiv(z, 146097);
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+    return static_cast<int32_t>(year * 12 + (month - 1));
+}
+
+// Kernel jumlah dan hitung pada kolom yang bersebelahan di memori.
+// Tanpa cabang di dalam loop sehingga compiler bisa memvektorkannya.
+int64_t SumColumn(const int32_t* values, size_t count) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+int64_t CountColumn(const uint8_t* values, size_t count) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+}
+
+int LocalUtcOffsetSeconds() {
+    return LocalUtcOffsetSeconds(std::time(nullptr));
+}
+
+int LocalUtcOffsetSeconds(std::time_t at) {
+#ifdef _WIN32
+    long timezone = 0;
+    long dstBias = 0;
+    _get_timezone(&timezone);
+    _get_dstbias(&dstBias);
+    std::tm local;
+    if (localtime_s(&local, &at) != 0) {
+        local.tm_isdst = 0;
+    }
+    return static_cast<int>(-(timezone + (local.tm_isdst > 0 ? dstBias : 0)));
+#else
+    std::tm local;
+    if (!localtime_r(&at, &local)) {
+        // Di luar rentang yang dikenal libc
+        at = std::time(nullptr);
+        localtime_r(&at, &local);
+    }
+    return static_cast<int>(local.tm_gmtoff);
+#endif
+}
+
+SessionStats::SessionStats()
+    : fixedOffset(false), utcOffsetSeconds(0), cachedWindowStart(0), cachedOffset(0),
+      cachedEndOffset(0), hasCachedOffset(false) {
+    Clear();
+}
+
+void SessionStats::SetUtcOffsetSeconds(int offsetSeconds) {
+    fixedOffset = true;
+    utcOffsetSeconds = offsetSeconds;
+}
+
+// Offset zona lokal yang berlaku pada saat itu, bukan offset hari ini:
+// sesi di sisi lain pergantian DST tetap masuk jam dan hari lokalnya.
+// Di-cache per jendela OFFSET_WINDOW_SECONDS: jika offset di kedua ujung
+// jendela sama, berlaku untuk seluruh jendela. Jendela yang memuat
+// pergantian bertanya ke localtime per panggilan. Record tersusun menurut
+// waktu, jadi Rebuild() hampir selalu mengenai cache.
+int SessionStats::LookupOffset(int64_t wallSeconds) const {
+    if (!hasCachedOffset || wallSeconds < cachedWindowStart ||
+        wallSeconds - cachedWindowStart >= OFFSET_WINDOW_SECONDS) {
+        int64_t first = FloorDiv(wallSeconds, OFFSET_WINDOW_SECONDS) * OFFSET_WINDOW_SECONDS;
+        // Jendela berikutnya: offset detik terakhir jendela sebelumnya
+        // sudah diketahui, jadi cukup satu localtime
+        cachedOffset = hasCachedOffset && first == cachedWindowStart + OFFSET_WINDOW_SECONDS
+                           ? cachedEndOffset
+                           : LocalUtcOffsetSeconds(static_cast<std::time_t>(first));
+        cachedEndOffset =
+            LocalUtcOffsetSeconds(static_cast<std::time_t>(first + OFFSET_WINDOW_SECONDS - 1));
+        cachedWindowStart = first;
+        hasCachedOffset = true;
+    }
+    if (cachedOffset != cachedEndOffset) {
+        return LocalUtcOffsetSeconds(static_cast<std::time_t>(wallSeconds));
+    }
+    return cachedOffset;
+}
+
+void SessionStats::Clear() {
+    firstDay = 0;
+    firstWeek = 0;
+    firstMonth = 0;
+    dayFocusSeconds.clear();
+    weekFocusSeconds.clear();
+    monthFocusSeconds.clear();
+    std::memset(hourFocusSeconds, 0, sizeof(hourFocusSeconds));
+    focusCompleted = 0;
+    focusReset = 0;
+    lastStreakDay = 0;
+    currentRun = 0;
+    longestRun = 0;
+}
+
+void SessionStats::Add(const SessionRecord& record) {
+    if (record.type != SESSION_FOCUS) {
+        return;
+    }
+
+    int32_t day = LocalDay(record.endMs);
+    AddToBuckets(day, record.actualSeconds);
+    hourFocusSeconds[LocalHour(record.startMs)] += record.actualSeconds;
+
+    if (record.flags & RECORD_COMPLETED) {
+        focusCompleted++;
+        AddStreakDay(day);
+    } else if (record.flags & RECORD_RESET) {
+        focusReset++;
+    }
+}
+
+void SessionStats::Rebuild(const SessionRecord* records, size_t count) {
+    Clear();
+
+    // Kolom untuk satu blok: diisi sekali dari record (AoS), lalu kernel
+    // berjalan di atas array yang rapat
+    std::vector<int32_t> dayColumn(REBUILD_BLOCK);
+    std::vector<int32_t> focusColumn(REBUILD_BLOCK);
+    std::vector<uint8_t> hourColumn(REBUILD_BLOCK);
+    std::vector<uint8_t> completedColumn(REBUILD_BLOCK);
+    std::vector<uint8_t> resetColumn(REBUILD_BLOCK);
+
+    for (size_t blockStart = 0; blockStart < count; blockStart += REBUILD_BLOCK) {
+        size_t n = count - blockStart;
+        if (n > REBUILD_BLOCK) {
+            n = REBUILD_BLOCK;
+        }
+        const SessionRecord* block = records + blockStart;
+
+        for (size_t i = 0; i < n; ++i) {
+            const SessionRecord& r = block[i];
+            int32_t isFocus = (r.type == SESSION_FOCUS) ? 1 : 0;
+            dayColumn[i] = LocalDay(r.endMs);
+            focusColumn[i] = r.actualSeconds * isFocus;
+            hourColumn[i] = static_cast<uint8_t>(LocalHour(r.startMs));
+            completedColumn[i] = static_cast<uint8_t>(isFocus & ((r.flags & RECORD_COMPLETED) ? 1 : 0));
+            resetColumn[i] = static_cast<uint8_t>(isFocus & ((r.flags & RECORD_RESET) ? 1 : 0));
+        }
+
+        focusCompleted += CountColumn(completedColumn.data(), n);
+        focusReset += CountColumn(resetColumn.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            hourFocusSeconds[hourColumn[i]] += focusColumn[i];
+        }
+
+        // Record tersusun menurut waktu, jadi satu hari = satu rentang rapat
+        size_t runStart = 0;
+        while (runStart < n) {
+            int32_t day = dayColumn[runStart];
+            size_t runEnd = runStart + 1;
+            while (runEnd < n && dayColumn[runEnd] == day) {
+                runEnd++;
+            }
+            size_t runLength = runEnd - runStart;
+            AddToBuckets(day, SumColumn(focusColumn.data() + runStart, runLength));
+            if (CountColumn(completedColumn.data() + runStart, runLength) > 0) {
+                AddStreakDay(day);
+            }
+            runStart = runEnd;
+        }
+    }
+}
+
+StatsSummary SessionStats::Summarize(int64_t nowWallMs) const {
+    StatsSummary summary;
+    int32_t today = LocalDay(nowWallMs);
+
+    summary.todayFocusMinutes = static_cast<int>(BucketAt(dayFocusSeconds, firstDay, today) / 60);
+    summary.weekFocusMinutes = static_cast<int>(BucketAt(weekFocusSeconds, firstWeek, WeekOfDay(today)) / 60);
+    summary.monthFocusMinutes = static_cast<int>(BucketAt(monthFocusSeconds, firstMonth, MonthOfDay(today)) / 60);
+
+    bool streakAlive = currentRun > 0 && (lastStreakDay == today || lastStreakDay == today - 1);
+    summary.currentStreakDays = streakAlive ? currentRun : 0;
+    summary.longestStreakDays = longestRun;
+
+    long long finished = focusCompleted + focusReset;
+    summary.completionPercent = finished > 0 ? static_cast<int>(focusCompleted * 100 / finished) : 0;
+    summary.focusSessions = focusCompleted;
+
+    for (int h = 0; h < 24; ++h) {
+        summary.hourFocusMinutes[h] = static_cast<int>(hourFocusSeconds[h] / 60);
+    }
+    return summary;
+}
+
+std::string SessionStats::FormatSummary(const StatsSummary& summary, int completedSessions) {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "Sesi selesai: %d\n"
+                  "Hari ini: %d mnt | Minggu ini: %d mnt | Bulan ini: %d mnt\n"
+                  "Streak: %d hari (terbaik %d) | Tuntas: %d%%",
+                  completedSessions,
+                  summary.todayFocusMinutes, summary.weekFocusMinutes, summary.monthFocusMinutes,
+                  summary.currentStreakDays, summary.longestStreakDays,
+                  summary.completionPercent);
+    return buffer;
+}
+
+std::string SessionStats::FormatHourHistogram(const StatsSummary& summary) {
+    static const char* const levels[8] = {
+        "\xE2\x96\x81", "\xE2\x96\x82", "\xE2\x96\x83", "\xE2\x96\x84",
+        "\xE2\x96\x85", "\xE2\x96\x86", "\xE2\x96\x87", "\xE2\x96\x88"
+    };
+
+    int maxMinutes = 0;
+    for (int h = 0; h < 24; ++h) {
+        if (summary.hourFocusMinutes[h] > maxMinutes) {
+            maxMinutes = summary.hourFocusMinutes[h];
+        }
+    }
+
+    std::string text = "00 ";
+    for (int h = 0; h < 24; ++h) {
+        int level = maxMinutes > 0 ? summary.hourFocusMinutes[h] * 7 / maxMinutes : 0;
+        text += levels[level];
+    }
+    text += " 23";
+    return text;
+}
+
+int32_t SessionStats::LocalDay(int64_t wallMs) const {
+    int64_t seconds = FloorDiv(wallMs, 1000);
+    return static_cast<int32_t>(FloorDiv(seconds + OffsetAt(seconds), 86400));
+}
+
+int SessionStats::LocalHour(int64_t wallMs) const {
+    int64_t seconds = FloorDiv(wallMs, 1000);
+    int64_t secondOfDay = seconds + OffsetAt(seconds);
+    secondOfDay -= FloorDiv(secondOfDay, 86400) * 86400;
+    return static_cast<int>(secondOfDay / 3600);
+}
+
+void SessionStats::AddToBuckets(int32_t day, int64_t focusSeconds) {
+    AddAt(dayFocusSeconds, firstDay, day, focusSeconds);
+    AddAt(weekFocusSeconds, firstWeek, WeekOfDay(day), focusSeconds);
+    AddAt(monthFocusSeconds, firstMonth, MonthOfDay(day), focusSeconds);
+}
+
+void SessionStats::AddStreakDay(int32_t day) {
+    if (currentRun > 0 && day <= lastStreakDay) {
+        return;
+    }
+    currentRun = (currentRun > 0 && day == lastStreakDay + 1) ? currentRun + 1 : 1;
+    lastStreakDay = day;
+    if (currentRun > longestRun) {
+        longestRun = currentRun;
+    }
+}
+
+void SessionStats::AddAt(std::vector<int64_t>& buckets, int32_t& first, int32_t index, int64_t value) {
+    if (buckets.empty()) {
+        first = index;
+        buckets.push_back(0);
+    } else if (index < first) {
+        // Jarang: record lebih tua dari bucket pertama
+        buckets.insert(buckets.begin(), static_cast<size_t>(first - index), 0);
+        first = index;
+    } else if (static_cast<size_t>(index - first) >= buckets.size()) {
+        buckets.resize(static_cast<size_t>(index - first) + 1, 0);
+    }
+    buckets[static_cast<size_t>(index - first)] += value;
+}
+
+int64_t SessionStats::BucketAt(const std::vector<int64_t>& buckets, int32_t first, int32_t index) {
+    if (buckets.empty() || index < first || static_cast<size_t>(index - first) >= buckets.size()) {
+        return 0;
+    }
+    return buckets[static_cast<size_t>(index - first)];
+}
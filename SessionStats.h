@@ -0,0 +1,102 @@
+// SessionStats.h
+#ifndef SESSION_STATS_H
+#define SESSION_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "SessionJournal.h"
+
+// Ringkasan yang ditampilkan di statsText
+struct StatsSummary {
+    int todayFocusMinutes;
+    int weekFocusMinutes;      // minggu kalender (Senin-Minggu)
+    int monthFocusMinutes;     // bulan kalender
+    int currentStreakDays;     // hari berturut-turut dengan sesi fokus selesai
+    int longestStreakDays;
+    int completionPercent;     // fokus selesai / (selesai + di-reset)
+    long long focusSessions;
+    int hourFocusMinutes[24];  // distribusi menit fokus menurut jam mulai
+};
+
+// Offset zona waktu lokal saat ini dalam detik (UTC+7 = 25200)
+int LocalUtcOffsetSeconds();
+// Offset zona waktu lokal yang berlaku pada waktu itu (termasuk DST)
+int LocalUtcOffsetSeconds(std::time_t at);
+
+// Statistik inkremental di atas bucket harian, mingguan dan bulanan.
+// Add() memperbarui bucket dalam O(1); Rebuild() menghitung ulang dari
+// riwayat mentah dengan scan kolom per blok. Hari dan jam lokal setiap
+// record memakai offset zona waktu yang berlaku saat record itu terjadi.
+class SessionStats {
+public:
+    // Jendela cache offset zona waktu; pergantian offset selalu berjarak
+    // jauh lebih dari seminggu
+    static const int64_t OFFSET_WINDOW_SECONDS = 7 * 86400;
+
+    SessionStats();
+
+    // Pakai satu offset tetap untuk semua record, bukan zona waktu lokal
+    void SetUtcOffsetSeconds(int offsetSeconds);
+
+    void Clear();
+    void Add(const SessionRecord& record);
+    void Rebuild(const SessionRecord* records, size_t count);
+
+    StatsSummary Summarize(int64_t nowWallMs) const;
+
+    // Teks ringkas untuk GUI/terminal
+    static std::string FormatSummary(const StatsSummary& summary, int completedSessions);
+    // Sparkline 24 jam dalam UTF-8
+    static std::string FormatHourHistogram(const StatsSummary& summary);
+
+private:
+    bool fixedOffset;
+    int utcOffsetSeconds;    // hanya jika fixedOffset
+    mutable int64_t cachedWindowStart;   // detik UTC awal jendela cache offset
+    mutable int cachedOffset;            // offset di awal dan akhir jendela itu
+    mutable int cachedEndOffset;
+    mutable bool hasCachedOffset;
+
+    // Bucket: indeks = nomor hari/minggu/bulan lokal dikurangi basisnya
+    int32_t firstDay;
+    int32_t firstWeek;
+    int32_t firstMonth;
+    std::vector<int64_t> dayFocusSeconds;
+    std::vector<int64_t> weekFocusSeconds;
+    std::vector<int64_t> monthFocusSeconds;
+    int64_t hourFocusSeconds[24];
+
+    long long focusCompleted;
+    long long focusReset;
+
+    // Streak dihitung saat record masuk (record tersusun menurut waktu)
+    int32_t lastStreakDay;
+    int currentRun;
+    int longestRun;
+
+    // Jalur cepat inline: offset tetap, atau masih di jendela cache tanpa
+    // pergantian offset
+    int OffsetAt(int64_t wallSeconds) const {
+        if (fixedOffset) {
+            return utcOffsetSeconds;
+        }
+        if (hasCachedOffset && cachedOffset == cachedEndOffset &&
+            static_cast<uint64_t>(wallSeconds - cachedWindowStart) < OFFSET_WINDOW_SECONDS) {
+            return cachedOffset;
+        }
+        return LookupOffset(wallSeconds);
+    }
+    int LookupOffset(int64_t wallSeconds) const;
+    int32_t LocalDay(int64_t wallMs) const;
+    int LocalHour(int64_t wallMs) const;
+    void AddToBuckets(int32_t day, int64_t focusSeconds);
+    void AddStreakDay(int32_t day);
+
+    static void AddAt(std::vector<int64_t>& buckets, int32_t& first, int32_t index, int64_t value);
+    static int64_t BucketAt(const std::vector<int64_t>& buckets, int32_t first, int32_t index);
+};
+
+#endif // SESSION_STATS_H
@@ -0,0 +1,158 @@
+// SettingsStore.cpp
+#include "SettingsStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool LoadSettingsFile(const std::string& path, Settings& settings) {
+    std::ifstream file(path.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+    file >> settings.focusDuration >> settings.breakDuration
+         >> settings.darkMode >> settings.soundEnabled >> settings.completedSessions;
+    int ticking = 0;
+    if (file >> ticking) {
+        settings.tickingSound = (ticking != 0);
+    }
+    int idlePause = 0;
+    int idleMinutes = 0;
+    if (file >> idlePause >> idleMinutes && idleMinutes > 0) {
+        settings.idlePause = (idlePause != 0);
+        settings.idlePauseMinutes = idleMinutes;
+    }
+    int tray = 0;
+    if (file >> tray) {
+        settings.trayMode = (tray != 0);
+    }
+    int task = 0;
+    if (file >> task && task >= 0) {
+        settings.activeTask = task;
+    }
+    file.close();
+    return true;
+}
+
+bool WriteSettingsFile(const std::string& path, const Settings& settings) {
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = std::fprintf(file, "%d\n%d\n%d\n%d\n%d\n%d\n%d\n%d\n%d\n%d\n",
+                           settings.focusDuration, settings.breakDuration,
+                           settings.darkMode ? 1 : 0, settings.soundEnabled ? 1 : 0,
+                           settings.completedSessions, settings.tickingSound ? 1 : 0,
+                           settings.idlePause ? 1 : 0, settings.idlePauseMinutes,
+                           settings.trayMode ? 1 : 0, settings.activeTask) > 0;
+    ok = (std::fflush(file) == 0) && ok;
+#ifdef _WIN32
+    ok = (_commit(_fileno(file)) == 0) && ok;
+#else
+    ok = (fsync(fileno(file)) == 0) && ok;
+#endif
+    ok = (std::fclose(file) == 0) && ok;
+
+    if (!ok) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    return MoveFileExA(tempPath.c_str(), path.c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+}
+
+SettingsWriter::SettingsWriter(const std::string& path, int debounceMs)
+    : path(path), debounceMs(debounceMs), hasPending(false),
+      flushRequested(false), writing(false), stopping(false),
+      writeCount(0), scheduleCount(0) {
+    worker = std::thread(&SettingsWriter::Run, this);
+}
+
+SettingsWriter::~SettingsWriter() {
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    worker.join();
+}
+
+void SettingsWriter::Schedule(const Settings& settings) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = settings;
+        hasPending = true;
+        scheduleCount++;
+    }
+    wakeup.notify_one();
+}
+
+void SettingsWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (hasPending || writing) {
+        if (hasPending) {
+            flushRequested = true;
+            wakeup.notify_one();
+        }
+        written.wait(lock);
+    }
+}
+
+long long SettingsWriter::GetWriteCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writeCount;
+}
+
+long long SettingsWriter::GetScheduleCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return scheduleCount;
+}
+
+void SettingsWriter::Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wakeup.wait(lock, [this] { return hasPending || stopping; });
+        if (!hasPending && stopping) {
+            return;
+        }
+
+        // Debounce: tunggu sampai tidak ada perubahan baru selama debounceMs
+        long long seen = scheduleCount;
+        while (!flushRequested && !stopping) {
+            wakeup.wait_for(lock, std::chrono::milliseconds(debounceMs));
+            if (scheduleCount == seen) {
+                break;
+            }
+            seen = scheduleCount;
+        }
+
+        Settings snapshot = pending;
+        hasPending = false;
+        flushRequested = false;
+        writing = true;
+
+        // Tulis tanpa memegang lock agar Schedule() tidak pernah menunggu disk
+        lock.unlock();
+        WriteSettingsFile(path, snapshot);
+        lock.lock();
+
+        writing = false;
+        writeCount++;
+        written.notify_all();
+    }
+}
@@ -0,0 +1,75 @@
+// SettingsStore.h
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Nama file pengaturan default
+const char* const SETTINGS_FILE = "pomodoro_settings.txt";
+
+// Isi pomodoro_settings.txt
+struct Settings {
+    int focusDuration;    // dalam menit
+    int breakDuration;    // dalam menit
+    bool darkMode;
+    bool soundEnabled;
+    int completedSessions;
+    bool tickingSound;    // detak selama sesi; file lama tanpa baris ini tetap terbaca
+    bool idlePause;       // jeda fokus otomatis saat pengguna diam
+    int idlePauseMinutes; // ambang diam, dalam menit
+    bool trayMode;        // ikon countdown di tray; minimize menyembunyikan jendela
+    int activeTask;       // task untuk sesi fokus (TaskStore), 0 = tanpa task
+
+    Settings()
+        : focusDuration(25), breakDuration(5), darkMode(false),
+          soundEnabled(true), completedSessions(0), tickingSound(false),
+          idlePause(true), idlePauseMinutes(5), trayMode(false), activeTask(0) {}
+};
+
+// Membaca file pengaturan; nilai yang tidak terbaca tetap default
+bool LoadSettingsFile(const std::string& path, Settings& settings);
+
+// Menulis ke file sementara lalu rename atomik, sehingga crash di tengah
+// penulisan tidak pernah meninggalkan file pengaturan kosong
+bool WriteSettingsFile(const std::string& path, const Settings& settings);
+
+// Penulis pengaturan di thread terpisah. Perubahan beruntun (misalnya saat
+// slider digeser) digabung dan baru ditulis setelah tenang selama
+// debounceMs, sehingga thread GUI tidak pernah menunggu disk.
+class SettingsWriter {
+public:
+    explicit SettingsWriter(const std::string& path, int debounceMs = 300);
+    ~SettingsWriter();
+
+    // Murah: hanya menyalin nilai dan membangunkan worker
+    void Schedule(const Settings& settings);
+
+    // Menulis perubahan yang tertunda sekarang dan menunggu sampai selesai
+    void Flush();
+
+    long long GetWriteCount() const;
+    long long GetScheduleCount() const;
+
+private:
+    std::string path;
+    int debounceMs;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable written;
+    Settings pending;
+    bool hasPending;
+    bool flushRequested;
+    bool writing;
+    bool stopping;
+    long long writeCount;
+    long long scheduleCount;
+    std::thread worker;
+
+    void Run();
+};
+
+#endif // SETTINGS_STORE_H
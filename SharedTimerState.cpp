@@ -0,0 +1,497 @@
+// SharedTimerState.cpp
+#include "SharedTimerState.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <climits>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const uint32_t SEGMENT_MAGIC = 0x504D5348;   // "PMSH"
+const uint32_t SEGMENT_LAYOUT = 1;
+const int STATE_WORDS = 7;
+// Batas pengulangan Read(): sequence yang tetap ganjil berarti pemilik mati
+// di tengah Publish(), bukan penulisan yang sebentar lagi selesai
+const int READ_SPIN_LIMIT = 4096;
+
+// Sequence ganjil = Publish() sedang menulis. Sequence dan isi state ada di
+// satu cache line, jadi satu Read() biasanya hanya menyentuh satu line.
+// wakeCount (word futex) dan waiters di line terpisah agar pembaca yang
+// menunggu tidak mengotori line yang dibaca per frame.
+struct alignas(64) Segment {
+    uint32_t magic;
+    uint32_t layout;
+    std::atomic<uint32_t> wakeCount;
+    std::atomic<uint32_t> waiters;
+    unsigned char padding[48];
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> words[STATE_WORDS];
+};
+
+static_assert(sizeof(Segment) == 128, "layout segmen berubah");
+static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+              std::atomic<uint64_t>::is_always_lock_free,
+              "seqlock di shared memory butuh atomic 64-bit tanpa kunci");
+
+// words[0] = state | inTransition << 8 | focusCompleted << 9 | completedSessions << 32
+// words[5] = focusMinutes | breakMinutes << 16 | ownerPid << 32
+void Encode(const SharedTimerState& state, uint64_t* words) {
+    words[0] = static_cast<uint64_t>(state.state) |
+               (state.inTransition ? 1ull << 8 : 0) |
+               (state.focusCompleted ? 1ull << 9 : 0) |
+               static_cast<uint64_t>(static_cast<uint32_t>(state.completedSessions)) << 32;
+    words[1] = static_cast<uint64_t>(state.deadlineMs);
+    words[2] = static_cast<uint64_t>(state.remainingMs);
+    words[3] = static_cast<uint64_t>(state.durationMs);
+    words[4] = static_cast<uint64_t>(state.transitionDeadlineMs);
+    words[5] = static_cast<uint64_t>(state.focusMinutes & 0xFFFF) |
+               static_cast<uint64_t>(state.breakMinutes & 0xFFFF) << 16 |
+               static_cast<uint64_t>(state.ownerPid) << 32;
+    words[6] = static_cast<uint64_t>(state.publishedMs);
+}
+
+void Decode(const uint64_t* words, SharedTimerState& state) {
+    state.state = static_cast<TimerState>(words[0] & 0xFF);
+    state.inTransition = (words[0] & (1ull << 8)) != 0;
+    state.focusCompleted = (words[0] & (1ull << 9)) != 0;
+    state.completedSessions = static_cast<int>(static_cast<uint32_t>(words[0] >> 32));
+    state.deadlineMs = static_cast<int64_t>(words[1]);
+    state.remainingMs = static_cast<int64_t>(words[2]);
+    state.durationMs = static_cast<int64_t>(words[3]);
+    state.transitionDeadlineMs = static_cast<int64_t>(words[4]);
+    state.focusMinutes = static_cast<int>(words[5] & 0xFFFF);
+    state.breakMinutes = static_cast<int>((words[5] >> 16) & 0xFFFF);
+    state.ownerPid = static_cast<uint32_t>(words[5] >> 32);
+    state.publishedMs = static_cast<int64_t>(words[6]);
+}
+
+#ifdef __linux__
+// Futex antar-proses (tanpa FUTEX_PRIVATE_FLAG) pada word di shared memory
+long Futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+}
+
+void WakeWaiters(Segment* shared) {
+    shared->wakeCount.fetch_add(1, std::memory_order_seq_cst);
+    if (shared->waiters.load(std::memory_order_seq_cst) > 0) {
+        Futex(&shared->wakeCount, FUTEX_WAKE, INT_MAX, nullptr);
+    }
+}
+#endif
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+}
+
+int64_t SharedTimerState::RemainingMs(int64_t nowMs) const {
+    if (deadlineMs < 0) {
+        return remainingMs;
+    }
+    return deadlineMs > nowMs ? deadlineMs - nowMs : 0;
+}
+
+int SharedTimerState::RemainingSeconds(int64_t nowMs) const {
+    return static_cast<int>((RemainingMs(nowMs) + 999) / 1000);
+}
+
+int SharedTimerState::TransitionSecondsLeft(int64_t nowMs) const {
+    if (!inTransition) {
+        return 0;
+    }
+    int64_t left = transitionDeadlineMs - nowMs;
+    return left > 0 ? static_cast<int>((left + 999) / 1000) : 0;
+}
+
+double SharedTimerState::ProgressFraction(int64_t nowMs) const {
+    if (state == READY || durationMs <= 0) {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(RemainingMs(nowMs)) / static_cast<double>(durationMs);
+}
+
+int SharedTimerState::ProgressPercent(int64_t nowMs) const {
+    if (state == READY || durationMs <= 0) {
+        return 0;
+    }
+    return static_cast<int>(100 - (RemainingMs(nowMs) * 100 / durationMs));
+}
+
+int64_t SharedTimerState::NextWakeupMs(int64_t nowMs) const {
+    int64_t deadline = inTransition ? transitionDeadlineMs : deadlineMs;
+    if (deadline < 0) {
+        return -1;
+    }
+    int64_t left = deadline - nowMs;
+    if (left <= 0) {
+        // Pemilik yang akan memajukan state; cek lagi sebentar lagi
+        return nowMs + 100;
+    }
+    int64_t delay = left % 1000;
+    return nowMs + (delay == 0 ? 1000 : delay);
+}
+
+SharedTimerState CaptureSharedState(const TimerCore& core) {
+    SharedTimerState state;
+    state.state = core.GetState();
+    state.inTransition = core.InTransition();
+    state.focusCompleted = core.WasFocusCompleted();
+    state.remainingMs = core.RemainingMs();
+    state.durationMs = core.SessionDurationMs();
+    if (core.InTransition()) {
+        state.transitionDeadlineMs = core.NextDeadlineMs();
+    } else if (core.IsRunning()) {
+        state.deadlineMs = core.NextDeadlineMs();
+    }
+    state.focusMinutes = core.GetFocusDuration();
+    state.breakMinutes = core.GetBreakDuration();
+    state.completedSessions = core.GetCompletedSessions();
+    state.publishedMs = core.GetClock().NowMs();
+    return state;
+}
+
+std::string DefaultSharedStateName() {
+#ifdef __linux__
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "/pomodoro-%u", static_cast<unsigned>(getuid()));
+    return buffer;
+#else
+    return "/pomodoro";
+#endif
+}
+
+SharedStatePublisher::SharedStatePublisher()
+    : segment(nullptr), fd(-1), publishCount(0), hasLast(false) {
+}
+
+SharedStatePublisher::~SharedStatePublisher() {
+    Close();
+}
+
+SharedStateReader::SharedStateReader() : segment(nullptr), fd(-1), retries(0) {
+}
+
+SharedStateReader::~SharedStateReader() {
+    Close();
+}
+
+SharedStateWatcher::SharedStateWatcher() : listener(nullptr), stopping(false) {
+}
+
+SharedStateWatcher::~SharedStateWatcher() {
+    Stop();
+}
+
+bool SharedStateWatcher::Start(const std::string& name, SharedStateListener* stateListener) {
+    Stop();
+    if (!stateListener || !reader.Open(name)) {
+        return false;
+    }
+    listener = stateListener;
+    stopping = false;
+    worker = std::thread(&SharedStateWatcher::Run, this);
+    return true;
+}
+
+void SharedStateWatcher::Stop() {
+    if (worker.joinable()) {
+        stopping = true;
+        reader.Wake();
+        worker.join();
+    }
+    reader.Close();
+}
+
+void SharedStateWatcher::Run() {
+    unsigned long long seen = 0;
+    bool hasState = false;
+    bool checkOwner = false;
+    while (!stopping) {
+        SharedTimerState state;
+        unsigned long long version;
+        if (reader.Read(state, version) && (!hasState || version != seen)) {
+            seen = version;
+            hasState = true;
+            listener->OnSharedStateChanged(state);
+        } else if (checkOwner && !reader.OwnerAlive()) {
+            listener->OnSharedOwnerGone();
+            return;
+        }
+        // Bangun tanpa snapshot baru berarti timeout atau pemilik menutup
+        // segmen; keduanya diikuti cek pemilik
+        reader.WaitForChange(seen, OWNER_CHECK_MS);
+        checkOwner = true;
+    }
+}
+
+#ifdef __linux__
+
+bool SharedStatePublisher::Open(const std::string& name) {
+    Close();
+    fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return false;
+    }
+    // Kunci pemilik; pembaca memakai LOCK_SH untuk tahu pemilik masih ada
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0 || ftruncate(fd, sizeof(Segment)) != 0) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    void* mapped = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    // Sequence genap dari pemilik sebelumnya dipertahankan agar versi yang
+    // dilihat pembaca tidak mundur; yang ganjil berarti pemilik mati saat
+    // menulis
+    Segment* shared = static_cast<Segment*>(mapped);
+    uint64_t sequence = shared->sequence.load(std::memory_order_relaxed);
+    if (shared->magic != SEGMENT_MAGIC || shared->layout != SEGMENT_LAYOUT) {
+        sequence = 0;
+    }
+    shared->sequence.store(sequence + (sequence & 1), std::memory_order_relaxed);
+    shared->magic = SEGMENT_MAGIC;
+    shared->layout = SEGMENT_LAYOUT;
+    segment = mapped;
+    publishCount = 0;
+    hasLast = false;
+    return true;
+}
+
+// Kunci dilepas sebelum pembaca dibangunkan, agar OwnerAlive() mereka
+// langsung melihat pemilik sudah tidak ada
+void SharedStatePublisher::Close() {
+    if (fd >= 0) {
+        flock(fd, LOCK_UN);
+    }
+    if (segment) {
+        WakeWaiters(static_cast<Segment*>(segment));
+        munmap(segment, sizeof(Segment));
+        segment = nullptr;
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+bool SharedStatePublisher::Publish(const SharedTimerState& state) {
+    if (!segment) {
+        return false;
+    }
+    Segment* shared = static_cast<Segment*>(segment);
+    SharedTimerState stamped = state;
+    stamped.ownerPid = static_cast<uint32_t>(getpid());
+    uint64_t words[STATE_WORDS];
+    Encode(stamped, words);
+
+    // Word 6 (publishedMs) tidak dibandingkan; word 2 (sisa) hanya jika
+    // sesi tidak berjalan
+    bool running = static_cast<int64_t>(words[1]) >= 0;
+    if (hasLast && std::memcmp(words, lastWords, 2 * sizeof(uint64_t)) == 0 &&
+        (running || words[2] == lastWords[2]) &&
+        std::memcmp(words + 3, lastWords + 3, 3 * sizeof(uint64_t)) == 0) {
+        return false;
+    }
+    std::memcpy(lastWords, words, sizeof(lastWords));
+    hasLast = true;
+
+    uint64_t sequence = shared->sequence.load(std::memory_order_relaxed);
+    shared->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < STATE_WORDS; ++i) {
+        shared->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    shared->sequence.store(sequence + 2, std::memory_order_release);
+    publishCount++;
+    WakeWaiters(shared);
+    return true;
+}
+
+bool SharedStateReader::Open(const std::string& name) {
+    Close();
+    // Baca-tulis hanya untuk word futex; isi state tidak pernah ditulis pembaca
+    fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Segment))) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    void* mapped = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    segment = mapped;
+    return true;
+}
+
+void SharedStateReader::Close() {
+    if (segment) {
+        munmap(segment, sizeof(Segment));
+        segment = nullptr;
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+bool SharedStateReader::Read(SharedTimerState& state, unsigned long long& version) {
+    if (!segment) {
+        return false;
+    }
+    const Segment* shared = static_cast<const Segment*>(segment);
+    if (shared->magic != SEGMENT_MAGIC || shared->layout != SEGMENT_LAYOUT) {
+        return false;
+    }
+    uint64_t words[STATE_WORDS];
+    uint64_t begin;
+    for (int attempt = 0;; ++attempt) {
+        if (attempt == READ_SPIN_LIMIT) {
+            // Pemanggil memeriksa OwnerAlive() setelah ini
+            return false;
+        }
+        begin = shared->sequence.load(std::memory_order_acquire);
+        if (begin & 1) {
+            retries++;
+            CpuRelax();
+            continue;
+        }
+        for (int i = 0; i < STATE_WORDS; ++i) {
+            words[i] = shared->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shared->sequence.load(std::memory_order_relaxed) == begin) {
+            break;
+        }
+        retries++;
+    }
+    if (begin == 0) {
+        return false;
+    }
+    Decode(words, state);
+    version = begin / 2;
+    return true;
+}
+
+bool SharedStateReader::WaitForChange(unsigned long long version, int timeoutMs) {
+    if (!segment) {
+        return false;
+    }
+    Segment* shared = static_cast<Segment*>(segment);
+    // wakeCount dibaca sebelum sequence: Publish() yang terjadi di antaranya
+    // mengubah wakeCount, sehingga futex tidak tidur
+    uint32_t observed = shared->wakeCount.load(std::memory_order_seq_cst);
+    shared->waiters.fetch_add(1, std::memory_order_seq_cst);
+    bool changed = shared->sequence.load(std::memory_order_seq_cst) / 2 != version;
+    bool woken = changed;
+    if (!changed) {
+        timespec timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+        woken = Futex(&shared->wakeCount, FUTEX_WAIT, observed, &timeout) == 0 ||
+                errno != ETIMEDOUT;
+    }
+    shared->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    return woken;
+}
+
+void SharedStateReader::Wake() {
+    if (segment) {
+        WakeWaiters(static_cast<Segment*>(segment));
+    }
+}
+
+bool SharedStateReader::OwnerAlive() const {
+    if (fd < 0) {
+        return false;
+    }
+    // Kunci bersama hanya didapat jika tidak ada pemilik
+    if (flock(fd, LOCK_SH | LOCK_NB) == 0) {
+        flock(fd, LOCK_UN);
+        return false;
+    }
+    return errno == EWOULDBLOCK;
+}
+
+#else
+
+bool SharedStatePublisher::Open(const std::string& name) {
+    return false;
+}
+
+void SharedStatePublisher::Close() {
+}
+
+bool SharedStatePublisher::Publish(const SharedTimerState& state) {
+    return false;
+}
+
+bool SharedStateReader::Open(const std::string& name) {
+    return false;
+}
+
+void SharedStateReader::Close() {
+}
+
+bool SharedStateReader::Read(SharedTimerState& state, unsigned long long& version) {
+    return false;
+}
+
+bool SharedStateReader::WaitForChange(unsigned long long version, int timeoutMs) {
+    return false;
+}
+
+void SharedStateReader::Wake() {
+}
+
+bool SharedStateReader::OwnerAlive() const {
+    return false;
+}
+
+#endif
+
+bool AcquireSharedOwnership(SharedStatePublisher& publisher, const std::string& name) {
+    SharedStateReader probe;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (publisher.Open(name)) {
+            return true;
+        }
+        if (!probe.Open(name)) {
+            return true;
+        }
+        if (probe.OwnerAlive()) {
+            return false;
+        }
+        // Pemilik baru saja keluar, atau cek ini bertabrakan dengan Open()
+        // instance lain: coba sekali lagi
+        probe.Close();
+    }
+    return false;
+}
@@ -0,0 +1,148 @@
+// SharedTimerState.h
+#ifndef SHARED_TIMER_STATE_H
+#define SHARED_TIMER_STATE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "TimerCore.h"
+
+// State sesi instance pemilik, cukup untuk menggambar countdown tanpa
+// TimerCore. Waktu absolut memakai MonotonicNowMs(), yang sama di semua
+// proses pada mesin yang sama.
+struct SharedTimerState {
+    TimerState state;
+    bool inTransition;
+    bool focusCompleted;          // jenis sesi yang baru selesai (masa transisi)
+    int64_t deadlineMs;           // akhir sesi yang berjalan, -1 jika tidak berjalan
+    int64_t remainingMs;          // sisa saat tidak berjalan (READY/jeda)
+    int64_t durationMs;           // panjang sesi, untuk progress
+    int64_t transitionDeadlineMs; // akhir masa transisi, -1 jika tidak ada
+    int focusMinutes;
+    int breakMinutes;
+    int completedSessions;
+    uint32_t ownerPid;
+    int64_t publishedMs;          // saat snapshot diterbitkan
+
+    SharedTimerState()
+        : state(READY), inTransition(false), focusCompleted(false), deadlineMs(-1),
+          remainingMs(0), durationMs(0), transitionDeadlineMs(-1), focusMinutes(25),
+          breakMinutes(5), completedSessions(0), ownerPid(0), publishedMs(0) {}
+
+    int64_t RemainingMs(int64_t nowMs) const;
+    int RemainingSeconds(int64_t nowMs) const;
+    int TransitionSecondsLeft(int64_t nowMs) const;
+    double ProgressFraction(int64_t nowMs) const;
+    int ProgressPercent(int64_t nowMs) const;
+    // Batas detik berikutnya saat tampilan berubah, atau -1 jika diam
+    int64_t NextWakeupMs(int64_t nowMs) const;
+};
+
+// Snapshot dari TimerCore milik instance pemilik
+SharedTimerState CaptureSharedState(const TimerCore& core);
+
+// "/pomodoro-<uid>" (objek POSIX shared memory)
+std::string DefaultSharedStateName();
+
+// Sisi pemilik: menerbitkan state ke segmen shared memory yang dijaga
+// seqlock. Hanya satu pemilik per segmen; Open() gagal selama proses lain
+// memegang kunci pemilik (flock pada segmen, lepas otomatis jika proses
+// itu mati). Publish() tidak pernah menunggu pembaca; futex hanya
+// dibangunkan jika ada pembaca yang sedang menunggu perubahan.
+class SharedStatePublisher {
+public:
+    SharedStatePublisher();
+    ~SharedStatePublisher();
+
+    bool Open(const std::string& name);
+    void Close();
+    bool IsOpen() const { return segment != nullptr; }
+
+    // Snapshot yang hanya berbeda sisa waktu sesi berjalan (pembaca
+    // menghitungnya sendiri dari deadline) tidak diterbitkan ulang, jadi
+    // tick per detik tidak membangunkan pembaca. true jika diterbitkan.
+    bool Publish(const SharedTimerState& state);
+    long long GetPublishCount() const { return publishCount; }
+
+private:
+    void* segment;
+    int fd;
+    long long publishCount;
+    bool hasLast;
+    uint64_t lastWords[7];
+};
+
+// Menjadi satu-satunya instance yang menulis jurnal, log checkpoint,
+// daftar task dan pengaturan. false jika proses lain sudah menjadi pemilik
+// segmen name; tanpa shared memory true dengan publisher tertutup
+// (instance berjalan sendiri).
+bool AcquireSharedOwnership(SharedStatePublisher& publisher, const std::string& name);
+
+// Sisi pembaca: sebanyak apa pun, di proses mana pun. Read() tanpa kunci
+// dan tanpa syscall; jika bertepatan dengan Publish() pembacaan diulang.
+class SharedStateReader {
+public:
+    SharedStateReader();
+    ~SharedStateReader();
+
+    bool Open(const std::string& name);
+    void Close();
+    bool IsOpen() const { return segment != nullptr; }
+
+    // false jika belum ada yang diterbitkan, atau jika penulisan tidak
+    // selesai dalam batas pengulangan (pemilik mati di tengah Publish()).
+    // version naik setiap Publish(), sehingga pemanggil bisa melewati
+    // snapshot yang sama.
+    bool Read(SharedTimerState& state, unsigned long long& version);
+    // Tidur (futex) sampai version berubah, Wake(), atau timeoutMs habis.
+    // true jika bangun sebelum timeout.
+    bool WaitForChange(unsigned long long version, int timeoutMs);
+    // Membangunkan semua yang sedang WaitForChange() pada segmen ini
+    void Wake();
+    // Satu syscall (flock); jangan dipanggil per frame
+    bool OwnerAlive() const;
+
+    long long GetRetryCount() const { return retries; }
+
+private:
+    void* segment;
+    int fd;
+    long long retries;
+};
+
+// Dipanggil dari thread SharedStateWatcher
+class SharedStateListener {
+public:
+    virtual ~SharedStateListener() {}
+
+    // Snapshot baru dari pemilik
+    virtual void OnSharedStateChanged(const SharedTimerState& state) = 0;
+    // Pemilik keluar atau mati; watcher berhenti setelah ini
+    virtual void OnSharedOwnerGone() = 0;
+};
+
+// Thread yang tidur di futex segmen dan meneruskan setiap snapshot baru ke
+// listener. Selama state tidak berubah thread ini hanya bangun setiap
+// OWNER_CHECK_MS untuk memastikan pemilik masih ada.
+class SharedStateWatcher {
+public:
+    static const int OWNER_CHECK_MS = 2000;
+
+    SharedStateWatcher();
+    ~SharedStateWatcher();
+
+    bool Start(const std::string& name, SharedStateListener* listener);
+    void Stop();
+    bool IsRunning() const { return worker.joinable(); }
+
+private:
+    SharedStateReader reader;
+    SharedStateListener* listener;
+    std::thread worker;
+    std::atomic<bool> stopping;
+
+    void Run();
+};
+
+#endif // SHARED_TIMER_STATE_H
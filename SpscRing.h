@@ -0,0 +1,51 @@
+// SpscRing.h
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+
+// Antrian lock-free satu produsen, satu konsumen dengan kapasitas tetap
+// (N harus pangkat dua). Push() dan Pop() tidak pernah menunggu dan tidak
+// mengalokasi; Push() gagal jika antrian penuh.
+template <typename T, size_t N>
+class SpscRing {
+    static_assert((N & (N - 1)) == 0, "kapasitas SpscRing harus pangkat dua");
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    // Hanya dari thread produsen
+    bool Push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        items[t & (N - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hanya dari thread konsumen
+    bool Pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[h & (N - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T items[N];
+    // Di cache line terpisah agar produsen dan konsumen tidak saling berebut
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,120 @@
+// StartupProfiler.cpp
+#include "StartupProfiler.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Waktu sejak exec dari /proc/self/stat (field 22, dalam tick sejak boot)
+double ReadProcessStartOffsetMs() {
+#ifdef __linux__
+    FILE* file = std::fopen("/proc/self/stat", "r");
+    if (!file) {
+        return -1.0;
+    }
+    char buffer[1024];
+    size_t length = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+    std::fclose(file);
+    buffer[length] = '\0';
+
+    // Nama proses di dalam kurung bisa berisi spasi; mulai setelah ')'
+    const char* cursor = std::strrchr(buffer, ')');
+    if (!cursor) {
+        return -1.0;
+    }
+    unsigned long long startTicks = 0;
+    int field = 2;
+    for (const char* p = cursor + 1; *p && field < 22; ++p) {
+        if (*p == ' ') {
+            field++;
+            if (field == 22 && std::sscanf(p + 1, "%llu", &startTicks) != 1) {
+                return -1.0;
+            }
+        }
+    }
+
+    struct timespec ts;
+    long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (field != 22 || ticksPerSecond <= 0 || clock_gettime(CLOCK_BOOTTIME, &ts) != 0) {
+        return -1.0;
+    }
+    double nowMs = ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+    double startMs = startTicks * 1000.0 / ticksPerSecond;
+    return nowMs > startMs ? nowMs - startMs : 0.0;
+#else
+    return -1.0;
+#endif
+}
+
+}
+
+StartupProfiler::StartupProfiler()
+    : begin(std::chrono::steady_clock::now()),
+      processStartOffsetMs(ReadProcessStartOffsetMs()), enabled(false) {
+}
+
+void StartupProfiler::Mark(const char* phase) {
+    double ms = ElapsedMs();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < phases.size(); ++i) {
+        if (phases[i].name == phase) {
+            return;
+        }
+    }
+    Phase entry;
+    entry.name = phase;
+    entry.ms = ms;
+    phases.push_back(entry);
+}
+
+bool StartupProfiler::HasMark(const char* phase) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < phases.size(); ++i) {
+        if (phases[i].name == phase) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double StartupProfiler::ElapsedMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+std::string StartupProfiler::Report() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string text;
+    char line[128];
+    if (processStartOffsetMs >= 0) {
+        std::snprintf(line, sizeof(line), "startup phase=exec_to_main ms=%.2f\n", processStartOffsetMs);
+        text += line;
+    }
+    double previous = 0.0;
+    for (size_t i = 0; i < phases.size(); ++i) {
+        std::snprintf(line, sizeof(line), "startup phase=%s ms=%.2f delta_ms=%.2f\n",
+                      phases[i].name.c_str(), phases[i].ms, phases[i].ms - previous);
+        text += line;
+        previous = phases[i].ms;
+    }
+    return text;
+}
+
+StartupProfiler& GetStartupProfiler() {
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+bool HasStartupTimingsFlag(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--startup-timings") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,53 @@
+// StartupProfiler.h
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Waktu fase startup (main, init toolkit, pengaturan, kontrol, paint
+// pertama, aset yang dimuat belakangan) relatif terhadap awal main().
+// Mark() selalu dicatat karena murah; laporan hanya dicetak jika
+// diaktifkan dengan --startup-timings.
+class StartupProfiler {
+public:
+    StartupProfiler();
+
+    void SetEnabled(bool enable) { enabled = enable; }
+    bool IsEnabled() const { return enabled; }
+
+    // Aman dari thread mana pun; fase yang sama hanya dicatat sekali
+    void Mark(const char* phase);
+    bool HasMark(const char* phase) const;
+
+    double ElapsedMs() const;
+
+    // Jarak dari exec proses sampai profiler dibuat, atau -1 jika tidak
+    // diketahui (resolusi tick kernel, biasanya 10 ms)
+    double ProcessStartOffsetMs() const { return processStartOffsetMs; }
+
+    // Satu baris per fase: "startup phase=<nama> ms=<total> delta_ms=<selisih>"
+    std::string Report() const;
+
+private:
+    struct Phase {
+        std::string name;
+        double ms;
+    };
+
+    std::chrono::steady_clock::time_point begin;
+    double processStartOffsetMs;
+    bool enabled;
+    mutable std::mutex mutex;
+    std::vector<Phase> phases;
+};
+
+// Profiler milik proses; dibuat saat pertama kali dipanggil (awal main)
+StartupProfiler& GetStartupProfiler();
+
+// true jika argumen berisi --startup-timings
+bool HasStartupTimingsFlag(int argc, char** argv);
+
+#endif // STARTUP_PROFILER_H
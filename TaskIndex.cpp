@@ -0,0 +1,306 @@
+// TaskIndex.cpp
+#include "TaskIndex.h"
+
+#include <algorithm>
+
+namespace {
+
+// Byte 0 sebagai pengisi gram awal kata; tidak pernah muncul di teks
+// yang sudah dinormalisasi
+uint32_t Gram(unsigned char a, unsigned char b, unsigned char c) {
+    return (static_cast<uint32_t>(a) << 16) | (static_cast<uint32_t>(b) << 8) | c;
+}
+
+const int FULL_MATCH_BONUS = 30;
+const int PREFIX_BONUS = 20;
+// Jumlah kata judul sama dengan query: judul yang persis diketik di depan
+const int EXACT_LENGTH_BONUS = 10;
+
+bool Better(const TaskMatch& a, const TaskMatch& b) {
+    return a.score != b.score ? a.score > b.score : a.id > b.id;
+}
+
+} // namespace
+
+TaskIndex::TaskIndex() : taskCount(0), lastId(0), postingCount(0) {}
+
+void TaskIndex::Clear() {
+    postings.clear();
+    hidden.clear();
+    wordCounts.clear();
+    hits.clear();
+    matchedTerms.clear();
+    scores.clear();
+    taskCount = 0;
+    lastId = 0;
+    postingCount = 0;
+}
+
+void TaskIndex::Reserve(size_t tasks) {
+    hidden.reserve(tasks + 1);
+    wordCounts.reserve(tasks + 1);
+    hits.reserve(tasks + 1);
+    matchedTerms.reserve(tasks + 1);
+    scores.reserve(tasks + 1);
+    touched.reserve(tasks);
+    candidates.reserve(tasks);
+}
+
+void TaskIndex::Normalize(const std::string& text, std::string& out) {
+    out.clear();
+    bool separator = true;
+    for (unsigned char c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<unsigned char>(c + ('a' - 'A'));
+        }
+        bool wordChar = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80;
+        if (wordChar) {
+            out.push_back(static_cast<char>(c));
+            separator = false;
+        } else if (!separator) {
+            out.push_back(' ');
+            separator = true;
+        }
+    }
+    if (!out.empty() && out.back() == ' ') {
+        out.pop_back();
+    }
+}
+
+void TaskIndex::WordGrams(const char* word, size_t length, std::vector<uint32_t>& grams) {
+    const unsigned char* w = reinterpret_cast<const unsigned char*>(word);
+    grams.push_back(Gram(0, 0, w[0]));
+    if (length >= 2) {
+        grams.push_back(Gram(0, w[0], w[1]));
+    }
+    for (size_t i = 0; i + 2 < length; ++i) {
+        grams.push_back(Gram(w[i], w[i + 1], w[i + 2]));
+    }
+}
+
+// Id yang dilewati (celah di daftar task) tetap ABSENT
+void TaskIndex::EnsureScratch(uint32_t id) {
+    if (hidden.size() <= id) {
+        hidden.resize(id + 1, ABSENT);
+        wordCounts.resize(id + 1, 0);
+        hits.resize(id + 1, 0);
+        matchedTerms.resize(id + 1, 0);
+        scores.resize(id + 1, 0);
+    }
+}
+
+void TaskIndex::Add(uint32_t id, const std::string& title) {
+    if (id == 0 || id <= lastId) {
+        return;
+    }
+    EnsureScratch(id);
+    hidden[id] = VISIBLE;
+    Normalize(title, textScratch);
+    gramScratch.clear();
+    int words = 0;
+    size_t start = 0;
+    while (start < textScratch.size()) {
+        size_t end = textScratch.find(' ', start);
+        if (end == std::string::npos) {
+            end = textScratch.size();
+        }
+        WordGrams(textScratch.data() + start, end - start, gramScratch);
+        words++;
+        start = end + 1;
+    }
+    wordCounts[id] = static_cast<uint8_t>(std::min(words, 255));
+    // Satu posting per gram per task
+    std::sort(gramScratch.begin(), gramScratch.end());
+    gramScratch.erase(std::unique(gramScratch.begin(), gramScratch.end()), gramScratch.end());
+    for (uint32_t gram : gramScratch) {
+        postings[gram].push_back(id);
+    }
+    postingCount += gramScratch.size();
+    taskCount++;
+    lastId = id;
+}
+
+void TaskIndex::SetHidden(uint32_t id, bool isHidden) {
+    if (id < hidden.size() && hidden[id] != ABSENT) {
+        hidden[id] = isHidden ? HIDDEN : VISIBLE;
+    }
+}
+
+const std::vector<uint32_t>* TaskIndex::Posting(uint32_t gram) const {
+    auto it = postings.find(gram);
+    return it == postings.end() ? nullptr : &it->second;
+}
+
+bool TaskIndex::BuildTerm(const char* word, size_t length, Term& term) const {
+    const unsigned char* w = reinterpret_cast<const unsigned char*>(word);
+    length = std::min(length, sizeof(term.grams) / sizeof(term.grams[0]) + 1);
+    term.gramCount = 0;
+    term.prefixGram = 0;
+    if (length <= 2) {
+        // Kata pendek hanya sebagai awal kata
+        term.grams[term.gramCount++] = length == 1 ? Gram(0, 0, w[0]) : Gram(0, w[0], w[1]);
+    } else {
+        for (size_t i = 0; i + 2 < length; ++i) {
+            uint32_t gram = Gram(w[i], w[i + 1], w[i + 2]);
+            if (std::find(term.grams, term.grams + term.gramCount, gram) ==
+                term.grams + term.gramCount) {
+                term.grams[term.gramCount++] = gram;
+            }
+        }
+        term.prefixGram = Gram(0, w[0], w[1]);
+        if (term.gramCount >= 4) {
+            // Kata panjang: awal kata ikut dihitung, sehingga huruf tertukar
+            // di depan (yang merusak hampir semua trigram) masih cocok
+            term.grams[term.gramCount++] = term.prefixGram;
+        }
+    }
+    // Satu huruf salah merusak sampai tiga trigram, dua huruf tertukar
+    // sampai empat; hanya kata yang cukup panjang yang boleh kehilangan
+    // sebagian
+    term.required = term.gramCount >= 4 ? (term.gramCount + 2) / 3 : term.gramCount;
+    term.cost = 0;
+    int present = 0;
+    for (int i = 0; i < term.gramCount; ++i) {
+        const std::vector<uint32_t>* posting = Posting(term.grams[i]);
+        if (posting) {
+            term.cost += posting->size();
+            present++;
+        }
+    }
+    return present >= term.required;
+}
+
+// Menghitung trigram yang cocok per task. Kata pertama (termurah) mengisi
+// kandidat; kata berikutnya hanya menghitung task yang masih kandidat.
+void TaskIndex::MatchTerm(const Term& term, int termIndex) {
+    if (termIndex > 0 && candidates.size() * 16 < term.cost) {
+        // Kandidat jauh lebih sedikit dari posting: cari tiap kandidat
+        // dengan binary search alih-alih menyapu posting list
+        for (uint32_t id : candidates) {
+            if (matchedTerms[id] != termIndex) {
+                continue;
+            }
+            int count = 0;
+            for (int g = 0; g < term.gramCount; ++g) {
+                const std::vector<uint32_t>* posting = Posting(term.grams[g]);
+                if (posting && std::binary_search(posting->begin(), posting->end(), id)) {
+                    count++;
+                }
+            }
+            if (count > 0) {
+                hits[id] = static_cast<uint8_t>(count);
+                touched.push_back(id);
+            }
+        }
+    } else {
+        for (int g = 0; g < term.gramCount; ++g) {
+            const std::vector<uint32_t>* posting = Posting(term.grams[g]);
+            if (!posting) {
+                continue;
+            }
+            for (uint32_t id : *posting) {
+                if (termIndex > 0 && matchedTerms[id] != termIndex) {
+                    continue;
+                }
+                if (hits[id]++ == 0) {
+                    touched.push_back(id);
+                }
+            }
+        }
+    }
+
+    const std::vector<uint32_t>* prefix = term.prefixGram ? Posting(term.prefixGram) : nullptr;
+    for (uint32_t id : touched) {
+        int count = hits[id];
+        hits[id] = 0;
+        if (count < term.required) {
+            continue;
+        }
+        int score = count * 100 / term.gramCount;
+        if (count == term.gramCount) {
+            score += FULL_MATCH_BONUS;
+        }
+        if (prefix && std::binary_search(prefix->begin(), prefix->end(), id)) {
+            score += PREFIX_BONUS;
+        }
+        if (termIndex == 0) {
+            candidates.push_back(id);
+        }
+        matchedTerms[id] = static_cast<uint8_t>(termIndex + 1);
+        scores[id] += score;
+    }
+    touched.clear();
+}
+
+size_t TaskIndex::Search(const std::string& query, size_t limit, std::vector<TaskMatch>& out,
+                         bool includeHidden) {
+    out.clear();
+    if (limit == 0) {
+        return 0;
+    }
+
+    Normalize(query, textScratch);
+    Term terms[MAX_QUERY_TERMS];
+    size_t termCount = 0;
+    size_t start = 0;
+    while (start < textScratch.size() && termCount < MAX_QUERY_TERMS) {
+        size_t end = textScratch.find(' ', start);
+        if (end == std::string::npos) {
+            end = textScratch.size();
+        }
+        if (!BuildTerm(textScratch.data() + start, end - start, terms[termCount])) {
+            // Kata ini tidak mungkin cocok dengan task mana pun
+            return 0;
+        }
+        termCount++;
+        start = end + 1;
+    }
+
+    if (termCount == 0) {
+        // Tanpa query: task terbaru
+        for (uint32_t id = lastId; id > 0 && out.size() < limit; --id) {
+            if (id < hidden.size() && (hidden[id] == VISIBLE ||
+                                       (includeHidden && hidden[id] == HIDDEN))) {
+                out.push_back(TaskMatch{ id, 0 });
+            }
+        }
+        return out.size();
+    }
+
+    // Kata dengan posting list terpendek lebih dulu: kandidat sedikit sejak awal
+    std::sort(terms, terms + termCount,
+              [](const Term& a, const Term& b) { return a.cost < b.cost; });
+    for (size_t i = 0; i < termCount; ++i) {
+        MatchTerm(terms[i], static_cast<int>(i));
+    }
+
+    ranked.clear();
+    for (uint32_t id : candidates) {
+        if (matchedTerms[id] == termCount && (includeHidden || hidden[id] == VISIBLE)) {
+            int score = scores[id] + (wordCounts[id] == termCount ? EXACT_LENGTH_BONUS : 0);
+            ranked.push_back(TaskMatch{ id, score });
+        }
+        matchedTerms[id] = 0;
+        scores[id] = 0;
+    }
+    candidates.clear();
+
+    size_t count = std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(), Better);
+    out.assign(ranked.begin(), ranked.begin() + count);
+    return count;
+}
+
+size_t TaskIndex::MemoryBytes() const {
+    // Perkiraan node dan bucket unordered_map ditambah isi vektor
+    size_t bytes = postings.bucket_count() * sizeof(void*) +
+                   postings.size() * (sizeof(std::pair<const uint32_t, std::vector<uint32_t>>) + 2 * sizeof(void*));
+    for (const auto& entry : postings) {
+        bytes += entry.second.capacity() * sizeof(uint32_t);
+    }
+    bytes += hidden.capacity() + wordCounts.capacity() + hits.capacity() + matchedTerms.capacity() +
+             scores.capacity() * sizeof(int32_t) +
+             (touched.capacity() + candidates.capacity()) * sizeof(uint32_t) +
+             ranked.capacity() * sizeof(TaskMatch);
+    return bytes;
+}
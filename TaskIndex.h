@@ -0,0 +1,91 @@
+// TaskIndex.h
+#ifndef TASK_INDEX_H
+#define TASK_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Satu hasil pencarian; skor lebih tinggi lebih relevan
+struct TaskMatch {
+    uint32_t id;
+    int score;
+};
+
+// Indeks trigram untuk pencarian task sambil mengetik. Judul dinormalisasi
+// (huruf kecil, selain huruf/angka menjadi pemisah kata), lalu setiap kata
+// menyumbang trigram di dalamnya plus gram awal kata (1 dan 2 huruf), yang
+// melayani query pendek sebagai prefix. Posting list per gram berisi id
+// task terurut naik; Add() hanya menambah di ujung, jadi indeks tumbuh
+// inkremental tanpa dibangun ulang.
+//
+// Query dipecah per kata. Kata 1-2 huruf cocok dengan awal kata; kata yang
+// lebih panjang cocok jika cukup banyak trigramnya ada di judul (semua untuk
+// kata pendek, sepertiga untuk kata >= 6 huruf), sehingga salah ketik satu
+// huruf atau dua huruf tertukar masih ditemukan. Semua kata query harus cocok. Biaya query
+// sebanding dengan panjang posting list yang disentuh, bukan jumlah task.
+class TaskIndex {
+public:
+    static const size_t MAX_QUERY_TERMS = 8;
+
+    TaskIndex();
+
+    void Clear();
+    void Reserve(size_t tasks);
+
+    // id harus lebih besar dari semua id sebelumnya (mulai dari 1)
+    void Add(uint32_t id, const std::string& title);
+    // Task tersembunyi (selesai) tidak muncul kecuali includeHidden
+    void SetHidden(uint32_t id, bool hidden);
+
+    // Paling banyak limit hasil ke out, urut skor lalu id terbaru. Query
+    // kosong menghasilkan task terbaru. Memakai buffer internal; tidak
+    // mengalokasi setelah pemanasan kecuali out perlu tumbuh.
+    size_t Search(const std::string& query, size_t limit, std::vector<TaskMatch>& out,
+                  bool includeHidden = false);
+
+    size_t Size() const { return taskCount; }
+    size_t GramCount() const { return postings.size(); }
+    size_t PostingCount() const { return postingCount; }
+    size_t MemoryBytes() const;
+
+    // Huruf kecil ASCII; byte UTF-8 dipertahankan; lainnya satu spasi
+    static void Normalize(const std::string& text, std::string& out);
+
+private:
+    struct Term {
+        uint32_t grams[32];
+        int gramCount;
+        int required;             // trigram minimum agar kata cocok
+        uint32_t prefixGram;      // gram awal kata, untuk bonus prefix
+        size_t cost;              // total panjang posting list
+    };
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+    enum : uint8_t { VISIBLE, HIDDEN, ABSENT };
+    std::vector<uint8_t> hidden;          // per id: VISIBLE/HIDDEN/ABSENT
+    std::vector<uint8_t> wordCounts;      // per id, untuk bonus judul yang pas
+    size_t taskCount;
+    uint32_t lastId;
+    size_t postingCount;
+
+    // Buffer query, per id; dikembalikan ke nol setelah setiap query
+    std::vector<uint8_t> hits;
+    std::vector<uint8_t> matchedTerms;
+    std::vector<int32_t> scores;
+    std::vector<uint32_t> touched;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> gramScratch;
+    std::string textScratch;
+    std::vector<TaskMatch> ranked;
+
+    const std::vector<uint32_t>* Posting(uint32_t gram) const;
+    void EnsureScratch(uint32_t id);
+    static void WordGrams(const char* word, size_t length, std::vector<uint32_t>& grams);
+    bool BuildTerm(const char* word, size_t length, Term& term) const;
+    void MatchTerm(const Term& term, int termIndex);
+};
+
+#endif // TASK_INDEX_H
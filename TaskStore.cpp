@@ -0,0 +1,302 @@
+// TaskStore.cpp
+#include "TaskStore.h"
+
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+// Satu baris: karakter kontrol menjadi spasi, spasi tepi dibuang, dipotong
+// di batas karakter UTF-8
+std::string CleanTitle(const std::string& title) {
+    std::string clean;
+    clean.reserve(title.size());
+    for (unsigned char c : title) {
+        clean.push_back(c < 0x20 || c == 0x7F ? ' ' : static_cast<char>(c));
+    }
+    size_t first = clean.find_first_not_of(' ');
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    clean.erase(0, first);
+    if (clean.size() > TASK_TITLE_MAX) {
+        size_t cut = TASK_TITLE_MAX;
+        while (cut > 0 && (static_cast<unsigned char>(clean[cut]) & 0xC0) == 0x80) {
+            cut--;
+        }
+        clean.resize(cut);
+    }
+    clean.erase(clean.find_last_not_of(' ') + 1);
+    return clean;
+}
+
+} // namespace
+
+TaskStore::TaskStore() : file(nullptr) {}
+
+TaskStore::~TaskStore() {
+    Close();
+}
+
+bool TaskStore::Open(const std::string& taskPath) {
+    Close();
+    path = taskPath;
+    bool truncated = false;
+    Replay(path, truncated);
+
+    file = std::fopen(path.c_str(), "a");
+    if (file && truncated) {
+        // Baris berikutnya tidak boleh tersambung ke sisa yang terpotong
+        AppendLine("\n");
+    }
+    return file != nullptr;
+}
+
+bool TaskStore::Load(const std::string& taskPath) {
+    Close();
+    path = taskPath;
+    bool truncated = false;
+    return Replay(path, truncated);
+}
+
+bool TaskStore::Replay(const std::string& logPath, bool& truncated) {
+    tasks.clear();
+    index.Clear();
+    titleIds.clear();
+
+    // Putar ulang log; baris yang rusak dilewati. Baris terakhir tanpa
+    // newline terpotong crash di tengah penulisan, meski bisa terlihat sah.
+    std::ifstream log(logPath);
+    if (!log) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(log, line)) {
+        if (log.eof()) {
+            truncated = !line.empty();
+            break;
+        }
+        if (line.size() < 3 || line[1] != ' ') {
+            continue;
+        }
+        const char* text = line.c_str() + 2;
+        char* end = nullptr;
+        unsigned long id = std::strtoul(text, &end, 10);
+        if (end == text || *end != ' ') {
+            continue;
+        }
+        if (line[0] == 'A') {
+            // Id yang lebih kecil dari id terakhir (duplikat) atau terlalu
+            // jauh berasal dari baris rusak
+            if (id <= tasks.size() || id > tasks.size() + TASK_ID_GAP_MAX) {
+                continue;
+            }
+            text = end + 1;
+            long long createdMs = std::strtoll(text, &end, 10);
+            std::string title = *end == ' ' && end != text ? CleanTitle(end + 1) : std::string();
+            if (title.empty()) {
+                // Sisa baris rusak, tetapi id-nya mungkin sudah dipakai sesi
+                ReserveId(static_cast<uint32_t>(id));
+                continue;
+            }
+            Insert(static_cast<uint32_t>(id), createdMs, title);
+        } else if (line[0] == 'D') {
+            Task* task = Mutable(static_cast<uint32_t>(id));
+            if (task) {
+                task->done = end[1] == '1';
+                index.SetHidden(task->id, task->done);
+            } else if (id > tasks.size() && id <= tasks.size() + TASK_ID_GAP_MAX) {
+                ReserveId(static_cast<uint32_t>(id));
+            }
+        }
+    }
+    return true;
+}
+
+void TaskStore::Close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+// Slot kosong sampai id: id yang barisnya hilang dari log tidak diberikan
+// lagi ke task baru
+void TaskStore::ReserveId(uint32_t id) {
+    while (tasks.size() < id) {
+        Task missing = Task();
+        missing.id = static_cast<uint32_t>(tasks.size() + 1);
+        tasks.push_back(missing);
+    }
+}
+
+void TaskStore::Insert(uint32_t id, int64_t createdMs, const std::string& title) {
+    ReserveId(id - 1);
+    Task task;
+    task.id = id;
+    task.done = false;
+    task.createdMs = createdMs;
+    task.title = title;
+    task.focusSeconds = 0;
+    task.completedSessions = 0;
+    task.lastFocusMs = 0;
+    tasks.push_back(task);
+    index.Add(id, title);
+    // Judul kembar di log lama: yang pertama tetap dipakai
+    TaskIndex::Normalize(title, normalized);
+    if (!normalized.empty()) {
+        titleIds.emplace(normalized, id);
+    }
+}
+
+bool TaskStore::AppendLine(const std::string& line) {
+    if (!file) {
+        return true;
+    }
+    bool ok = std::fputs(line.c_str(), file) >= 0;
+    return std::fflush(file) == 0 && ok;
+}
+
+uint32_t TaskStore::Add(const std::string& title, int64_t createdMs) {
+    std::string clean = CleanTitle(title);
+    if (clean.empty()) {
+        return 0;
+    }
+    uint32_t id = static_cast<uint32_t>(tasks.size() + 1);
+    if (!AppendLine("A " + std::to_string(id) + " " + std::to_string(createdMs) + " " +
+                    clean + "\n")) {
+        return 0;
+    }
+    Insert(id, createdMs, clean);
+    return id;
+}
+
+uint32_t TaskStore::FindTitle(const std::string& title) {
+    TaskIndex::Normalize(title, normalized);
+    if (normalized.empty()) {
+        return 0;
+    }
+    std::unordered_map<std::string, uint32_t>::const_iterator it = titleIds.find(normalized);
+    return it != titleIds.end() ? it->second : 0;
+}
+
+uint32_t TaskStore::FindOrAdd(const std::string& title, int64_t createdMs) {
+    uint32_t id = FindTitle(title);
+    if (id) {
+        SetDone(id, false);
+        return id;
+    }
+    return Add(title, createdMs);
+}
+
+bool TaskStore::WriteSnapshot(const std::string& snapshotPath) const {
+    std::string temp = snapshotPath + ".tmp";
+    FILE* out = std::fopen(temp.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+    bool ok = true;
+    for (const Task& task : tasks) {
+        if (task.title.empty()) {
+            continue;
+        }
+        ok = ok && std::fprintf(out, "A %u %lld %s\n", task.id,
+                                static_cast<long long>(task.createdMs), task.title.c_str()) > 0;
+        if (task.done) {
+            ok = ok && std::fprintf(out, "D %u 1\n", task.id) > 0;
+        }
+    }
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), snapshotPath.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+void TaskStore::MergeFrom(const TaskStore& other, std::vector<uint32_t>& idMap) {
+    idMap.assign(other.tasks.size() + 1, 0);
+    for (const Task& task : other.tasks) {
+        if (task.title.empty()) {
+            continue;
+        }
+        uint32_t id = FindTitle(task.title);
+        if (!id) {
+            id = Add(task.title, task.createdMs);
+            if (id && task.done) {
+                SetDone(id, true);
+            }
+        }
+        idMap[task.id] = id;
+    }
+}
+
+bool TaskStore::SetDone(uint32_t id, bool done) {
+    Task* task = Mutable(id);
+    if (!task) {
+        return false;
+    }
+    if (task->done == done) {
+        return true;
+    }
+    if (!AppendLine("D " + std::to_string(id) + (done ? " 1\n" : " 0\n"))) {
+        return false;
+    }
+    task->done = done;
+    index.SetHidden(id, done);
+    return true;
+}
+
+// Slot kosong tidak punya judul; task yang sah selalu punya (Add menolak
+// judul kosong)
+Task* TaskStore::Mutable(uint32_t id) {
+    return id >= 1 && id <= tasks.size() && !tasks[id - 1].title.empty() ? &tasks[id - 1]
+                                                                          : nullptr;
+}
+
+const Task* TaskStore::Find(uint32_t id) const {
+    return id >= 1 && id <= tasks.size() && !tasks[id - 1].title.empty() ? &tasks[id - 1]
+                                                                          : nullptr;
+}
+
+size_t TaskStore::Search(const std::string& query, size_t limit, std::vector<TaskMatch>& out,
+                         bool includeDone) {
+    return index.Search(query, limit, out, includeDone);
+}
+
+void TaskStore::AddSession(const SessionRecord& record) {
+    if (record.type != SESSION_FOCUS) {
+        return;
+    }
+    Task* task = Mutable(record.taskId);
+    if (!task) {
+        // Task yang barisnya hilang dari log: id tetap dicadangkan
+        if (record.taskId > tasks.size() && record.taskId <= tasks.size() + TASK_ID_GAP_MAX) {
+            ReserveId(record.taskId);
+        }
+        return;
+    }
+    task->focusSeconds += record.actualSeconds;
+    if (record.flags & RECORD_COMPLETED) {
+        task->completedSessions++;
+    }
+    if (record.endMs > task->lastFocusMs) {
+        task->lastFocusMs = record.endMs;
+    }
+}
+
+void TaskStore::RebuildRollups(const SessionRecord* records, size_t count) {
+    for (Task& task : tasks) {
+        task.focusSeconds = 0;
+        task.completedSessions = 0;
+        task.lastFocusMs = 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        AddSession(records[i]);
+    }
+}
+
+std::string TaskStore::FormatRollup(const Task& task) {
+    return std::to_string(task.completedSessions) + " sesi, " +
+           std::to_string(task.focusSeconds / 60) + " menit";
+}
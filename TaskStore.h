@@ -0,0 +1,112 @@
+// TaskStore.h
+#ifndef TASK_STORE_H
+#define TASK_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SessionJournal.h"
+#include "TaskIndex.h"
+
+// Nama file daftar task default
+const char* const TASKS_FILE = "pomodoro_tasks.txt";
+
+// Judul lebih panjang dipotong
+const size_t TASK_TITLE_MAX = 200;
+
+// Lompatan id terjauh yang diterima saat memutar ulang log; id yang lebih
+// jauh berasal dari baris rusak dan dilewati, agar tidak membuat jutaan
+// slot kosong
+const uint32_t TASK_ID_GAP_MAX = 100000;
+
+// Satu task beserta rollup sesi fokus yang tertaut padanya
+struct Task {
+    uint32_t id;                  // 1.., urutan dibuat; dipakai SessionRecord::taskId
+    bool done;
+    int64_t createdMs;            // jam dinding
+    std::string title;
+
+    int64_t focusSeconds;         // waktu fokus berjalan, termasuk sesi yang di-reset
+    int completedSessions;        // sesi fokus yang habis sampai deadline
+    int64_t lastFocusMs;          // akhir sesi fokus terakhir, 0 jika belum ada
+};
+
+// Daftar task pribadi. Perubahan ditulis sebagai baris ke log append-only
+// ("A <id> <dibuat_ms> <judul>" dan "D <id> <0|1>") yang diputar ulang
+// saat Open(); tidak pernah ada penulisan ulang file. Task diputar ulang
+// menurut id di barisnya: id yang barisnya rusak menjadi slot kosong
+// (Find() mengembalikan nullptr) dan task baru selalu mendapat id terbesar
+// yang pernah terlihat di log atau jurnal + 1, sehingga id yang sudah
+// dipakai SessionRecord tidak pernah dipakai ulang untuk task lain. Rollup waktu fokus
+// tidak disimpan: dihitung ulang dari jurnal saat startup lalu diperbarui
+// per sesi, seperti SessionStats. Pencarian lewat TaskIndex yang tumbuh
+// bersama daftar.
+class TaskStore {
+public:
+    TaskStore();
+    ~TaskStore();
+
+    bool Open(const std::string& path);
+    // Memutar ulang log tanpa membukanya untuk ditulis (log dari mesin lain);
+    // false jika file tidak ada
+    bool Load(const std::string& path);
+    void Close();
+    bool IsOpen() const { return file != nullptr; }
+
+    // Id task baru, atau 0 jika judul kosong. Tanpa Open() task hanya ada
+    // di memori (benchmark).
+    uint32_t Add(const std::string& title, int64_t createdMs);
+    bool SetDone(uint32_t id, bool done);
+    // Task dengan judul yang sama setelah normalisasi (huruf besar/kecil,
+    // tanda baca), termasuk yang selesai; jika tidak ada, task baru
+    uint32_t FindOrAdd(const std::string& title, int64_t createdMs);
+    // Id task dengan judul yang sama setelah normalisasi, 0 jika tidak ada;
+    // status selesai tidak diubah
+    uint32_t FindTitle(const std::string& title);
+
+    // Log ringkas berisi task yang ada sekarang dengan id yang sama, untuk
+    // ikut diekspor bersama jurnal; ditulis ke file sementara lalu di-rename
+    bool WriteSnapshot(const std::string& snapshotPath) const;
+    // Memasukkan task dari daftar mesin lain: judul yang sama memakai task
+    // lokal, sisanya ditambahkan. idMap[id asal] = id lokal (0 untuk slot
+    // kosong), untuk ImportJournal.
+    void MergeFrom(const TaskStore& other, std::vector<uint32_t>& idMap);
+
+    // Id terbesar, termasuk slot kosong
+    size_t Size() const { return tasks.size(); }
+    // nullptr jika id tidak dikenal atau barisnya hilang dari log
+    const Task* Find(uint32_t id) const;
+
+    // Task selesai disembunyikan kecuali includeDone
+    size_t Search(const std::string& query, size_t limit, std::vector<TaskMatch>& out,
+                  bool includeDone = false);
+    const TaskIndex& GetIndex() const { return index; }
+
+    // Rollup: sesi fokus dengan taskId yang dikenal
+    void AddSession(const SessionRecord& record);
+    void RebuildRollups(const SessionRecord* records, size_t count);
+
+    // "3 sesi, 75 menit"
+    static std::string FormatRollup(const Task& task);
+
+private:
+    std::string path;
+    FILE* file;
+    std::vector<Task> tasks;      // tasks[id - 1]
+    TaskIndex index;
+    // Judul ternormalisasi -> id, untuk FindTitle(); pencarian berperingkat
+    // bisa melewatkan judul yang pas di antara banyak judul yang mirip
+    std::unordered_map<std::string, uint32_t> titleIds;
+    std::string normalized;       // buffer Normalize()
+
+    Task* Mutable(uint32_t id);
+    bool Replay(const std::string& logPath, bool& truncated);
+    void ReserveId(uint32_t id);
+    void Insert(uint32_t id, int64_t createdMs, const std::string& title);
+    bool AppendLine(const std::string& line);
+};
+
+#endif // TASK_STORE_H
@@ -0,0 +1,321 @@
+// TimerCore.cpp
+#include "TimerCore.h"
+
+TimerCore::TimerCore(Clock& clock)
+    : clock(clock), listener(nullptr), state(READY),
+      focusDuration(25), breakDuration(5), completedSessions(0), taskId(0),
+      inTransition(false), transitionFromFocus(false), transitionDeadlineMs(0),
+      completedDeadlineMs(0),
+      lastReportedSeconds(-1), lastTransitionSeconds(-1),
+      sessionStartMs(0), sessionStartWallMs(0), pauseStartedMs(0),
+      runningSinceMs(0), pausedMs(0), pauseCount(0) {
+}
+
+void TimerCore::SetListener(TimerCoreListener* newListener) {
+    listener = newListener;
+}
+
+void TimerCore::SetDurations(int focusMinutes, int breakMinutes) {
+    focusDuration = focusMinutes;
+    breakDuration = breakMinutes;
+}
+
+void TimerCore::Start() {
+    if (state == READY && !inTransition) {
+        StartSession(RUNNING_FOCUS, focusDuration);
+    } else if (IsPaused()) {
+        // Lanjutkan sesi yang dijeda
+        int64_t now = clock.NowMs();
+        pausedMs += now - pauseStartedMs;
+        runningSinceMs = now;
+        countdown.Resume(now);
+        SetState(state == PAUSED_FOCUS ? RUNNING_FOCUS : RUNNING_BREAK);
+        EmitCheckpoint(CHECKPOINT_RESUME, now);
+    }
+}
+
+void TimerCore::Pause() {
+    PauseSince(clock.NowMs());
+}
+
+void TimerCore::PauseSince(int64_t sinceMs) {
+    // Jeda hanya berlaku saat sesi berjalan, bukan saat masa transisi
+    if (IsRunning() && !inTransition) {
+        int64_t now = clock.NowMs();
+        if (sinceMs > now) {
+            sinceMs = now;
+        }
+        if (sinceMs < runningSinceMs) {
+            sinceMs = runningSinceMs;
+        }
+        pauseStartedMs = sinceMs;
+        pauseCount++;
+        countdown.Pause(sinceMs);
+        SetState(state == RUNNING_FOCUS ? PAUSED_FOCUS : PAUSED_BREAK);
+        EmitCheckpoint(CHECKPOINT_PAUSE, sinceMs);
+    }
+}
+
+void TimerCore::Reset() {
+    bool wasInTransition = inTransition;
+
+    // Sesi yang dihentikan di tengah jalan tetap dicatat
+    if ((IsRunning() || IsPaused()) && !inTransition) {
+        int64_t now = clock.NowMs();
+        if (IsPaused()) {
+            pausedMs += now - pauseStartedMs;
+        }
+        EmitRecord(RECORD_RESET, now);
+        EmitCheckpoint(CHECKPOINT_RESET, now);
+    }
+
+    countdown.Reset();
+    inTransition = false;
+    lastReportedSeconds = -1;
+    lastTransitionSeconds = -1;
+
+    if (wasInTransition && listener) {
+        listener->OnTransitionFinished();
+    }
+    SetState(READY);
+}
+
+bool TimerCore::RestoreCheckpoint(const CheckpointRecord& record) {
+    if (state != READY || inTransition || !IsSessionInFlight(record) || record.durationMs <= 0) {
+        return false;
+    }
+    TimerState restored = static_cast<TimerState>(record.state);
+    bool paused = (restored == PAUSED_FOCUS || restored == PAUSED_BREAK);
+    if (!paused && restored != RUNNING_FOCUS && restored != RUNNING_BREAK) {
+        return false;
+    }
+
+    // Waktu selama aplikasi mati; jam dinding yang mundur dianggap nol
+    int64_t now = clock.NowMs();
+    int64_t offline = clock.WallNowMs() - record.wallMs;
+    if (offline < 0) {
+        offline = 0;
+    }
+    int64_t remaining = record.remainingMs - (paused ? 0 : offline);
+    int64_t checkpointMs = now - offline;
+
+    sessionStartWallMs = record.sessionStartWallMs;
+    sessionStartMs = checkpointMs - (record.wallMs - record.sessionStartWallMs);
+    pausedMs = record.pausedMs;
+    pauseCount = record.pauseCount;
+    if (record.taskId != 0) {
+        taskId = record.taskId;
+    }
+    runningSinceMs = checkpointMs;
+    state = restored;
+    // Deadline = now + remaining
+    countdown.Start(record.durationMs, now + remaining - record.durationMs);
+
+    if (remaining <= 0) {
+        // Habis selagi aplikasi mati: catat pada deadline-nya, tanpa
+        // notifikasi dan tanpa memulai sesi berikutnya
+        int64_t deadlineMs = now + remaining;
+        if (restored == RUNNING_FOCUS) {
+            completedSessions++;
+        }
+        EmitRecord(RECORD_COMPLETED, deadlineMs);
+        EmitCheckpoint(CHECKPOINT_COMPLETE, deadlineMs);
+        countdown.Reset();
+        lastReportedSeconds = -1;
+        SetState(READY);
+        return false;
+    }
+
+    if (paused) {
+        countdown.Pause(now);
+        pauseStartedMs = checkpointMs;
+    }
+    lastReportedSeconds = countdown.RemainingSeconds(now);
+    SetState(restored);
+    return true;
+}
+
+void TimerCore::Poll() {
+    int64_t now = clock.NowMs();
+
+    if (inTransition) {
+        if (now >= transitionDeadlineMs) {
+            inTransition = false;
+            lastTransitionSeconds = -1;
+            if (listener) {
+                listener->OnTransitionFinished();
+            }
+            // Tentukan sesi berikutnya berdasarkan sesi yang baru saja selesai
+            if (transitionFromFocus) {
+                StartSession(RUNNING_BREAK, breakDuration);
+            } else {
+                StartSession(RUNNING_FOCUS, focusDuration);
+            }
+        } else {
+            int secondsLeft = TransitionSecondsLeft();
+            if (secondsLeft != lastTransitionSeconds) {
+                lastTransitionSeconds = secondsLeft;
+                if (listener) {
+                    listener->OnTransitionTick(secondsLeft);
+                }
+            }
+        }
+        return;
+    }
+
+    if (!countdown.IsRunning()) {
+        return;
+    }
+
+    if (countdown.IsExpired(now)) {
+        CompleteSession(now);
+        return;
+    }
+
+    int seconds = countdown.RemainingSeconds(now);
+    if (seconds != lastReportedSeconds) {
+        lastReportedSeconds = seconds;
+        if (listener) {
+            listener->OnTick(seconds);
+        }
+    }
+}
+
+int64_t TimerCore::RemainingMs() const {
+    if (state == READY) {
+        return static_cast<int64_t>(focusDuration) * 60 * 1000;
+    }
+    return countdown.RemainingMs(clock.NowMs());
+}
+
+int TimerCore::RemainingSeconds() const {
+    return static_cast<int>((RemainingMs() + 999) / 1000);
+}
+
+int TimerCore::TransitionSecondsLeft() const {
+    if (!inTransition) {
+        return 0;
+    }
+    int64_t left = transitionDeadlineMs - clock.NowMs();
+    return left > 0 ? static_cast<int>((left + 999) / 1000) : 0;
+}
+
+int TimerCore::ProgressPercent() const {
+    int64_t total = countdown.DurationMs();
+    if (state == READY || total <= 0) {
+        return 0;
+    }
+    return static_cast<int>(100 - (RemainingMs() * 100 / total));
+}
+
+double TimerCore::ProgressFraction() const {
+    int64_t total = countdown.DurationMs();
+    if (state == READY || total <= 0) {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(RemainingMs()) / static_cast<double>(total);
+}
+
+int64_t TimerCore::NextWakeupMs() const {
+    int64_t now = clock.NowMs();
+    if (inTransition) {
+        int64_t left = transitionDeadlineMs - now;
+        if (left <= 0) {
+            return now;
+        }
+        int64_t delay = left % 1000;
+        return now + (delay == 0 ? 1000 : delay);
+    }
+    if (!countdown.IsRunning()) {
+        return -1;
+    }
+    return now + countdown.MsUntilNextSecond(now);
+}
+
+int64_t TimerCore::NextDeadlineMs() const {
+    if (inTransition) {
+        return transitionDeadlineMs;
+    }
+    if (!countdown.IsRunning()) {
+        return -1;
+    }
+    return countdown.DeadlineMs();
+}
+
+void TimerCore::StartSession(TimerState sessionState, int minutes) {
+    sessionStartMs = clock.NowMs();
+    sessionStartWallMs = clock.WallNowMs();
+    runningSinceMs = sessionStartMs;
+    pausedMs = 0;
+    pauseCount = 0;
+    countdown.Start(static_cast<int64_t>(minutes) * 60 * 1000, sessionStartMs);
+    lastReportedSeconds = minutes * 60;
+    SetState(sessionState);
+    EmitCheckpoint(CHECKPOINT_START, sessionStartMs);
+}
+
+void TimerCore::CompleteSession(int64_t nowMs) {
+    bool wasFocusSession = (state == RUNNING_FOCUS);
+    completedDeadlineMs = countdown.DeadlineMs();
+
+    if (wasFocusSession) {
+        completedSessions++;
+    }
+    EmitRecord(RECORD_COMPLETED, nowMs);
+    EmitCheckpoint(CHECKPOINT_COMPLETE, nowMs);
+
+    // Sesi berikutnya baru dimulai setelah masa transisi (notifikasi) habis
+    inTransition = true;
+    transitionFromFocus = wasFocusSession;
+    transitionDeadlineMs = nowMs + TRANSITION_SECONDS * 1000;
+    lastTransitionSeconds = TRANSITION_SECONDS;
+    lastReportedSeconds = 0;
+
+    if (listener) {
+        listener->OnTick(0);
+        listener->OnSessionCompleted(wasFocusSession);
+    }
+}
+
+void TimerCore::SetState(TimerState newState) {
+    state = newState;
+    if (listener) {
+        listener->OnStateChanged(state);
+    }
+}
+
+void TimerCore::EmitRecord(uint8_t flags, int64_t nowMs) {
+    if (!listener) {
+        return;
+    }
+
+    SessionRecord record = SessionRecord();
+    record.startMs = sessionStartWallMs;
+    record.endMs = sessionStartWallMs + (nowMs - sessionStartMs);
+    record.plannedSeconds = static_cast<int32_t>(countdown.DurationMs() / 1000);
+    record.actualSeconds = static_cast<int32_t>((nowMs - sessionStartMs - pausedMs + 500) / 1000);
+    record.pausedSeconds = static_cast<int32_t>((pausedMs + 500) / 1000);
+    record.pauseCount = static_cast<uint16_t>(pauseCount);
+    record.type = (state == RUNNING_FOCUS || state == PAUSED_FOCUS) ? SESSION_FOCUS : SESSION_BREAK;
+    record.flags = flags;
+    record.taskId = record.type == SESSION_FOCUS ? taskId : 0;
+    listener->OnSessionRecord(record);
+}
+
+void TimerCore::EmitCheckpoint(uint8_t event, int64_t nowMs) {
+    if (!listener) {
+        return;
+    }
+
+    CheckpointRecord record = CheckpointRecord();
+    record.wallMs = sessionStartWallMs + (nowMs - sessionStartMs);
+    record.sessionStartWallMs = sessionStartWallMs;
+    record.durationMs = countdown.DurationMs();
+    record.remainingMs = countdown.RemainingMs(nowMs);
+    record.pausedMs = pausedMs;
+    record.pauseCount = static_cast<uint16_t>(pauseCount);
+    record.event = event;
+    record.state = static_cast<uint8_t>(state);
+    record.taskId = taskId;
+    listener->OnCheckpoint(record);
+}
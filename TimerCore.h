@@ -0,0 +1,142 @@
+// TimerCore.h
+#ifndef TIMER_CORE_H
+#define TIMER_CORE_H
+
+#include "Clock.h"
+#include "CountdownEngine.h"
+#include "SessionJournal.h"
+#include "SessionCheckpoint.h"
+
+// Enum untuk state timer
+enum TimerState {
+    READY,
+    RUNNING_FOCUS,
+    RUNNING_BREAK,
+    PAUSED_FOCUS,
+    PAUSED_BREAK
+};
+const int TIMER_STATE_COUNT = PAUSED_BREAK + 1;
+
+// Lama jeda notifikasi sebelum sesi berikutnya dimulai
+const int TRANSITION_SECONDS = 5;
+
+// Callback dari TimerCore ke tampilan (GUI, terminal, simulasi)
+class TimerCoreListener {
+public:
+    virtual ~TimerCoreListener() {}
+
+    // State berubah (mulai, jeda, lanjut, reset, sesi berikutnya)
+    virtual void OnStateChanged(TimerState /*state*/) {}
+    // Angka detik yang tampil berubah
+    virtual void OnTick(int /*remainingSeconds*/) {}
+    // Sesi selesai; masuk masa transisi sebelum sesi berikutnya
+    virtual void OnSessionCompleted(bool /*wasFocusSession*/) {}
+    // Angka detik masa transisi berubah
+    virtual void OnTransitionTick(int /*secondsLeft*/) {}
+    // Masa transisi berakhir (habis atau dibatalkan oleh reset)
+    virtual void OnTransitionFinished() {}
+    // Catatan sesi yang selesai atau di-reset, untuk jurnal
+    virtual void OnSessionRecord(const SessionRecord& /*record*/) {}
+    // Transisi state sesi (mulai, jeda, lanjut, selesai, reset), untuk log checkpoint
+    virtual void OnCheckpoint(const CheckpointRecord& /*record*/) {}
+};
+
+// State machine sesi fokus/istirahat tanpa ketergantungan GUI.
+// Tidak ada timer di dalamnya: pemilik memanggil Poll() pada setiap wakeup
+// dan menjadwalkan wakeup berikutnya dari NextWakeupMs().
+class TimerCore {
+public:
+    explicit TimerCore(Clock& clock);
+
+    void SetListener(TimerCoreListener* listener);
+    void SetDurations(int focusMinutes, int breakMinutes);
+
+    // Perintah (setara tombol Start/Pause/Reset)
+    void Start();   // READY -> fokus, PAUSED_* -> lanjut
+    void Pause();
+    void Reset();
+    // Jeda yang berlaku mundur sejak sinceMs (jam monoton), misalnya saat
+    // pengguna terakhir aktif: waktu sesudahnya dikembalikan ke sisa sesi.
+    // Tidak mundur melewati saat sesi terakhir mulai berjalan.
+    void PauseSince(int64_t sinceMs);
+
+    // Melanjutkan sesi dari checkpoint terakhir setelah aplikasi mati.
+    // Sisa waktu dikurangi waktu jam dinding yang lewat sejak checkpoint
+    // (kecuali sesi dijeda); sesi yang sudah habis dicatat selesai tanpa
+    // masa transisi. true jika ada sesi yang kembali berjalan atau dijeda.
+    bool RestoreCheckpoint(const CheckpointRecord& record);
+
+    // Memproses deadline yang sudah lewat dan melaporkan perubahan tampilan
+    void Poll();
+
+    TimerState GetState() const { return state; }
+    bool IsRunning() const { return state == RUNNING_FOCUS || state == RUNNING_BREAK; }
+    bool IsPaused() const { return state == PAUSED_FOCUS || state == PAUSED_BREAK; }
+    bool InTransition() const { return inTransition; }
+    bool WasFocusCompleted() const { return transitionFromFocus; }
+
+    int GetFocusDuration() const { return focusDuration; }
+    int GetBreakDuration() const { return breakDuration; }
+    int GetCompletedSessions() const { return completedSessions; }
+    void SetCompletedSessions(int count) { completedSessions = count; }
+
+    // Task untuk sesi fokus (TaskStore), 0 = tanpa task. Dibaca saat record
+    // dan checkpoint dibuat, jadi task yang dipilih di tengah sesi berlaku
+    // untuk seluruh sesi itu.
+    uint32_t GetTaskId() const { return taskId; }
+    void SetTaskId(uint32_t id) { taskId = id; }
+
+    int RemainingSeconds() const;
+    int64_t RemainingMs() const;
+    int TransitionSecondsLeft() const;
+    // Panjang sesi yang sedang atau terakhir berjalan
+    int64_t SessionDurationMs() const { return countdown.DurationMs(); }
+    int ProgressPercent() const;
+    // Progres 0..1 tanpa pembulatan, untuk progress bar yang halus
+    double ProgressFraction() const;
+
+    // Waktu absolut wakeup berikutnya yang mengubah tampilan (batas detik),
+    // atau -1 jika tidak ada yang perlu dijadwalkan
+    int64_t NextWakeupMs() const;
+    // Deadline absolut berikutnya (akhir sesi atau akhir transisi), atau -1
+    int64_t NextDeadlineMs() const;
+    // Deadline terjadwal sesi yang terakhir selesai (untuk ukur latensi notifikasi)
+    int64_t CompletedDeadlineMs() const { return completedDeadlineMs; }
+
+    const Clock& GetClock() const { return clock; }
+
+private:
+    Clock& clock;
+    TimerCoreListener* listener;
+    CountdownEngine countdown;
+    TimerState state;
+
+    int focusDuration;    // dalam menit
+    int breakDuration;    // dalam menit
+    int completedSessions;
+    uint32_t taskId;
+
+    bool inTransition;
+    bool transitionFromFocus;
+    int64_t transitionDeadlineMs;
+    int64_t completedDeadlineMs;
+
+    int lastReportedSeconds;
+    int lastTransitionSeconds;
+
+    // Data sesi berjalan untuk SessionRecord
+    int64_t sessionStartMs;
+    int64_t sessionStartWallMs;
+    int64_t pauseStartedMs;
+    int64_t runningSinceMs;   // mulai atau terakhir dilanjutkan
+    int64_t pausedMs;
+    int pauseCount;
+
+    void StartSession(TimerState sessionState, int minutes);
+    void CompleteSession(int64_t nowMs);
+    void EmitRecord(uint8_t flags, int64_t nowMs);
+    void EmitCheckpoint(uint8_t event, int64_t nowMs);
+    void SetState(TimerState newState);
+};
+
+#endif // TIMER_CORE_H
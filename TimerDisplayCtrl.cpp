@@ -0,0 +1,302 @@
+// TimerDisplayCtrl.cpp
+#include "TimerDisplayCtrl.h"
+
+#include <wx/dcbuffer.h>
+#include <wx/dcmemory.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const int BAR_GAP = 8;       // jarak angka ke progress bar
+const int BAR_HEIGHT = 12;
+
+int64_t SteadyNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+int GlyphIndex(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    return 10;   // ':' dan karakter lain
+}
+
+// Campuran dua warna untuk kolom piksel ujung bar yang terisi sebagian
+wxColour Blend(const wxColour& from, const wxColour& to, int part, int parts) {
+    return wxColour(
+        static_cast<unsigned char>(from.Red() + (to.Red() - from.Red()) * part / parts),
+        static_cast<unsigned char>(from.Green() + (to.Green() - from.Green()) * part / parts),
+        static_cast<unsigned char>(from.Blue() + (to.Blue() - from.Blue()) * part / parts));
+}
+
+}
+
+GlyphCache::GlyphCache() : current(-1), useClock(0), rasterizeCount(0) {
+    for (int i = 0; i < ENTRIES; ++i) {
+        entries[i].used = false;
+        entries[i].lastUse = 0;
+    }
+}
+
+void GlyphCache::Select(const wxFont& font, const wxColour& text, const wxColour& background) {
+    useClock++;
+    int oldest = 0;
+    for (int i = 0; i < ENTRIES; ++i) {
+        Entry& entry = entries[i];
+        if (entry.used && entry.pointSize == font.GetPointSize() &&
+            entry.weight == font.GetWeight() &&
+            entry.text == text && entry.background == background) {
+            entry.lastUse = useClock;
+            current = i;
+            return;
+        }
+        if (!entry.used || (entries[oldest].used && entry.lastUse < entries[oldest].lastUse)) {
+            oldest = i;
+        }
+    }
+
+    Entry& entry = entries[oldest];
+    entry.used = true;
+    entry.lastUse = useClock;
+    entry.pointSize = font.GetPointSize();
+    entry.weight = font.GetWeight();
+    entry.text = text;
+    entry.background = background;
+    Rasterize(entry, font);
+    current = oldest;
+}
+
+void GlyphCache::Rasterize(Entry& entry, const wxFont& font) {
+    static const char CHARS[GLYPH_COUNT + 1] = "0123456789:";
+
+    wxBitmap probe(1, 1);
+    wxMemoryDC measure(probe);
+    measure.SetFont(font);
+    entry.digitWidth = 0;
+    entry.height = 0;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        wxSize extent = measure.GetTextExtent(wxString(CHARS + i, 1));
+        if (i < 10 && extent.GetWidth() > entry.digitWidth) {
+            entry.digitWidth = extent.GetWidth();
+        }
+        if (i == 10) {
+            entry.colonWidth = extent.GetWidth();
+        }
+        if (extent.GetHeight() > entry.height) {
+            entry.height = extent.GetHeight();
+        }
+    }
+    measure.SelectObject(wxNullBitmap);
+
+    // Glyph buram di atas warna latar tema: blit langsung tanpa alpha
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        int cellWidth = (i < 10) ? entry.digitWidth : entry.colonWidth;
+        wxBitmap& bitmap = entry.glyphs[i];
+        bitmap.Create(cellWidth > 0 ? cellWidth : 1, entry.height > 0 ? entry.height : 1);
+        wxMemoryDC dc(bitmap);
+        dc.SetBackground(wxBrush(entry.background));
+        dc.Clear();
+        dc.SetFont(font);
+        dc.SetTextForeground(entry.text);
+        dc.SetTextBackground(entry.background);
+        wxString glyph(CHARS + i, 1);
+        wxSize extent = dc.GetTextExtent(glyph);
+        dc.DrawText(glyph, (cellWidth - extent.GetWidth()) / 2, 0);
+        dc.SelectObject(wxNullBitmap);
+    }
+    rasterizeCount++;
+}
+
+const wxBitmap& GlyphCache::Glyph(char c) const {
+    return entries[current].glyphs[GlyphIndex(c)];
+}
+
+int GlyphCache::CellWidth(char c) const {
+    const Entry& entry = entries[current];
+    return GlyphIndex(c) < 10 ? entry.digitWidth : entry.colonWidth;
+}
+
+int GlyphCache::Height() const {
+    return current >= 0 ? entries[current].height : 0;
+}
+
+std::string TimerRenderCounters::Report() const {
+    char buffer[192];
+    std::snprintf(buffer, sizeof(buffer),
+                  "time_updates=%lld progress_updates=%lld cells=%lld paints=%lld blits=%lld paint_us_avg=%.1f",
+                  timeUpdates, progressUpdates, invalidatedCells, paints, glyphBlits,
+                  paints > 0 ? paintNs / 1e3 / paints : 0.0);
+    return buffer;
+}
+
+BEGIN_EVENT_TABLE(TimerDisplayCtrl, wxControl)
+    EVT_PAINT(TimerDisplayCtrl::OnPaint)
+    EVT_SIZE(TimerDisplayCtrl::OnSize)
+END_EVENT_TABLE()
+
+TimerDisplayCtrl::TimerDisplayCtrl(wxWindow* parent, wxWindowID id, int pointSize, int barWidth)
+    : wxControl(parent, id, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE),
+      textColour(20, 20, 20), backgroundColour(250, 250, 250),
+      trackColour(220, 220, 220), fillColour(100, 150, 200),
+      textLength(0), barWidth(barWidth), progressUnits(0) {
+    // Semua piksel digambar sendiri lewat buffer; tanpa erase latar
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
+
+    digitFont = GetFont();
+    digitFont.SetPointSize(pointSize);
+    digitFont.SetWeight(wxFONTWEIGHT_BOLD);
+    glyphs.Select(digitFont, textColour, backgroundColour);
+
+    std::strcpy(text, "00:00");
+    textLength = 5;
+    SetInitialSize(DoGetBestSize());
+}
+
+void TimerDisplayCtrl::SetTime(const char* newText) {
+    int length = static_cast<int>(std::strlen(newText));
+    if (length > MAX_TIME_CHARS) {
+        length = MAX_TIME_CHARS;
+    }
+
+    if (length != textLength) {
+        // Jumlah sel berubah (misalnya 100 menit): posisi semua sel bergeser
+        std::memcpy(text, newText, length);
+        text[length] = '\0';
+        textLength = length;
+        counters.timeUpdates++;
+        counters.invalidatedCells += length;
+        InvalidateBestSize();
+        Refresh(false);
+        return;
+    }
+
+    bool changed = false;
+    for (int i = 0; i < length; ++i) {
+        if (text[i] != newText[i]) {
+            text[i] = newText[i];
+            RefreshRect(CellRect(i), false);
+            counters.invalidatedCells++;
+            changed = true;
+        }
+    }
+    if (changed) {
+        counters.timeUpdates++;
+    }
+}
+
+bool TimerDisplayCtrl::SetProgress(double fraction) {
+    if (fraction < 0.0) {
+        fraction = 0.0;
+    } else if (fraction > 1.0) {
+        fraction = 1.0;
+    }
+    wxRect bar = BarRect();
+    int units = static_cast<int>(fraction * bar.GetWidth() * PROGRESS_SUBPIXELS + 0.5);
+    if (units == progressUnits) {
+        return false;
+    }
+
+    // Hanya kolom piksel antara ujung lama dan ujung baru
+    int first = (units < progressUnits ? units : progressUnits) / PROGRESS_SUBPIXELS;
+    int last = (units > progressUnits ? units : progressUnits) / PROGRESS_SUBPIXELS;
+    progressUnits = units;
+    counters.progressUpdates++;
+    RefreshRect(wxRect(bar.GetX() + first, bar.GetY(), last - first + 1, bar.GetHeight()), false);
+    return true;
+}
+
+void TimerDisplayCtrl::SetColours(const wxColour& text, const wxColour& background,
+                                  const wxColour& track, const wxColour& fill) {
+    textColour = text;
+    backgroundColour = background;
+    trackColour = track;
+    fillColour = fill;
+    glyphs.Select(digitFont, textColour, backgroundColour);
+    Refresh(false);
+}
+
+wxSize TimerDisplayCtrl::DoGetBestSize() const {
+    int width = TextWidth() + 10;
+    if (barWidth > width) {
+        width = barWidth;
+    }
+    return wxSize(width, glyphs.Height() + BAR_GAP + BAR_HEIGHT);
+}
+
+int TimerDisplayCtrl::TextWidth() const {
+    int width = 0;
+    for (int i = 0; i < textLength; ++i) {
+        width += glyphs.CellWidth(text[i]);
+    }
+    return width;
+}
+
+// Teks di tengah; lebar sel tetap sehingga posisi sel tidak bergantung angka
+wxRect TimerDisplayCtrl::CellRect(int index) const {
+    int x = (GetClientSize().GetWidth() - TextWidth()) / 2;
+    for (int i = 0; i < index; ++i) {
+        x += glyphs.CellWidth(text[i]);
+    }
+    return wxRect(x, 0, glyphs.CellWidth(text[index]), glyphs.Height());
+}
+
+wxRect TimerDisplayCtrl::BarRect() const {
+    int width = GetClientSize().GetWidth();
+    int barLength = barWidth < width ? barWidth : width;
+    return wxRect((width - barLength) / 2, glyphs.Height() + BAR_GAP, barLength, BAR_HEIGHT);
+}
+
+void TimerDisplayCtrl::OnPaint(wxPaintEvent& event) {
+    int64_t begin = SteadyNowNs();
+    wxAutoBufferedPaintDC dc(this);
+    const wxRegion& update = GetUpdateRegion();
+
+    // Latar hanya pada area yang di-invalidate
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(wxBrush(backgroundColour));
+    for (wxRegionIterator it(update); it; ++it) {
+        wxRect rect = it.GetRect();
+        dc.DrawRectangle(rect.GetX(), rect.GetY(), rect.GetWidth(), rect.GetHeight());
+    }
+
+    // Glyph dari cache untuk sel yang kena update
+    wxRect cell = CellRect(0);
+    for (int i = 0; i < textLength; ++i) {
+        cell.width = glyphs.CellWidth(text[i]);
+        if (update.Contains(cell) != wxOutRegion) {
+            dc.DrawBitmap(glyphs.Glyph(text[i]), cell.GetX(), cell.GetY(), false);
+            counters.glyphBlits++;
+        }
+        cell.x += cell.width;
+    }
+
+    // Progress bar: bagian terisi, satu kolom ujung yang dicampur, sisa track
+    wxRect bar = BarRect();
+    if (update.Contains(bar) != wxOutRegion) {
+        int full = progressUnits / PROGRESS_SUBPIXELS;
+        int part = progressUnits % PROGRESS_SUBPIXELS;
+        dc.SetBrush(wxBrush(fillColour));
+        dc.DrawRectangle(bar.GetX(), bar.GetY(), full, bar.GetHeight());
+        int trackStart = full;
+        if (part > 0) {
+            dc.SetBrush(wxBrush(Blend(trackColour, fillColour, part, PROGRESS_SUBPIXELS)));
+            dc.DrawRectangle(bar.GetX() + full, bar.GetY(), 1, bar.GetHeight());
+            trackStart++;
+        }
+        dc.SetBrush(wxBrush(trackColour));
+        dc.DrawRectangle(bar.GetX() + trackStart, bar.GetY(),
+                         bar.GetWidth() - trackStart, bar.GetHeight());
+    }
+
+    counters.paints++;
+    counters.paintNs += SteadyNowNs() - begin;
+}
+
+// Posisi sel dan bar bergantung lebar jendela
+void TimerDisplayCtrl::OnSize(wxSizeEvent& event) {
+    Refresh(false);
+    event.Skip();
+}
@@ -0,0 +1,118 @@
+// TimerDisplayCtrl.h
+#ifndef TIMER_DISPLAY_CTRL_H
+#define TIMER_DISPLAY_CTRL_H
+
+#include <wx/wx.h>
+#include <string>
+
+// Karakter angka timer yang dirasterisasi: '0'..'9' dan ':'
+const int GLYPH_COUNT = 11;
+// Panjang maksimum teks waktu, sama dengan DisplayState::timeText
+const int MAX_TIME_CHARS = 7;
+// Resolusi ujung progress bar: seperempat piksel
+const int PROGRESS_SUBPIXELS = 4;
+
+// Glyph angka yang sudah dirasterisasi per kombinasi font dan warna tema.
+// Beberapa set disimpan sekaligus, sehingga ganti tema bolak-balik tidak
+// merasterisasi ulang.
+class GlyphCache {
+public:
+    GlyphCache();
+
+    // Memilih set glyph untuk font dan warna ini; dibuat jika belum ada
+    void Select(const wxFont& font, const wxColour& text, const wxColour& background);
+
+    // Hanya setelah Select()
+    const wxBitmap& Glyph(char c) const;
+    int CellWidth(char c) const;
+    int Height() const;
+
+    long long GetRasterizeCount() const { return rasterizeCount; }
+
+private:
+    struct Entry {
+        bool used;
+        long long lastUse;
+        int pointSize;
+        wxFontWeight weight;
+        wxColour text;
+        wxColour background;
+        wxBitmap glyphs[GLYPH_COUNT];
+        int digitWidth;       // semua angka memakai lebar sel yang sama
+        int colonWidth;
+        int height;
+    };
+
+    static const int ENTRIES = 4;   // dua tema x dua ukuran
+
+    Entry entries[ENTRIES];
+    int current;
+    long long useClock;
+    long long rasterizeCount;
+
+    void Rasterize(Entry& entry, const wxFont& font);
+};
+
+// Instrumentasi render
+struct TimerRenderCounters {
+    long long timeUpdates;        // SetTime dengan teks berbeda
+    long long progressUpdates;    // SetProgress yang menggeser ujung bar
+    long long invalidatedCells;   // sel karakter yang di-invalidate
+    long long paints;
+    long long glyphBlits;
+    long long paintNs;            // total waktu handler paint
+
+    TimerRenderCounters()
+        : timeUpdates(0), progressUpdates(0), invalidatedCells(0),
+          paints(0), glyphBlits(0), paintNs(0) {}
+
+    std::string Report() const;
+};
+
+// Angka countdown besar dan progress bar yang digambar sendiri.
+// Angka digambar dari GlyphCache; setiap perubahan hanya meng-invalidate
+// sel karakter yang berbeda, dan progress bar hanya kolom piksel yang
+// dilewati ujungnya. Paint memakai buffer ganda (wxBG_STYLE_PAINT).
+class TimerDisplayCtrl : public wxControl {
+public:
+    TimerDisplayCtrl(wxWindow* parent, wxWindowID id, int pointSize, int barWidth = 300);
+
+    // Teks "MM:SS"
+    void SetTime(const char* newText);
+    // 0..1; true jika ada bagian bar yang perlu digambar ulang
+    bool SetProgress(double fraction);
+    void SetColours(const wxColour& text, const wxColour& background,
+                    const wxColour& track, const wxColour& fill);
+
+    const TimerRenderCounters& GetCounters() const { return counters; }
+    long long GetRasterizeCount() const { return glyphs.GetRasterizeCount(); }
+
+protected:
+    wxSize DoGetBestSize() const override;
+
+private:
+    GlyphCache glyphs;
+    wxFont digitFont;
+    wxColour textColour;
+    wxColour backgroundColour;
+    wxColour trackColour;
+    wxColour fillColour;
+
+    char text[MAX_TIME_CHARS + 1];
+    int textLength;
+    int barWidth;
+    int progressUnits;    // lebar isi bar dalam 1/PROGRESS_SUBPIXELS piksel
+
+    TimerRenderCounters counters;
+
+    int TextWidth() const;
+    wxRect CellRect(int index) const;
+    wxRect BarRect() const;
+
+    void OnPaint(wxPaintEvent& event);
+    void OnSize(wxSizeEvent& event);
+
+    DECLARE_EVENT_TABLE()
+};
+
+#endif // TIMER_DISPLAY_CTRL_H
@@ -0,0 +1,129 @@
+// TimerRegistry.cpp
+#include "TimerRegistry.h"
+
+TimerRegistry::TimerRegistry(Clock& clock)
+    : clock(clock), wheel(clock.NowMs()) {
+}
+
+TimerRegistry::Handle TimerRegistry::Add(const std::string& name) {
+    if (nameIndex.count(name) > 0) {
+        return INVALID_HANDLE;
+    }
+
+    Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<Handle>(timers.size());
+        timers.push_back(Entry());
+    }
+
+    Entry& entry = timers[handle];
+    entry.core.reset(new TimerCore(clock));
+    entry.name = name;
+    entry.wheelId = TimingWheel::INVALID_TIMER;
+    entry.wheelDeadline = -1;
+    entry.used = true;
+    nameIndex[name] = handle;
+    return handle;
+}
+
+bool TimerRegistry::Remove(Handle handle) {
+    if (!IsValid(handle)) {
+        return false;
+    }
+    Entry& entry = timers[handle];
+    wheel.Cancel(entry.wheelId);
+    nameIndex.erase(entry.name);
+    entry.core.reset();
+    entry.name.clear();
+    entry.wheelId = TimingWheel::INVALID_TIMER;
+    entry.used = false;
+    freeHandles.push_back(handle);
+    return true;
+}
+
+TimerRegistry::Handle TimerRegistry::Find(const std::string& name) const {
+    std::unordered_map<std::string, Handle>::const_iterator it = nameIndex.find(name);
+    return it != nameIndex.end() ? it->second : INVALID_HANDLE;
+}
+
+bool TimerRegistry::IsValid(Handle handle) const {
+    return handle < timers.size() && timers[handle].used;
+}
+
+void TimerRegistry::Start(Handle handle) {
+    Core(handle).Start();
+    Sync(handle);
+}
+
+void TimerRegistry::Pause(Handle handle) {
+    Core(handle).Pause();
+    Sync(handle);
+}
+
+void TimerRegistry::Reset(Handle handle) {
+    Core(handle).Reset();
+    Sync(handle);
+}
+
+void TimerRegistry::Poll(Handle handle) {
+    Core(handle).Poll();
+    Sync(handle);
+}
+
+void TimerRegistry::Sync(Handle handle) {
+    Entry& entry = timers[handle];
+    int64_t deadline = entry.core->NextDeadlineMs();
+
+    // Deadline yang sama tidak perlu dipindah di wheel
+    if (entry.wheelId != TimingWheel::INVALID_TIMER) {
+        if (deadline == entry.wheelDeadline) {
+            return;
+        }
+        wheel.Cancel(entry.wheelId);
+        entry.wheelId = TimingWheel::INVALID_TIMER;
+    }
+    if (deadline >= 0) {
+        entry.wheelId = wheel.Schedule(deadline, handle);
+        entry.wheelDeadline = deadline;
+    }
+}
+
+size_t TimerRegistry::Advance() {
+    expired.clear();
+    wheel.Advance(clock.NowMs(), [this](uint32_t handle, int64_t) {
+        timers[handle].wheelId = TimingWheel::INVALID_TIMER;
+        expired.push_back(handle);
+    });
+
+    // Poll dilakukan di luar callback wheel karena Sync menjadwalkan ulang
+    // deadline berikutnya (akhir transisi, sesi berikutnya)
+    for (size_t i = 0; i < expired.size(); ++i) {
+        Handle handle = expired[i];
+        if (IsValid(handle)) {
+            Poll(handle);
+        }
+    }
+    return expired.size();
+}
+
+size_t TimerRegistry::MemoryBytes() const {
+    size_t bytes = sizeof(*this) + wheel.MemoryBytes() - sizeof(wheel);
+    bytes += timers.capacity() * sizeof(Entry);
+    bytes += freeHandles.capacity() * sizeof(Handle);
+    bytes += expired.capacity() * sizeof(Handle);
+    for (size_t i = 0; i < timers.size(); ++i) {
+        if (timers[i].used) {
+            bytes += sizeof(TimerCore);
+            if (timers[i].name.capacity() > 15) {
+                bytes += timers[i].name.capacity() + 1;
+            }
+        }
+    }
+    // Perkiraan node hash map: pointer next, key, value, hash
+    bytes += nameIndex.size() * (sizeof(void*) + sizeof(std::string) + sizeof(Handle) + sizeof(size_t));
+    bytes += nameIndex.bucket_count() * sizeof(void*);
+    return bytes;
+}
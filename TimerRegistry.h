@@ -0,0 +1,73 @@
+// TimerRegistry.h
+#ifndef TIMER_REGISTRY_H
+#define TIMER_REGISTRY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Clock.h"
+#include "TimerCore.h"
+#include "TimingWheel.h"
+
+// Nama timer utama pemilik (yang ditampilkan jendela dan dicatat ke jurnal)
+const char* const DEFAULT_TIMER_NAME = "default";
+
+// Kumpulan timer bernama (per proyek, per ruangan, per orang) yang berbagi
+// satu Clock. Setiap timer adalah TimerCore biasa; deadline berikutnya
+// didaftarkan ke satu TimingWheel sehingga pemilik cukup menjadwalkan satu
+// wakeup OS untuk deadline terdekat di antara semua timer.
+class TimerRegistry {
+public:
+    typedef uint32_t Handle;
+    static const Handle INVALID_HANDLE = 0xFFFFFFFFu;
+
+    explicit TimerRegistry(Clock& clock);
+
+    Handle Add(const std::string& name);
+    bool Remove(Handle handle);
+    Handle Find(const std::string& name) const;
+    bool IsValid(Handle handle) const;
+
+    TimerCore& Core(Handle handle) { return *timers[handle].core; }
+    const TimerCore& Core(Handle handle) const { return *timers[handle].core; }
+    const std::string& Name(Handle handle) const { return timers[handle].name; }
+
+    // Perintah per timer; deadline di wheel ikut diperbarui
+    void Start(Handle handle);
+    void Pause(Handle handle);
+    void Reset(Handle handle);
+    void Poll(Handle handle);
+
+    // Mendaftarkan ulang deadline setelah TimerCore diubah langsung
+    void Sync(Handle handle);
+
+    // Mem-Poll setiap timer yang deadline-nya sudah lewat; hasilnya jumlah
+    // timer yang diproses
+    size_t Advance();
+
+    // Deadline terdekat di antara semua timer, atau -1
+    int64_t NextDeadlineMs() const { return wheel.NextDeadlineMs(); }
+
+    size_t Size() const { return nameIndex.size(); }
+    size_t MemoryBytes() const;
+
+private:
+    struct Entry {
+        std::unique_ptr<TimerCore> core;
+        std::string name;
+        TimingWheel::TimerId wheelId;
+        int64_t wheelDeadline;
+        bool used;
+    };
+
+    Clock& clock;
+    TimingWheel wheel;
+    std::vector<Entry> timers;
+    std::vector<Handle> freeHandles;
+    std::unordered_map<std::string, Handle> nameIndex;
+    std::vector<Handle> expired;
+};
+
+#endif // TIMER_REGISTRY_H
@@ -0,0 +1,256 @@
+// TimingWheel.cpp
+#include "TimingWheel.h"
+
+#include <cstring>
+
+namespace {
+
+int CountTrailingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    int count = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+}
+
+TimingWheel::TimingWheel(int64_t startMs)
+    : currentTick(startMs), activeCount(0), overflowHead(NIL) {
+    for (int level = 0; level < LEVELS; ++level) {
+        for (int slot = 0; slot < SLOTS; ++slot) {
+            heads[level][slot] = NIL;
+        }
+    }
+    std::memset(occupied, 0, sizeof(occupied));
+    std::memset(slotMinDirty, 0, sizeof(slotMinDirty));
+}
+
+TimingWheel::TimerId TimingWheel::Schedule(int64_t deadlineMs, uint32_t payload) {
+    uint32_t index = AllocNode();
+    Node& node = nodes[index];
+    node.deadline = deadlineMs;
+    node.payload = payload;
+    node.active = true;
+    activeCount++;
+    Insert(index);
+    return static_cast<TimerId>(index) | (static_cast<TimerId>(node.generation) << 32);
+}
+
+bool TimingWheel::Cancel(TimerId id) {
+    uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (id == INVALID_TIMER || index >= nodes.size()) {
+        return false;
+    }
+    Node& node = nodes[index];
+    if (!node.active || node.generation != generation) {
+        return false;
+    }
+    Unlink(index);
+    node.active = false;
+    node.generation++;
+    freeNodes.push_back(index);
+    activeCount--;
+    return true;
+}
+
+int64_t TimingWheel::NextDeadlineMs() const {
+    if (activeCount == 0) {
+        return -1;
+    }
+
+    int64_t best = -1;
+
+    // Level 0: setiap slot mewakili tepat satu tick dalam 256 ms ke depan
+    int current0 = static_cast<int>(currentTick & (SLOTS - 1));
+    int64_t lapStart = currentTick & ~static_cast<int64_t>(SLOTS - 1);
+    int slot = NextOccupied(0, current0);
+    if (slot >= 0) {
+        best = lapStart + slot;
+    } else {
+        slot = NextOccupied(0, 0);
+        if (slot >= 0) {
+            best = lapStart + SLOTS + slot;
+        }
+    }
+
+    // Level di atasnya: slot terisi pertama searah putaran berisi deadline
+    // terkecil level itu; isinya perlu dipindai. Slot saat ini biasanya
+    // berisi putaran berikutnya, kecuali currentTick tepat di batas
+    // putaran yang belum di-cascade.
+    for (int level = 1; level < LEVELS; ++level) {
+        int current = static_cast<int>((currentTick >> (8 * level)) & (SLOTS - 1));
+        int64_t lapMask = (static_cast<int64_t>(1) << (8 * level)) - 1;
+        bool pending = (currentTick & lapMask) == 0;
+        int found = NextOccupied(level, pending ? current : current + 1);
+        if (found < 0) {
+            found = NextOccupied(level, 0);
+        }
+        if (found < 0) {
+            continue;
+        }
+        int64_t candidate = SlotMin(level, found);
+        if (best < 0 || candidate < best) {
+            best = candidate;
+        }
+    }
+
+    if (overflowHead != NIL) {
+        int64_t candidate = MinDeadlineInList(overflowHead);
+        if (best < 0 || candidate < best) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+size_t TimingWheel::MemoryBytes() const {
+    return sizeof(*this) + nodes.capacity() * sizeof(Node) +
+           freeNodes.capacity() * sizeof(uint32_t);
+}
+
+uint32_t TimingWheel::AllocNode() {
+    if (!freeNodes.empty()) {
+        uint32_t index = freeNodes.back();
+        freeNodes.pop_back();
+        return index;
+    }
+    Node node = Node();
+    node.next = NIL;
+    node.prev = NIL;
+    nodes.push_back(node);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void TimingWheel::Insert(uint32_t index) {
+    Node& node = nodes[index];
+    int64_t tick = node.deadline < currentTick ? currentTick : node.deadline;
+    uint64_t diff = static_cast<uint64_t>(tick - currentTick);
+
+    int level = 0;
+    while (level < LEVELS && diff >= (1ULL << (8 * (level + 1)))) {
+        level++;
+    }
+
+    if (level == LEVELS) {
+        node.level = OVERFLOW_LEVEL;
+        node.slot = 0;
+        Link(index, overflowHead);
+        return;
+    }
+
+    int slot = static_cast<int>((tick >> (8 * level)) & (SLOTS - 1));
+    node.level = static_cast<uint8_t>(level);
+    node.slot = static_cast<uint8_t>(slot);
+    uint64_t bit = 1ULL << (slot % 64);
+    if (heads[level][slot] == NIL) {
+        slotMin[level][slot] = node.deadline;
+        slotMinDirty[level][slot / 64] &= ~bit;
+    } else if (node.deadline < slotMin[level][slot]) {
+        slotMin[level][slot] = node.deadline;
+    }
+    Link(index, heads[level][slot]);
+    occupied[level][slot / 64] |= bit;
+}
+
+void TimingWheel::Link(uint32_t index, uint32_t& head) {
+    Node& node = nodes[index];
+    node.prev = NIL;
+    node.next = head;
+    if (head != NIL) {
+        nodes[head].prev = index;
+    }
+    head = index;
+}
+
+void TimingWheel::Unlink(uint32_t index) {
+    Node& node = nodes[index];
+    uint32_t& head = HeadOf(node);
+    if (node.prev != NIL) {
+        nodes[node.prev].next = node.next;
+    } else {
+        head = node.next;
+    }
+    if (node.next != NIL) {
+        nodes[node.next].prev = node.prev;
+    }
+    if (node.level != OVERFLOW_LEVEL) {
+        uint64_t bit = 1ULL << (node.slot % 64);
+        if (head == NIL) {
+            occupied[node.level][node.slot / 64] &= ~bit;
+        } else if (node.deadline == slotMin[node.level][node.slot]) {
+            slotMinDirty[node.level][node.slot / 64] |= bit;
+        }
+    }
+    node.next = NIL;
+    node.prev = NIL;
+}
+
+uint32_t& TimingWheel::HeadOf(const Node& node) {
+    if (node.level == OVERFLOW_LEVEL) {
+        return overflowHead;
+    }
+    return heads[node.level][node.slot];
+}
+
+void TimingWheel::Cascade(int level) {
+    int slot = static_cast<int>((currentTick >> (8 * level)) & (SLOTS - 1));
+    uint32_t index = heads[level][slot];
+    heads[level][slot] = NIL;
+    occupied[level][slot / 64] &= ~(1ULL << (slot % 64));
+
+    while (index != NIL) {
+        uint32_t next = nodes[index].next;
+        Insert(index);
+        index = next;
+    }
+
+    // Timer di luar jangkauan wheel dicek ulang setiap putaran level teratas
+    if (level == LEVELS - 1 && overflowHead != NIL) {
+        uint32_t overflow = overflowHead;
+        overflowHead = NIL;
+        while (overflow != NIL) {
+            uint32_t next = nodes[overflow].next;
+            Insert(overflow);
+            overflow = next;
+        }
+    }
+}
+
+int TimingWheel::NextOccupied(int level, int fromSlot) const {
+    for (int word = fromSlot / 64; word < SLOTS / 64; ++word) {
+        uint64_t bits = occupied[level][word];
+        if (word == fromSlot / 64) {
+            bits &= ~0ULL << (fromSlot % 64);
+        }
+        if (bits != 0) {
+            return word * 64 + CountTrailingZeros(bits);
+        }
+    }
+    return -1;
+}
+
+int64_t TimingWheel::SlotMin(int level, int slot) const {
+    uint64_t bit = 1ULL << (slot % 64);
+    if (slotMinDirty[level][slot / 64] & bit) {
+        slotMin[level][slot] = MinDeadlineInList(heads[level][slot]);
+        slotMinDirty[level][slot / 64] &= ~bit;
+    }
+    return slotMin[level][slot];
+}
+
+int64_t TimingWheel::MinDeadlineInList(uint32_t head) const {
+    int64_t best = -1;
+    for (uint32_t index = head; index != NIL; index = nodes[index].next) {
+        if (best < 0 || nodes[index].deadline < best) {
+            best = nodes[index].deadline;
+        }
+    }
+    return best;
+}
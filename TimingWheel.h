@@ -0,0 +1,127 @@
+// TimingWheel.h
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Timing wheel hierarkis 4 level x 256 slot dengan resolusi 1 ms
+// (jangkauan ~49 hari, sisanya di daftar overflow). Schedule dan Cancel
+// O(1); Advance melompati slot kosong memakai bitmap per level.
+class TimingWheel {
+public:
+    typedef uint64_t TimerId;     // indeks node | (generasi << 32)
+    static const TimerId INVALID_TIMER = ~0ULL;
+
+    explicit TimingWheel(int64_t startMs = 0);
+
+    TimerId Schedule(int64_t deadlineMs, uint32_t payload);
+    bool Cancel(TimerId id);
+
+    // Menjalankan onExpire(payload, deadlineMs) untuk setiap timer dengan
+    // deadline <= nowMs. Callback boleh memanggil Schedule/Cancel.
+    template <class F>
+    void Advance(int64_t nowMs, F onExpire);
+
+    // Deadline terdekat, atau -1 jika kosong
+    int64_t NextDeadlineMs() const;
+
+    size_t Size() const { return activeCount; }
+    int64_t CurrentMs() const { return currentTick; }
+    size_t MemoryBytes() const;
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOTS = 256;
+    static const uint32_t NIL = 0xFFFFFFFFu;
+    static const uint8_t OVERFLOW_LEVEL = 0xFF;
+
+    struct Node {
+        int64_t deadline;
+        uint32_t next;
+        uint32_t prev;
+        uint32_t generation;
+        uint32_t payload;
+        uint8_t level;
+        uint8_t slot;
+        bool active;
+    };
+
+    int64_t currentTick;           // semua tick < currentTick sudah diproses
+    size_t activeCount;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeNodes;
+    uint32_t heads[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS][SLOTS / 64];
+    uint32_t overflowHead;
+
+    // Deadline terkecil per slot, agar NextDeadlineMs tidak memindai daftar
+    // panjang di level atas pada setiap wakeup. Dihitung ulang hanya jika
+    // node terkecil dibatalkan.
+    mutable int64_t slotMin[LEVELS][SLOTS];
+    mutable uint64_t slotMinDirty[LEVELS][SLOTS / 64];
+
+    uint32_t AllocNode();
+    void Insert(uint32_t index);
+    void Link(uint32_t index, uint32_t& head);
+    void Unlink(uint32_t index);
+    uint32_t& HeadOf(const Node& node);
+    void Cascade(int level);
+    int NextOccupied(int level, int fromSlot) const;
+    int64_t MinDeadlineInList(uint32_t head) const;
+    int64_t SlotMin(int level, int slot) const;
+
+    template <class F>
+    void ExpireSlot(int slot, F& onExpire);
+};
+
+template <class F>
+void TimingWheel::Advance(int64_t nowMs, F onExpire) {
+    while (currentTick <= nowMs) {
+        if ((currentTick & (SLOTS - 1)) == 0) {
+            // Batas putaran level 0: turunkan timer dari level di atasnya
+            int level = 1;
+            while (level < LEVELS - 1 &&
+                   ((currentTick >> (8 * level)) & (SLOTS - 1)) == 0) {
+                level++;
+            }
+            for (; level >= 1; --level) {
+                Cascade(level);
+            }
+        }
+
+        int slot = static_cast<int>(currentTick & (SLOTS - 1));
+        ExpireSlot(slot, onExpire);
+
+        // Lompat ke slot level 0 berikutnya yang terisi di putaran ini,
+        // atau ke batas putaran berikutnya
+        int next = NextOccupied(0, slot + 1);
+        int64_t lapStart = currentTick & ~static_cast<int64_t>(SLOTS - 1);
+        int64_t nextTick = (next >= 0 && next > slot) ? lapStart + next : lapStart + SLOTS;
+        if (nextTick > nowMs) {
+            currentTick = nowMs + 1;
+            break;
+        }
+        currentTick = nextTick;
+    }
+}
+
+template <class F>
+void TimingWheel::ExpireSlot(int slot, F& onExpire) {
+    // Callback bisa menambah timer baru pada tick yang sama; ulangi sampai kosong
+    while (heads[0][slot] != NIL) {
+        uint32_t index = heads[0][slot];
+        Unlink(index);
+        Node& node = nodes[index];
+        uint32_t payload = node.payload;
+        int64_t deadline = node.deadline;
+        node.active = false;
+        node.generation++;
+        freeNodes.push_back(index);
+        activeCount--;
+        onExpire(payload, deadline);
+    }
+}
+
+#endif // TIMING_WHEEL_H
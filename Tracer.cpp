@@ -0,0 +1,252 @@
+// Tracer.cpp
+#include "Tracer.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char* const HANDLER_NAMES[TRACE_HANDLER_COUNT] = {
+    "OnTimer",
+    "UpdateTimerDisplay",
+    "SaveSettings",
+    "ShowNotificationDialog",
+    "ApplyTheme"
+};
+
+int MostSignificantBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Nomor kecil per thread untuk kolom "tid" di trace
+uint32_t CurrentThreadId() {
+    static std::atomic<uint32_t> nextId(1);
+    thread_local uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+double NsToMs(int64_t ns) {
+    return ns / 1e6;
+}
+
+}
+
+const char* TraceHandlerName(TraceHandler handler) {
+    return handler >= 0 && handler < TRACE_HANDLER_COUNT ? HANDLER_NAMES[handler] : "tick";
+}
+
+LatencyHistogram::LatencyHistogram()
+    : count(0), sumNs(0), maxNs(0) {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::BucketIndex(int64_t ns) {
+    if (ns < 2 * SUB_BUCKETS) {
+        return ns > 0 ? static_cast<int>(ns) : 0;
+    }
+    int shift = MostSignificantBit(static_cast<uint64_t>(ns)) - 5;
+    if (shift > MAX_SHIFT) {
+        return BUCKET_COUNT - 1;
+    }
+    return 2 * SUB_BUCKETS + (shift - 1) * SUB_BUCKETS +
+           static_cast<int>((ns >> shift) - SUB_BUCKETS);
+}
+
+int64_t LatencyHistogram::BucketLowerNs(int index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    int shift = (index - 2 * SUB_BUCKETS) / SUB_BUCKETS + 1;
+    int64_t sub = (index - 2 * SUB_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+    return sub << shift;
+}
+
+int64_t LatencyHistogram::BucketWidthNs(int index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return 1;
+    }
+    return static_cast<int64_t>(1) << ((index - 2 * SUB_BUCKETS) / SUB_BUCKETS + 1);
+}
+
+void LatencyHistogram::Record(int64_t ns) {
+    if (ns < 0) {
+        ns = 0;
+    }
+    buckets[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sumNs.fetch_add(ns, std::memory_order_relaxed);
+    int64_t seen = maxNs.load(std::memory_order_relaxed);
+    while (ns > seen && !maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::Clear() {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sumNs.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::MeanNs() const {
+    long long n = Count();
+    return n > 0 ? static_cast<double>(sumNs.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+int64_t LatencyHistogram::PercentileNs(double p) const {
+    long long total = Count();
+    if (total == 0) {
+        return 0;
+    }
+    long long target = static_cast<long long>(p * total + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+    long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            int64_t value = BucketLowerNs(i) + BucketWidthNs(i) / 2;
+            int64_t max = MaxNs();
+            return value < max ? value : max;
+        }
+    }
+    return MaxNs();
+}
+
+std::string LatencyHistogram::Report() const {
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer),
+                  "n=%lld p50=%.3fms p99=%.3fms p99.9=%.3fms max=%.3fms",
+                  Count(), NsToMs(PercentileNs(0.50)), NsToMs(PercentileNs(0.99)),
+                  NsToMs(PercentileNs(0.999)), NsToMs(MaxNs()));
+    return buffer;
+}
+
+Tracer::Tracer()
+    : enabled(false), begin(std::chrono::steady_clock::now()),
+      outputPath(TRACE_FILE), eventCount(0) {
+}
+
+void Tracer::SetEnabled(bool enable) {
+    if (enable && !events) {
+        events.reset(new TraceEvent[EVENT_CAPACITY]);
+    }
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+int64_t Tracer::NowNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+}
+
+void Tracer::RecordSpan(TraceHandler handler, int64_t startNs, int64_t endNs) {
+    histograms[handler].Record(endNs - startNs);
+    AddEvent(static_cast<uint16_t>(handler), startNs, endNs - startNs);
+}
+
+void Tracer::RecordTickLateness(int64_t latenessNs) {
+    if (latenessNs < 0) {
+        latenessNs = 0;
+    }
+    tickJitter.Record(latenessNs);
+    AddEvent(TRACE_HANDLER_COUNT, NowNs(), latenessNs);
+}
+
+void Tracer::AddEvent(uint16_t handler, int64_t startNs, int64_t valueNs) {
+    if (!events) {
+        return;
+    }
+    long long index = eventCount.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent& event = events[static_cast<size_t>(index) % EVENT_CAPACITY];
+    event.startNs = startNs;
+    event.valueNs = valueNs;
+    event.threadId = CurrentThreadId();
+    event.handler = handler;
+    event.reserved = 0;
+}
+
+std::string Tracer::Report() const {
+    std::string text;
+    for (int i = 0; i < TRACE_HANDLER_COUNT; ++i) {
+        if (histograms[i].Count() == 0) {
+            continue;
+        }
+        text += std::string("trace ") + HANDLER_NAMES[i] + " " + histograms[i].Report() + "\n";
+    }
+    if (tickJitter.Count() > 0) {
+        text += "trace tick_late " + tickJitter.Report() + "\n";
+    }
+    return text;
+}
+
+bool Tracer::WriteChromeTrace(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    long long total = GetEventCount();
+    long long first = total > static_cast<long long>(EVENT_CAPACITY) ?
+                      total - static_cast<long long>(EVENT_CAPACITY) : 0;
+
+    // ts dan dur dalam mikrodetik; span sebagai event "X", jitter tick
+    // sebagai counter "C"
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"pomodoro\"}}", file);
+    for (long long i = first; events && i < total; ++i) {
+        const TraceEvent& event = events[static_cast<size_t>(i) % EVENT_CAPACITY];
+        if (event.handler < TRACE_HANDLER_COUNT) {
+            std::fprintf(file,
+                         ",\n{\"name\":\"%s\",\"cat\":\"handler\",\"ph\":\"X\",\"ts\":%.3f,"
+                         "\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                         HANDLER_NAMES[event.handler], event.startNs / 1e3,
+                         event.valueNs / 1e3, event.threadId);
+        } else {
+            std::fprintf(file,
+                         ",\n{\"name\":\"tick_late_ms\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,"
+                         "\"args\":{\"ms\":%.3f}}",
+                         event.startNs / 1e3, NsToMs(event.valueNs));
+        }
+    }
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+
+Tracer& GetTracer() {
+    static Tracer tracer;
+    return tracer;
+}
+
+bool ParseTraceFlag(int argc, char** argv, std::string& path) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace") == 0) {
+            path = TRACE_FILE;
+            return true;
+        }
+        if (std::strncmp(argv[i], "--trace=", 8) == 0 && argv[i][8] != '\0') {
+            path = argv[i] + 8;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ConfigureTracer(int argc, char** argv) {
+    std::string path;
+    if (ParseTraceFlag(argc, argv, path)) {
+        GetTracer().SetOutputPath(path);
+        GetTracer().SetEnabled(true);
+    }
+}
@@ -0,0 +1,150 @@
+// Tracer.h
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Nama file trace default untuk --trace
+const char* const TRACE_FILE = "pomodoro_trace.json";
+
+// Handler yang diukur; urutannya sama dengan TraceHandlerName()
+enum TraceHandler {
+    TRACE_ON_TIMER,
+    TRACE_UPDATE_DISPLAY,
+    TRACE_SAVE_SETTINGS,
+    TRACE_SHOW_NOTIFICATION,
+    TRACE_APPLY_THEME,
+    TRACE_HANDLER_COUNT
+};
+
+const char* TraceHandlerName(TraceHandler handler);
+
+// Histogram latensi gaya HDR dalam nanodetik: 0..63 ns linear, setelah itu
+// 32 sub-bucket per pangkat dua (galat relatif <= 3%) sampai ~2 jam.
+// Record() hanya beberapa operasi atomik relaxed, tanpa lock dan alokasi,
+// aman dari thread mana pun.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKETS = 32;
+    static const int MAX_SHIFT = 37;
+    static const int BUCKET_COUNT = 2 * SUB_BUCKETS + MAX_SHIFT * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    void Record(int64_t ns);
+    void Clear();
+
+    long long Count() const { return count.load(std::memory_order_relaxed); }
+    int64_t MaxNs() const { return maxNs.load(std::memory_order_relaxed); }
+    double MeanNs() const;
+
+    // Persentil (0..1), nilai tengah bucket-nya
+    int64_t PercentileNs(double p) const;
+
+    // "n=.. p50=..ms p99=..ms p99.9=..ms max=..ms"
+    std::string Report() const;
+
+    static int BucketIndex(int64_t ns);
+    static int64_t BucketLowerNs(int index);
+    static int64_t BucketWidthNs(int index);
+
+private:
+    std::atomic<long long> buckets[BUCKET_COUNT];
+    std::atomic<long long> count;
+    std::atomic<long long> sumNs;
+    std::atomic<int64_t> maxNs;
+};
+
+// Satu event untuk trace Chrome/Perfetto
+struct TraceEvent {
+    int64_t startNs;
+    int64_t valueNs;          // durasi span, atau keterlambatan tick
+    uint32_t threadId;
+    uint16_t handler;         // TraceHandler; TRACE_HANDLER_COUNT = tick
+    uint16_t reserved;
+};
+
+// Histogram per handler, histogram jitter tick dan ring buffer event untuk
+// diekspor sebagai JSON trace Chrome (chrome://tracing, ui.perfetto.dev).
+// Saat dimatikan, satu-satunya biaya di handler adalah satu load atomik.
+class Tracer {
+public:
+    // Event terbaru yang disimpan untuk ekspor; yang lebih lama ditimpa
+    static const size_t EVENT_CAPACITY = 65536;
+
+    Tracer();
+
+    // Dipanggil di awal main() sebelum thread lain dibuat
+    void SetEnabled(bool enable);
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void SetOutputPath(const std::string& path) { outputPath = path; }
+    const std::string& GetOutputPath() const { return outputPath; }
+
+    // Nanodetik sejak tracer dibuat (steady_clock)
+    int64_t NowNs() const;
+
+    void RecordSpan(TraceHandler handler, int64_t startNs, int64_t endNs);
+    // Selisih waktu bangun sebenarnya dengan jadwalnya; bangun lebih awal
+    // dicatat sebagai 0
+    void RecordTickLateness(int64_t latenessNs);
+
+    const LatencyHistogram& Histogram(TraceHandler handler) const { return histograms[handler]; }
+    const LatencyHistogram& TickJitter() const { return tickJitter; }
+    long long GetEventCount() const { return eventCount.load(std::memory_order_relaxed); }
+
+    // Satu baris per handler yang pernah tercatat, ditambah jitter tick
+    std::string Report() const;
+
+    // Menulis event di ring buffer sebagai JSON trace Chrome
+    bool WriteChromeTrace(const std::string& path) const;
+
+private:
+    std::atomic<bool> enabled;
+    std::chrono::steady_clock::time_point begin;
+    std::string outputPath;
+    LatencyHistogram histograms[TRACE_HANDLER_COUNT];
+    LatencyHistogram tickJitter;
+    std::unique_ptr<TraceEvent[]> events;   // dialokasikan saat diaktifkan
+    std::atomic<long long> eventCount;
+
+    void AddEvent(uint16_t handler, int64_t startNs, int64_t valueNs);
+};
+
+// Tracer milik proses; dibuat saat pertama kali dipanggil
+Tracer& GetTracer();
+
+// true jika argumen berisi --trace atau --trace=FILE; path diisi FILE,
+// atau TRACE_FILE jika tidak disebut
+bool ParseTraceFlag(int argc, char** argv, std::string& path);
+
+// Mengaktifkan tracer milik proses jika ada --trace[=FILE]
+void ConfigureTracer(int argc, char** argv);
+
+// Mengukur durasi scope ke histogram handler-nya
+class ScopedTrace {
+public:
+    explicit ScopedTrace(TraceHandler handler)
+        : handler(handler), startNs(GetTracer().IsEnabled() ? GetTracer().NowNs() : -1) {}
+
+    ~ScopedTrace() {
+        if (startNs >= 0) {
+            Tracer& tracer = GetTracer();
+            tracer.RecordSpan(handler, startNs, tracer.NowNs());
+        }
+    }
+
+private:
+    TraceHandler handler;
+    int64_t startNs;
+
+    ScopedTrace(const ScopedTrace&);
+    ScopedTrace& operator=(const ScopedTrace&);
+};
+
+#endif // TRACER_H
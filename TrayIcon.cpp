@@ -0,0 +1,143 @@
+// TrayIcon.cpp
+#include "TrayIcon.h"
+
+#include <cstdio>
+
+namespace {
+
+enum {
+    ID_TRAY_START = wxID_HIGHEST + 100,
+    ID_TRAY_PAUSE,
+    ID_TRAY_RESET,
+    ID_TRAY_SHOW,
+    ID_TRAY_QUIT
+};
+
+// Ukuran ikon tray dalam piksel; di luar Windows panel tray menskalakan
+// sendiri, jadi dipakai ukuran default atlas
+int TrayIconSize() {
+#ifdef __WXMSW__
+    int size = wxSystemSettings::GetMetric(wxSYS_SMALLICON_X);
+    if (size > 0) {
+        return size;
+    }
+#endif
+    return TrayIconAtlas::DEFAULT_SIZE;
+}
+
+} // namespace
+
+TrayIcon::TrayIcon(TrayIconListener* listener)
+    : listener(listener), builtGeneration(0), shownFrame(-1), shownVariant(-1),
+      iconSwaps(0) {
+    readyTooltip = "Pomodoro Timer: siap";
+    Bind(wxEVT_MENU, &TrayIcon::OnMenu, this, ID_TRAY_START, ID_TRAY_QUIT);
+    Bind(wxEVT_TASKBAR_LEFT_UP, &TrayIcon::OnLeftClick, this);
+}
+
+void TrayIcon::Configure(const TrayIconStyle& style, int focusMinutes, int breakMinutes) {
+    atlas.Configure(TrayIconSize(), style, focusMinutes, breakMinutes);
+    if (atlas.GetGeneration() != builtGeneration) {
+        BuildIcons();
+    }
+}
+
+// Satu kali per perubahan atlas: RGBA -> wxImage -> wxIcon, plus tooltip
+void TrayIcon::BuildIcons() {
+    int size = atlas.Size();
+    int frames = atlas.FrameCount();
+    wxImage image(size, size, false);
+    image.InitAlpha();
+    unsigned char* rgb = image.GetData();
+    unsigned char* alpha = image.GetAlpha();
+
+    icons.assign(frames, wxIcon());
+    tooltips[0].assign(frames, wxString());
+    tooltips[1].assign(frames, wxString());
+    for (int frame = 0; frame < frames; ++frame) {
+        const uint8_t* pixels = atlas.Pixels(frame);
+        for (int i = 0; i < size * size; ++i) {
+            rgb[i * 3] = pixels[i * 4];
+            rgb[i * 3 + 1] = pixels[i * 4 + 1];
+            rgb[i * 3 + 2] = pixels[i * 4 + 2];
+            alpha[i] = pixels[i * 4 + 3];
+        }
+        icons[frame].CopyFromBitmap(wxBitmap(image));
+
+        const char* session = atlas.FrameIsBreak(frame) ? "Istirahat" : "Fokus";
+        int minutes = atlas.FrameMinutes(frame);
+        tooltips[0][frame] = wxString::Format("%s: %d menit lagi", session, minutes);
+        tooltips[1][frame] = wxString::Format("%s dijeda: %d menit lagi", session, minutes);
+    }
+    builtGeneration = atlas.GetGeneration();
+    // Paksa SetIcon berikutnya memakai ikon baru
+    shownFrame = -1;
+}
+
+// Jalur tick: tanpa rasterisasi dan tanpa alokasi kecuali frame berubah
+void TrayIcon::Update(TimerState state, int64_t remainingMs, int64_t durationMs) {
+    if (icons.empty()) {
+        return;
+    }
+    bool breakSession = state == RUNNING_BREAK || state == PAUSED_BREAK;
+    int frame = atlas.FrameIndex(breakSession, remainingMs, durationMs);
+    int variant = state == READY ? 0 : (state == PAUSED_FOCUS || state == PAUSED_BREAK) ? 2 : 1;
+    if (frame == shownFrame && variant == shownVariant) {
+        return;
+    }
+    SetIcon(icons[frame], variant == 0 ? readyTooltip : tooltips[variant - 1][frame]);
+    shownFrame = frame;
+    shownVariant = variant;
+    iconSwaps++;
+}
+
+int64_t TrayIcon::NextChangeDelayMs(TimerState state, int64_t remainingMs,
+                                    int64_t durationMs) const {
+    if (icons.empty() || (state != RUNNING_FOCUS && state != RUNNING_BREAK)) {
+        return -1;
+    }
+    return atlas.NextChangeDelayMs(state == RUNNING_BREAK, remainingMs, durationMs);
+}
+
+std::string TrayIcon::Report() const {
+    char line[160];
+    std::snprintf(line, sizeof(line), "size=%d frames=%d atlas=%.1f KiB rendered=%lld swaps=%lld",
+                  atlas.Size(), atlas.FrameCount(), atlas.MemoryBytes() / 1024.0,
+                  atlas.GetRenderedFrames(), iconSwaps);
+    return line;
+}
+
+wxMenu* TrayIcon::CreatePopupMenu() {
+    wxMenu* menu = new wxMenu();
+    menu->Append(ID_TRAY_START, "Start");
+    menu->Append(ID_TRAY_PAUSE, "Jeda");
+    menu->Append(ID_TRAY_RESET, "Reset");
+    menu->AppendSeparator();
+    menu->Append(ID_TRAY_SHOW, "Tampilkan");
+    menu->Append(ID_TRAY_QUIT, "Keluar");
+    return menu;
+}
+
+void TrayIcon::OnMenu(wxCommandEvent& event) {
+    switch (event.GetId()) {
+        case ID_TRAY_START:
+            listener->OnTrayCommand(CONTROL_START);
+            break;
+        case ID_TRAY_PAUSE:
+            listener->OnTrayCommand(CONTROL_PAUSE);
+            break;
+        case ID_TRAY_RESET:
+            listener->OnTrayCommand(CONTROL_RESET);
+            break;
+        case ID_TRAY_SHOW:
+            listener->OnTrayActivate();
+            break;
+        case ID_TRAY_QUIT:
+            listener->OnTrayQuit();
+            break;
+    }
+}
+
+void TrayIcon::OnLeftClick(wxTaskBarIconEvent& event) {
+    listener->OnTrayActivate();
+}
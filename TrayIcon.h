@@ -0,0 +1,62 @@
+// TrayIcon.h
+#ifndef TRAY_ICON_H
+#define TRAY_ICON_H
+
+#include <wx/wx.h>
+#include <wx/taskbar.h>
+#include <string>
+#include <vector>
+#include "ControlServer.h"
+#include "TimerCore.h"
+#include "TrayIconAtlas.h"
+
+// Dipanggil di thread GUI dari menu dan klik ikon tray
+class TrayIconListener {
+public:
+    virtual ~TrayIconListener() {}
+    virtual void OnTrayCommand(ControlCommand command) = 0;
+    virtual void OnTrayActivate() = 0;     // tampilkan jendela
+    virtual void OnTrayQuit() = 0;
+};
+
+// Ikon tray dengan sisa menit dan busur progres. Semua frame dari
+// TrayIconAtlas diubah ke wxIcon (dan tooltip-nya dibuat) saat Configure(),
+// sehingga Update() di jalur tick hanya memilih indeks dan memanggil
+// SetIcon() jika frame berubah.
+class TrayIcon : public wxTaskBarIcon {
+public:
+    explicit TrayIcon(TrayIconListener* listener);
+
+    // Tema atau durasi berubah; frame hanya dibuat ulang jika atlas berubah
+    void Configure(const TrayIconStyle& style, int focusMinutes, int breakMinutes);
+
+    void Update(TimerState state, int64_t remainingMs, int64_t durationMs);
+    // Jeda sampai ikon berubah untuk sesi yang berjalan, atau -1
+    int64_t NextChangeDelayMs(TimerState state, int64_t remainingMs, int64_t durationMs) const;
+
+    const TrayIconAtlas& GetAtlas() const { return atlas; }
+    long long GetIconSwaps() const { return iconSwaps; }
+    std::string Report() const;
+
+protected:
+    wxMenu* CreatePopupMenu() override;
+
+private:
+    TrayIconListener* listener;
+    TrayIconAtlas atlas;
+    unsigned builtGeneration;     // generasi atlas yang sudah diubah ke wxIcon
+    std::vector<wxIcon> icons;
+    // Per frame: [0] berjalan, [1] dijeda
+    std::vector<wxString> tooltips[2];
+    wxString readyTooltip;
+
+    int shownFrame;               // -1 = belum ada ikon
+    int shownVariant;             // 0 siap, 1 berjalan, 2 dijeda
+    long long iconSwaps;
+
+    void BuildIcons();
+    void OnMenu(wxCommandEvent& event);
+    void OnLeftClick(wxTaskBarIconEvent& event);
+};
+
+#endif // TRAY_ICON_H
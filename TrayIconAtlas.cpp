@@ -0,0 +1,247 @@
+// TrayIconAtlas.cpp
+#include "TrayIconAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Subsampel per sumbu untuk tepi busur yang halus
+const int SUBSAMPLES = 4;
+const float RING_INSIDE = -1.0f;
+const float RING_OUTSIDE = -2.0f;
+
+// Angka 5x7, bit 4 paling kiri
+const uint8_t DIGIT_FONT[10][7] = {
+    { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E },
+    { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E },
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F },
+    { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E },
+    { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 },
+    { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E },
+    { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E },
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 },
+    { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E },
+    { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C },
+};
+const int DIGIT_WIDTH = 5;
+const int DIGIT_HEIGHT = 7;
+
+bool SameColour(const TrayIconColour& a, const TrayIconColour& b) {
+    return a.red == b.red && a.green == b.green && a.blue == b.blue;
+}
+
+} // namespace
+
+bool SameTrayIconStyle(const TrayIconStyle& a, const TrayIconStyle& b) {
+    return SameColour(a.text, b.text) && SameColour(a.background, b.background) &&
+           SameColour(a.track, b.track) && SameColour(a.focusFill, b.focusFill) &&
+           SameColour(a.breakFill, b.breakFill);
+}
+
+TrayIconAtlas::TrayIconAtlas()
+    : size(0), style(), generation(0), renderedFrames(0) {
+    for (Strip& strip : strips) {
+        strip.minutes = 0;
+        strip.stepsPerMinute = 1;
+        strip.steps = 0;
+        strip.fill = TrayIconColour();
+    }
+}
+
+bool TrayIconAtlas::Configure(int iconSize, const TrayIconStyle& newStyle,
+                              int focusMinutes, int breakMinutes) {
+    iconSize = std::max(8, std::min(iconSize, 256));
+    bool geometryChanged = iconSize != size;
+    bool styleChanged = !IsConfigured() || !SameTrayIconStyle(style, newStyle);
+    size = iconSize;
+    style = newStyle;
+
+    const int minutes[2] = {
+        std::max(1, std::min(focusMinutes, static_cast<int>(MAX_MINUTES))),
+        std::max(1, std::min(breakMinutes, static_cast<int>(MAX_MINUTES)))
+    };
+    const TrayIconColour fills[2] = { style.focusFill, style.breakFill };
+    bool rendered = false;
+    for (int i = 0; i < 2; ++i) {
+        if (geometryChanged || styleChanged || strips[i].minutes != minutes[i]) {
+            if (geometry.empty()) {
+                BuildGeometry();
+            }
+            Render(strips[i], minutes[i], fills[i]);
+            rendered = true;
+        }
+    }
+    std::vector<float>().swap(geometry);
+    if (rendered) {
+        generation++;
+    }
+    return rendered;
+}
+
+int TrayIconAtlas::FrameIndex(bool breakSession, int64_t remainingMs, int64_t durationMs) const {
+    const Strip& strip = StripFor(breakSession);
+    if (strip.steps == 0) {
+        return 0;
+    }
+    int64_t duration = durationMs > 0 ? durationMs : strip.minutes * 60000LL;
+    int64_t elapsed = std::max<int64_t>(0, std::min(duration, duration - remainingMs));
+    int step = static_cast<int>(elapsed * strip.steps / duration);
+    return (breakSession ? strips[0].steps + 1 : 0) + step;
+}
+
+int64_t TrayIconAtlas::NextChangeDelayMs(bool breakSession, int64_t remainingMs,
+                                         int64_t durationMs) const {
+    const Strip& strip = StripFor(breakSession);
+    if (strip.steps == 0) {
+        return -1;
+    }
+    int64_t duration = durationMs > 0 ? durationMs : strip.minutes * 60000LL;
+    int64_t elapsed = std::max<int64_t>(0, std::min(duration, duration - remainingMs));
+    int64_t step = elapsed * strip.steps / duration;
+    if (step >= strip.steps) {
+        return -1;
+    }
+    // Awal langkah berikutnya, dibulatkan ke atas ke milidetik
+    int64_t next = ((step + 1) * duration + strip.steps - 1) / strip.steps;
+    return next - elapsed;
+}
+
+int TrayIconAtlas::FrameCount() const {
+    return IsConfigured() ? strips[0].steps + 1 + strips[1].steps + 1 : 0;
+}
+
+int TrayIconAtlas::FrameMinutes(int frame) const {
+    bool breakFrame = FrameIsBreak(frame);
+    const Strip& strip = StripFor(breakFrame);
+    int step = breakFrame ? frame - (strips[0].steps + 1) : frame;
+    return (strip.steps - step + strip.stepsPerMinute - 1) / strip.stepsPerMinute;
+}
+
+bool TrayIconAtlas::FrameIsBreak(int frame) const {
+    return frame > strips[0].steps;
+}
+
+const uint8_t* TrayIconAtlas::Pixels(int frame) const {
+    bool breakFrame = FrameIsBreak(frame);
+    const Strip& strip = StripFor(breakFrame);
+    int step = breakFrame ? frame - (strips[0].steps + 1) : frame;
+    step = std::max(0, std::min(step, strip.steps));
+    return strip.pixels.data() + static_cast<size_t>(step) * size * size * 4;
+}
+
+size_t TrayIconAtlas::MemoryBytes() const {
+    return strips[0].pixels.capacity() + strips[1].pixels.capacity();
+}
+
+void TrayIconAtlas::BuildGeometry() {
+    const int samples = SUBSAMPLES * SUBSAMPLES;
+    geometry.resize(static_cast<size_t>(size) * size * samples);
+    double center = size / 2.0;
+    double outer = size / 2.0 - 0.5;
+    double inner = outer - std::max(2, size / 10);
+    const double TWO_PI = 6.283185307179586;
+    size_t index = 0;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            for (int sy = 0; sy < SUBSAMPLES; ++sy) {
+                for (int sx = 0; sx < SUBSAMPLES; ++sx) {
+                    double dx = x + (sx + 0.5) / SUBSAMPLES - center;
+                    double dy = y + (sy + 0.5) / SUBSAMPLES - center;
+                    double distance = std::sqrt(dx * dx + dy * dy);
+                    float value;
+                    if (distance > outer) {
+                        value = RING_OUTSIDE;
+                    } else if (distance < inner) {
+                        value = RING_INSIDE;
+                    } else {
+                        // Searah jarum jam dari jam 12
+                        double angle = std::atan2(dx, -dy) / TWO_PI;
+                        value = static_cast<float>(angle < 0 ? angle + 1.0 : angle);
+                    }
+                    geometry[index++] = value;
+                }
+            }
+        }
+    }
+}
+
+void TrayIconAtlas::Render(Strip& strip, int minutes, const TrayIconColour& fill) {
+    strip.minutes = minutes;
+    strip.fill = fill;
+    strip.stepsPerMinute = std::max(1, (ARC_RESOLUTION + minutes - 1) / minutes);
+    strip.steps = minutes * strip.stepsPerMinute;
+    size_t frameBytes = static_cast<size_t>(size) * size * 4;
+    std::vector<uint8_t>(frameBytes * (strip.steps + 1)).swap(strip.pixels);
+    for (int step = 0; step <= strip.steps; ++step) {
+        int shown = (strip.steps - step + strip.stepsPerMinute - 1) / strip.stepsPerMinute;
+        RenderFrame(strip.pixels.data() + step * frameBytes,
+                    static_cast<double>(step) / strip.steps, shown, fill);
+        renderedFrames++;
+    }
+}
+
+void TrayIconAtlas::RenderFrame(uint8_t* out, double progress, int minutes,
+                                const TrayIconColour& fill) const {
+    const int samples = SUBSAMPLES * SUBSAMPLES;
+    const TrayIconColour& background = style.background;
+    const TrayIconColour& track = style.track;
+    float limit = static_cast<float>(progress);
+    const float* sample = geometry.data();
+    for (int pixel = 0; pixel < size * size; ++pixel, out += 4) {
+        int inside = 0;
+        int filled = 0;
+        int empty = 0;
+        for (int i = 0; i < samples; ++i, ++sample) {
+            if (*sample == RING_INSIDE) {
+                inside++;
+            } else if (*sample >= 0.0f) {
+                if (*sample < limit) {
+                    filled++;
+                } else {
+                    empty++;
+                }
+            }
+        }
+        int covered = inside + filled + empty;
+        if (covered == 0) {
+            out[0] = out[1] = out[2] = out[3] = 0;
+            continue;
+        }
+        out[0] = static_cast<uint8_t>((inside * background.red + filled * fill.red + empty * track.red) / covered);
+        out[1] = static_cast<uint8_t>((inside * background.green + filled * fill.green + empty * track.green) / covered);
+        out[2] = static_cast<uint8_t>((inside * background.blue + filled * fill.blue + empty * track.blue) / covered);
+        out[3] = static_cast<uint8_t>(covered * 255 / samples);
+    }
+    out -= static_cast<size_t>(size) * size * 4;
+
+    // Angka menit di tengah, diperbesar bilangan bulat agar tetap tajam
+    minutes = std::max(0, std::min(minutes, static_cast<int>(MAX_MINUTES)));
+    int digits[2] = { minutes / 10, minutes % 10 };
+    int count = minutes >= 10 ? 2 : 1;
+    const int* first = count == 2 ? digits : digits + 1;
+    int scale = std::max(1, size / 16);
+    int width = count * DIGIT_WIDTH * scale + (count - 1) * scale;
+    int left = (size - width) / 2;
+    int top = (size - DIGIT_HEIGHT * scale) / 2;
+    for (int d = 0; d < count; ++d) {
+        const uint8_t* rows = DIGIT_FONT[first[d]];
+        int originX = left + d * (DIGIT_WIDTH + 1) * scale;
+        for (int row = 0; row < DIGIT_HEIGHT; ++row) {
+            for (int column = 0; column < DIGIT_WIDTH; ++column) {
+                if (!((rows[row] >> (DIGIT_WIDTH - 1 - column)) & 1)) {
+                    continue;
+                }
+                for (int y = 0; y < scale; ++y) {
+                    uint8_t* pixel = out + ((top + row * scale + y) * size + originX + column * scale) * 4;
+                    for (int x = 0; x < scale; ++x, pixel += 4) {
+                        pixel[0] = style.text.red;
+                        pixel[1] = style.text.green;
+                        pixel[2] = style.text.blue;
+                        pixel[3] = 255;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+// TrayIconAtlas.h
+#ifndef TRAY_ICON_ATLAS_H
+#define TRAY_ICON_ATLAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct TrayIconColour {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+};
+
+// Warna ikon tray, mengikuti tema dari ApplyTheme
+struct TrayIconStyle {
+    TrayIconColour text;          // angka menit
+    TrayIconColour background;    // cakram di dalam busur
+    TrayIconColour track;         // busur yang belum dilewati
+    TrayIconColour focusFill;     // busur progres sesi fokus
+    TrayIconColour breakFill;     // busur progres sesi istirahat
+};
+
+bool SameTrayIconStyle(const TrayIconStyle& a, const TrayIconStyle& b);
+
+// Semua frame ikon countdown (angka sisa menit di tengah busur progres)
+// untuk durasi fokus dan istirahat yang dikonfigurasi, dirasterisasi
+// sekali ke RGBA. Sesi dibagi menjadi langkah busur yang sejajar dengan
+// batas menit, jadi setiap langkah punya tepat satu angka menit; tick
+// hanya menghitung indeks frame. Strip fokus dan istirahat dirender ulang
+// terpisah, hanya jika ukuran, warna atau durasinya berubah.
+class TrayIconAtlas {
+public:
+    static const int DEFAULT_SIZE = 32;
+    // Langkah busur minimum per sesi; istirahat pendek dibagi lebih halus
+    static const int ARC_RESOLUTION = 60;
+    // Dua digit
+    static const int MAX_MINUTES = 99;
+
+    TrayIconAtlas();
+
+    // true jika ada strip yang dirender ulang
+    bool Configure(int size, const TrayIconStyle& style, int focusMinutes, int breakMinutes);
+    bool IsConfigured() const { return size > 0; }
+
+    // Tanpa alokasi. durationMs adalah panjang sesi yang berjalan; jika
+    // berbeda dari durasi strip (durasi diubah di tengah sesi) langkah
+    // busur tetap proporsional.
+    int FrameIndex(bool breakSession, int64_t remainingMs, int64_t durationMs) const;
+    // Jeda sampai FrameIndex berubah untuk sesi yang berjalan, atau -1
+    int64_t NextChangeDelayMs(bool breakSession, int64_t remainingMs, int64_t durationMs) const;
+
+    int FrameCount() const;
+    int FrameMinutes(int frame) const;
+    bool FrameIsBreak(int frame) const;
+    // RGBA tanpa premultiply, Size() * Size() * 4 byte
+    const uint8_t* Pixels(int frame) const;
+
+    int Size() const { return size; }
+    size_t MemoryBytes() const;
+    // Naik setiap ada strip yang dirender ulang
+    unsigned GetGeneration() const { return generation; }
+    long long GetRenderedFrames() const { return renderedFrames; }
+
+private:
+    struct Strip {
+        int minutes;
+        int stepsPerMinute;
+        int steps;                    // frame = steps + 1 (busur kosong .. penuh)
+        TrayIconColour fill;
+        std::vector<uint8_t> pixels;
+    };
+
+    Strip strips[2];                  // [0] fokus, [1] istirahat
+    int size;
+    TrayIconStyle style;
+    unsigned generation;
+    long long renderedFrames;
+    // Sudut (0..1 searah jarum jam dari atas) setiap subsampel busur,
+    // RING_INSIDE/RING_OUTSIDE untuk yang lain; hanya selama render
+    std::vector<float> geometry;
+
+    const Strip& StripFor(bool breakSession) const { return strips[breakSession ? 1 : 0]; }
+    void BuildGeometry();
+    void Render(Strip& strip, int minutes, const TrayIconColour& fill);
+    void RenderFrame(uint8_t* out, double progress, int minutes, const TrayIconColour& fill) const;
+};
+
+#endif // TRAY_ICON_ATLAS_H
@@ -0,0 +1,77 @@
+// WakeupScheduler.cpp
+#include "WakeupScheduler.h"
+
+#include <cstdio>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace {
+
+// Slack timer (ns): kernel boleh menggabungkan wakeup kita dengan wakeup lain
+// dalam rentang ini. Saat tersembunyi tidak ada yang dilihat per detik,
+// jadi slack boleh lebih longgar.
+const unsigned long VISIBLE_TIMER_SLACK_NS = 10UL * 1000 * 1000;
+const unsigned long HIDDEN_TIMER_SLACK_NS = 50UL * 1000 * 1000;
+
+}
+
+WakeupScheduler::WakeupScheduler(const Clock& clock)
+    : clock(clock), visible(true), visibleWakeups(0), hiddenWakeups(0),
+      countersStartMs(clock.NowMs()) {
+    ApplyTimerSlack();
+}
+
+void WakeupScheduler::SetVisible(bool isVisible) {
+    if (visible == isVisible) {
+        return;
+    }
+    visible = isVisible;
+    ApplyTimerSlack();
+}
+
+int64_t WakeupScheduler::NextDelayMs(const TimerCore& core) const {
+    int64_t next = visible ? core.NextWakeupMs() : core.NextDeadlineMs();
+    if (next < 0) {
+        return -1;
+    }
+    int64_t delay = next - clock.NowMs();
+    return delay > 0 ? delay : 0;
+}
+
+void WakeupScheduler::RecordWakeup() {
+    if (visible) {
+        visibleWakeups++;
+    } else {
+        hiddenWakeups++;
+    }
+}
+
+double WakeupScheduler::WakeupsPerHour() const {
+    int64_t elapsed = clock.NowMs() - countersStartMs;
+    if (elapsed <= 0) {
+        return 0.0;
+    }
+    return GetWakeupCount() * 3600000.0 / elapsed;
+}
+
+std::string WakeupScheduler::Report() const {
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer),
+                  "%.1f wakeup/jam (terlihat: %lld, tersembunyi: %lld)",
+                  WakeupsPerHour(), visibleWakeups, hiddenWakeups);
+    return buffer;
+}
+
+void WakeupScheduler::ResetCounters() {
+    visibleWakeups = 0;
+    hiddenWakeups = 0;
+    countersStartMs = clock.NowMs();
+}
+
+void WakeupScheduler::ApplyTimerSlack() {
+#ifdef __linux__
+    prctl(PR_SET_TIMERSLACK, visible ? VISIBLE_TIMER_SLACK_NS : HIDDEN_TIMER_SLACK_NS, 0, 0, 0);
+#endif
+}
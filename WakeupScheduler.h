@@ -0,0 +1,40 @@
+// WakeupScheduler.h
+#ifndef WAKEUP_SCHEDULER_H
+#define WAKEUP_SCHEDULER_H
+
+#include <string>
+#include "Clock.h"
+#include "TimerCore.h"
+
+// Menentukan kapan proses perlu bangun berikutnya.
+// Saat countdown terlihat, bangun di setiap batas detik; saat jendela
+// tersembunyi/diminimalkan, hanya satu wakeup tepat di deadline sesi.
+class WakeupScheduler {
+public:
+    explicit WakeupScheduler(const Clock& clock);
+
+    void SetVisible(bool visible);
+    bool IsVisible() const { return visible; }
+
+    // Jeda (ms) sampai wakeup berikutnya, atau -1 jika tidak perlu bangun
+    int64_t NextDelayMs(const TimerCore& core) const;
+
+    // Dipanggil di setiap wakeup timer
+    void RecordWakeup();
+
+    long long GetWakeupCount() const { return visibleWakeups + hiddenWakeups; }
+    double WakeupsPerHour() const;
+    std::string Report() const;
+    void ResetCounters();
+
+private:
+    const Clock& clock;
+    bool visible;
+    long long visibleWakeups;
+    long long hiddenWakeups;
+    int64_t countersStartMs;
+
+    void ApplyTimerSlack();
+};
+
+#endif // WAKEUP_SCHEDULER_H
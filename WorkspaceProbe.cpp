@@ -0,0 +1,125 @@
+// WorkspaceProbe.cpp
+#include "WorkspaceProbe.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <dwmapi.h>
+#elif defined(POMODORO_HAVE_X11)
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#endif
+
+namespace {
+
+#if !defined(_WIN32) && defined(POMODORO_HAVE_X11)
+
+// Nilai _NET_WM_DESKTOP untuk jendela yang tampil di semua workspace
+const unsigned long ALL_DESKTOPS = 0xFFFFFFFFul;
+
+// Satu CARDINAL 32-bit; false jika properti tidak ada
+bool ReadCardinal(Display* x, Window window, Atom property, unsigned long& value) {
+    Atom type = None;
+    int format = 0;
+    unsigned long count = 0;
+    unsigned long after = 0;
+    unsigned char* data = nullptr;
+    bool ok = XGetWindowProperty(x, window, property, 0, 1, False, XA_CARDINAL, &type,
+                                 &format, &count, &after, &data) == Success &&
+              data && type == XA_CARDINAL && format == 32 && count == 1;
+    if (ok) {
+        // Format 32 selalu dikembalikan sebagai long
+        value = *reinterpret_cast<unsigned long*>(data);
+    }
+    if (data) {
+        XFree(data);
+    }
+    return ok;
+}
+
+bool HasState(Display* x, Window window, Atom stateProperty, Atom state) {
+    Atom type = None;
+    int format = 0;
+    unsigned long count = 0;
+    unsigned long after = 0;
+    unsigned char* data = nullptr;
+    bool found = false;
+    if (XGetWindowProperty(x, window, stateProperty, 0, 32, False, XA_ATOM, &type, &format,
+                           &count, &after, &data) == Success &&
+        data && type == XA_ATOM && format == 32) {
+        const Atom* atoms = reinterpret_cast<const Atom*>(data);
+        for (unsigned long i = 0; i < count && !found; ++i) {
+            found = atoms[i] == state;
+        }
+    }
+    if (data) {
+        XFree(data);
+    }
+    return found;
+}
+
+#endif
+
+} // namespace
+
+WorkspaceProbe::WorkspaceProbe()
+    : lastWindow(0), lastQueryMs(-1), lastResult(true), queries(0) {
+}
+
+bool WorkspaceProbe::IsOnCurrentWorkspace(void* display, uintptr_t window, int64_t nowMs) {
+    if (window == 0) {
+        return true;
+    }
+    if (window == lastWindow && lastQueryMs >= 0 && nowMs - lastQueryMs < MIN_INTERVAL_MS) {
+        return lastResult;
+    }
+    lastWindow = window;
+    lastQueryMs = nowMs;
+    lastResult = Query(display, window);
+    queries++;
+    return lastResult;
+}
+
+#ifdef _WIN32
+
+bool WorkspaceProbe::Query(void* /*display*/, uintptr_t window) {
+    DWORD cloaked = 0;
+    HRESULT result = DwmGetWindowAttribute(reinterpret_cast<HWND>(window), DWMWA_CLOAKED,
+                                           &cloaked, sizeof(cloaked));
+    return FAILED(result) || cloaked == 0;
+}
+
+#elif defined(POMODORO_HAVE_X11)
+
+bool WorkspaceProbe::Query(void* display, uintptr_t window) {
+    Display* x = static_cast<Display*>(display);
+    if (!x) {
+        return true;
+    }
+    // Atom yang sudah ada di-cache Xlib, jadi hanya panggilan pertama yang
+    // ke server
+    Atom wmDesktop = XInternAtom(x, "_NET_WM_DESKTOP", True);
+    Atom currentDesktop = XInternAtom(x, "_NET_CURRENT_DESKTOP", True);
+    Atom wmState = XInternAtom(x, "_NET_WM_STATE", True);
+    Atom hidden = XInternAtom(x, "_NET_WM_STATE_HIDDEN", True);
+    Window xid = static_cast<Window>(window);
+
+    if (wmState != None && hidden != None && HasState(x, xid, wmState, hidden)) {
+        return false;
+    }
+    unsigned long desktop = 0;
+    unsigned long current = 0;
+    if (wmDesktop == None || currentDesktop == None ||
+        !ReadCardinal(x, xid, wmDesktop, desktop) ||
+        !ReadCardinal(x, DefaultRootWindow(x), currentDesktop, current)) {
+        return true;
+    }
+    return desktop == ALL_DESKTOPS || desktop == current;
+}
+
+#else
+
+bool WorkspaceProbe::Query(void* /*display*/, uintptr_t /*window*/) {
+    return true;
+}
+
+#endif
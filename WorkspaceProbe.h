@@ -0,0 +1,47 @@
+// WorkspaceProbe.h
+#ifndef WORKSPACE_PROBE_H
+#define WORKSPACE_PROBE_H
+
+#include <cstdint>
+
+// Apakah jendela top-level ada di workspace (desktop virtual) yang sedang
+// tampil. Jendela di workspace lain tetap IsShown() dan tidak diminimalkan,
+// jadi tanpa cek ini countdown-nya tetap dibangunkan setiap detik.
+//
+// X11 (POMODORO_HAVE_X11): _NET_WM_DESKTOP jendela dibandingkan dengan
+// _NET_CURRENT_DESKTOP milik root, ditambah _NET_WM_STATE_HIDDEN; butuh
+// window manager EWMH. Windows: DWMWA_CLOAKED, yang diset DWM untuk jendela
+// di desktop virtual lain. Jendela yang tertutup penuh jendela lain tidak
+// dilaporkan platform mana pun dengan murah, jadi tetap dianggap terlihat;
+// begitu juga di Wayland, macOS, dan window manager tanpa EWMH.
+class WorkspaceProbe {
+public:
+    // Hasil dipakai ulang selama ini: cek X11 butuh round trip ke server,
+    // dan paint/aktivasi bisa datang beruntun
+    static const int MIN_INTERVAL_MS = 250;
+
+    // Jarak cek ulang selama jendela di workspace lain; jauh di bawah 1 Hz,
+    // tetapi kembalinya jendela tetap terlihat dalam beberapa detik
+    static const int RECHECK_MS = 5000;
+
+    WorkspaceProbe();
+
+    // display: Display* milik toolkit (X11) atau nullptr (Windows); window:
+    // XID atau HWND. true jika tidak diketahui.
+    bool IsOnCurrentWorkspace(void* display, uintptr_t window, int64_t nowMs);
+
+    // Lupakan hasil terakhir, misalnya setelah jendela ditampilkan lagi
+    void Invalidate() { lastQueryMs = -1; }
+
+    long long GetQueryCount() const { return queries; }
+
+private:
+    uintptr_t lastWindow;
+    int64_t lastQueryMs;
+    bool lastResult;
+    long long queries;
+
+    bool Query(void* display, uintptr_t window);
+};
+
+#endif // WORKSPACE_PROBE_H
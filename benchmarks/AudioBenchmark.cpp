@@ -0,0 +1,169 @@
+// AudioBenchmark.cpp
+// AudioEngine tanpa perangkat audio:
+// 1. biaya dekode WAV ke cache PCM (dengan dan tanpa resample),
+// 2. latensi pemicu -> sampel pertama dengan NullAudioSink realtime, dari
+//    keadaan diam (thread audio tidur) dan saat detak sedang berputar,
+//    serta biaya Play() di thread pemanggil,
+// 3. CPU pencampur per detik audio dengan MAX_VOICES suara aktif
+//    (sink tidak realtime, jadi pencampur berjalan secepat mungkin).
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. AudioBenchmark.cpp ../AudioEngine.cpp ../AudioSink.cpp ../LatencyRecorder.cpp -o audio_bench
+// Usage: audio_bench [jumlah_pemicu] [detik_audio_pencampur]
+#include "AudioEngine.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+int64_t SteadyNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+double ProcessCpuMs() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+void PutLe(std::vector<char>& out, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+// WAV PCM 16-bit berisi nada sinus
+std::vector<char> MakeWav(int sampleRate, int channels, double seconds, double frequency) {
+    int frames = static_cast<int>(sampleRate * seconds);
+    uint32_t dataBytes = static_cast<uint32_t>(frames * channels * 2);
+    std::vector<char> wav;
+    wav.insert(wav.end(), {'R', 'I', 'F', 'F'});
+    PutLe(wav, 36 + dataBytes, 4);
+    wav.insert(wav.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    PutLe(wav, 16, 4);
+    PutLe(wav, 1, 2);
+    PutLe(wav, static_cast<uint32_t>(channels), 2);
+    PutLe(wav, static_cast<uint32_t>(sampleRate), 4);
+    PutLe(wav, static_cast<uint32_t>(sampleRate * channels * 2), 4);
+    PutLe(wav, static_cast<uint32_t>(channels * 2), 2);
+    PutLe(wav, 16, 2);
+    wav.insert(wav.end(), {'d', 'a', 't', 'a'});
+    PutLe(wav, dataBytes, 4);
+    for (int f = 0; f < frames; ++f) {
+        int16_t sample = static_cast<int16_t>(8000 * std::sin(2 * M_PI * frequency * f / sampleRate));
+        for (int c = 0; c < channels; ++c) {
+            PutLe(wav, static_cast<uint16_t>(sample), 2);
+        }
+    }
+    return wav;
+}
+
+void BenchDecode(const char* label, const std::vector<char>& wav) {
+    const int rounds = 20;
+    PcmClip clip;
+    std::string error;
+    int64_t begin = SteadyNowNs();
+    for (int i = 0; i < rounds; ++i) {
+        DecodeWav(wav.data(), wav.size(), AudioEngine::SAMPLE_RATE, clip, error);
+    }
+    double us = (SteadyNowNs() - begin) / 1e3 / rounds;
+    std::printf("decode %s bytes=%zu frames=%zu decode_us=%.0f\n",
+                label, wav.size(), clip.Frames(), us);
+}
+
+void LoadCue(AudioEngine& engine, AudioCue cue, const std::vector<char>& wav) {
+    std::string error;
+    if (!engine.LoadCueFromMemory(cue, wav.data(), wav.size(), error)) {
+        std::fprintf(stderr, "dekode gagal: %s\n", error.c_str());
+        std::exit(1);
+    }
+}
+
+void BenchTrigger(const char* label, int triggers, bool withTicking,
+                  const std::vector<char>& cue, const std::vector<char>& tick) {
+    AudioEngine engine;
+    LoadCue(engine, CUE_ALARM, cue);
+    LoadCue(engine, CUE_TICK, tick);
+    engine.Start(std::unique_ptr<AudioSink>(new NullAudioSink(true)));
+    if (withTicking) {
+        engine.StartLoop(CUE_TICK, 0.5f);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Jarak antar pemicu lebih panjang dari isyarat, agar mesin sempat
+    // kembali diam pada skenario tanpa detak
+    int64_t callNs = 0;
+    for (int i = 0; i < triggers; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(120 + (i * 7) % 40));
+        int64_t begin = SteadyNowNs();
+        engine.Play(CUE_ALARM);
+        callNs += SteadyNowNs() - begin;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    AudioStats stats = engine.GetStats();
+    engine.Stop();
+    // NullAudioSink tidak punya latensi perangkat; perangkat sungguhan
+    // menambah isi buffernya (QueuedFrames) di atas angka ini
+    const LatencyRecorder& latency = stats.triggerLatency;
+    std::printf("trigger %s n=%lld first_sample_ms p50=%.2f p99=%.2f max=%.2f play_call_ns=%.0f dropped=%lld\n",
+                label, latency.Count(), latency.Percentile(0.50), latency.Percentile(0.99),
+                latency.MaxMs(), static_cast<double>(callNs) / triggers, stats.dropped);
+}
+
+void BenchMixer(double audioSeconds, const std::vector<char>& cue) {
+    AudioEngine engine;
+    LoadCue(engine, CUE_TICK, cue);
+    NullAudioSink* sink = new NullAudioSink(false);
+    engine.Start(std::unique_ptr<AudioSink>(sink));
+
+    double cpuBegin = ProcessCpuMs();
+    int64_t begin = SteadyNowNs();
+    // StartLoop tidak menggandakan detak; pakai Play untuk suara lain
+    engine.StartLoop(CUE_TICK);
+    for (int i = 1; i < AudioEngine::MAX_VOICES; ++i) {
+        engine.Play(CUE_TICK);
+    }
+    long long target = static_cast<long long>(audioSeconds * AudioEngine::SAMPLE_RATE);
+    while (engine.GetStats().periods * AudioEngine::PERIOD_FRAMES < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    AudioStats stats = engine.GetStats();
+    double wallMs = (SteadyNowNs() - begin) / 1e6;
+    engine.Stop();
+    double cpuMs = ProcessCpuMs() - cpuBegin;
+
+    std::printf("mixer voices=%d audio_s=%.1f mix_ms_per_audio_s=%.3f thread_cpu_ms_per_audio_s=%.3f realtime_factor=%.0fx\n",
+                AudioEngine::MAX_VOICES, stats.audioSeconds, stats.mixMsPerSecond,
+                cpuMs / stats.audioSeconds, stats.audioSeconds * 1000.0 / wallMs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int triggers = argc > 1 ? std::atoi(argv[1]) : 100;
+    double mixSeconds = argc > 2 ? std::atof(argv[2]) : 600.0;
+
+    std::vector<char> alarm44k = MakeWav(44100, 1, 2.0, 880.0);
+    std::vector<char> alarm48k = MakeWav(48000, 2, 2.0, 880.0);
+    BenchDecode("44100Hz_mono_resample", alarm44k);
+    BenchDecode("48000Hz_stereo", alarm48k);
+
+    std::vector<char> cue = MakeWav(48000, 2, 0.05, 660.0);
+    std::vector<char> tick = MakeWav(48000, 1, 1.0, 1500.0);
+    BenchTrigger("idle", triggers, false, cue, tick);
+    BenchTrigger("ticking", triggers, true, cue, tick);
+
+    // Loop panjang agar semua suara aktif sepanjang pengukuran
+    BenchMixer(mixSeconds, MakeWav(48000, 2, 30.0, 440.0));
+    return 0;
+}
@@ -0,0 +1,440 @@
+// ControlBenchmark.cpp
+// Klien lokal untuk ControlServer:
+// 1. latensi request/response "status" satu klien,
+// 2. latensi perintah start/pause sampai update state diterima pelanggan
+//    (perintah diteruskan ke thread "GUI" yang menjalankan TimerCore,
+//    seperti CallAfter di aplikasi),
+// 3. fan-out update ke ratusan pelanggan: throughput, latensi sampai semua
+//    pelanggan menerima update terakhir, dan biaya Publish() di thread GUI,
+// 4. timer bernama: add/start/status/list menuju timer yang benar dan
+//    nama yang salah ditolak.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. ControlBenchmark.cpp ../ControlServer.cpp ../TimerRegistry.cpp ../TimingWheel.cpp ../TimerCore.cpp ../CountdownEngine.cpp ../Clock.cpp -o control_bench
+// Usage: control_bench [jumlah_pelanggan] [jumlah_update] [jumlah_request]
+#include "ControlServer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+int64_t NowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+double Percentile(std::vector<int64_t>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return static_cast<double>(values[index]);
+}
+
+int Connect(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+// Pembaca baris sederhana untuk satu socket blocking
+class LineReader {
+public:
+    explicit LineReader(int fd) : fd(fd) {}
+
+    bool ReadLine(std::string& line) {
+        while (true) {
+            size_t newline = buffer.find('\n');
+            if (newline != std::string::npos) {
+                line = buffer.substr(0, newline);
+                buffer.erase(0, newline + 1);
+                return true;
+            }
+            char chunk[4096];
+            ssize_t received = read(fd, chunk, sizeof(chunk));
+            if (received <= 0) {
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(received));
+        }
+    }
+
+private:
+    int fd;
+    std::string buffer;
+};
+
+bool SendLine(int fd, const char* text) {
+    std::string line = std::string(text) + "\n";
+    return send(fd, line.data(), line.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(line.size());
+}
+
+// Thread "GUI": menerima perintah dari thread I/O lewat antrian (pengganti
+// CallAfter), menjalankannya pada TimerCore, dan mempublikasikan status
+class GuiThread : public ControlServerListener, public TimerCoreListener {
+public:
+    GuiThread(ControlServer& server)
+        : server(server), core(clock), stopping(false) {
+        core.SetListener(this);
+        worker = std::thread(&GuiThread::Run, this);
+    }
+
+    ~GuiThread() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_one();
+        worker.join();
+    }
+
+    void OnControlCommand(ControlCommand command) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            commands.push_back(command);
+        }
+        wakeup.notify_one();
+    }
+
+    void OnStateChanged(TimerState state) override {
+        ControlStatus status;
+        status.state = state;
+        status.remainingMs = core.RemainingMs();
+        status.atMs = clock.NowMs();
+        server.Publish(status);
+    }
+
+private:
+    ControlServer& server;
+    SystemClock clock;
+    TimerCore core;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<ControlCommand> commands;
+    bool stopping;
+    std::thread worker;
+
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeup.wait(lock, [this]() { return stopping || !commands.empty(); });
+            if (stopping) {
+                return;
+            }
+            ControlCommand command = commands.front();
+            commands.pop_front();
+            lock.unlock();
+            if (command == CONTROL_START) {
+                core.Start();
+            } else if (command == CONTROL_PAUSE) {
+                core.Pause();
+            } else {
+                core.Reset();
+            }
+            lock.lock();
+        }
+    }
+};
+
+// Pemilik TimerRegistry untuk timer bernama; perintah dijalankan langsung
+// di thread I/O karena tidak ada thread lain yang menyentuh registry
+class NamedTimerOwner : public ControlServerListener {
+public:
+    explicit NamedTimerOwner(ControlServer& server)
+        : server(server), registry(clock) {
+        registry.Add(DEFAULT_TIMER_NAME);
+    }
+
+    void OnControlCommand(ControlCommand /*command*/) override {}
+
+    void OnTimerCommand(const ControlTimerCommand& command) override {
+        ApplyTimerCommand(registry, command);
+        server.PublishTimers(registry);
+    }
+
+private:
+    ControlServer& server;
+    SystemClock clock;
+    TimerRegistry registry;
+};
+
+// Kirim satu baris dan periksa bahwa balasannya memuat setiap potongan
+bool Expect(int fd, LineReader& reader, const char* command,
+            std::initializer_list<const char*> parts) {
+    std::string line;
+    if (!SendLine(fd, command) || !reader.ReadLine(line)) {
+        return false;
+    }
+    for (const char* part : parts) {
+        if (line.find(part) == std::string::npos) {
+            std::fprintf(stderr, "%s: %s\n", command, line.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void RaiseFileLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int subscriberCount = argc > 1 ? std::atoi(argv[1]) : 500;
+    int updates = argc > 2 ? std::atoi(argv[2]) : 500;
+    int requests = argc > 3 ? std::atoi(argv[3]) : 20000;
+    RaiseFileLimit();
+
+    char path[64];
+    std::snprintf(path, sizeof(path), "/tmp/pomodoro-bench-%d.sock", static_cast<int>(getpid()));
+
+    ControlServer server;
+    if (!server.Start(path)) {
+        std::fprintf(stderr, "tidak dapat membuka %s\n", path);
+        return 1;
+    }
+
+    // 1. Latensi "status"
+    {
+        int fd = Connect(path);
+        LineReader reader(fd);
+        std::string line;
+        std::vector<int64_t> latencies;
+        latencies.reserve(requests);
+        int64_t begin = NowNs();
+        for (int i = 0; i < requests; ++i) {
+            int64_t sent = NowNs();
+            SendLine(fd, "status");
+            if (!reader.ReadLine(line)) {
+                std::fprintf(stderr, "koneksi status terputus\n");
+                return 1;
+            }
+            latencies.push_back(NowNs() - sent);
+        }
+        double seconds = (NowNs() - begin) / 1e9;
+        close(fd);
+        std::printf("status_requests=%d requests_per_s=%.0f latency_us p50=%.1f p99=%.1f max=%.1f\n",
+                    requests, requests / seconds,
+                    Percentile(latencies, 0.50) / 1000.0, Percentile(latencies, 0.99) / 1000.0,
+                    Percentile(latencies, 1.0) / 1000.0);
+    }
+
+    // 2. Perintah sampai update diterima
+    {
+        GuiThread gui(server);
+        server.SetListener(&gui);
+
+        int fd = Connect(path);
+        LineReader reader(fd);
+        std::string line;
+        SendLine(fd, "subscribe");
+        reader.ReadLine(line);     // ok
+        reader.ReadLine(line);     // snapshot awal
+
+        int commands = requests / 10;
+        std::vector<int64_t> latencies;
+        latencies.reserve(commands);
+        for (int i = 0; i < commands; ++i) {
+            // start pertama memulai fokus, berikutnya bergantian pause/start
+            const char* command = (i % 2 == 0) ? "start" : "pause";
+            const char* expected = (i % 2 == 0) ? "\"state\":\"focus\"" : "\"state\":\"paused_focus\"";
+            int64_t sent = NowNs();
+            SendLine(fd, command);
+            while (reader.ReadLine(line)) {
+                if (line.find("\"update\"") != std::string::npos &&
+                    line.find(expected) != std::string::npos) {
+                    break;
+                }
+            }
+            latencies.push_back(NowNs() - sent);
+        }
+        close(fd);
+        server.SetListener(nullptr);
+        std::printf("commands=%d roundtrip_us p50=%.1f p99=%.1f max=%.1f\n",
+                    commands, Percentile(latencies, 0.50) / 1000.0,
+                    Percentile(latencies, 0.99) / 1000.0, Percentile(latencies, 1.0) / 1000.0);
+    }
+
+    // 3. Fan-out ke banyak pelanggan: setiap update ditunggu sampai semua
+    //    pelanggan menerimanya, lalu satu ledakan update tanpa jeda untuk
+    //    melihat penggabungan
+    {
+        std::vector<int> fds;
+        int epollFd = epoll_create1(EPOLL_CLOEXEC);
+        for (int i = 0; i < subscriberCount; ++i) {
+            int fd = Connect(path);
+            if (fd < 0) {
+                std::fprintf(stderr, "hanya %d pelanggan tersambung\n", i);
+                break;
+            }
+            SendLine(fd, "subscribe");
+            fds.push_back(fd);
+        }
+        while (server.GetSubscriberCount() < fds.size()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Buang balasan subscribe sebelum pengukuran
+        for (size_t i = 0; i < fds.size(); ++i) {
+            LineReader reader(fds[i]);
+            std::string line;
+            reader.ReadLine(line);
+            reader.ReadLine(line);
+            epoll_event event;
+            std::memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.u32 = static_cast<uint32_t>(i);
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fds[i], &event);
+        }
+
+        std::vector<std::string> partial(fds.size());
+        long long delivered = 0;
+
+        // Membaca semua pelanggan sampai masing-masing menerima baris yang
+        // berisi marker; false jika waktu habis
+        auto drainUntil = [&](const std::string& marker) {
+            std::vector<bool> done(fds.size(), false);
+            size_t remaining = fds.size();
+            epoll_event events[64];
+            while (remaining > 0) {
+                int count = epoll_wait(epollFd, events, 64, 5000);
+                if (count <= 0) {
+                    return false;
+                }
+                for (int e = 0; e < count; ++e) {
+                    uint32_t index = events[e].data.u32;
+                    char chunk[65536];
+                    ssize_t received = read(fds[index], chunk, sizeof(chunk));
+                    if (received <= 0) {
+                        continue;
+                    }
+                    std::string& buffer = partial[index];
+                    buffer.append(chunk, static_cast<size_t>(received));
+                    size_t start = 0;
+                    size_t newline;
+                    while ((newline = buffer.find('\n', start)) != std::string::npos) {
+                        delivered++;
+                        if (!done[index] && buffer.find(marker, start) < newline) {
+                            done[index] = true;
+                            remaining--;
+                        }
+                        start = newline + 1;
+                    }
+                    buffer.erase(0, start);
+                }
+            }
+            return true;
+        };
+
+        ControlStatus status;
+        status.state = RUNNING_FOCUS;
+        std::vector<int64_t> fanout;
+        fanout.reserve(updates);
+        int64_t publishNs = 0;
+        bool complete = true;
+
+        int64_t begin = NowNs();
+        for (int i = 0; i < updates && complete; ++i) {
+            status.remainingMs = 1000000 + i;
+            char marker[48];
+            std::snprintf(marker, sizeof(marker), "\"remaining_ms\":%lld,",
+                          static_cast<long long>(status.remainingMs));
+            int64_t before = NowNs();
+            server.Publish(status);
+            int64_t published = NowNs();
+            publishNs += published - before;
+            complete = drainUntil(marker);
+            fanout.push_back(NowNs() - published);
+        }
+        double seconds = (NowNs() - begin) / 1e9;
+
+        std::printf("subscribers=%zu updates=%d delivered=%lld fanout_msgs_per_s=%.0f publish_ns=%.0f\n",
+                    fds.size(), updates, delivered, delivered / seconds,
+                    static_cast<double>(publishNs) / updates);
+        std::printf("all_subscribers_received_us p50=%.1f p99=%.1f max=%.1f complete=%s\n",
+                    Percentile(fanout, 0.50) / 1000.0, Percentile(fanout, 0.99) / 1000.0,
+                    Percentile(fanout, 1.0) / 1000.0, complete ? "yes" : "no");
+
+        // Ledakan: update beruntun digabung, pelanggan hanya melihat yang terbaru
+        delivered = 0;
+        for (int i = 0; i < updates; ++i) {
+            status.remainingMs = i + 1;
+            server.Publish(status);
+        }
+        complete = complete && drainUntil("\"remaining_ms\":" + std::to_string(updates) + ",");
+        std::printf("burst_updates=%d delivered_per_subscriber=%.1f complete=%s\n",
+                    updates, static_cast<double>(delivered) / fds.size(), complete ? "yes" : "no");
+
+        for (size_t i = 0; i < fds.size(); ++i) {
+            close(fds[i]);
+        }
+        close(epollFd);
+        if (!complete) {
+            server.Stop();
+            return 1;
+        }
+    }
+
+    // 4. Timer bernama
+    {
+        NamedTimerOwner owner(server);
+        server.SetListener(&owner);
+        int fd = Connect(path);
+        LineReader reader(fd);
+        bool named = Expect(fd, reader, "add rapat 50 10", { "\"ok\"", "\"timer\":\"rapat\"" }) &&
+                     Expect(fd, reader, "add rapat", { "timer exists" }) &&
+                     Expect(fd, reader, "add default", { "timer exists" }) &&
+                     Expect(fd, reader, "add a/b", { "invalid timer name" }) &&
+                     Expect(fd, reader, "add dapur 0", { "invalid duration" }) &&
+                     Expect(fd, reader, "start rapat", { "\"ok\"" }) &&
+                     Expect(fd, reader, "status rapat",
+                            { "\"timer\":\"rapat\"", "\"state\":\"focus\"", "\"focus_min\":50" }) &&
+                     Expect(fd, reader, "status default", { "\"event\":\"status\"" }) &&
+                     Expect(fd, reader, "pause lain", { "unknown timer" }) &&
+                     Expect(fd, reader, "pause rapat", { "\"ok\"" }) &&
+                     Expect(fd, reader, "list",
+                            { "{\"timer\":\"default\",",
+                              "{\"timer\":\"rapat\",\"state\":\"paused_focus\"" });
+        close(fd);
+        server.SetListener(nullptr);
+        std::printf("named_timers=%s\n", named ? "ok" : "SALAH");
+        if (!named) {
+            server.Stop();
+            return 1;
+        }
+    }
+
+    server.Stop();
+    return 0;
+}
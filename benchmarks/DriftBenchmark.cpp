@@ -0,0 +1,117 @@
+// DriftBenchmark.cpp
+// Membandingkan error akhir sesi antara model lama (remainingSeconds-- per
+// tick periodik 1000 ms) dan CountdownEngine berbasis deadline, pada event
+// loop yang sengaja dibuat tersendat (tick terlambat, tick tergabung) dan
+// satu kali suspend/resume.
+//
+// Build: g++ -std=c++17 -O2 -I.. DriftBenchmark.cpp ../CountdownEngine.cpp -o drift_bench
+// Usage: drift_bench [menit_sesi] [seed] [suspend_ms]
+#include "CountdownEngine.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+// Model event loop yang tersendat. Waktu "boot" ikut berjalan saat suspend,
+// sedangkan jam timer event loop (seperti CLOCK_MONOTONIC di GLib) tidak.
+struct StalledLoop {
+    std::mt19937 rng;
+    int64_t bootMs;
+    int64_t suspendAtMs;
+    int64_t suspendMs;
+    bool suspended;
+
+    StalledLoop(unsigned seed, int64_t suspendAt, int64_t suspendLength)
+        : rng(seed), bootMs(0), suspendAtMs(suspendAt),
+          suspendMs(suspendLength), suspended(false) {}
+
+    // Keterlambatan dispatch: kebanyakan kecil, sesekali repaint lambat,
+    // jarang sekali stall besar
+    int64_t NextStall() {
+        std::uniform_int_distribution<int> pick(0, 999);
+        int p = pick(rng);
+        if (p < 900) return std::uniform_int_distribution<int>(0, 5)(rng);
+        if (p < 990) return std::uniform_int_distribution<int>(20, 200)(rng);
+        return std::uniform_int_distribution<int>(500, 2500)(rng);
+    }
+
+    // Menunggu timer dengan interval tertentu; mengembalikan waktu boot saat
+    // handler benar-benar dijalankan
+    int64_t Wait(int64_t intervalMs) {
+        bootMs += intervalMs + NextStall();
+        if (!suspended && bootMs >= suspendAtMs) {
+            suspended = true;
+            bootMs += suspendMs;
+        }
+        return bootMs;
+    }
+};
+
+struct Result {
+    int64_t endMs;
+    int ticks;
+};
+
+// Perilaku lama: timer->Start(1000) + remainingSeconds-- per tick
+Result RunLegacy(int sessionSeconds, unsigned seed, int64_t suspendAt, int64_t suspendMs) {
+    StalledLoop loop(seed, suspendAt, suspendMs);
+    int remainingSeconds = sessionSeconds;
+    Result result = {0, 0};
+    for (;;) {
+        int64_t now = loop.Wait(1000);
+        result.ticks++;
+        if (remainingSeconds > 0) {
+            remainingSeconds--;
+        } else {
+            result.endMs = now;
+            return result;
+        }
+    }
+}
+
+// Perilaku baru: deadline absolut + StartOnce sampai batas detik berikutnya
+Result RunDeadline(int sessionSeconds, unsigned seed, int64_t suspendAt, int64_t suspendMs) {
+    StalledLoop loop(seed, suspendAt, suspendMs);
+    CountdownEngine countdown;
+    countdown.Start(static_cast<int64_t>(sessionSeconds) * 1000, 0);
+    Result result = {0, 0};
+    int64_t now = 0;
+    for (;;) {
+        now = loop.Wait(countdown.MsUntilNextSecond(now));
+        result.ticks++;
+        if (countdown.IsExpired(now)) {
+            result.endMs = now;
+            return result;
+        }
+    }
+}
+
+void Report(const char* name, const Result& r, int64_t plannedMs) {
+    std::printf("%-10s end_error_ms=%lld ticks=%d\n", name,
+                static_cast<long long>(r.endMs - plannedMs), r.ticks);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int sessionMinutes = argc > 1 ? std::atoi(argv[1]) : 25;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 42;
+    int64_t suspendMs = argc > 3 ? std::atoll(argv[3]) : 120000;
+
+    int sessionSeconds = sessionMinutes * 60;
+    int64_t plannedMs = static_cast<int64_t>(sessionSeconds) * 1000;
+    int64_t suspendAt = plannedMs / 2;
+
+    std::printf("session=%d min seed=%u suspend=%lld ms\n",
+                sessionMinutes, seed, static_cast<long long>(suspendMs));
+
+    Report("legacy", RunLegacy(sessionSeconds, seed, suspendAt, 0), plannedMs);
+    Report("deadline", RunDeadline(sessionSeconds, seed, suspendAt, 0), plannedMs);
+
+    std::printf("-- dengan suspend/resume --\n");
+    Report("legacy", RunLegacy(sessionSeconds, seed, suspendAt, suspendMs), plannedMs);
+    Report("deadline", RunDeadline(sessionSeconds, seed, suspendAt, suspendMs), plannedMs);
+    return 0;
+}
@@ -0,0 +1,241 @@
+// HookBenchmark.cpp
+// Hook event sesi lewat SessionHooks:
+// 1. event yang diturunkan dari satu siklus TimerCore (jam virtual);
+// 2. biaya Dispatch() di thread pemanggil dengan hook di dalam proses;
+// 3. hook perintah yang macet (sleep) dihentikan pada timeout-nya, dan yang
+//    mengabaikan SIGTERM dihentikan dengan SIGKILL setelah masa tenggang;
+// 4. selama hook macet: latensi Dispatch() dari loop "tick" 1 ms (harus
+//    tetap mikrodetik), hook lain tetap berjalan, event untuk hook yang
+//    macet digabung (coalesce) atau dibuang (drop), dan kedalaman antrean.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. HookBenchmark.cpp ../SessionHooks.cpp ../ControlServer.cpp ../TimerRegistry.cpp ../TimingWheel.cpp ../LatencyRecorder.cpp ../TimerCore.cpp ../CountdownEngine.cpp ../Clock.cpp -o hooks_bench
+// Usage: hooks_bench [dispatch_putaran] [timeout_ms]
+#include "SessionHooks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int64_t NowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+HookEventData MakeData(SessionHookEvent event) {
+    HookEventData data;
+    data.event = event;
+    data.state = RUNNING_FOCUS;
+    data.remainingMs = 1500000;
+    data.completedSessions = 0;
+    data.wallMs = 0;
+    return data;
+}
+
+// Meneruskan callback TimerCore ke SessionHooks seperti PomodoroFrame
+class HookForwarder : public TimerCoreListener {
+public:
+    HookForwarder(SessionHooks& hooks, TimerCore& core) : hooks(hooks), core(core) {}
+
+    void OnStateChanged(TimerState) override { hooks.OnStateChanged(core); }
+    void OnSessionCompleted(bool wasFocus) override { hooks.OnSessionCompleted(core, wasFocus); }
+
+private:
+    SessionHooks& hooks;
+    TimerCore& core;
+};
+
+bool CheckEvents() {
+    std::mutex mutex;
+    std::vector<std::string> seen;
+    SessionHooks hooks;
+    SessionHook recorder;
+    recorder.eventMask = HOOK_ALL_EVENTS;
+    recorder.handler = [&](const HookEventData& data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.push_back(HookEventName(data.event));
+        return true;
+    };
+    hooks.Add(recorder);
+    hooks.Start(1);
+
+    VirtualClock clock(0, 1700000000000LL);
+    TimerCore core(clock);
+    core.SetDurations(1, 1);
+    HookForwarder forwarder(hooks, core);
+    core.SetListener(&forwarder);
+
+    // Setiap langkah ditunggu agar event tidak digabung
+    core.Start();
+    hooks.WaitIdle(1000);
+    core.Pause();
+    hooks.WaitIdle(1000);
+    core.Start();
+    hooks.WaitIdle(1000);
+    for (int i = 0; i < 80; ++i) {
+        clock.Advance(1000);
+        core.Poll();
+        hooks.WaitIdle(1000);
+    }
+    core.Reset();
+    hooks.WaitIdle(1000);
+    core.SetListener(nullptr);
+    hooks.Stop();
+
+    const char* expected[] = { "focus_start", "pause", "resume", "focus_complete", "break_start", "reset" };
+    bool ok = seen.size() == sizeof(expected) / sizeof(expected[0]);
+    std::string sequence;
+    for (size_t i = 0; i < seen.size(); ++i) {
+        sequence += (i ? "," : "") + seen[i];
+        ok &= i < sizeof(expected) / sizeof(expected[0]) && seen[i] == expected[i];
+    }
+    std::printf("events             %s %s\n", sequence.c_str(), ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+bool CheckDispatchCost(int rounds) {
+    std::atomic<long long> handled(0);
+    SessionHooks hooks;
+    SessionHook counter;
+    counter.eventMask = HOOK_ALL_EVENTS;
+    counter.handler = [&](const HookEventData&) {
+        handled++;
+        return true;
+    };
+    hooks.Add(counter);
+    hooks.Start();
+
+    HookEventData data = MakeData(HOOK_PAUSE);
+    int64_t before = NowNs();
+    for (int i = 0; i < rounds; ++i) {
+        hooks.Dispatch(data);
+    }
+    double dispatchNs = static_cast<double>(NowNs() - before) / rounds;
+    bool idle = hooks.WaitIdle(5000);
+    HookStats stats = hooks.GetStats(0);
+    hooks.Stop();
+    // Setiap Dispatch() berakhir dijalankan atau digabung ke job yang antre
+    bool ok = idle && stats.runs + stats.coalesced == rounds && stats.runs == handled;
+    std::printf("dispatch           n=%d ns=%.1f runs=%lld coalesced=%lld %s\n",
+                rounds, dispatchNs, stats.runs, stats.coalesced, ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+// Hook perintah yang tidak selesai sendiri; waktu berjalan harus dekat
+// timeout (+ masa tenggang jika SIGTERM diabaikan)
+bool CheckKill(const char* label, const std::string& command, int timeoutMs, int expectedMs) {
+    SessionHooks hooks;
+    SessionHook hang;
+    hang.eventMask = 1u << HOOK_FOCUS_START;
+    hang.command = command;
+    hang.timeoutMs = timeoutMs;
+    hooks.Add(hang);
+    hooks.Start();
+    hooks.Dispatch(MakeData(HOOK_FOCUS_START));
+    bool idle = hooks.WaitIdle(expectedMs + 5000);
+    HookStats stats = hooks.GetStats(0);
+    hooks.Stop();
+    double runMs = stats.runTime.MaxMs();
+    bool ok = idle && stats.timeouts == 1 && stats.failures == 1 && runMs >= timeoutMs &&
+              runMs < expectedMs + 250;
+    std::printf("%-18s timeout=%d ms jalan=%.1f ms timeouts=%lld %s\n",
+                label, timeoutMs, runMs, stats.timeouts, ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+bool CheckEnvironment() {
+    SessionHooks hooks;
+    SessionHook env;
+    env.eventMask = 1u << HOOK_BREAK_START;
+    env.command = "test \"$POMODORO_EVENT\" = break_start && test \"$POMODORO_REMAINING_MS\" = 1500000"
+                  " && test \"$POMODORO_STATE\" = focus";
+    hooks.Add(env);
+    hooks.Start();
+    hooks.Dispatch(MakeData(HOOK_BREAK_START));
+    bool idle = hooks.WaitIdle(5000);
+    HookStats stats = hooks.GetStats(0);
+    hooks.Stop();
+    bool ok = idle && stats.runs == 1 && stats.failures == 0;
+    std::printf("environment        runs=%lld failures=%lld spawn=%.2f ms %s\n",
+                stats.runs, stats.failures, stats.runTime.MaxMs(), ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+// Dua hook macet (coalesce dan drop) dan satu hook cepat; loop tick 1 ms
+// terus memanggil Dispatch() selama hook macet berjalan
+bool CheckIsolation(int timeoutMs) {
+    std::atomic<long long> fastRuns(0);
+    SessionHooks hooks;
+    SessionHook coalesce;
+    coalesce.eventMask = HOOK_ALL_EVENTS;
+    coalesce.command = "sleep 30";
+    coalesce.timeoutMs = timeoutMs;
+    SessionHook drop = coalesce;
+    drop.backpressure = HOOK_DROP;
+    SessionHook fast;
+    fast.eventMask = HOOK_ALL_EVENTS;
+    fast.handler = [&](const HookEventData&) {
+        fastRuns++;
+        return true;
+    };
+    hooks.Add(coalesce);
+    hooks.Add(drop);
+    hooks.Add(fast);
+    hooks.Start(3);
+
+    LatencyRecorder dispatchLatency(0.1);
+    int ticks = 0;
+    int64_t start = NowNs();
+    int64_t end = start + static_cast<int64_t>(timeoutMs) * 1000000 / 2;
+    size_t maxDepth = 0;
+    while (NowNs() < end) {
+        int64_t before = NowNs();
+        hooks.Dispatch(MakeData(ticks % 2 ? HOOK_PAUSE : HOOK_RESUME));
+        dispatchLatency.Record((NowNs() - before) / 1e6);
+        maxDepth = std::max(maxDepth, hooks.GetQueueDepth());
+        ticks++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bool idle = hooks.WaitIdle(timeoutMs * 4 + 5000);
+    HookStats coalesced = hooks.GetStats(0);
+    HookStats dropped = hooks.GetStats(1);
+    HookStats quick = hooks.GetStats(2);
+    hooks.Stop();
+
+    // Hook macet hanya berjalan sekali (event berikutnya tiba saat ia
+    // berjalan) lalu sekali lagi untuk event gabungan
+    bool ok = idle && dispatchLatency.MaxMs() < 1.0 && fastRuns == quick.runs &&
+              quick.runs + quick.coalesced == ticks && coalesced.runs == 2 &&
+              coalesced.coalesced == ticks - 2 && dropped.runs == 1 && dropped.dropped == ticks - 1 &&
+              maxDepth <= hooks.GetHookCount();
+    std::printf("isolation          ticks=%d dispatch %s\n", ticks, dispatchLatency.Report().c_str());
+    std::printf("isolation          fast_runs=%lld coalesce_runs=%lld coalesced=%lld drop_runs=%lld dropped=%lld max_depth=%zu %s\n",
+                quick.runs, coalesced.runs, coalesced.coalesced, dropped.runs, dropped.dropped,
+                maxDepth, ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int timeoutMs = argc > 2 ? std::atoi(argv[2]) : 300;
+    rounds = rounds < 1 ? 1 : rounds;
+    timeoutMs = timeoutMs < 50 ? 50 : timeoutMs;
+
+    bool ok = CheckEvents();
+    ok &= CheckDispatchCost(rounds);
+    ok &= CheckEnvironment();
+    ok &= CheckKill("kill_term", "sleep 30", timeoutMs, timeoutMs);
+    ok &= CheckKill("kill_grace", "trap '' TERM; sleep 30", timeoutMs,
+                    timeoutMs + SessionHooks::KILL_GRACE_MS);
+    ok &= CheckIsolation(timeoutMs);
+    return ok ? 0 : 1;
+}
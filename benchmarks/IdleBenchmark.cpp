@@ -0,0 +1,237 @@
+// IdleBenchmark.cpp
+// Deteksi pengguna diam lewat IdleMonitor: latensi event diam (dihitung
+// dari input terakhir + ambang), latensi event aktif setelah input
+// sintetis, dan berapa kali thread monitor bangun serta CPU yang dipakai
+// selama periode tenang tanpa input (harapannya nol). Juga memeriksa bahwa
+// IdleAutoPause mengembalikan waktu diam ke sisa sesi fokus dan tidak
+// menjeda istirahat.
+//
+// Butuh display X11 dengan ekstensi SYNC (mis. xvfb-run). Input sintetis
+// lewat XTest jika tersedia, selain itu XResetScreenSaver.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. -DPOMODORO_HAVE_XSYNC IdleBenchmark.cpp ../IdleMonitor.cpp ../TimerRegistry.cpp ../TimingWheel.cpp ../TimerCore.cpp ../CountdownEngine.cpp ../Clock.cpp -lXext -lX11 -o idle_bench
+// Usage: idle_bench [ambang_ms] [putaran] [detik_tenang]
+#include "IdleMonitor.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <X11/Xlib.h>
+
+#ifdef POMODORO_HAVE_XTEST
+#include <X11/extensions/XTest.h>
+#endif
+
+namespace {
+
+double NowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+double ProcessCpuMs() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Mencatat waktu event dari thread monitor
+class RecordingListener : public IdleListener {
+public:
+    RecordingListener() : idleAt(0), activeAt(0), idleCount(0), activeCount(0) {}
+
+    void OnUserIdle(int64_t /*idleMs*/) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        idleAt = NowMs();
+        idleCount++;
+        changed.notify_all();
+    }
+
+    void OnUserActive() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        activeAt = NowMs();
+        activeCount++;
+        changed.notify_all();
+    }
+
+    // Menunggu event diam ke-n; waktu event, atau -1 jika habis waktu
+    double WaitIdle(int n, double timeoutMs) {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool ok = changed.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs),
+                                   [&] { return idleCount >= n; });
+        return ok ? idleAt : -1;
+    }
+
+    double WaitActive(int n, double timeoutMs) {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool ok = changed.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs),
+                                   [&] { return activeCount >= n; });
+        return ok ? activeAt : -1;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    double idleAt;
+    double activeAt;
+    int idleCount;
+    int activeCount;
+};
+
+// Input sintetis di koneksi X milik benchmark; waktu setelah server
+// memprosesnya
+double InjectInput(Display* x) {
+#ifdef POMODORO_HAVE_XTEST
+    static int offset = 0;
+    offset = 1 - offset;
+    XTestFakeRelativeMotionEvent(x, offset ? 1 : -1, 0, CurrentTime);
+#else
+    XResetScreenSaver(x);
+#endif
+    XSync(x, False);
+    return NowMs();
+}
+
+void PrintStats(const char* name, const double* values, int count) {
+    if (count == 0) {
+        std::printf("%-18s tidak ada sampel\n", name);
+        return;
+    }
+    double sum = 0;
+    double worst = values[0];
+    double best = values[0];
+    for (int i = 0; i < count; ++i) {
+        sum += values[i];
+        worst = values[i] > worst ? values[i] : worst;
+        best = values[i] < best ? values[i] : best;
+    }
+    std::printf("%-18s n=%d rata2=%.2f ms min=%.2f ms maks=%.2f ms\n",
+                name, count, sum / count, best, worst);
+}
+
+// IdleAutoPause dengan jam virtual: waktu diam kembali ke sisa sesi,
+// istirahat tidak dijeda, perintah manual membatalkan lanjut otomatis
+bool CheckAutoPause() {
+    VirtualClock clock(0, 1700000000000LL);
+    TimerRegistry registry(clock);
+    TimerRegistry::Handle handle = registry.Add("default");
+    TimerCore& core = registry.Core(handle);
+    core.SetDurations(25, 5);
+    IdleAutoPause autoPause(registry, handle);
+    bool ok = true;
+
+    registry.Start(handle);
+    clock.Advance(10 * 60 * 1000);
+    registry.Advance();
+    // Diam 3 menit terakhir dari 10 menit berjalan: sisa sesi seperti
+    // dijeda 3 menit lalu
+    int64_t idleMs = 3 * 60 * 1000;
+    ok &= autoPause.OnUserIdle(idleMs);
+    ok &= core.GetState() == PAUSED_FOCUS;
+    int64_t expected = 25 * 60 * 1000 - (10 * 60 * 1000 - idleMs);
+    ok &= core.RemainingMs() == expected;
+
+    clock.Advance(60 * 1000);
+    ok &= autoPause.OnUserActive();
+    ok &= core.GetState() == RUNNING_FOCUS;
+    ok &= core.RemainingMs() == expected;
+
+    // Jeda manual setelah diam: kembalinya pengguna tidak melanjutkan
+    autoPause.OnUserIdle(1000);
+    autoPause.Forget();
+    ok &= !autoPause.OnUserActive();
+    ok &= core.GetState() == PAUSED_FOCUS;
+
+    // Istirahat tidak dijeda
+    registry.Start(handle);
+    while (core.GetState() == RUNNING_FOCUS || core.InTransition()) {
+        clock.Advance(1000);
+        registry.Advance();
+        registry.Poll(handle);
+    }
+    bool breakPaused = autoPause.OnUserIdle(60 * 1000);
+    ok &= !breakPaused && core.GetState() == RUNNING_BREAK;
+
+    std::printf("auto_pause         dikembalikan=%lld ms jeda=%lld lanjut=%lld %s\n",
+                static_cast<long long>(autoPause.GetReturnedMs()), autoPause.GetPauseCount(),
+                autoPause.GetResumeCount(), ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int64_t thresholdMs = argc > 1 ? std::atoll(argv[1]) : 1000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+    int quietSeconds = argc > 3 ? std::atoi(argv[3]) : 10;
+    const int MAX_ROUNDS = 100;
+    rounds = rounds < 1 ? 1 : (rounds > MAX_ROUNDS ? MAX_ROUNDS : rounds);
+
+    bool ok = CheckAutoPause();
+
+    Display* x = XOpenDisplay(nullptr);
+    if (!x) {
+        std::fputs("tidak ada display; pengukuran IdleMonitor dilewati (jalankan di bawah xvfb-run)\n",
+                   stderr);
+        return ok ? 0 : 1;
+    }
+
+    RecordingListener listener;
+    IdleMonitor monitor;
+    double lastInput = InjectInput(x);
+    if (!monitor.Start(thresholdMs, &listener)) {
+        std::fputs("ekstensi SYNC atau counter IDLETIME tidak tersedia\n", stderr);
+        XCloseDisplay(x);
+        return 1;
+    }
+
+    double idleLatency[MAX_ROUNDS];
+    double activeLatency[MAX_ROUNDS];
+    int idleSamples = 0;
+    int activeSamples = 0;
+    double timeoutMs = thresholdMs + 5000.0;
+
+    for (int round = 1; round <= rounds; ++round) {
+        double idleAt = listener.WaitIdle(round, timeoutMs);
+        if (idleAt < 0) {
+            std::fprintf(stderr, "putaran %d: event diam tidak datang\n", round);
+            ok = false;
+            break;
+        }
+        idleLatency[idleSamples++] = idleAt - lastInput - thresholdMs;
+
+        lastInput = InjectInput(x);
+        double activeAt = listener.WaitActive(round, 5000.0);
+        if (activeAt < 0) {
+            std::fprintf(stderr, "putaran %d: event aktif tidak datang\n", round);
+            ok = false;
+            break;
+        }
+        activeLatency[activeSamples++] = activeAt - lastInput;
+    }
+
+    PrintStats("idle_latency", idleLatency, idleSamples);
+    PrintStats("active_latency", activeLatency, activeSamples);
+
+    // Periode tenang: sudah diam, tidak ada input, tidak ada yang berubah
+    if (ok && listener.WaitIdle(rounds + 1, timeoutMs) >= 0) {
+        long long wakeupsBefore = monitor.GetWakeupCount();
+        double cpuBefore = ProcessCpuMs();
+        std::this_thread::sleep_for(std::chrono::seconds(quietSeconds));
+        long long wakeups = monitor.GetWakeupCount() - wakeupsBefore;
+        double cpuMs = ProcessCpuMs() - cpuBefore;
+        std::printf("quiet_period       detik=%d wakeup=%lld cpu=%.3f ms %s\n",
+                    quietSeconds, wakeups, cpuMs, wakeups == 0 ? "ok" : "BANGUN");
+        ok &= wakeups == 0;
+    }
+
+    std::printf("monitor            wakeup=%lld event=%lld\n",
+                monitor.GetWakeupCount(), monitor.GetEventCount());
+    monitor.Stop();
+    XCloseDisplay(x);
+    return ok ? 0 : 1;
+}
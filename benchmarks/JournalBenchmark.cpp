@@ -0,0 +1,84 @@
+// JournalBenchmark.cpp
+// Biaya Append() ke SessionJournal saat riwayat sudah berisi jutaan record,
+// dan biaya query rentang waktu ("90 hari terakhir") dengan binary search.
+// Juga memeriksa bahwa penulis kedua pada file yang sama ditolak.
+//
+// Build: g++ -std=c++17 -O2 -I.. JournalBenchmark.cpp ../SessionJournal.cpp -o journal_bench
+// Usage: journal_bench [jumlah_record] [file]
+#include "SessionJournal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+double NowUs() {
+    using namespace std::chrono;
+    return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long long count = argc > 1 ? std::atoll(argv[1]) : 5000000;
+    std::string path = argc > 2 ? argv[2] : "bench_journal.bin";
+    std::remove(path.c_str());
+
+    SessionJournal journal;
+    if (!journal.Open(path)) {
+        std::fprintf(stderr, "tidak dapat membuka %s\n", path.c_str());
+        return 1;
+    }
+
+    // Satu sesi tiap 30 menit, mundur dari sekarang
+    const int64_t stepMs = 30LL * 60 * 1000;
+    int64_t t = 1700000000000LL;
+    SessionRecord record = SessionRecord();
+    record.plannedSeconds = 25 * 60;
+    record.actualSeconds = 25 * 60;
+    record.flags = RECORD_COMPLETED;
+
+    double worstUs = 0;
+    double begin = NowUs();
+    for (long long i = 0; i < count; ++i) {
+        record.startMs = t;
+        record.endMs = t + record.plannedSeconds * 1000LL;
+        record.type = (i % 2 == 0) ? SESSION_FOCUS : SESSION_BREAK;
+        double a = NowUs();
+        journal.Append(record);
+        double elapsed = NowUs() - a;
+        if (elapsed > worstUs) {
+            worstUs = elapsed;
+        }
+        t += stepMs;
+    }
+    double appendTotal = NowUs() - begin;
+
+    // Query 90 hari terakhir, diulang agar terukur
+    const int queries = 100000;
+    int64_t to = t;
+    int64_t from = to - 90LL * 24 * 3600 * 1000;
+    size_t first = 0;
+    size_t last = 0;
+    begin = NowUs();
+    for (int q = 0; q < queries; ++q) {
+        journal.FindRange(from - q, to, first, last);
+    }
+    double queryTotal = NowUs() - begin;
+
+    // Selama jurnal terbuka, pembuka kedua (proses lain) harus gagal
+    SessionJournal second;
+    bool exclusive = !second.Open(path);
+
+    std::printf("records=%zu append_ns_avg=%.1f append_us_worst=%.1f\n",
+                journal.Size(), appendTotal * 1000.0 / count, worstUs);
+    std::printf("range_90d_records=%zu query_ns_avg=%.1f\n",
+                last - first, queryTotal * 1000.0 / queries);
+    std::printf("second_writer=%s\n", exclusive ? "ditolak ok" : "DITERIMA");
+
+    journal.Close();
+    std::remove(path.c_str());
+    return exclusive ? 0 : 1;
+}
@@ -0,0 +1,400 @@
+// PomodoroBench.cpp
+// Suite benchmark jalur yang dilalui setiap detik dan setiap klik: format
+// waktu, tick TimerCore, simpan/muat pengaturan, dan (jika dibangun dengan
+// wxWidgets dan ada display, misalnya di bawah Xvfb) tick penuh
+// OnTimer -> UpdateTimerDisplay -> paint, pembuatan dialog notifikasi dan
+// ganti tema pada PomodoroFrame yang sebenarnya.
+//
+// Hasil ditulis sebagai JSON Lines (satu objek per benchmark) agar bisa
+// dibandingkan antar revisi: --baseline membaca hasil lama dan menandai
+// benchmark yang p50-nya memburuk melewati --threshold persen.
+//
+// Build: cmake -S . -B build && cmake --build build --target pomodoro_bench
+// Usage: pomodoro_bench [--json FILE] [--baseline FILE] [--threshold PCT]
+//                       [--filter TEKS] [--quick] [--no-ui] [--workdir DIR]
+#include "Clock.h"
+#include "DisplayModel.h"
+#include "SettingsStore.h"
+#include "TimerCore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#define chdir _chdir
+#else
+#include <unistd.h>
+#endif
+
+#ifdef POMODORO_BENCH_WX
+#include <wx/tglbtn.h>
+#include "PomodoroTimer.h"
+#endif
+
+#ifndef POMODORO_REVISION
+#define POMODORO_REVISION "unknown"
+#endif
+
+namespace {
+
+double NowNs() {
+    using namespace std::chrono;
+    return duration<double, std::nano>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct BenchResult {
+    std::string name;
+    int samples;
+    int batch;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double min;
+};
+
+struct BenchOptions {
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string filter;
+    double thresholdPercent;
+    bool quick;
+    bool ui;
+
+    BenchOptions() : thresholdPercent(10.0), quick(false), ui(true) {}
+};
+
+// Menjalankan op dalam `samples` sampel, masing-masing `batch` kali
+// berturut-turut; statistik dihitung dari ns per op tiap sampel
+class BenchSuite {
+public:
+    explicit BenchSuite(const BenchOptions& options) : options(options) {}
+
+    void Run(const char* name, int samples, int batch, const std::function<void(int)>& op) {
+        if (!options.filter.empty() && std::strstr(name, options.filter.c_str()) == nullptr) {
+            return;
+        }
+        if (options.quick) {
+            samples = std::max(5, samples / 10);
+        }
+
+        // Pemanasan: cache, alokasi pertama, lazy init
+        for (int i = 0; i < batch; ++i) {
+            op(i);
+        }
+
+        std::vector<double> perOp;
+        perOp.reserve(samples);
+        int counter = 0;
+        for (int s = 0; s < samples; ++s) {
+            double begin = NowNs();
+            for (int i = 0; i < batch; ++i) {
+                op(counter++);
+            }
+            perOp.push_back((NowNs() - begin) / batch);
+        }
+
+        std::vector<double> sorted = perOp;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0;
+        for (double v : perOp) {
+            total += v;
+        }
+
+        BenchResult result;
+        result.name = name;
+        result.samples = samples;
+        result.batch = batch;
+        result.mean = total / samples;
+        result.p50 = Percentile(sorted, 0.50);
+        result.p90 = Percentile(sorted, 0.90);
+        result.p99 = Percentile(sorted, 0.99);
+        result.min = sorted.front();
+        results.push_back(result);
+
+        std::printf("%-24s p50=%12.1f ns  p99=%12.1f ns  (%d x %d)\n",
+                    name, result.p50, result.p99, samples, batch);
+        std::fflush(stdout);
+    }
+
+    bool WriteJson(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+        std::fprintf(file, "{\"meta\":\"pomodoro_bench\",\"revision\":\"%s\",\"unit\":\"ns\"}\n",
+                     POMODORO_REVISION);
+        for (const BenchResult& r : results) {
+            std::fprintf(file,
+                         "{\"name\":\"%s\",\"samples\":%d,\"batch\":%d,\"mean\":%.1f,"
+                         "\"p50\":%.1f,\"p90\":%.1f,\"p99\":%.1f,\"min\":%.1f}\n",
+                         r.name.c_str(), r.samples, r.batch, r.mean, r.p50, r.p90, r.p99, r.min);
+        }
+        return std::fclose(file) == 0;
+    }
+
+    // Jumlah benchmark yang memburuk melewati ambang, atau -1 jika
+    // baseline tidak terbaca
+    int CompareWithBaseline(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "r");
+        if (!file) {
+            return -1;
+        }
+        int regressions = 0;
+        char line[512];
+        std::printf("\nvs %s (ambang %.0f%%)\n", path.c_str(), options.thresholdPercent);
+        while (std::fgets(line, sizeof(line), file)) {
+            const char* name = std::strstr(line, "\"name\":\"");
+            const char* p50 = std::strstr(line, "\"p50\":");
+            if (!name || !p50) {
+                continue;
+            }
+            name += 8;
+            const char* nameEnd = std::strchr(name, '"');
+            double old = 0;
+            if (!nameEnd || std::sscanf(p50 + 6, "%lf", &old) != 1 || old <= 0) {
+                continue;
+            }
+            std::string key(name, nameEnd);
+            for (const BenchResult& r : results) {
+                if (r.name != key) {
+                    continue;
+                }
+                double change = (r.p50 - old) * 100.0 / old;
+                bool regressed = change > options.thresholdPercent;
+                if (regressed) {
+                    regressions++;
+                }
+                std::printf("%-24s %12.1f -> %12.1f ns  %+6.1f%%%s\n",
+                            key.c_str(), old, r.p50, change, regressed ? "  REGRESI" : "");
+            }
+        }
+        std::fclose(file);
+        return regressions;
+    }
+
+private:
+    BenchOptions options;
+    std::vector<BenchResult> results;
+
+    static double Percentile(const std::vector<double>& sorted, double p) {
+        size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[index];
+    }
+};
+
+volatile int sink;
+
+void RunCoreBenchmarks(BenchSuite& suite) {
+    // Format "MM:SS" untuk setiap detik satu jam
+    suite.Run("format_time", 200, 10000, [](int i) {
+        char buffer[8];
+        FormatTime(i % 3600, buffer, sizeof(buffer));
+        sink = buffer[4];
+    });
+
+    // Snapshot tampilan dan diff, seperti di awal UpdateTimerDisplay
+    VirtualClock displayClock(0, 1700000000000LL);
+    TimerCore displayCore(displayClock);
+    displayCore.Start();
+    DisplayState previous = BuildDisplayState(displayCore);
+    suite.Run("display_state_diff", 200, 10000, [&](int /*i*/) {
+        displayClock.Advance(1000);
+        DisplayState display = BuildDisplayState(displayCore);
+        sink = static_cast<int>(DiffDisplayState(previous, display));
+        previous = display;
+        if (displayCore.RemainingMs() == 0) {
+            displayCore.Reset();
+            displayCore.Start();
+        }
+    });
+
+    // Satu wakeup TimerCore per detik, sesi dan transisi bergantian
+    VirtualClock tickClock(0, 1700000000000LL);
+    TimerCore tickCore(tickClock);
+    tickCore.Start();
+    suite.Run("core_tick", 200, 10000, [&](int /*i*/) {
+        tickClock.Advance(1000);
+        tickCore.Poll();
+    });
+
+    // Pengaturan: tulis atomik (fsync + rename) lalu baca kembali
+    Settings settings;
+    suite.Run("settings_roundtrip", 50, 1, [&](int i) {
+        settings.focusDuration = 15 + i % 46;
+        WriteSettingsFile("bench_settings.txt", settings);
+        Settings loaded;
+        LoadSettingsFile("bench_settings.txt", loaded);
+        sink = loaded.focusDuration;
+    });
+    suite.Run("settings_load", 200, 100, [&](int /*i*/) {
+        Settings loaded;
+        LoadSettingsFile("bench_settings.txt", loaded);
+        sink = loaded.focusDuration;
+    });
+
+    // Biaya SaveSettings di thread GUI: hanya Schedule()
+    {
+        SettingsWriter writer("bench_settings.txt", 300);
+        suite.Run("settings_schedule", 200, 1000, [&](int i) {
+            settings.focusDuration = 15 + i % 46;
+            writer.Schedule(settings);
+        });
+        writer.Flush();
+    }
+    std::remove("bench_settings.txt");
+}
+
+#ifdef POMODORO_BENCH_WX
+void SendCommand(wxWindow* window, wxEventType type, int id) {
+    wxCommandEvent event(type, id);
+    event.SetEventObject(wxWindow::FindWindowById(id, window));
+    window->GetEventHandler()->ProcessEvent(event);
+}
+
+void RunUiBenchmarks(BenchSuite& suite) {
+    // Teks waktu sebagai wxString baru tiap tick (perilaku lama
+    // FormatTimeDisplay), pembanding untuk jalur tanpa alokasi
+    suite.Run("format_time_display", 200, 10000, [](int i) {
+        char buffer[8];
+        FormatTime(i % 3600, buffer, sizeof(buffer));
+        wxString text(buffer);
+        sink = static_cast<int>(text.length());
+    });
+
+    // Frame sungguhan dengan jam virtual: setiap op memajukan jam satu
+    // detik, mengirim event timer ke OnTimer, lalu memaksa paint
+    VirtualClock clock(0, 1700000000000LL);
+    PomodoroFrame* frame = new PomodoroFrame("Pomodoro Bench", &clock);
+    frame->Show(true);
+    frame->Update();
+    wxYield();
+    SendCommand(frame, wxEVT_BUTTON, ID_START_BUTTON);
+
+    wxTimerEvent timerEvent;
+    timerEvent.SetEventType(wxEVT_TIMER);
+    timerEvent.SetId(ID_TIMER);
+    suite.Run("ui_tick", 200, 10, [&](int i) {
+        clock.Advance(1000);
+        frame->GetEventHandler()->ProcessEvent(timerEvent);
+        frame->Update();
+    });
+
+    // Ganti tema: ApplyTheme + SaveSettings + repaint
+    wxToggleButton* themeToggle =
+        wxDynamicCast(wxWindow::FindWindowById(ID_THEME_TOGGLE, frame), wxToggleButton);
+    if (themeToggle) {
+        suite.Run("theme_switch", 100, 1, [&](int i) {
+            themeToggle->SetValue(!themeToggle->GetValue());
+            SendCommand(frame, wxEVT_TOGGLEBUTTON, ID_THEME_TOGGLE);
+            frame->Update();
+        });
+    }
+
+    // Dialog notifikasi: pembuatan jendela baru (perilaku lama tiap sesi)
+    // dan tampil/sembunyi pada jendela yang dipakai ulang
+    std::vector<NotificationSurface*> surfaces;
+    suite.Run("notification_create", 50, 1, [&](int i) {
+        NotificationSurface* surface = new NotificationSurface(clock);
+        surface->Create(frame);
+        surfaces.push_back(surface);
+    });
+    if (!surfaces.empty()) {
+        NotificationSurface* surface = surfaces.front();
+        suite.Run("notification_show", 100, 1, [&](int i) {
+            surface->Show("Waktu Fokus Selesai", "Anda telah menyelesaikan sesi fokus.",
+                          wxString::Format("Istirahat dimulai dalam: %d detik", i % 5),
+                          i % 2 ? wxColour(100, 150, 200) : wxColour(130, 170, 220), -1);
+            wxYield();
+            surface->Hide();
+        });
+    }
+
+    frame->Destroy();
+    wxYield();
+    for (NotificationSurface* surface : surfaces) {
+        delete surface;
+    }
+}
+#endif
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (arg == "--threshold" && hasValue) {
+            options.thresholdPercent = std::atof(argv[++i]);
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--no-ui") {
+            options.ui = false;
+        } else if (arg == "--workdir" && hasValue) {
+            if (chdir(argv[++i]) != 0) {
+                std::fprintf(stderr, "tidak dapat pindah ke %s\n", argv[i]);
+                return false;
+            }
+        } else {
+            std::fprintf(stderr, "opsi tidak dikenal: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fputs("Usage: pomodoro_bench [--json FILE] [--baseline FILE] [--threshold PCT]\n"
+                   "                      [--filter TEKS] [--quick] [--no-ui] [--workdir DIR]\n",
+                   stderr);
+        return 2;
+    }
+
+    std::printf("pomodoro_bench revisi %s\n", POMODORO_REVISION);
+    BenchSuite suite(options);
+    RunCoreBenchmarks(suite);
+
+#ifdef POMODORO_BENCH_WX
+    if (options.ui) {
+        // Frame memakai file pengaturan/jurnal di direktori kerja dan
+        // socket kontrol di $XDG_RUNTIME_DIR; jalankan dengan --workdir
+        // agar tidak menyentuh data sungguhan
+        if (wxEntryStart(argc, argv)) {
+            RunUiBenchmarks(suite);
+            wxEntryCleanup();
+        } else {
+            std::fputs("tidak ada display; benchmark UI dilewati (jalankan di bawah xvfb-run)\n",
+                       stderr);
+        }
+    }
+#endif
+
+    if (!options.jsonPath.empty() && !suite.WriteJson(options.jsonPath)) {
+        std::fprintf(stderr, "tidak dapat menulis %s\n", options.jsonPath.c_str());
+        return 1;
+    }
+    if (!options.baselinePath.empty()) {
+        int regressions = suite.CompareWithBaseline(options.baselinePath);
+        if (regressions < 0) {
+            std::fprintf(stderr, "tidak dapat membaca %s\n", options.baselinePath.c_str());
+            return 1;
+        }
+        return regressions > 0 ? 3 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,203 @@
+// RenderBenchmark.cpp
+// Biaya render angka countdown: TimerDisplayCtrl (cache glyph, invalidasi
+// parsial, progress bar seperempat piksel) dibandingkan wxStaticText 42pt
+// + wxGauge seperti tampilan lama. Setiap tampilan diukur pada:
+//   1hz    satu update per detik (sesi 25 menit berjalan normal)
+//   60fps  update progress per frame, angka tetap per detik
+//   sweep  60 fps dengan bar penuh dalam 10 detik (setiap frame berubah)
+// Setiap update diikuti Update() agar repaint terjadi sinkron dan ikut
+// terukur. CPU dari getrusage proses ini saja (kerja server X tidak
+// termasuk).
+//
+// Build: g++ -std=c++17 -O2 -I.. RenderBenchmark.cpp ../TimerDisplayCtrl.cpp `wx-config --cxxflags --libs` -o render_bench
+// Usage: xvfb-run -a ./render_bench [detik_per_mode]
+#include "TimerDisplayCtrl.h"
+
+#include <wx/gauge.h>
+#include <wx/timer.h>
+#include <chrono>
+#include <cstdio>
+
+#include <sys/resource.h>
+
+namespace {
+
+int64_t SteadyNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+double ProcessCpuMs() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+struct Mode {
+    bool custom;
+    const char* rate;
+    int intervalMs;
+    double sessionMs;    // durasi sesi yang ditampilkan progress bar
+};
+
+const Mode MODES[] = {
+    { true,  "1hz",   1000, 25 * 60 * 1000.0 },
+    { true,  "60fps", 16,   25 * 60 * 1000.0 },
+    { true,  "sweep", 16,   10 * 1000.0 },
+    { false, "1hz",   1000, 25 * 60 * 1000.0 },
+    { false, "60fps", 16,   25 * 60 * 1000.0 },
+    { false, "sweep", 16,   10 * 1000.0 },
+};
+const int MODE_COUNT = sizeof(MODES) / sizeof(MODES[0]);
+
+class RenderFrame : public wxFrame {
+public:
+    explicit RenderFrame(int secondsPerMode)
+        : wxFrame(NULL, wxID_ANY, "render_bench", wxDefaultPosition, wxSize(450, 220)),
+          secondsPerMode(secondsPerMode), modeIndex(-1), timer(this) {
+        panel = new wxPanel(this);
+        panel->SetBackgroundColour(wxColour(250, 250, 250));
+        wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+
+        display = new TimerDisplayCtrl(panel, wxID_ANY, 42);
+
+        label = new wxStaticText(panel, wxID_ANY, "25:00", wxDefaultPosition, wxDefaultSize,
+                                 wxALIGN_CENTRE_HORIZONTAL | wxST_NO_AUTORESIZE);
+        wxFont font = label->GetFont();
+        font.SetPointSize(42);
+        font.SetWeight(wxFONTWEIGHT_BOLD);
+        label->SetFont(font);
+        wxSize digits = label->GetTextExtent("00:00");
+        label->SetMinSize(wxSize(digits.GetWidth() + 10, digits.GetHeight()));
+        gauge = new wxGauge(panel, wxID_ANY, 100, wxDefaultPosition, wxSize(300, 15));
+
+        sizer->Add(display, 0, wxALIGN_CENTER | wxALL, 5);
+        sizer->Add(label, 0, wxALIGN_CENTER | wxALL, 5);
+        sizer->Add(gauge, 0, wxALIGN_CENTER | wxALL, 8);
+        panel->SetSizer(sizer);
+
+        Bind(wxEVT_TIMER, &RenderFrame::OnTimer, this);
+        CallAfter([this]() { NextMode(); });
+    }
+
+private:
+    int secondsPerMode;
+    int modeIndex;
+    wxTimer timer;
+    wxPanel* panel;
+    TimerDisplayCtrl* display;
+    wxStaticText* label;
+    wxGauge* gauge;
+
+    int64_t modeStartNs;
+    double modeStartCpuMs;
+    long long updates;
+    int64_t updateNs;
+    int lastSeconds;
+    TimerRenderCounters countersAtStart;
+
+    void NextMode() {
+        if (modeIndex >= 0) {
+            Report();
+        }
+        modeIndex++;
+        if (modeIndex >= MODE_COUNT) {
+            timer.Stop();
+            Close(true);
+            return;
+        }
+        const Mode& mode = MODES[modeIndex];
+        display->Show(mode.custom);
+        label->Show(!mode.custom);
+        gauge->Show(!mode.custom);
+        panel->Layout();
+        Update();
+
+        updates = 0;
+        updateNs = 0;
+        lastSeconds = -1;
+        countersAtStart = display->GetCounters();
+        modeStartNs = SteadyNowNs();
+        modeStartCpuMs = ProcessCpuMs();
+        timer.Start(mode.intervalMs);
+    }
+
+    void OnTimer(wxTimerEvent& event) {
+        const Mode& mode = MODES[modeIndex];
+        int64_t now = SteadyNowNs();
+        double elapsedMs = (now - modeStartNs) / 1e6;
+        if (elapsedMs >= secondsPerMode * 1000.0) {
+            timer.Stop();
+            NextMode();
+            return;
+        }
+
+        // Sweep berulang; sesi normal dimulai dari awal
+        double sessionElapsed = elapsedMs;
+        while (sessionElapsed >= mode.sessionMs) {
+            sessionElapsed -= mode.sessionMs;
+        }
+        int remainingSeconds = static_cast<int>((mode.sessionMs - sessionElapsed) / 1000.0);
+        double fraction = sessionElapsed / mode.sessionMs;
+
+        int64_t begin = SteadyNowNs();
+        if (mode.custom) {
+            if (remainingSeconds != lastSeconds) {
+                char text[8];
+                std::snprintf(text, sizeof(text), "%02d:%02d",
+                              remainingSeconds / 60 % 100, remainingSeconds % 60);
+                display->SetTime(text);
+            }
+            display->SetProgress(fraction);
+            display->Update();
+        } else {
+            if (remainingSeconds != lastSeconds) {
+                label->SetLabel(wxString::Format("%02d:%02d", remainingSeconds / 60, remainingSeconds % 60));
+            }
+            gauge->SetValue(static_cast<int>(fraction * 100));
+            label->Update();
+            gauge->Update();
+        }
+        updateNs += SteadyNowNs() - begin;
+        updates++;
+        lastSeconds = remainingSeconds;
+    }
+
+    void Report() {
+        const Mode& mode = MODES[modeIndex];
+        double wallMs = (SteadyNowNs() - modeStartNs) / 1e6;
+        double cpuMs = ProcessCpuMs() - modeStartCpuMs;
+        std::printf("render view=%s rate=%s updates=%lld update_us_avg=%.1f cpu_pct=%.2f",
+                    mode.custom ? "custom" : "static_gauge", mode.rate, updates,
+                    updates > 0 ? updateNs / 1e3 / updates : 0.0, cpuMs * 100.0 / wallMs);
+        if (mode.custom) {
+            const TimerRenderCounters& counters = display->GetCounters();
+            long long paints = counters.paints - countersAtStart.paints;
+            std::printf(" paints=%lld paint_us_avg=%.1f cells=%lld blits=%lld",
+                        paints,
+                        paints > 0 ? (counters.paintNs - countersAtStart.paintNs) / 1e3 / paints : 0.0,
+                        counters.invalidatedCells - countersAtStart.invalidatedCells,
+                        counters.glyphBlits - countersAtStart.glyphBlits);
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+};
+
+class RenderApp : public wxApp {
+public:
+    bool OnInit() override {
+        long seconds = 5;
+        if (argc > 1 && (!wxString(argv[1]).ToLong(&seconds) || seconds <= 0)) {
+            seconds = 5;
+        }
+        RenderFrame* frame = new RenderFrame(static_cast<int>(seconds));
+        frame->Show();
+        return true;
+    }
+};
+
+} // namespace
+
+wxIMPLEMENT_APP(RenderApp);
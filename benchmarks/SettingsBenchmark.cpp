@@ -0,0 +1,74 @@
+// SettingsBenchmark.cpp
+// Waktu thread GUI per satu kali geser slider: penulisan sinkron di setiap
+// EVT_SLIDER (perilaku lama) dibanding SettingsWriter yang menggabungkan
+// perubahan dan menulis di latar belakang.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. SettingsBenchmark.cpp ../SettingsStore.cpp -o settings_bench
+// Usage: settings_bench [direktori] [event_per_geser] [jumlah_geser]
+#include "SettingsStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+
+double NowUs() {
+    using namespace std::chrono;
+    return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : ".";
+    int eventsPerDrag = argc > 2 ? std::atoi(argv[2]) : 40;
+    int drags = argc > 3 ? std::atoi(argv[3]) : 20;
+    std::string path = directory + "/bench_settings.txt";
+
+    Settings settings;
+
+    // Sebelum: tulis ulang file di setiap event slider
+    double syncTotal = 0;
+    for (int d = 0; d < drags; ++d) {
+        for (int e = 0; e < eventsPerDrag; ++e) {
+            settings.focusDuration = 15 + (e % 46);
+            double begin = NowUs();
+            WriteSettingsFile(path, settings);
+            syncTotal += NowUs() - begin;
+        }
+    }
+
+    // Sesudah: Schedule() di thread GUI, tulis di worker
+    double asyncTotal = 0;
+    double flushTotal = 0;
+    long long writes = 0;
+    {
+        SettingsWriter writer(path, 300);
+        for (int d = 0; d < drags; ++d) {
+            for (int e = 0; e < eventsPerDrag; ++e) {
+                settings.focusDuration = 15 + (e % 46);
+                double begin = NowUs();
+                writer.Schedule(settings);
+                asyncTotal += NowUs() - begin;
+                // Jarak antar event saat slider digeser
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+        double begin = NowUs();
+        writer.Flush();
+        flushTotal = NowUs() - begin;
+        writes = writer.GetWriteCount();
+    }
+
+    std::remove(path.c_str());
+
+    std::printf("events_per_drag=%d drags=%d\n", eventsPerDrag, drags);
+    std::printf("sync   gui_us_per_drag=%.1f writes=%d\n",
+                syncTotal / drags, eventsPerDrag * drags);
+    std::printf("writer gui_us_per_drag=%.1f writes=%lld final_flush_us=%.1f\n",
+                asyncTotal / drags, writes, flushTotal);
+    return 0;
+}
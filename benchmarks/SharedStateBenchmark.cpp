@@ -0,0 +1,294 @@
+// SharedStateBenchmark.cpp
+// State bersama antar instance: satu proses pemilik menerbitkan state
+// dengan laju tetap, N proses pembaca membacanya dari segmen shared memory.
+// 1. pembaca yang berputar (seperti render per frame): Read() per detik per
+//    pembaca, pengulangan seqlock, snapshot robek (harus 0), dan keterlambatan
+//    dari Publish() sampai pembaca melihat versi baru;
+// 2. pembaca yang tidur di futex (seperti SharedStateWatcher): latensi
+//    bangun setelah Publish() dan jumlah bangun tanpa perubahan;
+// 3. biaya Publish() di thread pemilik, dengan dan tanpa pembaca menunggu.
+//
+// Setiap snapshot benchmark membawa penghitung k di semua field dan waktu
+// steady_clock (ns) di publishedMs, sehingga pembaca bisa memeriksa
+// konsistensi dan mengukur keterlambatan.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. SharedStateBenchmark.cpp ../SharedTimerState.cpp ../TimerCore.cpp ../CountdownEngine.cpp ../Clock.cpp -o shared_state_bench
+// Usage: shared_state_bench [jumlah_pembaca] [detik_per_fase] [publish_per_detik]
+#include "SharedTimerState.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const int64_t STOP_MARKER = -2;
+const int MAX_SAMPLES = 1 << 16;
+
+int64_t NowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+SharedTimerState MakeState(int64_t k) {
+    SharedTimerState state;
+    state.state = RUNNING_FOCUS;
+    state.deadlineMs = k;
+    state.remainingMs = k;
+    state.durationMs = k;
+    state.transitionDeadlineMs = k;
+    state.completedSessions = static_cast<int>(k & 0x7FFFFFFF);
+    state.publishedMs = NowNs();
+    return state;
+}
+
+bool Consistent(const SharedTimerState& state) {
+    int64_t k = state.deadlineMs;
+    return state.remainingMs == k && state.durationMs == k && state.transitionDeadlineMs == k &&
+           state.completedSessions == static_cast<int>(k & 0x7FFFFFFF);
+}
+
+// Dikirim setiap proses pembaca lewat pipe
+struct ReaderResult {
+    long long reads;
+    long long retries;
+    long long versions;
+    long long torn;
+    long long wakeups;
+    long long emptyWakeups;   // bangun tanpa versi baru
+    double p50Us;
+    double p99Us;
+    double maxUs;
+};
+
+double Percentile(std::vector<int64_t>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index] / 1000.0;
+}
+
+void Summarize(std::vector<int64_t>& lateness, ReaderResult& result) {
+    result.p50Us = Percentile(lateness, 0.50);
+    result.p99Us = Percentile(lateness, 0.99);
+    result.maxUs = lateness.empty() ? 0.0 : *std::max_element(lateness.begin(), lateness.end()) / 1000.0;
+}
+
+ReaderResult RunReader(const std::string& name, bool waiting) {
+    ReaderResult result = {};
+    SharedStateReader reader;
+    if (!reader.Open(name)) {
+        result.torn = -1;
+        return result;
+    }
+    std::vector<int64_t> lateness;
+    lateness.reserve(MAX_SAMPLES);
+    unsigned long long seen = 0;
+    for (;;) {
+        SharedTimerState state;
+        unsigned long long version;
+        bool fresh = reader.Read(state, version) && version != seen;
+        result.reads++;
+        if (fresh) {
+            int64_t now = NowNs();
+            seen = version;
+            result.versions++;
+            if (state.deadlineMs == STOP_MARKER) {
+                break;
+            }
+            if (!Consistent(state)) {
+                result.torn++;
+            }
+            // Versi pertama diterbitkan sebelum pembaca mulai
+            if (result.versions > 1 && lateness.size() < static_cast<size_t>(MAX_SAMPLES)) {
+                lateness.push_back(now - state.publishedMs);
+            }
+        } else if (waiting && result.wakeups > 0) {
+            result.emptyWakeups++;
+        }
+        if (waiting) {
+            reader.WaitForChange(seen, 1000);
+            result.wakeups++;
+        }
+    }
+    result.retries = reader.GetRetryCount();
+    Summarize(lateness, result);
+    return result;
+}
+
+struct PhaseResult {
+    ReaderResult total;
+    double worstP99Us;
+    double worstMaxUs;
+    long long publishes;
+    double publishNs;
+    bool ok;
+};
+
+PhaseResult RunPhase(const std::string& name, SharedStatePublisher& publisher, int readers,
+                     double seconds, int rate, bool waiting) {
+    PhaseResult phase = {};
+    phase.ok = true;
+    // Ganti penanda berhenti fase sebelumnya
+    publisher.Publish(MakeState(0));
+    std::vector<pid_t> children;
+    std::vector<int> pipes;
+    for (int i = 0; i < readers; ++i) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            phase.ok = false;
+            break;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            ReaderResult result = RunReader(name, waiting);
+            ssize_t written = write(fds[1], &result, sizeof(result));
+            _exit(written == sizeof(result) ? 0 : 1);
+        }
+        close(fds[1]);
+        children.push_back(pid);
+        pipes.push_back(fds[0]);
+    }
+
+    // Beri waktu pembaca membuka segmen sebelum menerbitkan
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    int64_t interval = 1000000000LL / (rate > 0 ? rate : 1);
+    int64_t start = NowNs();
+    int64_t end = start + static_cast<int64_t>(seconds * 1e9);
+    int64_t publishTotalNs = 0;
+    int64_t k = 1;
+    for (int64_t next = start; next < end; next += interval) {
+        while (NowNs() < next) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(next - NowNs()));
+        }
+        SharedTimerState state = MakeState(k++);
+        int64_t before = NowNs();
+        publisher.Publish(state);
+        publishTotalNs += NowNs() - before;
+        phase.publishes++;
+    }
+    phase.publishNs = phase.publishes > 0 ? static_cast<double>(publishTotalNs) / phase.publishes : 0;
+
+    // Penanda berhenti; diterbitkan ulang sampai semua pembaca keluar
+    SharedTimerState stop = MakeState(STOP_MARKER);
+    for (size_t i = 0; i < children.size(); ++i) {
+        ReaderResult result = {};
+        for (;;) {
+            stop.completedSessions++;
+            publisher.Publish(stop);
+            int status = 0;
+            if (waitpid(children[i], &status, WNOHANG) == children[i]) {
+                phase.ok &= WIFEXITED(status) && WEXITSTATUS(status) == 0;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        if (read(pipes[i], &result, sizeof(result)) != sizeof(result) || result.torn < 0) {
+            phase.ok = false;
+        }
+        close(pipes[i]);
+        phase.total.reads += result.reads;
+        phase.total.retries += result.retries;
+        phase.total.versions += result.versions;
+        phase.total.torn += result.torn > 0 ? result.torn : 0;
+        phase.total.wakeups += result.wakeups;
+        phase.total.emptyWakeups += result.emptyWakeups;
+        phase.total.p50Us += result.p50Us / children.size();
+        phase.worstP99Us = std::max(phase.worstP99Us, result.p99Us);
+        phase.worstMaxUs = std::max(phase.worstMaxUs, result.maxUs);
+    }
+    phase.ok &= phase.total.torn == 0;
+    return phase;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int readers = argc > 1 ? std::atoi(argv[1]) : 8;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+    int rate = argc > 3 ? std::atoi(argv[3]) : 1000;
+    readers = readers < 1 ? 1 : readers;
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "/pomodoro-bench-%d", static_cast<int>(getpid()));
+    SharedStatePublisher publisher;
+    if (!publisher.Open(name)) {
+        std::fprintf(stderr, "tidak dapat membuat segmen %s\n", name);
+        return 1;
+    }
+
+    // Pemilik kedua harus ditolak selama yang pertama hidup
+    SharedStatePublisher second;
+    bool exclusive = !second.Open(name);
+    SharedStateReader probe;
+    bool ownerSeen = probe.Open(name) && probe.OwnerAlive();
+    std::printf("owner_exclusive=%s owner_alive=%s\n", exclusive ? "ok" : "GAGAL",
+                ownerSeen ? "ok" : "GAGAL");
+
+    // Biaya Publish() tanpa pembaca; snapshot yang sama (tick per detik)
+    // tidak diterbitkan ulang
+    const int publishRounds = 1000000;
+    int64_t before = NowNs();
+    for (int i = 0; i < publishRounds; ++i) {
+        publisher.Publish(MakeState(i + 1));
+    }
+    double publishNs = static_cast<double>(NowNs() - before) / publishRounds;
+    long long countBefore = publisher.GetPublishCount();
+    SharedTimerState same = MakeState(7);
+    for (int i = 0; i < 1000; ++i) {
+        same.remainingMs = 1000 - i;   // hanya sisa waktu sesi berjalan
+        same.publishedMs = NowNs();
+        publisher.Publish(same);
+    }
+    bool skipped = publisher.GetPublishCount() - countBefore == 1;
+    std::printf("publish_ns=%.1f (tanpa pembaca, termasuk MakeState) unchanged_skipped=%s\n",
+                publishNs, skipped ? "ok" : "GAGAL");
+
+    // Read() tanpa kontensi, satu proses
+    SharedTimerState state;
+    unsigned long long version = 0;
+    const int readRounds = 10000000;
+    before = NowNs();
+    long long checksum = 0;
+    for (int i = 0; i < readRounds; ++i) {
+        probe.Read(state, version);
+        checksum += state.deadlineMs;
+    }
+    std::printf("read_ns=%.2f (tanpa kontensi) checksum=%lld\n",
+                static_cast<double>(NowNs() - before) / readRounds, checksum & 0xFF);
+
+    bool ok = exclusive && ownerSeen && skipped;
+    const bool modes[] = { false, true };
+    for (bool waiting : modes) {
+        PhaseResult phase = RunPhase(name, publisher, readers, seconds, rate, waiting);
+        const char* label = waiting ? "wait" : "spin";
+        std::printf("%s readers=%d publishes=%lld publish_ns=%.1f versions_seen=%lld torn=%lld %s\n",
+                    label, readers, phase.publishes, phase.publishNs, phase.total.versions,
+                    phase.total.torn, phase.ok ? "ok" : "GAGAL");
+        if (waiting) {
+            std::printf("wait wakeups=%lld empty_wakeups=%lld wake_latency_us p50=%.1f p99=%.1f max=%.1f\n",
+                        phase.total.wakeups, phase.total.emptyWakeups, phase.total.p50Us,
+                        phase.worstP99Us, phase.worstMaxUs);
+        } else {
+            std::printf("spin reads_per_s=%.0f per_reader=%.0f retries=%lld staleness_us p50=%.2f p99=%.2f max=%.1f\n",
+                        phase.total.reads / seconds, phase.total.reads / seconds / readers,
+                        phase.total.retries, phase.total.p50Us, phase.worstP99Us, phase.worstMaxUs);
+        }
+        ok &= phase.ok;
+    }
+
+    probe.Close();
+    publisher.Close();
+    shm_unlink(name);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// SimulationBenchmark.cpp
+// Menjalankan TimerCore dengan VirtualClock: siklus fokus/istirahat, jeda,
+// lanjut dan reset secara acak, tanpa event loop dan tanpa detik sungguhan.
+// Melaporkan jumlah siklus dan wakeup per detik, serta memeriksa bahwa
+// setiap sesi selesai tepat pada deadline-nya.
+//
+// Build: g++ -std=c++17 -O2 -I.. SimulationBenchmark.cpp ../TimerCore.cpp ../CountdownEngine.cpp ../Clock.cpp -o simulation_bench
+// Usage: simulation_bench [jumlah_siklus] [seed]
+#include "TimerCore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+// Menghitung event dan memeriksa ketepatan waktu selesai sesi
+class CountingListener : public TimerCoreListener {
+public:
+    explicit CountingListener(const VirtualClock& clock)
+        : clock(clock), stateChanges(0), ticks(0), completions(0),
+          focusCompletions(0), transitions(0), lateCompletions(0),
+          expectedDeadlineMs(-1) {}
+
+    void OnStateChanged(TimerState /*state*/) override { stateChanges++; }
+    void OnTick(int /*remainingSeconds*/) override { ticks++; }
+    void OnSessionCompleted(bool wasFocusSession) override {
+        completions++;
+        if (wasFocusSession) {
+            focusCompletions++;
+        }
+        if (expectedDeadlineMs >= 0 && clock.NowMs() != expectedDeadlineMs) {
+            lateCompletions++;
+        }
+    }
+    void OnTransitionFinished() override { transitions++; }
+
+    const VirtualClock& clock;
+    long long stateChanges;
+    long long ticks;
+    long long completions;
+    long long focusCompletions;
+    long long transitions;
+    long long lateCompletions;
+    int64_t expectedDeadlineMs;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long long cycles = argc > 1 ? std::atoll(argv[1]) : 2000000;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 7;
+
+    VirtualClock clock;
+    TimerCore core(clock);
+    CountingListener listener(clock);
+    core.SetListener(&listener);
+    core.SetDurations(25, 5);
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> action(0, 99);
+    std::uniform_int_distribution<int> pauseLength(1000, 600000);
+
+    long long wakeups = 0;
+    long long pauses = 0;
+    long long resets = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (long long i = 0; i < cycles; ++i) {
+        int a = action(rng);
+        if (core.GetState() == READY || core.IsPaused()) {
+            core.Start();
+        } else if (a < 3 && !core.InTransition()) {
+            core.Reset();
+            resets++;
+            continue;
+        } else if (a < 10 && !core.InTransition()) {
+            core.Pause();
+            clock.Advance(pauseLength(rng));
+            pauses++;
+            continue;
+        }
+
+        // Lompat langsung ke deadline berikutnya (mode satu-wakeup), atau
+        // sesekali ke batas detik berikutnya seperti saat jendela terlihat
+        int64_t next = (a < 50) ? core.NextWakeupMs() : core.NextDeadlineMs();
+        if (next < 0) {
+            continue;
+        }
+        listener.expectedDeadlineMs = core.InTransition() ? -1 : core.NextDeadlineMs();
+        clock.Set(next);
+        core.Poll();
+        wakeups++;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - begin).count();
+
+    std::printf("cycles=%lld elapsed_s=%.3f cycles_per_s=%.0f\n",
+                cycles, seconds, cycles / seconds);
+    std::printf("wakeups=%lld pauses=%lld resets=%lld\n", wakeups, pauses, resets);
+    std::printf("completions=%lld focus=%lld transitions=%lld late=%lld\n",
+                listener.completions, listener.focusCompletions,
+                listener.transitions, listener.lateCompletions);
+    std::printf("simulated_hours=%.1f\n", clock.NowMs() / 3600000.0);
+    return listener.lateCompletions == 0 ? 0 : 1;
+}
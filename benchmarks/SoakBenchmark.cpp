@@ -0,0 +1,563 @@
+// SoakBenchmark.cpp
+// Uji rendam dengan jam dipercepat: ribuan siklus fokus/istirahat (jeda dan
+// lanjut di tengah fokus, masa transisi dengan notifikasi, reset di tengah
+// istirahat setiap siklus ke-10) dalam hitungan menit, sambil mencatat
+// sumber daya proses secara berkala:
+//   rss_anon_kb  memori anonim (tanpa halaman jurnal yang di-memory-map)
+//   heap_kb      byte heap yang terpakai (mallinfo2)
+//   fds          file descriptor terbuka
+//   threads      thread proses
+//   widgets      jendela wx (top-level dan semua anaknya)
+//   x_resources  resource X milik proses ini dan byte pixmap-nya (XRes)
+// Siklus awal (10%) adalah pemanasan. Setelah itu median seperempat sampel
+// terakhir dibandingkan dengan median seperempat pertama; program keluar
+// dengan status 1 jika ada yang tumbuh melewati toleransinya. rss_file_kb
+// hanya ditampilkan: jurnal memang bertambah satu record per sesi.
+//
+// Jika dibangun dengan wxWidgets dan ada display (mis. xvfb-run), yang
+// direndam adalah PomodoroFrame yang sebenarnya; tombol dan event timer
+// dikirim seperti di pomodoro_bench. Tanpa wx atau dengan --core, yang
+// direndam adalah TimerCore dengan jurnal, log checkpoint, statistik,
+// penulis pengaturan dan hook seperti di mode headless. Data ditulis ke
+// direktori sementara yang dihapus setelah selesai. Jalankan saat tidak
+// ada instance lain (state bersama per pengguna).
+//
+// Build: cmake -S . -B build && cmake --build build --target soak_bench
+// Usage: soak_bench [siklus] [siklus_per_sampel] [--core]
+//        cmake --build build --target soak   (di bawah Xvfb jika ada)
+#include "AudioEngine.h"
+#include "Clock.h"
+#include "ControlServer.h"
+#include "SessionCheckpoint.h"
+#include "SessionCues.h"
+#include "SessionHooks.h"
+#include "SessionJournal.h"
+#include "SessionStats.h"
+#include "SettingsStore.h"
+#include "TimerCore.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#ifdef POMODORO_BENCH_WX
+#include "PomodoroTimer.h"
+#endif
+
+#ifdef POMODORO_HAVE_XRES
+#include <X11/Xlib.h>
+#include <X11/extensions/XRes.h>
+#endif
+
+namespace {
+
+struct ResourceSample {
+    long cycle;
+    long rssAnonKb;
+    long rssFileKb;
+    long heapKb;
+    long fds;
+    long threads;
+    long widgets;       // -1 jika tidak tersedia
+    long xResources;    // -1 jika tidak tersedia
+    long xPixmapKb;
+};
+
+struct Metric {
+    const char* name;
+    long ResourceSample::*field;
+    long tolerance;
+};
+
+// Toleransi menampung cache yang terisi bertahap (glyph, bucket statistik
+// per hari) tanpa menutupi kebocoran per siklus
+const Metric METRICS[] = {
+    { "rss_anon_kb", &ResourceSample::rssAnonKb, 1024 },
+    { "heap_kb", &ResourceSample::heapKb, 256 },
+    { "fds", &ResourceSample::fds, 0 },
+    { "threads", &ResourceSample::threads, 0 },
+    { "widgets", &ResourceSample::widgets, 0 },
+    { "x_resources", &ResourceSample::xResources, 8 },
+    { "x_pixmap_kb", &ResourceSample::xPixmapKb, 256 },
+};
+const int METRIC_COUNT = sizeof(METRICS) / sizeof(METRICS[0]);
+
+// Satu field "Nama:   nilai kB" dari /proc/self/status
+long ReadStatusField(const char* name) {
+    FILE* file = std::fopen("/proc/self/status", "r");
+    if (!file) {
+        return -1;
+    }
+    char line[256];
+    size_t length = std::strlen(name);
+    long value = -1;
+    while (std::fgets(line, sizeof(line), file)) {
+        if (std::strncmp(line, name, length) == 0 && line[length] == ':') {
+            value = std::atol(line + length + 1);
+            break;
+        }
+    }
+    std::fclose(file);
+    return value;
+}
+
+long CountOpenFds() {
+    DIR* dir = opendir("/proc/self/fd");
+    if (!dir) {
+        return -1;
+    }
+    long count = 0;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            count++;
+        }
+    }
+    closedir(dir);
+    return count - 1;   // fd direktori ini sendiri
+}
+
+long HeapInUseKb() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return static_cast<long>(mallinfo2().uordblks / 1024);
+#else
+    return -1;
+#endif
+}
+
+#ifdef POMODORO_HAVE_XRES
+// Resource X milik semua koneksi proses ini, lewat koneksi terpisah yang
+// tidak membuat resource sendiri
+class XResourceCounter {
+public:
+    XResourceCounter() : display(XOpenDisplay(nullptr)) {}
+    ~XResourceCounter() {
+        if (display) {
+            XCloseDisplay(display);
+        }
+    }
+
+    bool Sample(long& resources, long& pixmapKb) {
+        resources = -1;
+        pixmapKb = -1;
+        int eventBase = 0;
+        int errorBase = 0;
+        if (!display || !XResQueryExtension(display, &eventBase, &errorBase)) {
+            return false;
+        }
+        XResClientIdSpec spec = { 0, XRES_CLIENT_ID_PID_MASK };
+        long count = 0;
+        XResClientIdValue* ids = nullptr;
+        if (XResQueryClientIds(display, 1, &spec, &count, &ids) != Success) {
+            return false;
+        }
+        resources = 0;
+        unsigned long pixmapBytes = 0;
+        for (long i = 0; i < count; ++i) {
+            if (XResGetClientPid(&ids[i]) != getpid()) {
+                continue;
+            }
+            XID client = ids[i].spec.client;
+            int typeCount = 0;
+            XResType* types = nullptr;
+            if (XResQueryClientResources(display, client, &typeCount, &types) == Success) {
+                for (int j = 0; j < typeCount; ++j) {
+                    resources += types[j].count;
+                }
+                XFree(types);
+            }
+            unsigned long bytes = 0;
+            if (XResQueryClientPixmapBytes(display, client, &bytes) == Success) {
+                pixmapBytes += bytes;
+            }
+        }
+        XResClientIdsDestroy(count, ids);
+        pixmapKb = static_cast<long>(pixmapBytes / 1024);
+        return true;
+    }
+
+private:
+    Display* display;
+};
+#endif
+
+// Yang direndam: TimerCore saja atau PomodoroFrame
+class SoakTarget {
+public:
+    virtual ~SoakTarget() {}
+
+    virtual const TimerCore& Core() const = 0;
+    virtual void Command(ControlCommand command) = 0;
+    // Jam sudah dimajukan; proses wakeup seperti timer sungguhan
+    virtual void Tick() = 0;
+    // Sekali per siklus: event yang tertunda (CallAfter, paint)
+    virtual void Settle() {}
+    virtual long CountWidgets() const { return -1; }
+};
+
+// Komponen mode headless di sekitar TimerCore
+class CoreTarget : public SoakTarget, public TimerCoreListener {
+public:
+    explicit CoreTarget(Clock& clock)
+        : core(clock), settingsWriter(SETTINGS_FILE), cues(audio, core) {
+        journal.Open(JOURNAL_FILE);
+        checkpointLog.Open(CHECKPOINT_FILE);
+        SessionHook hook;
+        hook.eventMask = HOOK_ALL_EVENTS;
+        hook.handler = [](const HookEventData&) { return true; };
+        hooks.Add(hook);
+        hooks.Start();
+        core.SetListener(this);
+    }
+
+    ~CoreTarget() {
+        core.SetListener(nullptr);
+        hooks.Stop();
+        settingsWriter.Flush();
+        checkpointLog.Close();
+    }
+
+    const TimerCore& Core() const override { return core; }
+
+    void Command(ControlCommand command) override {
+        switch (command) {
+            case CONTROL_START:
+                core.Start();
+                break;
+            case CONTROL_PAUSE:
+                core.Pause();
+                break;
+            case CONTROL_RESET:
+                core.Reset();
+                break;
+            case CONTROL_TRACE:
+            case CONTROL_ADD:
+                break;
+        }
+    }
+
+    void Tick() override { core.Poll(); }
+
+    // Satu siklus sungguhan berlangsung setengah jam; worker yang dibatasi
+    // jam nyata (fsync per detik, debounce pengaturan) harus sempat selesai,
+    // kalau tidak antreannya tampak seperti kebocoran
+    void Settle() override {
+        checkpointLog.Flush();
+        settingsWriter.Flush();
+        hooks.WaitIdle(1000);
+    }
+
+    void OnStateChanged(TimerState state) override {
+        cues.OnStateChanged(state);
+        hooks.OnStateChanged(core);
+    }
+
+    void OnSessionCompleted(bool wasFocusSession) override {
+        hooks.OnSessionCompleted(core, wasFocusSession);
+        cues.OnSessionCompleted(wasFocusSession);
+        if (wasFocusSession) {
+            Settings settings;
+            settings.completedSessions = core.GetCompletedSessions();
+            settingsWriter.Schedule(settings);
+        }
+    }
+
+    void OnSessionRecord(const SessionRecord& record) override {
+        journal.Append(record);
+        stats.Add(record);
+    }
+
+    void OnCheckpoint(const CheckpointRecord& record) override {
+        checkpointLog.Append(record);
+    }
+
+private:
+    TimerCore core;
+    SessionJournal journal;
+    SessionStats stats;
+    CheckpointLog checkpointLog;
+    SettingsWriter settingsWriter;
+    AudioEngine audio;
+    SessionCues cues;
+    SessionHooks hooks;
+};
+
+#ifdef POMODORO_BENCH_WX
+long CountWindows(wxWindow* window) {
+    long count = 1;
+    for (wxWindowList::compatibility_iterator node = window->GetChildren().GetFirst(); node;
+         node = node->GetNext()) {
+        count += CountWindows(node->GetData());
+    }
+    return count;
+}
+
+class FrameTarget : public SoakTarget {
+public:
+    explicit FrameTarget(Clock& clock) : frame(new PomodoroFrame("Pomodoro Soak", &clock)) {
+        frame->Show(true);
+        frame->Update();
+        wxYield();
+        timerEvent.SetEventType(wxEVT_TIMER);
+        timerEvent.SetId(ID_TIMER);
+    }
+
+    ~FrameTarget() {
+        frame->Close(true);
+        wxYield();
+    }
+
+    bool IsMirror() const { return frame->IsMirror(); }
+
+    const TimerCore& Core() const override { return frame->GetCore(); }
+
+    void Command(ControlCommand command) override {
+        int id = command == CONTROL_START ? ID_START_BUTTON :
+                 command == CONTROL_PAUSE ? ID_PAUSE_BUTTON : ID_RESET_BUTTON;
+        wxCommandEvent event(wxEVT_BUTTON, id);
+        event.SetEventObject(wxWindow::FindWindowById(id, frame));
+        frame->GetEventHandler()->ProcessEvent(event);
+    }
+
+    void Tick() override { frame->GetEventHandler()->ProcessEvent(timerEvent); }
+
+    void Settle() override {
+        frame->Update();
+        wxYield();
+    }
+
+    long CountWidgets() const override {
+        long count = 0;
+        for (wxWindowList::compatibility_iterator node = wxTopLevelWindows.GetFirst(); node;
+             node = node->GetNext()) {
+            count += CountWindows(node->GetData());
+        }
+        return count;
+    }
+
+private:
+    PomodoroFrame* frame;
+    wxTimerEvent timerEvent;
+};
+#endif
+
+void Step(SoakTarget& target, VirtualClock& clock, int64_t ms) {
+    clock.Advance(ms > 0 ? ms : 1);
+    target.Tick();
+}
+
+// Menjalankan sesi yang berjalan sampai habis, termasuk masa transisi
+// per detik (countdown notifikasi); true jika sesi berikutnya sudah mulai
+bool FinishSession(SoakTarget& target, VirtualClock& clock) {
+    const TimerCore& core = target.Core();
+    TimerState session = core.GetState();
+    for (int guard = 0; guard < 64; ++guard) {
+        if (core.InTransition()) {
+            Step(target, clock, 1000);
+        } else if (core.GetState() != session) {
+            return true;
+        } else {
+            Step(target, clock, core.RemainingMs());
+        }
+    }
+    return false;
+}
+
+bool RunCycle(SoakTarget& target, VirtualClock& clock, long cycle) {
+    const TimerCore& core = target.Core();
+    if (core.GetState() == READY || core.IsPaused()) {
+        target.Command(CONTROL_START);
+    }
+    if (core.GetState() != RUNNING_FOCUS) {
+        return false;
+    }
+    // Jeda semenit di sepertiga sesi fokus
+    Step(target, clock, core.RemainingMs() / 3);
+    target.Command(CONTROL_PAUSE);
+    Step(target, clock, 60 * 1000);
+    target.Command(CONTROL_START);
+    if (!FinishSession(target, clock) || core.GetState() != RUNNING_BREAK) {
+        return false;
+    }
+    if (cycle % 10 == 9) {
+        Step(target, clock, core.RemainingMs() / 2);
+        target.Command(CONTROL_RESET);
+    } else if (!FinishSession(target, clock)) {
+        return false;
+    }
+    target.Settle();
+    return core.GetState() == READY || core.GetState() == RUNNING_FOCUS;
+}
+
+ResourceSample TakeSample(const SoakTarget& target, long cycle) {
+    ResourceSample sample;
+    sample.cycle = cycle;
+    sample.rssAnonKb = ReadStatusField("RssAnon");
+    sample.rssFileKb = ReadStatusField("RssFile");
+    sample.heapKb = HeapInUseKb();
+    sample.fds = CountOpenFds();
+    sample.threads = ReadStatusField("Threads");
+    sample.widgets = target.CountWidgets();
+    sample.xResources = -1;
+    sample.xPixmapKb = -1;
+#ifdef POMODORO_HAVE_XRES
+    static XResourceCounter counter;
+    counter.Sample(sample.xResources, sample.xPixmapKb);
+#endif
+    return sample;
+}
+
+long Median(std::vector<long> values) {
+    std::sort(values.begin(), values.end());
+    return values.empty() ? 0 : values[values.size() / 2];
+}
+
+// Median seperempat terakhir dikurangi median seperempat pertama dari
+// sampel setelah pemanasan
+bool CheckGrowth(const std::vector<ResourceSample>& samples, long warmupCycles, long cycles) {
+    std::vector<const ResourceSample*> steady;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (samples[i].cycle >= warmupCycles) {
+            steady.push_back(&samples[i]);
+        }
+    }
+    if (steady.size() < 4) {
+        std::printf("sampel setelah pemanasan kurang (%zu); tambah siklus GAGAL\n", steady.size());
+        return false;
+    }
+    size_t window = steady.size() / 4;
+    long span = steady.back()->cycle - steady.front()->cycle;
+    bool ok = true;
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        const Metric& metric = METRICS[m];
+        if (steady.front()->*metric.field < 0) {
+            std::printf("%-12s tidak tersedia\n", metric.name);
+            continue;
+        }
+        std::vector<long> first;
+        std::vector<long> last;
+        for (size_t i = 0; i < window; ++i) {
+            first.push_back(steady[i]->*metric.field);
+            last.push_back(steady[steady.size() - window + i]->*metric.field);
+        }
+        long growth = Median(last) - Median(first);
+        double per1000 = span > 0 ? growth * 1000.0 / span : 0.0;
+        bool grew = growth > metric.tolerance;
+        std::printf("%-12s awal=%ld akhir=%ld tumbuh=%ld (%.1f per 1000 siklus) toleransi=%ld %s\n",
+                    metric.name, Median(first), Median(last), growth, per1000, metric.tolerance,
+                    grew ? "GAGAL" : "ok");
+        ok &= !grew;
+    }
+    std::printf("rss_file_kb  awal=%ld akhir=%ld (jurnal, tidak diperiksa) siklus=%ld\n",
+                steady.front()->rssFileKb, steady.back()->rssFileKb, cycles);
+    return ok;
+}
+
+bool RunSoak(SoakTarget& target, VirtualClock& clock, long cycles, long sampleEvery) {
+    std::vector<ResourceSample> samples;
+    std::printf("%8s %11s %11s %8s %5s %7s %7s %11s %11s\n", "siklus", "rss_anon_kb", "rss_file_kb",
+                "heap_kb", "fds", "threads", "widgets", "x_resources", "x_pixmap_kb");
+    for (long cycle = 0; cycle < cycles; ++cycle) {
+        if (!RunCycle(target, clock, cycle)) {
+            std::printf("siklus %ld tidak berjalan seperti yang diharapkan (state %s) GAGAL\n",
+                        cycle, ControlStateName(target.Core().GetState()));
+            return false;
+        }
+        if ((cycle + 1) % sampleEvery == 0) {
+            ResourceSample sample = TakeSample(target, cycle + 1);
+            samples.push_back(sample);
+            std::printf("%8ld %11ld %11ld %8ld %5ld %7ld %7ld %11ld %11ld\n", sample.cycle,
+                        sample.rssAnonKb, sample.rssFileKb, sample.heapKb, sample.fds,
+                        sample.threads, sample.widgets, sample.xResources, sample.xPixmapKb);
+            std::fflush(stdout);
+        }
+    }
+    std::printf("sesi_selesai=%d hari_virtual=%.1f\n", target.Core().GetCompletedSessions(),
+                clock.NowMs() / 86400000.0);
+    return CheckGrowth(samples, cycles / 10, cycles);
+}
+
+void RemoveWorkdir(const std::string& path) {
+    if (DIR* dir = opendir(path.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+                unlink((path + "/" + entry->d_name).c_str());
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(path.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long cycles = 0;
+    long sampleEvery = 0;
+    bool coreOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--core") == 0) {
+            coreOnly = true;
+        } else if (cycles == 0) {
+            cycles = std::atol(argv[i]);
+        } else {
+            sampleEvery = std::atol(argv[i]);
+        }
+    }
+    cycles = cycles > 0 ? cycles : 2000;
+    sampleEvery = sampleEvery > 0 ? sampleEvery : std::max(1L, cycles / 40);
+
+    // Pengaturan, jurnal, checkpoint dan socket kontrol di direktori sendiri;
+    // jeda otomatis saat diam dimatikan agar tidak ikut menjeda sesi
+    char workdir[] = "/tmp/pomodoro-soak-XXXXXX";
+    if (!mkdtemp(workdir) || chdir(workdir) != 0) {
+        std::fputs("tidak dapat membuat direktori kerja\n", stderr);
+        return 1;
+    }
+    setenv("XDG_RUNTIME_DIR", workdir, 1);
+    Settings settings;
+    settings.idlePause = false;
+    WriteSettingsFile(SETTINGS_FILE, settings);
+
+    VirtualClock clock(0, 1700000000000LL);
+    bool ok = false;
+    bool ran = false;
+#ifdef POMODORO_BENCH_WX
+    if (!coreOnly) {
+        if (wxEntryStart(argc, argv)) {
+            {
+                FrameTarget target(clock);
+                if (target.IsMirror()) {
+                    std::fputs("instance lain sedang berjalan; tutup dulu\n", stderr);
+                } else {
+                    std::printf("mode=frame siklus=%ld sampel_setiap=%ld\n", cycles, sampleEvery);
+                    ok = RunSoak(target, clock, cycles, sampleEvery);
+                }
+            }
+            wxEntryCleanup();
+            ran = true;
+        } else {
+            std::fputs("tidak ada display; hanya TimerCore yang direndam (jalankan di bawah xvfb-run)\n",
+                       stderr);
+        }
+    }
+#else
+    (void)coreOnly;
+#endif
+    if (!ran) {
+        CoreTarget target(clock);
+        std::printf("mode=core siklus=%ld sampel_setiap=%ld\n", cycles, sampleEvery);
+        ok = RunSoak(target, clock, cycles, sampleEvery);
+    }
+
+    if (chdir("/") == 0) {
+        RemoveWorkdir(workdir);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+// StartupBenchmark.cpp
+// Membandingkan waktu startup dan memori puncak (max RSS) beberapa mode
+// aplikasi. Setiap perintah dijalankan berulang kali sampai keluar sendiri
+// (--exit-after-startup), dan diukur dari fork sampai proses selesai.
+//
+// Build: g++ -std=c++17 -O2 StartupBenchmark.cpp -o startup_bench
+// Usage: startup_bench jumlah_run "label=perintah argumen..." ...
+// Contoh (satu baris):
+//   startup_bench 20 "cli=./pomodoro-cli --exit-after-startup"
+//                    "headless=./pomodoro --headless --exit-after-startup"
+//                    "gui=./pomodoro --exit-after-startup"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct RunResult {
+    double wallMs;
+    long maxRssKb;
+    int exitCode;
+};
+
+bool RunOnce(const std::vector<std::string>& args, RunResult& result) {
+    std::vector<char*> argv;
+    for (size_t i = 0; i < args.size(); ++i) {
+        argv.push_back(const_cast<char*>(args[i].c_str()));
+    }
+    argv.push_back(nullptr);
+
+    auto begin = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDOUT_FILENO);
+            dup2(devNull, STDERR_FILENO);
+        }
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        return false;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    result.wallMs = std::chrono::duration<double, std::milli>(end - begin).count();
+    result.maxRssKb = usage.ru_maxrss;
+    result.exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    return true;
+}
+
+double Median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values.empty() ? 0.0 : values[values.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: %s jumlah_run \"label=perintah argumen...\" ...\n", argv[0]);
+        return 2;
+    }
+    int runs = std::atoi(argv[1]);
+    int failures = 0;
+
+    for (int c = 2; c < argc; ++c) {
+        std::string spec = argv[c];
+        size_t equals = spec.find('=');
+        std::string label = equals != std::string::npos ? spec.substr(0, equals) : spec;
+        std::istringstream command(equals != std::string::npos ? spec.substr(equals + 1) : spec);
+        std::vector<std::string> args;
+        std::string word;
+        while (command >> word) {
+            args.push_back(word);
+        }
+
+        std::vector<double> wall;
+        std::vector<double> rss;
+        int badExits = 0;
+        for (int i = 0; i < runs; ++i) {
+            RunResult result;
+            if (!RunOnce(args, result)) {
+                badExits++;
+                continue;
+            }
+            if (result.exitCode != 0) {
+                badExits++;
+            }
+            wall.push_back(result.wallMs);
+            rss.push_back(static_cast<double>(result.maxRssKb));
+        }
+        std::sort(wall.begin(), wall.end());
+
+        std::printf("%s runs=%d startup_ms min=%.2f p50=%.2f max=%.2f max_rss_kb p50=%.0f failed=%d\n",
+                    label.c_str(), runs,
+                    wall.empty() ? 0.0 : wall.front(), Median(wall),
+                    wall.empty() ? 0.0 : wall.back(), Median(rss), badExits);
+        failures += badExits;
+    }
+    return failures == 0 ? 0 : 1;
+}
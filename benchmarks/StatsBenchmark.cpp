@@ -0,0 +1,82 @@
+// StatsBenchmark.cpp
+// Biaya SessionStats::Rebuild() atas 10 juta sesi (scan kolom per blok)
+// dibanding biaya Add() inkremental per sesi yang selesai.
+//
+// Build: g++ -std=c++17 -O3 -march=native -I.. StatsBenchmark.cpp ../SessionStats.cpp -o stats_bench
+// Usage: stats_bench [jumlah_sesi]
+#include "SessionStats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+double NowUs() {
+    using namespace std::chrono;
+    return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 10000000;
+
+    // Riwayat sintetis: fokus/istirahat bergantian, sesekali di-reset
+    std::vector<SessionRecord> records(count);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> gap(60, 4 * 3600);
+    std::uniform_int_distribution<int> pick(0, 99);
+    int64_t t = 1500000000000LL;
+    for (size_t i = 0; i < count; ++i) {
+        SessionRecord& r = records[i];
+        r = SessionRecord();
+        bool focus = (i % 2 == 0);
+        bool reset = pick(rng) < 8;
+        r.type = focus ? SESSION_FOCUS : SESSION_BREAK;
+        r.plannedSeconds = focus ? 25 * 60 : 5 * 60;
+        r.actualSeconds = reset ? r.plannedSeconds / 2 : r.plannedSeconds;
+        r.flags = reset ? RECORD_RESET : RECORD_COMPLETED;
+        r.startMs = t;
+        r.endMs = t + r.actualSeconds * 1000LL;
+        t = r.endMs + gap(rng) * 1000LL;
+    }
+
+    SessionStats stats;
+    double begin = NowUs();
+    stats.Rebuild(records.data(), records.size());
+    double rebuildUs = NowUs() - begin;
+
+    StatsSummary summary = stats.Summarize(t);
+
+    // Inkremental: tambahkan 1 juta sesi lagi satu per satu
+    const size_t extra = 1000000;
+    SessionRecord r = records.back();
+    begin = NowUs();
+    for (size_t i = 0; i < extra; ++i) {
+        r.startMs = t;
+        r.endMs = t + 25 * 60 * 1000LL;
+        r.type = SESSION_FOCUS;
+        r.flags = RECORD_COMPLETED;
+        stats.Add(r);
+        t = r.endMs + 5 * 60 * 1000LL;
+    }
+    double addUs = NowUs() - begin;
+
+    begin = NowUs();
+    const int summaries = 100000;
+    for (int i = 0; i < summaries; ++i) {
+        summary = stats.Summarize(t + i);
+    }
+    double summarizeUs = NowUs() - begin;
+
+    std::printf("sessions=%zu rebuild_ms=%.1f rebuild_ns_per_record=%.2f\n",
+                count, rebuildUs / 1000.0, rebuildUs * 1000.0 / count);
+    std::printf("add_ns_avg=%.1f summarize_ns_avg=%.1f\n",
+                addUs * 1000.0 / extra, summarizeUs * 1000.0 / summaries);
+    std::printf("focus_sessions=%lld completion=%d%% longest_streak=%d\n",
+                summary.focusSessions, summary.completionPercent, summary.longestStreakDays);
+    return 0;
+}
@@ -0,0 +1,418 @@
+// TaskBenchmark.cpp
+// Daftar task dan indeks pencariannya (TaskStore, TaskIndex) pada daftar
+// sintetis berukuran besar (default 100000 task):
+// 1. waktu bangun indeks (Add satu per satu, seperti memutar ulang log),
+//    jumlah gram/posting dan perkiraan memori;
+// 2. latensi query sambil mengetik: setiap prefix judul yang diketik
+//    huruf demi huruf, query dua kata, dan query dengan salah ketik;
+//    p99 harus di bawah satu frame (16 ms), dan query setelah pemanasan
+//    tidak boleh mengalokasi;
+// 3. kebenaran: judul persis ada di urutan pertama, dua huruf tertukar
+//    masih menemukan task, task selesai disembunyikan, FindOrAdd tidak
+//    membuat duplikat, juga saat judulnya tertimbun judul yang mirip;
+// 4. rollup per task dari record jurnal, inkremental sama dengan dibangun
+//    ulang;
+// 5. log task: tulis, buka ulang, isi dan status selesai sama; baris rusak
+//    di tengah log tidak menggeser id task sesudahnya, dan id yang hilang
+//    (dari log atau dipakai jurnal) tidak diberikan ke task baru.
+//
+// Build: g++ -std=c++17 -O2 -I.. TaskBenchmark.cpp ../TaskIndex.cpp ../TaskStore.cpp -o task_bench
+// Usage: task_bench [jumlah_task]
+#include "TaskStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+std::atomic<long long> allocationCount(0);
+
+void* CountedAlloc(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* p = CountedAlloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+const double FRAME_BUDGET_MS = 16.0;
+
+int64_t NowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+double Percentile(std::vector<int64_t>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return static_cast<double>(values[index]);
+}
+
+// Judul task bertahun-tahun: kata kerja, objek, area dan nomor tiket,
+// dengan kosakata kecil sehingga posting list kata umum sangat panjang
+const char* const VERBS[] = {
+    "Review", "Fix", "Write", "Refactor", "Plan", "Update", "Investigate", "Draft",
+    "Prepare", "Test", "Deploy", "Document", "Migrate", "Design", "Clean up", "Benchmark",
+    "Tulis", "Perbaiki", "Siapkan", "Baca",
+};
+const char* const OBJECTS[] = {
+    "login flow", "quarterly report", "invoice export", "search index", "onboarding docs",
+    "payment gateway", "release notes", "database schema", "cache layer", "mobile layout",
+    "API pagination", "error handling", "unit tests", "build pipeline", "user survey",
+    "laporan bulanan", "rapat tim", "proposal klien", "slide presentasi", "anggaran",
+    "dark mode", "notification settings", "audit log", "backup script", "CSV importer",
+};
+const char* const AREAS[] = {
+    "frontend", "backend", "infra", "marketing", "finance", "research", "personal",
+    "thesis", "kantor", "rumah", "client Acme", "client Globex", "side project",
+};
+
+std::string MakeTitle(uint32_t seed) {
+    uint32_t x = seed * 2654435761u + 12345u;
+    std::string title = VERBS[x % (sizeof(VERBS) / sizeof(VERBS[0]))];
+    x = x * 1103515245u + 12345u;
+    title += " ";
+    title += OBJECTS[(x >> 8) % (sizeof(OBJECTS) / sizeof(OBJECTS[0]))];
+    x = x * 1103515245u + 12345u;
+    title += " (";
+    title += AREAS[(x >> 8) % (sizeof(AREAS) / sizeof(AREAS[0]))];
+    title += ") #" + std::to_string(1000 + seed);
+    return title;
+}
+
+bool CheckBuild(TaskStore& store, int count) {
+    std::vector<std::string> titles;
+    titles.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        titles.push_back(MakeTitle(static_cast<uint32_t>(i)));
+    }
+    int64_t start = NowNs();
+    for (int i = 0; i < count; ++i) {
+        store.Add(titles[i], 1600000000000LL + i * 60000LL);
+    }
+    double buildMs = (NowNs() - start) / 1e6;
+    const TaskIndex& index = store.GetIndex();
+    bool ok = store.Size() == static_cast<size_t>(count);
+    std::printf("bangun             task=%d waktu=%.1f ms (%.2f us/task) gram=%zu posting=%zu memori=%.1f MiB %s\n",
+                count, buildMs, buildMs * 1000.0 / count, index.GramCount(), index.PostingCount(),
+                index.MemoryBytes() / (1024.0 * 1024.0), ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+// Query yang diketik huruf demi huruf: setiap prefix adalah satu query
+void TypeAhead(const std::string& text, std::vector<std::string>& queries) {
+    for (size_t i = 1; i <= text.size(); ++i) {
+        queries.push_back(text.substr(0, i));
+    }
+}
+
+bool CheckLatency(TaskStore& store, int count) {
+    std::vector<std::string> queries;
+    const char* const typed[] = {
+        "review login", "invoice", "lapo bula", "deploy cache infra", "dark mode frontend",
+        "proposal klien acme", "benchmark search index", "tulis thesis",
+    };
+    for (const char* text : typed) {
+        TypeAhead(text, queries);
+    }
+    // Judul lengkap dengan nomor tiket, diketik huruf demi huruf
+    for (int i = 0; i < 6; ++i) {
+        TypeAhead(MakeTitle(static_cast<uint32_t>(1 + (i * 7919) % count)), queries);
+    }
+    // Salah ketik
+    const char* const typos[] = {
+        "invocie export", "pamyent gateway", "refactr cache", "onbaording docs", "laporna bulanan",
+        "migarte database", "notifcation settings",
+    };
+    for (const char* text : typos) {
+        queries.push_back(text);
+    }
+
+    std::vector<TaskMatch> results;
+    results.reserve(10);
+    // Pemanasan: buffer internal indeks tumbuh sekali
+    for (const std::string& query : queries) {
+        store.Search(query, 10, results);
+    }
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(queries.size() * 5);
+    long long before = allocationCount.load();
+    size_t found = 0;
+    for (int round = 0; round < 5; ++round) {
+        for (const std::string& query : queries) {
+            int64_t start = NowNs();
+            found += store.Search(query, 10, results);
+            latencies.push_back(NowNs() - start);
+        }
+    }
+    long long allocations = allocationCount.load() - before;
+    size_t samples = latencies.size();
+    double p50 = Percentile(latencies, 0.50) / 1e6;
+    double p99 = Percentile(latencies, 0.99) / 1e6;
+    double max = Percentile(latencies, 1.0) / 1e6;
+    bool ok = p99 < FRAME_BUDGET_MS && allocations == 0;
+    std::printf("query              n=%zu hasil=%zu ms p50=%.3f p99=%.3f max=%.3f alokasi=%lld %s\n",
+                samples, found, p50, p99, max, allocations, ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+bool CheckRanking(TaskStore& store, int count) {
+    std::vector<TaskMatch> results;
+    bool ok = true;
+
+    // Judul persis (tanpa memperhatikan huruf besar) di urutan pertama
+    uint32_t id = static_cast<uint32_t>(count / 2 + 1);
+    std::string title = store.Find(id)->title;
+    std::string lower = title;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    store.Search(lower, 5, results);
+    bool exact = !results.empty() && results[0].id == id;
+
+    // Dua huruf tertukar di tengah kata terpanjang judul (kata pendek harus
+    // cocok utuh)
+    std::string typo = title;
+    size_t longest = 0;
+    size_t longestLength = 0;
+    for (size_t start = 0; start < typo.size();) {
+        size_t end = typo.find(' ', start);
+        end = end == std::string::npos ? typo.size() : end;
+        if (end - start > longestLength) {
+            longest = start;
+            longestLength = end - start;
+        }
+        start = end + 1;
+    }
+    size_t swap = longest + longestLength / 2;
+    std::swap(typo[swap], typo[swap + 1]);
+    store.Search(typo, 5, results);
+    std::printf("salah_ketik        \"%s\" -> \"%s\"\n", title.c_str(), typo.c_str());
+    bool typoFound = false;
+    for (const TaskMatch& match : results) {
+        typoFound |= match.id == id;
+    }
+
+    // Prefix satu kata mengembalikan hasil penuh
+    store.Search("rev", 10, results);
+    bool prefix = results.size() == 10;
+
+    // Selesai: hilang dari hasil, kembali dengan includeDone
+    store.SetDone(id, true);
+    store.Search(title, 5, results);
+    bool hidden = results.empty() || results[0].id != id;
+    store.Search(title, 5, results, true);
+    bool shownWithDone = !results.empty() && results[0].id == id;
+
+    // FindOrAdd pada judul yang ada (beda huruf besar, task selesai)
+    // mengembalikan task yang sama dan membukanya lagi
+    size_t sizeBefore = store.Size();
+    uint32_t again = store.FindOrAdd(lower, 0);
+    bool reused = again == id && store.Size() == sizeBefore && !store.Find(id)->done;
+    uint32_t added = store.FindOrAdd("Judul yang belum pernah ada", 0);
+    bool created = added == sizeBefore + 1 && store.Size() == sizeBefore + 1;
+
+    // Query tanpa kata: task terbaru
+    store.Search("", 3, results);
+    bool recent = results.size() == 3 && results[0].id == added;
+
+    // Judul persis tertimbun banyak judul satu kata yang skornya sama
+    // (yang lebih baru menang seri): FindOrAdd tetap menemukan task lama
+    TaskStore crowdedStore;
+    crowdedStore.Add("fix", 0);
+    for (int i = 0; i < 20; ++i) {
+        crowdedStore.Add("fix" + std::to_string(i), 0);
+    }
+    bool crowded = crowdedStore.FindOrAdd("fix", 0) == 1 && crowdedStore.Size() == 21;
+
+    ok = exact && typoFound && prefix && hidden && shownWithDone && reused && created && recent &&
+         crowded;
+    std::printf("urutan             persis=%d salah_ketik=%d prefix=%d selesai=%d/%d find_or_add=%d/%d terbaru=%d berdesakan=%d %s\n",
+                exact, typoFound, prefix, hidden, shownWithDone, reused, created, recent, crowded,
+                ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+SessionRecord MakeRecord(uint32_t taskId, int64_t endMs, int seconds, bool completed, uint8_t type) {
+    SessionRecord record = {};
+    record.startMs = endMs - seconds * 1000LL;
+    record.endMs = endMs;
+    record.plannedSeconds = 25 * 60;
+    record.actualSeconds = seconds;
+    record.type = type;
+    record.flags = completed ? RECORD_COMPLETED : 0;
+    record.taskId = taskId;
+    return record;
+}
+
+bool CheckRollups(TaskStore& store) {
+    std::vector<SessionRecord> records;
+    int64_t endMs = 1700000000000LL;
+    int expectedSessions = 0;
+    int64_t expectedSeconds = 0;
+    for (int i = 0; i < 1000; ++i) {
+        uint32_t taskId = 1 + static_cast<uint32_t>(i % 7);
+        bool completed = i % 5 != 0;
+        int seconds = completed ? 25 * 60 : 300 + i;
+        endMs += 30 * 60000LL;
+        records.push_back(MakeRecord(taskId, endMs, seconds, completed, SESSION_FOCUS));
+        // Istirahat dan sesi tanpa task tidak masuk rollup
+        records.push_back(MakeRecord(taskId, endMs + 1, 300, true, SESSION_BREAK));
+        records.push_back(MakeRecord(0, endMs + 2, 25 * 60, true, SESSION_FOCUS));
+        if (taskId == 3) {
+            expectedSessions += completed ? 1 : 0;
+            expectedSeconds += seconds;
+        }
+    }
+
+    store.RebuildRollups(nullptr, 0);
+    for (const SessionRecord& record : records) {
+        store.AddSession(record);
+    }
+    const Task* task = store.Find(3);
+    int incrementalSessions = task->completedSessions;
+    int64_t incrementalSeconds = task->focusSeconds;
+
+    int64_t start = NowNs();
+    store.RebuildRollups(records.data(), records.size());
+    double rebuildUs = (NowNs() - start) / 1e3;
+    bool ok = incrementalSessions == expectedSessions && incrementalSeconds == expectedSeconds &&
+              task->completedSessions == expectedSessions && task->focusSeconds == expectedSeconds &&
+              task->lastFocusMs > 0 && store.Find(8)->completedSessions == 0;
+    std::printf("rollup             record=%zu task3=\"%s\" bangun_ulang=%.1f us %s\n", records.size(),
+                TaskStore::FormatRollup(*task).c_str(), rebuildUs, ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+bool CheckLogReplay() {
+    char workdir[] = "/tmp/task_bench_XXXXXX";
+    if (!mkdtemp(workdir)) {
+        std::printf("log                tidak bisa membuat direktori sementara GAGAL\n");
+        return false;
+    }
+    std::string path = std::string(workdir) + "/" + TASKS_FILE;
+    bool ok;
+    {
+        TaskStore store;
+        ok = store.Open(path);
+        for (int i = 1; i <= 500; ++i) {
+            store.Add(MakeTitle(static_cast<uint32_t>(i)), i);
+        }
+        store.Add("  baris\tdengan\nkontrol  ", 501);
+        ok &= store.Add("   ", 502) == 0;
+        store.SetDone(10, true);
+        store.SetDone(20, true);
+        store.SetDone(20, false);
+    }
+    // Baris terakhir terpotong, seperti crash di tengah penulisan
+    FILE* file = std::fopen(path.c_str(), "a");
+    if (file) {
+        std::fputs("A 502 503 terpot", file);
+        std::fclose(file);
+    }
+
+    TaskStore reopened;
+    ok &= reopened.Open(path);
+    ok &= reopened.Size() == 501;
+    ok &= reopened.Find(10)->done && !reopened.Find(20)->done;
+    ok &= reopened.Find(123)->title == MakeTitle(123);
+    ok &= reopened.Find(501)->title == "baris dengan kontrol";
+    std::vector<TaskMatch> results;
+    reopened.Search(MakeTitle(321), 1, results);
+    ok &= !results.empty() && results[0].id == 321;
+    // Id berikutnya melanjutkan log
+    ok &= reopened.Add("Task baru", 600) == 502;
+    reopened.Close();
+
+    // Baris A di tengah dan di akhir log rusak
+    std::string damagedPath = std::string(workdir) + "/rusak.txt";
+    file = std::fopen(damagedPath.c_str(), "w");
+    bool damagedOk = file != nullptr;
+    if (file) {
+        std::fputs("A 1 100 Satu\nA 2 1x0 Dua\nA 3 300 Tiga\nD 2 1\nA 4 400\n", file);
+        std::fclose(file);
+    }
+    TaskStore damaged;
+    damagedOk &= damaged.Open(damagedPath);
+    damagedOk &= damaged.Find(1) && damaged.Find(1)->title == "Satu" && !damaged.Find(2) &&
+                 damaged.Find(3) && damaged.Find(3)->title == "Tiga" && !damaged.Find(4);
+    // Sesi jurnal yang tertaut ke task 3 tetap masuk ke task 3; sesi ke
+    // task 6 (barisnya hilang) mencadangkan id 6
+    SessionRecord records[2] = { MakeRecord(3, 1000, 1500, true, SESSION_FOCUS),
+                                 MakeRecord(6, 2000, 1500, true, SESSION_FOCUS) };
+    damaged.RebuildRollups(records, 2);
+    damagedOk &= damaged.Find(3)->completedSessions == 1;
+    damagedOk &= damaged.Add("Baru", 500) == 7;
+    damaged.Close();
+    ok &= damagedOk;
+
+    unlink(damagedPath.c_str());
+    unlink(path.c_str());
+    rmdir(workdir);
+    std::printf("log                task=%zu rusak=%s %s\n", reopened.Size(),
+                damagedOk ? "ok" : "GAGAL", ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    count = count < 100 ? 100 : count;
+
+    TaskStore store;
+    bool ok = CheckBuild(store, count);
+    ok &= CheckLatency(store, count);
+    ok &= CheckRanking(store, count);
+    ok &= CheckRollups(store);
+    ok &= CheckLogReplay();
+    return ok ? 0 : 1;
+}
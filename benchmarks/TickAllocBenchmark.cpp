@@ -0,0 +1,293 @@
+// TickAllocBenchmark.cpp
+// Memeriksa bahwa jalur tick dalam keadaan tunak (wakeup -> Advance/Poll
+// registry -> isyarat -> snapshot dan diff tampilan -> publish status ->
+// jadwal wakeup berikutnya) tidak mengalokasi memori. operator new global
+// diganti dengan versi yang menghitung; program keluar dengan status 1 jika
+// ada tick sesi fokus atau istirahat yang mengalokasi, dengan tracer mati
+// maupun hidup. Tick pertama setiap fase (pemanasan vektor internal) dan
+// tick di sekitar selesai sesi tidak dihitung.
+//
+// Jika dibangun dengan wxWidgets dan ada display, tick yang sama juga
+// diperiksa lewat OnTimer pada PomodoroFrame yang sebenarnya (tanpa paint,
+// yang dijadwalkan dan dialokasi oleh wx sendiri).
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. TickAllocBenchmark.cpp ../TimerRegistry.cpp ../TimingWheel.cpp ../TimerCore.cpp ../CountdownEngine.cpp ../Clock.cpp ../WakeupScheduler.cpp ../SessionCues.cpp ../AudioEngine.cpp ../AudioSink.cpp ../DisplayModel.cpp ../ControlServer.cpp ../Tracer.cpp -o tick_alloc_bench
+// Usage: tick_alloc_bench [--no-ui]
+#include "AudioEngine.h"
+#include "ControlServer.h"
+#include "DisplayModel.h"
+#include "SessionCues.h"
+#include "TimerRegistry.h"
+#include "Tracer.h"
+#include "WakeupScheduler.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef POMODORO_BENCH_WX
+#include "PomodoroTimer.h"
+#endif
+
+namespace {
+
+std::atomic<long long> allocationCount(0);
+
+void* CountedAlloc(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* p = CountedAlloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+long long Allocations() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+// Padanan tanpa GUI dari OnTimer/UpdateTimerDisplay/PublishControlStatus
+// di PomodoroFrame
+class TickPath : public TimerCoreListener {
+public:
+    TickPath()
+        : clock(0, 1700000000000LL), registry(clock),
+          mainTimer(registry.Add("default")), core(registry.Core(mainTimer)),
+          wakeups(clock), cues(audio, core), displayValid(false), nextDelayMs(0) {
+        core.SetDurations(25, 5);
+        core.SetListener(this);
+    }
+
+    ~TickPath() { core.SetListener(nullptr); }
+
+    void Start() { registry.Start(mainTimer); }
+
+    // Satu wakeup OS: majukan jam ke wakeup berikutnya lalu layani
+    void Tick() {
+        clock.Advance(nextDelayMs > 0 ? nextDelayMs : 1000);
+        Tracer& tracer = GetTracer();
+        if (tracer.IsEnabled()) {
+            tracer.RecordTickLateness(0);
+        }
+        ScopedTrace trace(TRACE_ON_TIMER);
+        wakeups.RecordWakeup();
+        registry.Advance();
+        registry.Poll(mainTimer);
+        cues.Poll();
+        ScheduleNext();
+    }
+
+    bool InSteadyCountdown() const {
+        return core.IsRunning() && !core.InTransition() && core.RemainingMs() > 2000;
+    }
+
+    TimerState State() const { return core.GetState(); }
+
+    void OnStateChanged(TimerState state) override {
+        cues.OnStateChanged(state);
+        UpdateDisplay();
+        PublishStatus();
+    }
+
+    void OnTick(int /*remainingSeconds*/) override {
+        UpdateDisplay();
+        PublishStatus();
+    }
+
+    void OnTransitionTick(int /*secondsLeft*/) override { PublishStatus(); }
+
+private:
+    VirtualClock clock;
+    TimerRegistry registry;
+    TimerRegistry::Handle mainTimer;
+    TimerCore& core;
+    WakeupScheduler wakeups;
+    AudioEngine audio;
+    SessionCues cues;
+    ControlServer control;
+    DisplayState lastDisplay;
+    bool displayValid;
+    int64_t nextDelayMs;
+
+    void UpdateDisplay() {
+        ScopedTrace trace(TRACE_UPDATE_DISPLAY);
+        DisplayState display = BuildDisplayState(core);
+        if (displayValid && DiffDisplayState(lastDisplay, display) == 0) {
+            return;
+        }
+        lastDisplay = display;
+        displayValid = true;
+    }
+
+    void PublishStatus() {
+        ControlStatus status;
+        status.state = core.GetState();
+        status.inTransition = core.InTransition();
+        status.remainingMs = core.RemainingMs();
+        status.atMs = clock.NowMs();
+        status.completedSessions = core.GetCompletedSessions();
+        control.Publish(status);
+    }
+
+    void ScheduleNext() {
+        int64_t delay = wakeups.NextDelayMs(core);
+        int64_t now = clock.NowMs();
+        const int64_t deadlines[] = { registry.NextDeadlineMs(), cues.NextCueMs() };
+        for (int64_t deadline : deadlines) {
+            if (deadline < 0) {
+                continue;
+            }
+            int64_t deadlineDelay = deadline > now ? deadline - now : 0;
+            if (delay < 0 || deadlineDelay < delay) {
+                delay = deadlineDelay;
+            }
+        }
+        nextDelayMs = delay;
+    }
+};
+
+struct PhaseResult {
+    long long ticks;
+    long long allocations;
+};
+
+// Tick sampai fase fokus dan istirahat berikutnya selesai; hanya tick di
+// tengah countdown (setelah pemanasan) yang dihitung
+PhaseResult RunCoreTicks(TickPath& path, int warmupTicks) {
+    PhaseResult result = { 0, 0 };
+    TimerState previous = READY;
+    long long guard = 0;
+    path.Start();
+    for (int phase = 0; phase < 2; ++phase) {
+        while ((path.State() == previous || !path.InSteadyCountdown()) && ++guard < 100000) {
+            path.Tick();
+        }
+        TimerState state = path.State();
+        int seen = 0;
+        while (path.State() == state && path.InSteadyCountdown()) {
+            long long before = Allocations();
+            path.Tick();
+            if (++seen > warmupTicks) {
+                result.ticks++;
+                result.allocations += Allocations() - before;
+            }
+        }
+        previous = state;
+    }
+    return result;
+}
+
+#ifdef POMODORO_BENCH_WX
+PhaseResult RunFrameTicks(int warmupTicks, int ticks) {
+    PhaseResult result = { 0, 0 };
+    VirtualClock clock(0, 1700000000000LL);
+    PomodoroFrame* frame = new PomodoroFrame("Pomodoro Tick", &clock);
+    frame->Show(true);
+    frame->Update();
+    wxYield();
+
+    wxCommandEvent start(wxEVT_BUTTON, ID_START_BUTTON);
+    start.SetEventObject(wxWindow::FindWindowById(ID_START_BUTTON, frame));
+    frame->GetEventHandler()->ProcessEvent(start);
+
+    wxTimerEvent timerEvent;
+    timerEvent.SetEventType(wxEVT_TIMER);
+    timerEvent.SetId(ID_TIMER);
+    for (int i = 0; i < warmupTicks + ticks; ++i) {
+        clock.Advance(1000);
+        long long before = Allocations();
+        frame->GetEventHandler()->ProcessEvent(timerEvent);
+        if (i >= warmupTicks) {
+            result.ticks++;
+            result.allocations += Allocations() - before;
+        }
+    }
+
+    frame->Destroy();
+    wxYield();
+    return result;
+}
+#endif
+
+bool Report(const char* name, const PhaseResult& result) {
+    std::printf("%-22s ticks=%lld allocations=%lld per_tick=%.3f %s\n",
+                name, result.ticks, result.allocations,
+                result.ticks > 0 ? static_cast<double>(result.allocations) / result.ticks : 0.0,
+                result.allocations == 0 ? "ok" : "MENGALOKASI");
+    return result.allocations == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int warmupTicks = 3;
+    bool ui = !(argc > 1 && std::strcmp(argv[1], "--no-ui") == 0);
+    bool ok = true;
+
+    {
+        TickPath path;
+        ok &= Report("core_tick", RunCoreTicks(path, warmupTicks));
+    }
+
+    // Ring event tracer dialokasikan saat diaktifkan, bukan per tick
+    GetTracer().SetEnabled(true);
+    {
+        TickPath path;
+        ok &= Report("core_tick_traced", RunCoreTicks(path, warmupTicks));
+    }
+    GetTracer().SetEnabled(false);
+
+#ifdef POMODORO_BENCH_WX
+    if (ui) {
+        if (wxEntryStart(argc, argv)) {
+            ok &= Report("frame_tick", RunFrameTicks(warmupTicks, 600));
+            wxEntryCleanup();
+        } else {
+            std::fputs("tidak ada display; tick frame dilewati (jalankan di bawah xvfb-run)\n",
+                       stderr);
+        }
+    }
+#else
+    (void)ui;
+#endif
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+// TimerWheelBenchmark.cpp
+// Banyak timer bersamaan di atas TimingWheel.
+// Bagian 1: biaya Schedule/Cancel, lalu 100k timer dengan jam sungguhan;
+//           pemilik tidur sampai deadline terdekat (satu wakeup OS) dan
+//           latensi kedaluwarsa diukur dalam mikrodetik.
+// Bagian 2: 100k TimerCore di TimerRegistry dengan VirtualClock, siklus
+//           fokus/istirahat penuh; melaporkan throughput dan memori per timer.
+//
+// Build: g++ -std=c++17 -O2 -I.. TimerWheelBenchmark.cpp ../TimingWheel.cpp ../TimerRegistry.cpp ../TimerCore.cpp ../CountdownEngine.cpp ../Clock.cpp -o timer_wheel_bench
+// Usage: timer_wheel_bench [jumlah_timer] [rentang_deadline_ms] [jam_simulasi]
+#include "TimingWheel.h"
+#include "TimerRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int64_t SteadyNowUs() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+double Percentile(std::vector<int64_t>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return static_cast<double>(values[index]);
+}
+
+// Memeriksa bahwa setiap sesi selesai tepat pada deadline-nya
+class CountingListener : public TimerCoreListener {
+public:
+    CountingListener() : completions(0), resets(0), lateCompletions(0) {}
+
+    void OnSessionRecord(const SessionRecord& record) override {
+        if (record.flags & RECORD_RESET) {
+            resets++;
+            return;
+        }
+        completions++;
+        int64_t expectedMs = static_cast<int64_t>(record.plannedSeconds) * 1000 +
+                             static_cast<int64_t>(record.pausedSeconds) * 1000;
+        if (record.endMs - record.startMs != expectedMs) {
+            lateCompletions++;
+        }
+    }
+
+    long long completions;
+    long long resets;
+    long long lateCompletions;
+};
+
+void RunWheel(int count, int spreadMs, std::mt19937& rng) {
+    std::uniform_int_distribution<int> offset(0, spreadMs);
+
+    // Biaya Schedule dan Cancel murni
+    {
+        TimingWheel wheel(SteadyNowUs() / 1000);
+        std::vector<TimingWheel::TimerId> ids(count);
+        int64_t base = wheel.CurrentMs();
+
+        int64_t begin = SteadyNowUs();
+        for (int i = 0; i < count; ++i) {
+            ids[i] = wheel.Schedule(base + offset(rng) * 64LL, static_cast<uint32_t>(i));
+        }
+        int64_t scheduled = SteadyNowUs();
+        for (int i = 0; i < count; ++i) {
+            wheel.Cancel(ids[i]);
+        }
+        int64_t cancelled = SteadyNowUs();
+
+        std::printf("schedule_ns=%.1f cancel_ns=%.1f\n",
+                    (scheduled - begin) * 1000.0 / count,
+                    (cancelled - scheduled) * 1000.0 / count);
+    }
+
+    // Kedaluwarsa dengan jam sungguhan
+    TimingWheel wheel(SteadyNowUs() / 1000);
+    int64_t base = wheel.CurrentMs() + 50;
+    for (int i = 0; i < count; ++i) {
+        wheel.Schedule(base + offset(rng), static_cast<uint32_t>(i));
+    }
+    size_t memory = wheel.MemoryBytes();
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(count);
+    long long wakeups = 0;
+
+    while (wheel.Size() > 0) {
+        int64_t next = wheel.NextDeadlineMs();
+        int64_t sleepUs = next * 1000 - SteadyNowUs();
+        if (sleepUs > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(sleepUs));
+        }
+        wakeups++;
+        int64_t nowUs = SteadyNowUs();
+        wheel.Advance(nowUs / 1000, [&](uint32_t, int64_t deadlineMs) {
+            latencies.push_back(SteadyNowUs() - deadlineMs * 1000);
+        });
+    }
+
+    std::printf("wheel_timers=%d spread_ms=%d wakeups=%lld bytes_per_timer=%.1f\n",
+                count, spreadMs, wakeups, static_cast<double>(memory) / count);
+    std::printf("expiry_latency_us p50=%.0f p99=%.0f max=%.0f\n",
+                Percentile(latencies, 0.50), Percentile(latencies, 0.99),
+                Percentile(latencies, 1.0));
+}
+
+int RunRegistry(int count, double hours, std::mt19937& rng) {
+    VirtualClock clock;
+    TimerRegistry registry(clock);
+    CountingListener listener;
+    std::uniform_int_distribution<int> focusMinutes(15, 50);
+    std::uniform_int_distribution<int> breakMinutes(3, 15);
+    std::uniform_int_distribution<int> startDelay(0, 999);
+    std::uniform_int_distribution<int> action(0, 999);
+
+    std::vector<TimerRegistry::Handle> handles(count);
+    for (int i = 0; i < count; ++i) {
+        handles[i] = registry.Add("timer-" + std::to_string(i));
+        TimerCore& core = registry.Core(handles[i]);
+        core.SetListener(&listener);
+        core.SetDurations(focusMinutes(rng), breakMinutes(rng));
+        clock.Advance(startDelay(rng) % 3);
+        registry.Start(handles[i]);
+    }
+    size_t memory = registry.MemoryBytes();
+
+    int64_t endMs = clock.NowMs() + static_cast<int64_t>(hours * 3600000.0);
+    long long wakeups = 0;
+    long long expirations = 0;
+    long long restarts = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    while (true) {
+        int64_t next = registry.NextDeadlineMs();
+        if (next < 0 || next > endMs) {
+            break;
+        }
+        clock.Set(next);
+        expirations += registry.Advance();
+        wakeups++;
+
+        // Sesekali seseorang me-reset dan memulai ulang timernya
+        if (action(rng) < 5) {
+            TimerRegistry::Handle handle = handles[action(rng) * count / 1000];
+            registry.Reset(handle);
+            registry.Start(handle);
+            restarts++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::printf("registry_timers=%d simulated_hours=%.1f elapsed_s=%.3f\n",
+                count, hours, seconds);
+    std::printf("wakeups=%lld expirations=%lld expirations_per_s=%.0f restarts=%lld\n",
+                wakeups, expirations, expirations / seconds, restarts);
+    std::printf("completions=%lld resets=%lld late=%lld bytes_per_timer=%.1f\n",
+                listener.completions, listener.resets, listener.lateCompletions,
+                static_cast<double>(memory) / count);
+    return listener.lateCompletions == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int spreadMs = argc > 2 ? std::atoi(argv[2]) : 2000;
+    double hours = argc > 3 ? std::atof(argv[3]) : 24.0;
+
+    std::mt19937 rng(11);
+    RunWheel(count, spreadMs, rng);
+    return RunRegistry(count, hours, rng);
+}
@@ -0,0 +1,221 @@
+// TrayIconBenchmark.cpp
+// Atlas ikon tray (TrayIconAtlas):
+// 1. waktu render dan memori atlas untuk ukuran ikon tray umum dan beberapa
+//    pasangan durasi fokus/istirahat dari rentang slider;
+// 2. biaya per update (FrameIndex + NextChangeDelayMs, yang dipanggil
+//    setiap tick) dalam ns dan jumlah alokasinya (harus 0);
+// 3. konsistensi: angka pada frame yang dipilih sama dengan sisa menit
+//    dibulatkan ke atas, dan frame hanya berubah pada jeda yang dilaporkan
+//    NextChangeDelayMs;
+// 4. render ulang: ganti tema merender kedua strip, ganti durasi istirahat
+//    hanya strip istirahat, konfigurasi yang sama tidak merender apa pun.
+//
+// Build: g++ -std=c++17 -O2 -I.. TrayIconBenchmark.cpp ../TrayIconAtlas.cpp -o tray_icon_bench
+// Usage: tray_icon_bench [update_putaran]
+#include "TrayIconAtlas.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<long long> allocationCount(0);
+
+void* CountedAlloc(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* p = CountedAlloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+int64_t NowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Warna tema "Light" dari PomodoroFrame::ApplyTheme
+TrayIconStyle LightStyle() {
+    TrayIconStyle style;
+    style.text = { 20, 20, 20 };
+    style.background = { 250, 250, 250 };
+    style.track = { 220, 220, 220 };
+    style.focusFill = { 100, 150, 200 };
+    style.breakFill = { 130, 170, 220 };
+    return style;
+}
+
+TrayIconStyle CreamStyle() {
+    TrayIconStyle style;
+    style.text = { 70, 50, 30 };
+    style.background = { 250, 245, 230 };
+    style.track = { 225, 215, 195 };
+    style.focusFill = { 180, 140, 100 };
+    style.breakFill = { 130, 170, 220 };
+    return style;
+}
+
+bool CheckFootprint() {
+    const int sizes[] = { 16, 22, 32, 48 };
+    const int durations[][2] = { { 15, 5 }, { 25, 5 }, { 60, 30 } };
+    bool ok = true;
+    for (int size : sizes) {
+        for (const auto& pair : durations) {
+            TrayIconAtlas atlas;
+            int64_t before = NowNs();
+            atlas.Configure(size, LightStyle(), pair[0], pair[1]);
+            double buildMs = (NowNs() - before) / 1e6;
+            size_t expected = static_cast<size_t>(atlas.FrameCount()) * size * size * 4;
+            bool sizeOk = atlas.MemoryBytes() == expected;
+            ok &= sizeOk;
+            std::printf("atlas              size=%-2d fokus=%-2d istirahat=%-2d frames=%-3d memori=%7.1f KiB render=%6.2f ms %s\n",
+                        size, pair[0], pair[1], atlas.FrameCount(), atlas.MemoryBytes() / 1024.0,
+                        buildMs, sizeOk ? "ok" : "GAGAL");
+        }
+    }
+    return ok;
+}
+
+bool CheckUpdateCost(int rounds) {
+    TrayIconAtlas atlas;
+    atlas.Configure(TrayIconAtlas::DEFAULT_SIZE, LightStyle(), 25, 5);
+    const int64_t duration = 25 * 60000LL;
+
+    // Seperti tick: sisa waktu turun, frame hanya disentuh jika berubah
+    long long before = allocationCount.load();
+    int64_t start = NowNs();
+    int lastFrame = -1;
+    int changes = 0;
+    int64_t sink = 0;
+    for (int i = 0; i < rounds; ++i) {
+        int64_t remaining = duration - (static_cast<int64_t>(i) * 37) % duration;
+        bool breakSession = (i & 1023) == 0;
+        int frame = atlas.FrameIndex(breakSession, remaining, duration);
+        sink += atlas.NextChangeDelayMs(breakSession, remaining, duration);
+        if (frame != lastFrame) {
+            sink += atlas.Pixels(frame)[3];
+            lastFrame = frame;
+            changes++;
+        }
+    }
+    double perUpdateNs = static_cast<double>(NowNs() - start) / rounds;
+    long long allocations = allocationCount.load() - before;
+    bool ok = allocations == 0;
+    std::printf("update             n=%d ns=%.1f ganti_frame=%d alokasi=%lld (%lld) %s\n",
+                rounds, perUpdateNs, changes, allocations, static_cast<long long>(sink & 1),
+                ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+// Sisa menit pada ikon = ceil(sisa waktu), dan frame tetap sampai jeda
+// dari NextChangeDelayMs habis
+bool CheckConsistency() {
+    TrayIconAtlas atlas;
+    atlas.Configure(TrayIconAtlas::DEFAULT_SIZE, LightStyle(), 25, 5);
+    bool ok = true;
+    int checked = 0;
+    for (int pass = 0; pass < 2 && ok; ++pass) {
+        bool breakSession = pass == 1;
+        int64_t duration = (breakSession ? 5 : 25) * 60000LL;
+        for (int64_t remaining = duration; remaining > 0; remaining -= 997) {
+            int frame = atlas.FrameIndex(breakSession, remaining, duration);
+            int expectedMinutes = static_cast<int>((remaining + 59999) / 60000);
+            ok &= atlas.FrameIsBreak(frame) == breakSession;
+            ok &= atlas.FrameMinutes(frame) == expectedMinutes;
+            int64_t delay = atlas.NextChangeDelayMs(breakSession, remaining, duration);
+            ok &= delay > 0;
+            if (delay > 1) {
+                ok &= atlas.FrameIndex(breakSession, remaining - delay + 1, duration) == frame;
+            }
+            if (remaining - delay > 0) {
+                ok &= atlas.FrameIndex(breakSession, remaining - delay, duration) != frame;
+            }
+            checked++;
+        }
+        int last = atlas.FrameIndex(breakSession, 0, duration);
+        ok &= atlas.FrameMinutes(last) == 0;
+        ok &= atlas.NextChangeDelayMs(breakSession, 0, duration) == -1;
+    }
+    std::printf("konsistensi        sampel=%d %s\n", checked, ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+bool CheckRerender() {
+    TrayIconAtlas atlas;
+    atlas.Configure(TrayIconAtlas::DEFAULT_SIZE, LightStyle(), 25, 5);
+    int focusFrames = atlas.FrameIndex(true, 5 * 60000LL, 5 * 60000LL);
+    int breakFrames = atlas.FrameCount() - focusFrames;
+
+    long long before = atlas.GetRenderedFrames();
+    unsigned generation = atlas.GetGeneration();
+    bool same = !atlas.Configure(TrayIconAtlas::DEFAULT_SIZE, LightStyle(), 25, 5);
+    bool ok = same && atlas.GetRenderedFrames() == before && atlas.GetGeneration() == generation;
+
+    before = atlas.GetRenderedFrames();
+    atlas.Configure(TrayIconAtlas::DEFAULT_SIZE, CreamStyle(), 25, 5);
+    long long theme = atlas.GetRenderedFrames() - before;
+    ok &= theme == focusFrames + breakFrames && atlas.GetGeneration() == generation + 1;
+
+    before = atlas.GetRenderedFrames();
+    atlas.Configure(TrayIconAtlas::DEFAULT_SIZE, CreamStyle(), 25, 10);
+    long long breakOnly = atlas.GetRenderedFrames() - before;
+    int newBreakFrames = atlas.FrameCount() - focusFrames;
+    ok &= breakOnly == newBreakFrames;
+
+    // Warna teks tema baru harus benar-benar dipakai
+    const uint8_t* pixels = atlas.Pixels(0);
+    bool textFound = false;
+    for (int i = 0; i < atlas.Size() * atlas.Size(); ++i) {
+        const uint8_t* p = pixels + i * 4;
+        textFound |= p[0] == 70 && p[1] == 50 && p[2] == 30 && p[3] == 255;
+    }
+    ok &= textFound;
+    std::printf("render_ulang       sama=%d tema=%lld istirahat=%lld teks=%s %s\n",
+                same ? 0 : 1, theme, breakOnly, textFound ? "ya" : "tidak", ok ? "ok" : "GAGAL");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    rounds = rounds < 1 ? 1 : rounds;
+
+    bool ok = CheckFootprint();
+    ok &= CheckUpdateCost(rounds);
+    ok &= CheckConsistency();
+    ok &= CheckRerender();
+    return ok ? 0 : 1;
+}
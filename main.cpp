@@ -1 +1,34 @@
+// main.cpp
+// Titik masuk aplikasi. "--headless" menjalankan timer tanpa
+// menginisialisasi wx/GTK; selain itu GUI dijalankan lewat wxEntry.
 #include "PomodoroTimer.h"
+#include "HeadlessRunner.h"
+#include "StartupProfiler.h"
+#include "Tracer.h"
+
+#ifdef _WIN32
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
+    GetStartupProfiler().Mark("main");
+    GetStartupProfiler().SetEnabled(HasStartupTimingsFlag(__argc, __argv));
+    ConfigureTracer(__argc, __argv);
+    if (IsHeadlessRequested(__argc, __argv)) {
+        // Aplikasi GUI Windows tidak punya konsol sendiri
+        if (AttachConsole(ATTACH_PARENT_PROCESS) || AllocConsole()) {
+            freopen("CONOUT$", "w", stdout);
+            freopen("CONOUT$", "w", stderr);
+        }
+        return RunHeadless(__argc, __argv);
+    }
+    return wxEntry(hInstance, hPrevInstance, lpCmdLine, nCmdShow);
+}
+#else
+int main(int argc, char** argv) {
+    GetStartupProfiler().Mark("main");
+    GetStartupProfiler().SetEnabled(HasStartupTimingsFlag(argc, argv));
+    ConfigureTracer(argc, argv);
+    if (IsHeadlessRequested(argc, argv)) {
+        return RunHeadless(argc, argv);
+    }
+    return wxEntry(argc, argv);
+}
+#endif